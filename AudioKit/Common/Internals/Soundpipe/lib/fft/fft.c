@@ -12,6 +12,14 @@
 #include <math.h>
 #include "soundpipe.h"
 
+#ifdef SP_FFT_KISS
+#include "kiss_fftr.h"
+#endif
+
+#ifndef NO_PTHREADS
+#include <pthread.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -27,6 +35,9 @@
 #define MYCOSPID8 0.9238795325112867561281831893967882868224  /* cos(pi/8)  */
 #define MYSINPID8 0.3826834323650897717284599840303988667613  /* sin(pi/8)  */
 
+/* Green's FFT, the default backend */
+#ifndef SP_FFT_KISS
+
 /*****************************************************
  * routines to initialize tables used by fft routines *
  *****************************************************/
@@ -3083,8 +3094,110 @@ static void riffts1(SPFLOAT *ioptr, int M, SPFLOAT *Utbl, int16_t *BRLow)
                 ifftrecurs(ioptr, M, Utbl, 2, NDiffU, StageCnt); /* RADIX 8 Stages */
     }
 }
+//static inline int ConvertFFTSize(sp_fft *fft, int N)
+//{
+//    if (N <= 0)
+//      return (-N);
+//    switch (N) {
+//      case 0x00000001:  return 0;
+//      case 0x00000002:  return 1;
+//      case 0x00000004:  return 2;
+//      case 0x00000008:  return 3;
+//      case 0x00000010:  return 4;
+//      case 0x00000020:  return 5;
+//      case 0x00000040:  return 6;
+//      case 0x00000080:  return 7;
+//      case 0x00000100:  return 8;
+//      case 0x00000200:  return 9;
+//      case 0x00000400:  return 10;
+//      case 0x00000800:  return 11;
+//      case 0x00001000:  return 12;
+//      case 0x00002000:  return 13;
+//      case 0x00004000:  return 14;
+//      case 0x00008000:  return 15;
+//      case 0x00010000:  return 16;
+//      case 0x00020000:  return 17;
+//      case 0x00040000:  return 18;
+//      case 0x00080000:  return 19;
+//      case 0x00100000:  return 20;
+//      case 0x00200000:  return 21;
+//      case 0x00400000:  return 22;
+//      case 0x00800000:  return 23;
+//      case 0x01000000:  return 24;
+//      case 0x02000000:  return 25;
+//      case 0x04000000:  return 26;
+//      case 0x08000000:  return 27;
+//      case 0x10000000:  return 28;
+//    }
+//    return 0;
+//}
+
+//static inline void getTablePointers(sp_fft *p, SPFLOAT **ct, int16_t **bt,
+//                                    int cn, int bn)
+//{
+//    /*if (!(p->FFT_max_size & (1 << cn)))
+//     fftInit(p, cn);
+//     */
+//    //*ct = ((SPFLOAT**) p->FFT_table_1)[cn];
+//    //*bt = ((int16_t**) p->FFT_table_2)[bn];
+//}
+
+#endif /* SP_FFT_KISS */
+
+/*
+ * Plan cache
+ *
+ * Twiddle and bit reversal tables only depend on the size, so they are
+ * kept once per size for the whole process and shared by every sp_fft
+ * (sp_conv and sp_mincer instances, ...) through a refcount. One plan
+ * serves both directions.
+ *
+ * kissfft keeps its scratch buffer in its config, so a shared config could
+ * not be used from two threads at once. With SP_FFT_KISS the plan only
+ * knows the config size, and each work area gets its own pair of configs
+ * from sp_fft_plan_work_init().
+ *
+ * The backend is chosen at compile time: Green's radix-2 by default, or
+ * kissfft with SP_FFT_KISS. Both use the packed real spectrum layout of
+ * rffts1: Re(0), Re(N/2), Re(1), Im(1), ... Re(N/2-1), Im(N/2-1), and
+ * the inverse is scaled by 1/N.
+ */
+
+struct sp_fft_plan {
+    int M;
+    int refcount;
+    struct sp_fft_plan *next;
+#ifdef SP_FFT_KISS
+    /* bytes a kissfft config for either direction takes */
+    size_t cfgsize;
+#else
+    SPFLOAT *utbl;
+    int16_t *BRLow;
+#endif
+};
+
+static sp_fft_plan *fft_plans = NULL;
+
+#ifdef SP_FFT_KISS
+/* start of a work area, followed by the spectrum and both configs */
+typedef struct {
+    kiss_fftr_cfg fwd, inv;
+    kiss_fft_cpx *spec;
+} fft_work;
+#endif
+
+#ifndef NO_PTHREADS
+static pthread_mutex_t fft_plans_lock = PTHREAD_MUTEX_INITIALIZER;
+#define PLANS_LOCK() pthread_mutex_lock(&fft_plans_lock)
+#define PLANS_UNLOCK() pthread_mutex_unlock(&fft_plans_lock)
+#else
+#define PLANS_LOCK()
+#define PLANS_UNLOCK()
+#endif
+
+#ifndef SP_FFT_KISS
 //static void fftInit(sp_fft *fft, int M)
-void sp_fft_init(sp_fft *fft, int M)
+static void fftInit(sp_fft_plan *fft, int M)
 {
     /* malloc and init cosine and bit reversed tables for a given size  */
     /* fft, ifft, rfft, rifft                                           */
@@ -3137,79 +3250,148 @@ void sp_fft_init(sp_fft *fft, int M)
     
     //fft->FFT_max_size |= (1 << M);
 }
+#endif
 
-//static inline int ConvertFFTSize(sp_fft *fft, int N)
-//{
-//    if (N <= 0)
-//      return (-N);
-//    switch (N) {
-//      case 0x00000001:  return 0;
-//      case 0x00000002:  return 1;
-//      case 0x00000004:  return 2;
-//      case 0x00000008:  return 3;
-//      case 0x00000010:  return 4;
-//      case 0x00000020:  return 5;
-//      case 0x00000040:  return 6;
-//      case 0x00000080:  return 7;
-//      case 0x00000100:  return 8;
-//      case 0x00000200:  return 9;
-//      case 0x00000400:  return 10;
-//      case 0x00000800:  return 11;
-//      case 0x00001000:  return 12;
-//      case 0x00002000:  return 13;
-//      case 0x00004000:  return 14;
-//      case 0x00008000:  return 15;
-//      case 0x00010000:  return 16;
-//      case 0x00020000:  return 17;
-//      case 0x00040000:  return 18;
-//      case 0x00080000:  return 19;
-//      case 0x00100000:  return 20;
-//      case 0x00200000:  return 21;
-//      case 0x00400000:  return 22;
-//      case 0x00800000:  return 23;
-//      case 0x01000000:  return 24;
-//      case 0x02000000:  return 25;
-//      case 0x04000000:  return 26;
-//      case 0x08000000:  return 27;
-//      case 0x10000000:  return 28;
-//    }
-//    return 0;
-//}
+sp_fft_plan *sp_fft_plan_get(int M)
+{
+    sp_fft_plan *plan;
 
-//static inline void getTablePointers(sp_fft *p, SPFLOAT **ct, int16_t **bt,
-//                                    int cn, int bn)
-//{
-//    /*if (!(p->FFT_max_size & (1 << cn)))
-//     fftInit(p, cn);
-//     */
-//    //*ct = ((SPFLOAT**) p->FFT_table_1)[cn];
-//    //*bt = ((int16_t**) p->FFT_table_2)[bn];
-//}
+    PLANS_LOCK();
+    for (plan = fft_plans; plan != NULL; plan = plan->next) {
+        if (plan->M == M) break;
+    }
+    if (plan == NULL) {
+        /* plans outlive any one sp_data, so they never come from an arena */
+        plan = malloc(sizeof(sp_fft_plan));
+        plan->M = M;
+        plan->refcount = 0;
+#ifdef SP_FFT_KISS
+        plan->cfgsize = 0;
+        kiss_fftr_alloc(POW2(M), 0, NULL, &plan->cfgsize);
+#else
+        fftInit(plan, M);
+#endif
+        plan->next = fft_plans;
+        fft_plans = plan;
+    }
+    plan->refcount++;
+    PLANS_UNLOCK();
+    return plan;
+}
+
+void sp_fft_plan_release(sp_fft_plan *plan)
+{
+    sp_fft_plan **pp;
+
+    PLANS_LOCK();
+    if (--plan->refcount > 0) {
+        PLANS_UNLOCK();
+        return;
+    }
+    for (pp = &fft_plans; *pp != plan; pp = &(*pp)->next);
+    *pp = plan->next;
+    PLANS_UNLOCK();
+#ifndef SP_FFT_KISS
+    free(plan->utbl);
+    free(plan->BRLow);
+#endif
+    free(plan);
+}
+
+int sp_fft_plan_size(sp_fft_plan *plan)
+{
+    return POW2(plan->M);
+}
+
+void sp_fft_plan_forward(sp_fft_plan *plan, SPFLOAT *buf, void *work)
+{
+#ifdef SP_FFT_KISS
+    fft_work *w = work;
+    kiss_fft_cpx *spec = w->spec;
+    int i, N2 = POW2(plan->M) / 2;
+    kiss_fftr(w->fwd, buf, spec);
+    buf[0] = spec[0].r;
+    buf[1] = spec[N2].r;
+    for (i = 1; i < N2; i++) {
+        buf[2 * i] = spec[i].r;
+        buf[2 * i + 1] = spec[i].i;
+    }
+#else
+    rffts1(buf, plan->M, plan->utbl, plan->BRLow);
+#endif
+}
+
+void sp_fft_plan_inverse(sp_fft_plan *plan, SPFLOAT *buf, void *work)
+{
+#ifdef SP_FFT_KISS
+    fft_work *w = work;
+    kiss_fft_cpx *spec = w->spec;
+    int i, N = POW2(plan->M), N2 = N / 2;
+    SPFLOAT scale = 1.0 / N;
+    spec[0].r = buf[0];
+    spec[0].i = 0;
+    spec[N2].r = buf[1];
+    spec[N2].i = 0;
+    for (i = 1; i < N2; i++) {
+        spec[i].r = buf[2 * i];
+        spec[i].i = buf[2 * i + 1];
+    }
+    kiss_fftri(w->inv, spec, buf);
+    for (i = 0; i < N; i++) buf[i] *= scale;
+#else
+    riffts1(buf, plan->M, plan->utbl, plan->BRLow);
+#endif
+}
+
+size_t sp_fft_plan_worksize(sp_fft_plan *plan)
+{
+#ifdef SP_FFT_KISS
+    return sizeof(fft_work) + sizeof(kiss_fft_cpx) * (POW2(plan->M) / 2 + 1) +
+        2 * plan->cfgsize;
+#else
+    return 0;
+#endif
+}
+
+void sp_fft_plan_work_init(sp_fft_plan *plan, void *work)
+{
+#ifdef SP_FFT_KISS
+    fft_work *w = work;
+    char *mem = (char *)(w + 1);
+    size_t len;
+    int N = POW2(plan->M);
+
+    w->spec = (kiss_fft_cpx *)mem;
+    mem += sizeof(kiss_fft_cpx) * (N / 2 + 1);
+    len = plan->cfgsize;
+    w->fwd = kiss_fftr_alloc(N, 0, mem, &len);
+    mem += plan->cfgsize;
+    len = plan->cfgsize;
+    w->inv = kiss_fftr_alloc(N, 1, mem, &len);
+#endif
+}
+
+void sp_fft_init(sp_fft *fft, int M)
+{
+    size_t size;
+    fft->plan = sp_fft_plan_get(M);
+    size = sp_fft_plan_worksize(fft->plan);
+    fft->work = size > 0 ? malloc(size) : NULL;
+    if (fft->work != NULL) sp_fft_plan_work_init(fft->plan, fft->work);
+}
 
 void sp_fftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
 {
-//    SPFLOAT *Utbl;
-//    int16_t *BRLow;
-    int   M = log2(FFTsize);
-    
-    //M = ConvertFFTSize(fft, FFTsize);
-    //getTablePointers(fft, &Utbl, &BRLow, M, (M - 1) / 2);
-    rffts1(buf, M, fft->utbl, fft->BRLow);
+    sp_fft_plan_forward(fft->plan, buf, fft->work);
 }
 
 void sp_ifftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
 {
-//    SPFLOAT *Utbl;
-//    int16_t *BRLow;
-    int   M = log2(FFTsize);
-    
-    //M = ConvertFFTSize(fft, FFTsize);
-    //getTablePointers(fft, &Utbl, &BRLow, M, (M - 1) / 2);
-    riffts1(buf, M, fft->utbl, fft->BRLow);
+    sp_fft_plan_inverse(fft->plan, buf, fft->work);
 }
 
 void sp_fft_destroy(sp_fft *fft) 
 {
-    free(fft->utbl);
-    free(fft->BRLow);
+    sp_fft_plan_release(fft->plan);
+    free(fft->work);
 }
@@ -6,13 +6,13 @@ enum { CLEAR, ATTACK, DECAY, SUSTAIN, RELEASE };
 
 int sp_adsr_create(sp_adsr **p)
 {
-    *p = malloc(sizeof(sp_adsr));
+    *p = sp_malloc(sizeof(sp_adsr));
     return SP_OK;
 }
 
 int sp_adsr_destroy(sp_adsr **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -86,3 +86,12 @@ int sp_adsr_compute(sp_data *sp, sp_adsr *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_adsr_compute_block(sp_data *sp, sp_adsr *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_adsr_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -16,15 +16,15 @@
 
 int sp_allpass_create(sp_allpass **p)
 {
-    *p = malloc(sizeof(sp_allpass));
+    *p = sp_malloc(sizeof(sp_allpass));
     return SP_OK;
 }
 
 int sp_allpass_destroy(sp_allpass **p)
 {
     sp_allpass *pp = *p;
-    sp_auxdata_free(&pp->aux);
-    free(*p);
+    sp_dline_destroy(&pp->dl);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -33,28 +33,41 @@ int sp_allpass_init(sp_data *sp, sp_allpass *p, SPFLOAT looptime)
     p->revtime = 3.5;
     p->looptime = looptime;
     p->bufsize = 0.5 + looptime * sp->sr;
-    sp_auxdata_alloc(&p->aux, p->bufsize * sizeof(SPFLOAT));
+    if(p->bufsize < 1) p->bufsize = 1;
+    sp_dline_init(&p->dl, p->bufsize);
     p->prvt = 0.0;
     p->coef = 0.0;
-    p->bufpos = 0;
     return SP_OK;
 }
 
 int sp_allpass_compute(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out)
 {
-    SPFLOAT y, z;
+    return sp_allpass_compute_block(sp, p, in, out, 1);
+}
+
+int sp_allpass_compute_block(sp_data *sp, sp_allpass *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT y[SP_DLINE_CHUNK], z[SP_DLINE_CHUNK];
     SPFLOAT coef = p->coef;
+    uint32_t bufsize = p->bufsize;
+    uint32_t i = 0, j, len;
 
     if(p->prvt != p->revtime) {
         p->prvt = p->revtime;
         coef = p->coef = exp(-6.9078 * p->looptime / p->prvt);
     }
-    sp_auxdata_getbuf(&p->aux, p->bufpos, &y);
-    z = coef * y + *in; 
-    sp_auxdata_setbuf(&p->aux, p->bufpos, &z);
-    *out = y - coef * z;
 
-    p->bufpos++;
-    p->bufpos %= p->bufsize; 
+    while(i < n) {
+        len = n - i;
+        if(len > SP_DLINE_CHUNK) len = SP_DLINE_CHUNK;
+        if(len > bufsize) len = bufsize;
+        sp_dline_read(&p->dl, bufsize, y, len);
+        for(j = 0; j < len; j++) {
+            z[j] = coef * y[j] + in[i + j];
+            out[i + j] = y[j] - coef * z[j];
+        }
+        sp_dline_write(&p->dl, z, len);
+        i += len;
+    }
     return SP_OK;
 }
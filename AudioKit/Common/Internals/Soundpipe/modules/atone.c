@@ -20,13 +20,13 @@
 
 int sp_atone_create(sp_atone **p)
 {
-    *p = malloc(sizeof(sp_atone));
+    *p = sp_malloc(sizeof(sp_atone));
     return SP_OK;
 }
 
 int sp_atone_destroy(sp_atone **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -44,9 +44,15 @@ int sp_atone_init(sp_data *sp, sp_atone *p)
 }
 
 int sp_atone_compute(sp_data *sp, sp_atone *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_atone_compute_block(sp, p, in, out, 1);
+}
+
+int sp_atone_compute_block(sp_data *sp, sp_atone *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT c2 = p->c2, yt1 = p->yt1;
     SPFLOAT x;
+    uint32_t i;
 
     if (p->hp != p->prvhp) {
       SPFLOAT b;
@@ -55,9 +61,11 @@ int sp_atone_compute(sp_data *sp, sp_atone *p, SPFLOAT *in, SPFLOAT *out)
       p->c2 = c2 = b - sqrt(b * b - 1.0);
     }
 
-    x = yt1 = c2 * (yt1 + *in);
-    *out = x;
-    yt1 -= *in;
+    for(i = 0; i < n; i++) {
+        x = yt1 = c2 * (yt1 + in[i]);
+        out[i] = x;
+        yt1 -= in[i];
+    }
     p->yt1 = yt1;
     return SP_OK;
 }
@@ -42,12 +42,12 @@ typedef struct {
 } autowah;
 
 autowah* newautowah() { 
-	autowah* dsp = (autowah*)malloc(sizeof(autowah));
+	autowah* dsp = (autowah*)sp_malloc(sizeof(autowah));
 	return dsp;
 }
 
 void deleteautowah(autowah* dsp) { 
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitautowah(autowah* dsp, int samplingFreq) {
@@ -174,7 +174,7 @@ static void addVerticalSlider(void* ui_interface, const char* label, FAUSTFLOAT*
 
 int sp_autowah_create(sp_autowah **p)
 {
-    *p = malloc(sizeof(sp_autowah));
+    *p = sp_malloc(sizeof(sp_autowah));
     return SP_OK;
 }
 
@@ -183,7 +183,7 @@ int sp_autowah_destroy(sp_autowah **p)
     sp_autowah *pp = *p;
     autowah *dsp = pp->faust;
     deleteautowah (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -213,3 +213,12 @@ int sp_autowah_compute(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out)
     computeautowah(dsp, 1, faust_in, faust_out);
     return SP_OK;
 }
+
+int sp_autowah_compute_block(sp_data *sp, sp_autowah *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    autowah *dsp = p->faust;
+    SPFLOAT *faust_out[] = {out};
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in};
+    computeautowah(dsp, n, faust_in, faust_out);
+    return SP_OK;
+}
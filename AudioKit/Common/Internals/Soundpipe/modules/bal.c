@@ -20,13 +20,13 @@
 
 int sp_bal_create(sp_bal **p)
 {
-    *p = malloc(sizeof(sp_bal));
+    *p = sp_malloc(sizeof(sp_bal));
     return SP_OK;
 }
 
 int sp_bal_destroy(sp_bal **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -44,27 +44,37 @@ int sp_bal_init(sp_data *sp, sp_bal *p)
 }
 
 int sp_bal_compute(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp, SPFLOAT *out)
+{
+    return sp_bal_compute_block(sp, p, sig, comp, out, 1);
+}
+
+int sp_bal_compute_block(sp_data *sp, sp_bal *p, const SPFLOAT *sig, const SPFLOAT *comp, SPFLOAT *out, uint32_t n)
 {
     double  q, r, a;
     double  c1 = p->c1, c2 = p->c2;
+    SPFLOAT prvq = p->prvq, prvr = p->prvr;
+    uint32_t i;
+
+    for(i = 0; i < n; i++) {
+        double as = sig[i];
+        double cs = comp[i];
 
-    q = p->prvq;
-    r = p->prvr;
-    double as = *sig;
-    double cs = *comp;
+        q = c1 * as * as + c2 * prvq;
+        r = c1 * cs * cs + c2 * prvr;
 
-    q = c1 * as * as + c2 * q;
-    r = c1 * cs * cs + c2 * r;
+        prvq = q;
+        prvr = r;
 
-    p->prvq = q;
-    p->prvr = r;
+        if (q != 0.0) {
+            a = sqrt(r/q);
+        } else {
+            a = sqrt(r);
+        }
 
-    if (q != 0.0) {
-        a = sqrt(r/q);
-    } else {
-        a = sqrt(r);
+        out[i] = sig[i] * a;
     }
 
-    *out = *sig * a;
+    p->prvq = prvq;
+    p->prvr = prvr;
     return SP_OK;
 }
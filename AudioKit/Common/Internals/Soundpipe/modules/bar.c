@@ -21,7 +21,7 @@
 
 int sp_bar_create(sp_bar **p)
 {
-    *p = malloc(sizeof(sp_bar));
+    *p = sp_malloc(sizeof(sp_bar));
     return SP_OK;
 }
 
@@ -29,7 +29,7 @@ int sp_bar_destroy(sp_bar **p)
 {
     sp_bar *pp = *p;
     sp_auxdata_free(&pp->w_aux);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -185,3 +185,12 @@ int sp_bar_compute(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out)
     p->w2 = w2;
     return SP_OK;
 }
+
+int sp_bar_compute_block(sp_data *sp, sp_bar *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_bar_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
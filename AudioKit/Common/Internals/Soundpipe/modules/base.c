@@ -2,8 +2,64 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "soundpipe.h"
 
+struct sp_arena {
+    void *mem;
+    char *buf;
+    size_t size;
+    atomic_size_t pos;
+    /* blocks handed out and not yet given back to sp_free() */
+    atomic_int nblocks;
+    /* held by the sp_data, each live block and each bound thread; the
+     * memory goes when the last one lets go */
+    atomic_int refs;
+    /* set once the sp_data is destroyed, bindings to it are stale */
+    atomic_int dead;
+};
+
+/* sits right before every block sp_malloc() hands out, so sp_free() can
+ * tell an arena block from a heap one without looking anything up */
+typedef union {
+    sp_arena *arena;
+    char pad[16];
+} sp_block;
+
+/* arena sp_malloc() uses on this thread, the key's destructor drops it
+ * when the thread exits */
+static pthread_key_t sp_bound;
+static pthread_once_t sp_bound_once = PTHREAD_ONCE_INIT;
+
+static void sp_arena_unref(void *ud)
+{
+    sp_arena *arena = ud;
+    if(atomic_fetch_sub(&arena->refs, 1) == 1) {
+        free(arena->mem);
+        free(arena);
+    }
+}
+
+static void sp_bound_init(void)
+{
+    pthread_key_create(&sp_bound, sp_arena_unref);
+}
+
+static sp_arena *sp_bound_arena(void)
+{
+    pthread_once(&sp_bound_once, sp_bound_init);
+    return pthread_getspecific(sp_bound);
+}
+
+static void sp_bind(sp_arena *arena)
+{
+    sp_arena *old = sp_bound_arena();
+    if(arena != NULL) atomic_fetch_add(&arena->refs, 1);
+    pthread_setspecific(sp_bound, arena);
+    if(old != NULL) sp_arena_unref(old);
+}
+
 int sp_create(sp_data **spp)
 {
     *spp = (sp_data *) malloc(sizeof(sp_data));
@@ -18,6 +74,8 @@ int sp_create(sp_data **spp)
     sp->pos = 0;
     sp->k = 1;
     sp->rand = 0;
+    sp->arena = NULL;
+    sp->ftcache = NULL;
     return 0;
 }
 
@@ -35,17 +93,105 @@ int sp_createn(sp_data **spp, int nchan)
     sp->pos = 0;
     sp->k = 1;
     sp->rand = 0;
+    sp->arena = NULL;
+    sp->ftcache = NULL;
     return 0;
 }
 
 int sp_destroy(sp_data **spp)
 {
     sp_data *sp = *spp;
+    if(sp->arena != NULL) {
+        atomic_store(&sp->arena->dead, 1);
+        sp_arena_unref(sp->arena);
+    }
+    free(sp->ftcache);
     free(sp->out);
     free(*spp);
     return 0;
 }
 
+int sp_create_arena(sp_data **spp, size_t size)
+{
+    sp_data *sp;
+    sp_arena *arena;
+    sp_create(spp);
+    sp = *spp;
+    arena = malloc(sizeof(sp_arena));
+    arena->mem = malloc(size + SP_ARENA_ALIGN - 1);
+    if(arena->mem == NULL) {
+        free(arena);
+        return SP_NOT_OK;
+    }
+    arena->buf = (char *)(((uintptr_t)arena->mem + SP_ARENA_ALIGN - 1) &
+            ~(uintptr_t)(SP_ARENA_ALIGN - 1));
+    arena->size = size;
+    atomic_init(&arena->pos, 0);
+    atomic_init(&arena->nblocks, 0);
+    atomic_init(&arena->refs, 1);
+    atomic_init(&arena->dead, 0);
+    sp->arena = arena;
+    sp_bind(arena);
+    return SP_OK;
+}
+
+int sp_arena_bind(sp_data *sp)
+{
+    sp_bind(sp == NULL ? NULL : sp->arena);
+    return SP_OK;
+}
+
+int sp_arena_reset(sp_data *sp)
+{
+    if(sp->arena == NULL || atomic_load(&sp->arena->nblocks) != 0) {
+        return SP_NOT_OK;
+    }
+    atomic_store(&sp->arena->pos, 0);
+    return SP_OK;
+}
+
+void *sp_malloc(size_t size)
+{
+    sp_arena *arena = sp_bound_arena();
+    sp_block *b;
+    size_t len, pos;
+    if(arena != NULL && atomic_load(&arena->dead)) {
+        sp_bind(NULL);
+        arena = NULL;
+    }
+    if(arena != NULL) {
+        /* the block starts on a boundary, its header fills the end of the
+         * slot before it */
+        len = SP_ARENA_ALIGN +
+            ((size + SP_ARENA_ALIGN - 1) & ~(size_t)(SP_ARENA_ALIGN - 1));
+        pos = atomic_fetch_add(&arena->pos, len);
+        if(pos <= arena->size && len <= arena->size - pos) {
+            atomic_fetch_add(&arena->refs, 1);
+            atomic_fetch_add(&arena->nblocks, 1);
+            b = (sp_block *)(arena->buf + pos + SP_ARENA_ALIGN) - 1;
+            b->arena = arena;
+            return b + 1;
+        }
+    }
+    b = malloc(sizeof(sp_block) + size);
+    if(b == NULL) return NULL;
+    b->arena = NULL;
+    return b + 1;
+}
+
+void sp_free(void *ptr)
+{
+    sp_block *b;
+    if(ptr == NULL) return;
+    b = (sp_block *)ptr - 1;
+    if(b->arena == NULL) {
+        free(b);
+    } else {
+        atomic_fetch_sub(&b->arena->nblocks, 1);
+        sp_arena_unref(b->arena);
+    }
+}
+
 #ifndef NO_LIBSNDFILE
 
 //int sp_process(sp_data *sp, void *ud, void (*callback)(sp_data *, void *))
@@ -118,15 +264,22 @@ int sp_process_raw(sp_data *sp, void *ud, void (*callback)(sp_data *, void *))
 }
 int sp_auxdata_alloc(sp_auxdata *aux, size_t size)
 {
-    aux->ptr = malloc(size);
+    aux->ptr = sp_malloc(size);
     aux->size = size;
     memset(aux->ptr, 0, size);
     return SP_OK;
 }
 
+int sp_auxdata_reserve(sp_auxdata *aux, size_t size)
+{
+    aux->ptr = sp_malloc(size);
+    aux->size = size;
+    return SP_OK;
+}
+
 int sp_auxdata_free(sp_auxdata *aux)
 {
-    free(aux->ptr);
+    sp_free(aux->ptr);
     return SP_OK;
 }
 
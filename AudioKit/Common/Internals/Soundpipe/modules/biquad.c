@@ -21,13 +21,13 @@
 
 int sp_biquad_create(sp_biquad **p)
 {
-    *p = malloc(sizeof(sp_biquad));
+    *p = sp_malloc(sizeof(sp_biquad));
     return SP_OK;
 }
 
 int sp_biquad_destroy(sp_biquad **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -63,21 +63,29 @@ int sp_biquad_init(sp_data *sp, sp_biquad *p)
 }
 
 int sp_biquad_compute(sp_data *sp, sp_biquad *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_biquad_compute_block(sp, p, in, out, 1);
+}
+
+int sp_biquad_compute_block(sp_data *sp, sp_biquad *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT xn, yn;
     SPFLOAT a0 = p->a0, a1 = p->a1, a2 = p->a2;
     SPFLOAT b0 = p->b0, b1 = p->b1, b2 = p->b2;
     SPFLOAT xnm1 = p->xnm1, xnm2 = p->xnm2, ynm1 = p->ynm1, ynm2 = p->ynm2;
+    uint32_t i;
+
+    for(i = 0; i < n; i++) {
+        xn = in[i];
+        yn = ( b0 * xn + b1 * xnm1 + b2 * xnm2 -
+                 a1 * ynm1 - a2 * ynm2) / a0;
+        xnm2 = xnm1;
+        xnm1 = xn;
+        ynm2 = ynm1;
+        ynm1 = yn;
+        out[i] = yn;
+    }
 
-    xn = *in;
-    yn = ( b0 * xn + b1 * xnm1 + b2 * xnm2 -
-             a1 * ynm1 - a2 * ynm2) / a0;
-    xnm2 = xnm1;
-    xnm1 = xn;
-    ynm2 = ynm1;
-    ynm1 = yn;
-    *out = yn;
-    
     p->xnm1 = xnm1; p->xnm2 = xnm2; p->ynm1 = ynm1; p->ynm2 = ynm2;
     return SP_OK;
 }
@@ -3,13 +3,13 @@
 
 int sp_biscale_create(sp_biscale **p)
 {
-    *p = malloc(sizeof(sp_biscale));
+    *p = sp_malloc(sizeof(sp_biscale));
     return SP_OK;
 }
 
 int sp_biscale_destroy(sp_biscale **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -22,6 +22,16 @@ int sp_biscale_init(sp_data *sp, sp_biscale *p)
 
 int sp_biscale_compute(sp_data *sp, sp_biscale *p, SPFLOAT *in, SPFLOAT *out)
 {
-    *out = p->min + (*in + 1.0) / 2.0 * (p->max - p->min);
+    return sp_biscale_compute_block(sp, p, in, out, 1);
+}
+
+int sp_biscale_compute_block(sp_data *sp, sp_biscale *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT min = p->min;
+    SPFLOAT range = p->max - p->min;
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        out[i] = min + (in[i] + 1.0) / 2.0 * range;
+    }
     return SP_OK;
 }
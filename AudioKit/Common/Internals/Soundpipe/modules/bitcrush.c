@@ -4,7 +4,7 @@
 
 int sp_bitcrush_create(sp_bitcrush **p)
 {
-    *p = malloc(sizeof(sp_bitcrush));
+    *p = sp_malloc(sizeof(sp_bitcrush));
     return SP_OK;
 }
 
@@ -12,7 +12,7 @@ int sp_bitcrush_destroy(sp_bitcrush **p)
 {
     sp_bitcrush *pp = *p;
     sp_fold_destroy(&pp->fold);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -41,3 +41,12 @@ int sp_bitcrush_compute(sp_data *sp, sp_bitcrush *p, SPFLOAT *in, SPFLOAT *out)
     *out /= 65536.0;
     return SP_OK;
 }
+
+int sp_bitcrush_compute_block(sp_data *sp, sp_bitcrush *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_bitcrush_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
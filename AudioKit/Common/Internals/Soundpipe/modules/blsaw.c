@@ -39,12 +39,12 @@ typedef struct {
 } blsaw;
 
 blsaw* newblsaw() {
-	blsaw* dsp = (blsaw*)malloc(sizeof(blsaw));
+	blsaw* dsp = (blsaw*)sp_malloc(sizeof(blsaw));
 	return dsp;
 }
 
 void deleteblsaw(blsaw* dsp) {
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitblsaw(blsaw* dsp, int samplingFreq) {
@@ -128,7 +128,7 @@ static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOA
 
 int sp_blsaw_create(sp_blsaw **p)
 {
-    *p = malloc(sizeof(sp_blsaw));
+    *p = sp_malloc(sizeof(sp_blsaw));
     return SP_OK;
 }
 
@@ -137,7 +137,7 @@ int sp_blsaw_destroy(sp_blsaw **p)
     sp_blsaw *pp = *p;
     blsaw *dsp = pp->ud;
     deleteblsaw (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -171,3 +171,12 @@ int sp_blsaw_compute(sp_data *sp, sp_blsaw *p, SPFLOAT *in, SPFLOAT *out)
     *out = out1;
     return SP_OK;
 }
+
+int sp_blsaw_compute_block(sp_data *sp, sp_blsaw *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    blsaw *dsp = p->ud;
+    SPFLOAT *faust_out[] = {out};
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in};
+    computeblsaw(dsp, n, faust_in, faust_out);
+    return SP_OK;
+}
@@ -31,12 +31,12 @@ typedef struct {
 } blsquare;
 
 blsquare* newblsquare() {
-	blsquare* dsp = (blsquare*)malloc(sizeof(blsquare));
+	blsquare* dsp = (blsquare*)sp_malloc(sizeof(blsquare));
 	return dsp;
 }
 
 void deleteblsquare(blsquare* dsp) {
-	free(dsp);
+	sp_free(dsp);
 }
 
 
@@ -140,7 +140,7 @@ static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOA
 
 int sp_blsquare_create(sp_blsquare **p)
 {
-    *p = malloc(sizeof(sp_blsquare));
+    *p = sp_malloc(sizeof(sp_blsquare));
     return SP_OK;
 }
 
@@ -149,7 +149,7 @@ int sp_blsquare_destroy(sp_blsquare **p)
     sp_blsquare *pp = *p;
     blsquare *dsp = pp->ud;
     deleteblsquare (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -183,3 +183,12 @@ int sp_blsquare_compute(sp_data *sp, sp_blsquare *p, SPFLOAT *in, SPFLOAT *out)
     *out = out1;
     return SP_OK;
 }
+
+int sp_blsquare_compute_block(sp_data *sp, sp_blsquare *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    blsquare *dsp = p->ud;
+    SPFLOAT *faust_out[] = {out};
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in};
+    computeblsquare(dsp, n, faust_in, faust_out);
+    return SP_OK;
+}
@@ -37,12 +37,12 @@ typedef struct {
 } bltriangle;
 
 bltriangle* newbltriangle() {
-	bltriangle* dsp = (bltriangle*)malloc(sizeof(bltriangle));
+	bltriangle* dsp = (bltriangle*)sp_malloc(sizeof(bltriangle));
 	return dsp;
 }
 
 void deletebltriangle(bltriangle* dsp) {
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitbltriangle(bltriangle* dsp, int samplingFreq) {
@@ -158,7 +158,7 @@ static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOA
 
 int sp_bltriangle_create(sp_bltriangle **p)
 {
-    *p = malloc(sizeof(sp_bltriangle));
+    *p = sp_malloc(sizeof(sp_bltriangle));
     return SP_OK;
 }
 
@@ -167,7 +167,7 @@ int sp_bltriangle_destroy(sp_bltriangle **p)
     sp_bltriangle *pp = *p;
     bltriangle *dsp = pp->ud;
     deletebltriangle (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -200,3 +200,12 @@ int sp_bltriangle_compute(sp_data *sp, sp_bltriangle *p, SPFLOAT *in, SPFLOAT *o
     *out = out1;
     return SP_OK;
 }
+
+int sp_bltriangle_compute_block(sp_data *sp, sp_bltriangle *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    bltriangle *dsp = p->ud;
+    SPFLOAT *faust_out[] = {out};
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in};
+    computebltriangle(dsp, n, faust_in, faust_out);
+    return SP_OK;
+}
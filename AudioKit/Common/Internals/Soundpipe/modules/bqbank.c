@@ -0,0 +1,297 @@
+/*
+ * Biquad Bank
+ *
+ * Runs a bank of independent second order sections, one per channel.
+ * Coefficients and state are kept in structure-of-arrays form and the
+ * channels are processed SP_BQBANK_LANES at a time, so the inner loops map
+ * directly onto SSE/AVX/NEON registers.
+ *
+ * The sp_bqbank_* design functions produce the coefficients used by the
+ * butlp, buthp, butbp, butbr, pareq and eqfil modules. They were moved here
+ * from those modules, which were extracted from the Csound butter, pareq
+ * and eqfil opcodes (Paris Smaragdis, John ffitch, Hans Mikelson,
+ * Matt Gerassimoff, Jens Groh, Steven Yi, Victor Lazzarini).
+ *
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#define ROOT2 (1.4142135623730950488)
+
+#ifndef M_PI
+#define M_PI		3.14159265358979323846	/* pi */
+#endif
+
+#ifndef SP_BQBANK_LANES
+#ifdef __AVX__
+#define SP_BQBANK_LANES 8
+#else
+#define SP_BQBANK_LANES 4
+#endif
+#endif
+
+#include "soundpipe.h"
+
+int sp_bqbank_create(sp_bqbank **p)
+{
+    *p = sp_malloc(sizeof(sp_bqbank));
+    return SP_OK;
+}
+
+int sp_bqbank_destroy(sp_bqbank **p)
+{
+    sp_bqbank *pp = *p;
+    sp_auxdata_free(&pp->aux);
+    sp_free(*p);
+    return SP_OK;
+}
+
+int sp_bqbank_init(sp_data *sp, sp_bqbank *p, uint32_t nchan)
+{
+    uint32_t nlanes, i;
+    SPFLOAT *buf;
+
+    if(nchan == 0) return SP_NOT_OK;
+
+    nlanes = (nchan + SP_BQBANK_LANES - 1) / SP_BQBANK_LANES;
+    nlanes *= SP_BQBANK_LANES;
+    p->nchan = nchan;
+    p->nlanes = nlanes;
+
+    sp_auxdata_alloc(&p->aux, 7 * nlanes * sizeof(SPFLOAT));
+    buf = p->aux.ptr;
+    p->b0 = buf;
+    p->b1 = buf + nlanes;
+    p->b2 = buf + 2 * nlanes;
+    p->a1 = buf + 3 * nlanes;
+    p->a2 = buf + 4 * nlanes;
+    p->z1 = buf + 5 * nlanes;
+    p->z2 = buf + 6 * nlanes;
+
+    /* every lane starts out as a unity gain pass-through */
+    for(i = 0; i < nlanes; i++) p->b0[i] = 1.0;
+
+    return SP_OK;
+}
+
+int sp_bqbank_set(sp_bqbank *p, uint32_t chan, const SPFLOAT *c)
+{
+    if(chan >= p->nchan) return SP_NOT_OK;
+    p->b0[chan] = c[0];
+    p->b1[chan] = c[1];
+    p->b2[chan] = c[2];
+    p->a1[chan] = c[3];
+    p->a2[chan] = c[4];
+    return SP_OK;
+}
+
+int sp_bqbank_clear(sp_bqbank *p)
+{
+    uint32_t i;
+    for(i = 0; i < p->nlanes; i++) {
+        p->z1[i] = 0;
+        p->z2[i] = 0;
+    }
+    return SP_OK;
+}
+
+int sp_bqbank_compute(sp_data *sp, sp_bqbank *p, SPFLOAT *in, SPFLOAT *out)
+{
+    const SPFLOAT *b0 = p->b0, *b1 = p->b1, *b2 = p->b2;
+    const SPFLOAT *a1 = p->a1, *a2 = p->a2;
+    SPFLOAT *z1 = p->z1, *z2 = p->z2;
+    SPFLOAT t;
+    uint32_t l;
+
+    for(l = 0; l < p->nchan; l++) {
+        t = in[l] - a1[l] * z1[l] - a2[l] * z2[l];
+        out[l] = t * b0[l] + b1[l] * z1[l] + b2[l] * z2[l];
+        z2[l] = z1[l];
+        z1[l] = t;
+    }
+    return SP_OK;
+}
+
+int sp_bqbank_compute_block(sp_data *sp, sp_bqbank *p, const SPFLOAT **in, SPFLOAT **out, uint32_t n)
+{
+    SPFLOAT x[SP_BQBANK_LANES], y[SP_BQBANK_LANES];
+    SPFLOAT z1[SP_BQBANK_LANES], z2[SP_BQBANK_LANES];
+    SPFLOAT t;
+    uint32_t g, l, i, nused;
+
+    for(g = 0; g < p->nchan; g += SP_BQBANK_LANES) {
+        const SPFLOAT *b0 = p->b0 + g, *b1 = p->b1 + g, *b2 = p->b2 + g;
+        const SPFLOAT *a1 = p->a1 + g, *a2 = p->a2 + g;
+
+        nused = p->nchan - g;
+        if(nused > SP_BQBANK_LANES) nused = SP_BQBANK_LANES;
+
+        for(l = 0; l < SP_BQBANK_LANES; l++) {
+            x[l] = 0;
+            z1[l] = p->z1[g + l];
+            z2[l] = p->z2[g + l];
+        }
+
+        for(i = 0; i < n; i++) {
+            for(l = 0; l < nused; l++) x[l] = in[g + l][i];
+            for(l = 0; l < SP_BQBANK_LANES; l++) {
+                t = x[l] - a1[l] * z1[l] - a2[l] * z2[l];
+                y[l] = t * b0[l] + b1[l] * z1[l] + b2[l] * z2[l];
+                z2[l] = z1[l];
+                z1[l] = t;
+            }
+            for(l = 0; l < nused; l++) out[g + l][i] = y[l];
+        }
+
+        for(l = 0; l < SP_BQBANK_LANES; l++) {
+            p->z1[g + l] = z1[l];
+            p->z2[g + l] = z2[l];
+        }
+    }
+    return SP_OK;
+}
+
+/* the section that outputs 0, as the modules do past their range */
+static int bqbank_silence(SPFLOAT *c)
+{
+    c[0] = c[1] = c[2] = c[3] = c[4] = 0.0;
+    return SP_OK;
+}
+
+int sp_bqbank_butlp(sp_data *sp, SPFLOAT freq, SPFLOAT *c)
+{
+    SPFLOAT pidsr = M_PI / sp->sr;
+    SPFLOAT k;
+    if (freq <= 0.0) return bqbank_silence(c);
+    k = 1.0 / tan((SPFLOAT)(pidsr * freq));
+    c[0] = 1.0 / ( 1.0 + ROOT2 * k + k * k);
+    c[1] = c[0] + c[0];
+    c[2] = c[0];
+    c[3] = 2.0 * ( 1.0 - k*k) * c[0];
+    c[4] = ( 1.0 - ROOT2 * k + k * k) * c[0];
+    return SP_OK;
+}
+
+int sp_bqbank_buthp(sp_data *sp, SPFLOAT freq, SPFLOAT *c)
+{
+    SPFLOAT pidsr = M_PI / sp->sr;
+    SPFLOAT k;
+    if (freq <= 0.0) return bqbank_silence(c);
+    k = tan((SPFLOAT)(pidsr * freq));
+    c[0] = 1.0 / ( 1.0 + ROOT2 * k + k * k);
+    c[1] = -(c[0] + c[0]);
+    c[2] = c[0];
+    c[3] = 2.0 * ( k*k - 1.0) * c[0];
+    c[4] = ( 1.0 - ROOT2 * k + k * k) * c[0];
+    return SP_OK;
+}
+
+int sp_bqbank_butbp(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c)
+{
+    SPFLOAT pidsr = M_PI / sp->sr;
+    SPFLOAT tpidsr = 2 * M_PI / sp->sr;
+    SPFLOAT k, d;
+    if (bw <= 0.0) return bqbank_silence(c);
+    k = 1.0 / tan((SPFLOAT)(pidsr * bw));
+    d = 2.0 * cos((SPFLOAT)(tpidsr * freq));
+    c[0] = 1.0 / (1.0 + k);
+    c[1] = 0.0;
+    c[2] = -c[0];
+    c[3] = - k * d * c[0];
+    c[4] = (k - 1.0) * c[0];
+    return SP_OK;
+}
+
+int sp_bqbank_butbr(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c)
+{
+    SPFLOAT pidsr = M_PI / sp->sr;
+    SPFLOAT tpidsr = 2 * M_PI / sp->sr;
+    SPFLOAT k, d;
+    if (bw <= 0.0) return bqbank_silence(c);
+    k = tan((SPFLOAT)(pidsr * bw));
+    d = 2.0 * cos((SPFLOAT)(tpidsr * freq));
+    c[0] = 1.0 / (1.0 + k);
+    c[1] = - d * c[0];
+    c[2] = c[0];
+    c[3] = c[1];
+    c[4] = (1.0 - k) * c[0];
+    return SP_OK;
+}
+
+int sp_bqbank_pareq(sp_data *sp, int mode, SPFLOAT fc, SPFLOAT v, SPFLOAT q, SPFLOAT *c)
+{
+    SPFLOAT tpidsr = (2 * M_PI) / sp->sr;
+    SPFLOAT omega = (SPFLOAT)(tpidsr * fc), sq, k, kk, vkk, vk, vkdq, a0;
+
+    switch (mode) {
+        /* Low Shelf */
+        case 1:
+            sq = sqrt(2.0 * v);
+            k = tan(omega * 0.5);
+            kk = k * k;
+            vkk = v * kk;
+            c[0] = 1.0 + sq * k + vkk;
+            c[1] = 2.0 * (vkk - 1.0);
+            c[2] = 1.0 - sq * k + vkk;
+            a0 = 1.0 + k / q + kk;
+            c[3] = 2.0 * (kk - 1.0);
+            c[4] = 1.0 - k / q + kk;
+            break;
+
+        /* High Shelf */
+        case 2:
+            sq = sqrt(2.0 * v);
+            k = tan((M_PI - omega) * 0.5);
+            kk = k * k;
+            vkk = v * kk;
+            c[0] = 1.0 + sq * k + vkk;
+            c[1] = -2.0 * (vkk - 1.0);
+            c[2] = 1.0 - sq * k + vkk;
+            a0 = 1.0 + k / q + kk;
+            c[3] = -2.0 * (kk - 1.0);
+            c[4] = 1.0 - k / q + kk;
+            break;
+
+        /* Peaking EQ */
+        default:
+            k = tan(omega * 0.5);
+            kk = k * k;
+            vk = v * k;
+            vkdq = vk / q;
+            c[0] = 1.0 + vkdq + kk;
+            c[1] = 2.0 * (kk - 1.0);
+            c[2] = 1.0 - vkdq + kk;
+            a0 = 1.0 + k / q + kk;
+            c[3] = 2.0 * (kk - 1.0);
+            c[4] = 1.0 - k / q + kk;
+    }
+    a0 = 1.0 / a0;
+    c[3] *= a0; c[4] *= a0; c[0] *= a0; c[1] *= a0; c[2] *= a0;
+    return SP_OK;
+}
+
+int sp_bqbank_eqfil_ap(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c)
+{
+    SPFLOAT k = tan(M_PI * bw / sp->sr);
+    c[0] = cos(2 * M_PI * freq / sp->sr);
+    c[1] = (1.0 - k) / (1.0 + k);
+    return SP_OK;
+}
+
+int sp_bqbank_eqfil(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT gain, SPFLOAT *c)
+{
+    /* eqfil mixes the input with a second order allpass:
+     * out = 0.5 * ((1 + gain) * in + (1 - gain) * allpass(in)) */
+    SPFLOAT ap[2], d, a;
+    SPFLOAT dry = 0.5 * (1.0 + gain), wet = 0.5 * (1.0 - gain);
+    sp_bqbank_eqfil_ap(sp, freq, bw, ap);
+    d = ap[0];
+    a = ap[1];
+    c[0] = dry + wet * a;
+    c[1] = -d * (1.0 + a);
+    c[2] = dry * a + wet;
+    c[3] = c[1];
+    c[4] = a;
+    return SP_OK;
+}
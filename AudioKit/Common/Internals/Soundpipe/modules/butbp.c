@@ -23,13 +23,13 @@
 
 int sp_butbp_create(sp_butbp **p)
 {
-    *p = malloc(sizeof(sp_butbp));
+    *p = sp_malloc(sizeof(sp_butbp));
     return SP_OK;
 }
 
 int sp_butbp_destroy(sp_butbp **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -48,13 +48,19 @@ int sp_butbp_init(sp_data *sp, sp_butbp *p)
 }
 
 int sp_butbp_compute(sp_data *sp, sp_butbp *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_butbp_compute_block(sp, p, in, out, 1);
+}
+
+int sp_butbp_compute_block(sp_data *sp, sp_butbp *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT *a = p->a;
     SPFLOAT t, y;
+    SPFLOAT a1, a2, a3, a4, a5, a6, a7;
+    uint32_t i;
 
-    *out = p->sr;
     if (p->bw <= 0.0) {
-       *out = 0;
+       for(i = 0; i < n; i++) out[i] = 0;
        return SP_OK;
     }
 
@@ -63,21 +69,20 @@ int sp_butbp_compute(sp_data *sp, sp_butbp *p, SPFLOAT *in, SPFLOAT *out)
     fr = p->freq;
 
     if (bw != p->lkb || fr != p->lkf) {
-        SPFLOAT c, d;
         p->lkf = fr;
         p->lkb = bw;
-        c = 1.0 / tan((SPFLOAT)(p->pidsr * bw));
-        d = 2.0 * cos((SPFLOAT)(p->tpidsr * fr));
-        a[1] = 1.0 / (1.0 + c);
-        a[2] = 0.0;
-        a[3] = -a[1];
-        a[4] = - c * d * a[1];
-        a[5] = (c - 1.0) * a[1];
+        sp_bqbank_butbp(sp, fr, bw, &a[1]);
+    }
+
+    a1 = a[1]; a2 = a[2]; a3 = a[3]; a4 = a[4]; a5 = a[5];
+    a6 = a[6]; a7 = a[7];
+    for(i = 0; i < n; i++) {
+        t = in[i] - a4 * a6 - a5 * a7;
+        y = t * a1 + a2 * a6 + a3 * a7;
+        a7 = a6;
+        a6 = t;
+        out[i] = y;
     }
-    t = *in - a[4] * a[6] - a[5] * a[7];
-    y = t * a[1] + a[2] * a[6] + a[3] * a[7];
-    a[7] = a[6];
-    a[6] = t;
-    *out = y;
+    a[6] = a6; a[7] = a7;
     return SP_OK;
 }
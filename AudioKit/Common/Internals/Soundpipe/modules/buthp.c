@@ -23,29 +23,36 @@
 
 /* Filter loop */
 
-static int sp_butter_filter(SPFLOAT *in, SPFLOAT *out, SPFLOAT *a)
+static int sp_butter_filter(const SPFLOAT *in, SPFLOAT *out, SPFLOAT *a, uint32_t n)
 {
     SPFLOAT t, y;
-    t = *in - a[4] * a[6] - a[5] * a[7];
-    /*TODO: look into this function */
-    //t = csoundUndenormalizeDouble(t); /* Not needed on AMD */
-    y = t * a[1] + a[2] * a[6] + a[3] * a[7];
-    a[7] = a[6];
-    a[6] = t;
-    *out = y;
+    SPFLOAT a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5];
+    SPFLOAT a6 = a[6], a7 = a[7];
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        t = in[i] - a4 * a6 - a5 * a7;
+        /*TODO: look into this function */
+        //t = csoundUndenormalizeDouble(t); /* Not needed on AMD */
+        y = t * a1 + a2 * a6 + a3 * a7;
+        a7 = a6;
+        a6 = t;
+        out[i] = y;
+    }
+    a[6] = a6;
+    a[7] = a7;
     return SP_OK;
 }
 
 
 int sp_buthp_create(sp_buthp **p)
 {
-    *p = malloc(sizeof(sp_buthp));
+    *p = sp_malloc(sizeof(sp_buthp));
     return SP_OK;
 }
 
 int sp_buthp_destroy(sp_buthp **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -64,24 +71,23 @@ int sp_buthp_init(sp_data *sp, sp_buthp *p)
 
 int sp_buthp_compute(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out)
 {
+    return sp_buthp_compute_block(sp, p, in, out, 1);
+}
+
+int sp_buthp_compute_block(sp_data *sp, sp_buthp *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+
     if (p->freq <= 0.0)     {
-      *out = 0;
+      for(i = 0; i < n; i++) out[i] = 0;
       return SP_OK;
     }
 
     if (p->freq != p->lkf)      {
-      SPFLOAT *a, c;
-      a = p->a;
       p->lkf = p->freq;
-      c = tan((SPFLOAT)(p->pidsr * p->lkf));
-
-      a[1] = 1.0 / ( 1.0 + ROOT2 * c + c * c);
-      a[2] = -(a[1] + a[1]);
-      a[3] = a[1];
-      a[4] = 2.0 * ( c*c - 1.0) * a[1];
-      a[5] = ( 1.0 - ROOT2 * c + c * c) * a[1];
+      sp_bqbank_buthp(sp, p->lkf, &p->a[1]);
     }
-    sp_butter_filter(in, out, p->a);
+    sp_butter_filter(in, out, p->a, n);
     return SP_OK;
 }
 
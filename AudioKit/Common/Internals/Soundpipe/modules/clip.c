@@ -23,13 +23,13 @@
 
 int sp_clip_create(sp_clip **p)
 {
-    *p = malloc(sizeof(sp_clip));
+    *p = sp_malloc(sizeof(sp_clip));
     return SP_OK;
 }
 
 int sp_clip_destroy(sp_clip **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -59,53 +59,63 @@ int sp_clip_init(sp_data *sp, sp_clip *p)
 }
 
 int sp_clip_compute(sp_data *sp, sp_clip *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_clip_compute_block(sp, p, in, out, 1);
+}
+
+int sp_clip_compute_block(sp_data *sp, sp_clip *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT a = p->arg, k1 = p->k1, k2 = p->k2;
     SPFLOAT limit = p->lim;
     SPFLOAT rlim = 1.0 / limit;
     SPFLOAT x;
+    uint32_t i;
 
     switch (p->meth) {
         case 0:                     /* Soft clip with division */
-            x = *in;
-            if (x >= 0.0) {
-                if (x > limit) x = k2;
-                else if (x > a){
-                    x = a + (x - a) / (1.0 + (x - a) * (x - a) * k1);
-                }
-            } else {
-                if (x < -limit) {
-                    x = -k2;
-                } else if (-x > a) {
-                    x = -a + (x + a) / (1.0 + (x + a) * (x + a) * k1);
+            for(i = 0; i < n; i++) {
+                x = in[i];
+                if (x >= 0.0) {
+                    if (x > limit) x = k2;
+                    else if (x > a){
+                        x = a + (x - a) / (1.0 + (x - a) * (x - a) * k1);
+                    }
+                } else {
+                    if (x < -limit) {
+                        x = -k2;
+                    } else if (-x > a) {
+                        x = -a + (x + a) / (1.0 + (x + a) * (x + a) * k1);
+                    }
                 }
+                out[i] = x;
             }
-            *out = x;
-
             return SP_OK;
         case 1:
-            x = *in;
-            if (x >= limit) {
-                x = limit;
-            } else if (x <= -limit)
-              x = -limit;
-            else{
-                x = limit * sin(k1 * x);
+            for(i = 0; i < n; i++) {
+                x = in[i];
+                if (x >= limit) {
+                    x = limit;
+                } else if (x <= -limit)
+                  x = -limit;
+                else{
+                    x = limit * sin(k1 * x);
+                }
+                out[i] = x;
             }
-            *out = x;
-          
             return SP_OK;
         case 2:
-            x = *in;
-            if (x >= limit){
-              x = limit;
-            } else if (x <= -limit){
-              x = -limit;
-            }
-            else{
-              x = limit * k1 * tanh(x * rlim);
+            for(i = 0; i < n; i++) {
+                x = in[i];
+                if (x >= limit){
+                  x = limit;
+                } else if (x <= -limit){
+                  x = -limit;
+                }
+                else{
+                  x = limit * k1 * tanh(x * rlim);
+                }
+                out[i] = x;
             }
-            *out = x;
             return SP_OK;
         }
 
@@ -18,15 +18,15 @@
 
 int sp_comb_create(sp_comb **p)
 {
-    *p = malloc(sizeof(sp_comb));
+    *p = sp_malloc(sizeof(sp_comb));
     return SP_OK;
 }
 
 int sp_comb_destroy(sp_comb **p)
 {
     sp_comb *pp = *p;
-    sp_auxdata_free(&pp->aux);
-    free(*p);
+    sp_dline_destroy(&pp->dl);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -35,18 +35,24 @@ int sp_comb_init(sp_data *sp, sp_comb *p, SPFLOAT looptime)
     p->revtime = 3.5;
     p->looptime = looptime;
     p->bufsize = (uint32_t) (0.5 + looptime * sp->sr);
-    sp_auxdata_alloc(&p->aux, p->bufsize * sizeof(SPFLOAT));
+    if(p->bufsize < 1) p->bufsize = 1;
+    sp_dline_init(&p->dl, p->bufsize);
     p->prvt = 0.0;
     p->coef = 0.0;
-    p->bufpos = 0;
     return SP_OK;
 }
 
 int sp_comb_compute(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out)
 {
-    SPFLOAT tmp = 0;
+    return sp_comb_compute_block(sp, p, in, out, 1);
+}
+
+int sp_comb_compute_block(sp_data *sp, sp_comb *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT y[SP_DLINE_CHUNK], z[SP_DLINE_CHUNK];
     SPFLOAT coef = p->coef;
-    SPFLOAT outsamp = 0;
+    uint32_t bufsize = p->bufsize;
+    uint32_t i = 0, j, len;
 
     if(p->prvt != p->revtime) {
         p->prvt = p->revtime;
@@ -57,15 +63,18 @@ int sp_comb_compute(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out)
             coef = p->coef = exp(exp_arg);
         }
     }
-    sp_auxdata_getbuf(&p->aux, p->bufpos, &outsamp);
-    tmp = outsamp;
-    tmp *= coef;
-    tmp += *in;
-    sp_auxdata_setbuf(&p->aux, p->bufpos, &tmp);
-    *out = outsamp;
-    
 
-    p->bufpos++;
-    p->bufpos %= p->bufsize; 
+    while(i < n) {
+        len = n - i;
+        if(len > SP_DLINE_CHUNK) len = SP_DLINE_CHUNK;
+        if(len > bufsize) len = bufsize;
+        sp_dline_read(&p->dl, bufsize, y, len);
+        for(j = 0; j < len; j++) {
+            z[j] = y[j] * coef + in[i + j];
+            out[i + j] = y[j];
+        }
+        sp_dline_write(&p->dl, z, len);
+        i += len;
+    }
     return SP_OK;
 }
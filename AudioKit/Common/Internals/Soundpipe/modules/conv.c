@@ -15,6 +15,12 @@
 #include <stdlib.h>
 #include "soundpipe.h"
 
+#ifndef NO_PTHREADS
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#endif
+
 static void multiply_fft_buffers(SPFLOAT *outBuf, SPFLOAT *ringBuf,
                                  SPFLOAT *IR_Data, int partSize, int nPartitions,
                                  int ringBuf_startPos)
@@ -82,7 +88,7 @@ static inline int buf_bytes_alloc(int nChannels, int partSize, int nPartitions)
     return ((int) sizeof(SPFLOAT) * nSmps);
 }
 
-static void set_buf_pointers(sp_conv *p,
+static void set_buf_pointers(sp_conv_stage *p,
                              int nChannels, int partSize, int nPartitions)
 {
     SPFLOAT *ptr;
@@ -103,78 +109,45 @@ static void set_buf_pointers(sp_conv *p,
     }
 }
 
-int sp_conv_create(sp_conv **p)
-{
-    *p = malloc(sizeof(sp_conv));
-    return SP_OK;
-}
-
-int sp_conv_destroy(sp_conv **p)
-{
-    sp_conv *pp = *p;
-    sp_auxdata_free(&pp->auxData);
-    sp_fft_destroy(&pp->fft);
-    free(*p);
-    return SP_OK;
-}
-
-int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen)
+/* Sets up a uniformly partitioned stage covering nSmps samples of the IR,
+ * starting at table frame "start". The table holds "stride" interleaved
+ * channels, of which nChannels are read from channel "first" on. */
+static int conv_stage_init(sp_conv_stage *p, sp_ftbl *ft, int stride, int first,
+                           int nChannels, int start, int nSmps, int partSize,
+                           int delay)
 {
-    int     i, j, k, n, nBytes, skipSamples;
+    int     i, j, k, n, nBytes;
     SPFLOAT FFTscale;
 
-    p->iTotLen = ft->size;
-    p->iSkipSamples = 0;
-    p->iPartLen = iPartLen;
-
-    p->nChannels = 1;
-    /* partition length */
-    p->partSize = (int)lrintf(p->iPartLen);
-    if (p->partSize < 4 || (p->partSize & (p->partSize - 1)) != 0) {
-        fprintf(stderr, "conv: invalid partition size.\n");
-        return SP_NOT_OK;  
-    }
-
+    p->partSize = partSize;
+    p->delay = delay;
     sp_fft_init(&p->fft, (int)log2(p->partSize << 1));
-    n = (int) ft->size / p->nChannels;
-    skipSamples = (int)lrintf(p->iSkipSamples);
-    n -= skipSamples;
-
-    if (lrintf(p->iTotLen) > 0 && n > lrintf(p->iTotLen)) {
-        n = (int)lrintf(p->iTotLen);
-    }
-
-    if (n <= 0) {
-        fprintf(stderr, "uh oh.\n");
-        return SP_NOT_OK;
-    }
-
-    p->nPartitions = (n + (p->partSize - 1)) / p->partSize;
+    p->nPartitions = (nSmps + (p->partSize - 1)) / p->partSize;
     /* calculate the amount of aux space to allocate (in bytes) */
-    nBytes = buf_bytes_alloc(p->nChannels, p->partSize, p->nPartitions);
+    nBytes = buf_bytes_alloc(nChannels, p->partSize, p->nPartitions);
     sp_auxdata_alloc(&p->auxData, nBytes);
-    /* if skipping samples: check for possible truncation of IR */
     /* initialise buffer pointers */
-    set_buf_pointers(p, p->nChannels, p->partSize, p->nPartitions);
+    set_buf_pointers(p, nChannels, p->partSize, p->nPartitions);
     /* clear ring buffer to zero */
     n = (p->partSize << 1) * p->nPartitions;
     memset(p->ringBuf, 0, n*sizeof(SPFLOAT));
     p->cnt = 0;
     p->rbCnt = 0;
     FFTscale = 1.0;
-    for (j = 0; j < p->nChannels; j++) {
+    for (j = 0; j < nChannels; j++) {
         /* table read position */
-        i = (skipSamples * p->nChannels) + j; 
+        i = (start * stride) + first + j;
         /* IR write position */
-        n = (p->partSize << 1) * (p->nPartitions - 1); 
-        do { 
+        n = (p->partSize << 1) * (p->nPartitions - 1);
+        do {
             for (k = 0; k < p->partSize; k++) {
-                if (i >= 0 && i < (int) ft->size) {
+                if (i >= 0 && i < (int) ft->size &&
+                    (i / stride) < start + nSmps) {
                     p->IR_Data[j][n + k] = ft->tbl[i] * FFTscale;
                 } else {
                     p->IR_Data[j][n + k] = 0.0;
-                } 
-                i += p->nChannels;
+                }
+                i += stride;
             }
         /* pad second half of IR to zero */
             for (k = p->partSize; k < (p->partSize << 1); k++) {
@@ -186,33 +159,28 @@ int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen)
         } while (n >= 0);
     }
     /* clear output buffers to zero */
-    for (j = 0; j < p->nChannels; j++) {
+    for (j = 0; j < nChannels; j++) {
         for (i = 0; i < (p->partSize << 1); i++)
         p->outBuffers[j][i] = 0.0;
     }
-    p->initDone = 1;
-
     return SP_OK;
 }
 
-int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
+static void conv_stage_destroy(sp_conv_stage *p)
+{
+    sp_auxdata_free(&p->auxData);
+    sp_fft_destroy(&p->fft);
+}
+
+/* transforms the block just collected in the current ring slot and adds
+ * the next partSize samples of output to the overlap buffer */
+static void conv_stage_flush(sp_conv_stage *p, int nChannels)
 {
     SPFLOAT *x, *rBuf;
     int i, n, nSamples, rBufPos;
 
     nSamples = p->partSize;
     rBuf = &(p->ringBuf[p->rbCnt * (nSamples << 1)]);
-    /* store input signal in buffer */
-    rBuf[p->cnt] = *in;
-    /* copy output signals from buffer */
-    *out = p->outBuffers[0][p->cnt]; 
-
-    /* is input buffer full ? */
-    if (++p->cnt < nSamples) {
-        return SP_OK;                   
-    }
-    /* reset buffer position */
-    p->cnt = 0;
     /* calculate FFT of input */
     for (i = nSamples; i < (nSamples << 1); i++) {
         /* Zero padding */
@@ -222,14 +190,13 @@ int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
     /* update ring buffer position */
     p->rbCnt++;
 
-    if (p->rbCnt >= p->nPartitions){ 
-        p->rbCnt = 0; 
+    if (p->rbCnt >= p->nPartitions){
+        p->rbCnt = 0;
     }
 
     rBufPos = p->rbCnt * (nSamples << 1);
-    rBuf = &(p->ringBuf[rBufPos]);
-    /* PB: will only loop once since nChannels == 1*/
-    for (n = 0; n < p->nChannels; n++) {
+    /* the input spectrum is shared by all channels */
+    for (n = 0; n < nChannels; n++) {
         /* multiply complex arrays */
         multiply_fft_buffers(p->tmpBuf, p->ringBuf, p->IR_Data[n],
                      nSamples, p->nPartitions, rBufPos);
@@ -242,5 +209,435 @@ int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
             x[i + nSamples] = p->tmpBuf[i + nSamples];
         }
     }
+}
+
+/* adds the stage output for each channel to out */
+static void conv_stage_compute(sp_conv_stage *p, int nChannels, SPFLOAT in,
+                               SPFLOAT *out)
+{
+    int n;
+
+    /* store input signal in buffer */
+    p->ringBuf[p->rbCnt * (p->partSize << 1) + p->cnt] = in;
+    /* copy output signals from buffer */
+    for (n = 0; n < nChannels; n++) {
+        out[n] += p->outBuffers[n][p->cnt];
+    }
+
+    /* is input buffer full ? */
+    if (++p->cnt < p->partSize) {
+        return;
+    }
+    /* reset buffer position */
+    p->cnt = 0;
+    conv_stage_flush(p, nChannels);
+}
+
+#ifndef NO_PTHREADS
+
+/*
+ * Worker thread
+ *
+ * Once a stage is threaded only the worker touches its state. The render
+ * thread hands it each block it collects through a small queue, and picks
+ * up the output of a block two block periods later, so the block collected
+ * during period j is played during period j + 3. The stage's input delay
+ * is shortened by two blocks to make up for it. The render thread never
+ * takes a lock and never waits: output that is not back by its deadline
+ * is played as silence, and a block that finds the queue full is turned
+ * into a silent one, so the stage keeps its place in the IR.
+ */
+
+#define CONV_QLEN 4
+
+typedef struct {
+    SPFLOAT *in, *out;
+    /* blocks the render thread could not queue just before this one */
+    int skip;
+    /* number of the block, counted by the render thread */
+    unsigned int seq;
+} conv_slot;
+
+typedef struct {
+    sp_conv_stage *st;
+    int cnt;
+    SPFLOAT *inBuf, *curOut;
+    conv_slot slot[CONV_QLEN];
+    /* blocks queued, written by the render thread */
+    _Atomic unsigned int head;
+    /* blocks done, written by the worker */
+    _Atomic unsigned int tail;
+    /* render thread only: next done block to look at, blocks collected
+     * and blocks dropped since the last one queued */
+    unsigned int rd;
+    unsigned int seq;
+    int skip;
+} conv_job;
+
+struct sp_conv_worker {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    _Atomic int running;
+    int nChannels;
+    int first;
+    int njobs;
+    conv_job job[SP_CONV_MAXSTAGES];
+    sp_auxdata aux;
+};
+
+static void conv_slot_run(sp_conv_stage *st, conv_slot *s, int nChannels)
+{
+    int n = st->partSize, c;
+    for (; s->skip > 0; s->skip--) {
+        memset(&st->ringBuf[st->rbCnt * (n << 1)], 0, n * sizeof(SPFLOAT));
+        conv_stage_flush(st, nChannels);
+    }
+    memcpy(&st->ringBuf[st->rbCnt * (n << 1)], s->in, n * sizeof(SPFLOAT));
+    conv_stage_flush(st, nChannels);
+    for (c = 0; c < nChannels; c++) {
+        memcpy(s->out + c * n, st->outBuffers[c], n * sizeof(SPFLOAT));
+    }
+}
+
+static void *conv_worker_main(void *ud)
+{
+    struct sp_conv_worker *w = ud;
+    struct timespec ts;
+    conv_job *j;
+    unsigned int tail;
+    int k, did;
+
+    while (atomic_load(&w->running)) {
+        did = 0;
+        /* smaller stages have the earlier deadlines */
+        for (k = 0; k < w->njobs; k++) {
+            j = &w->job[k];
+            tail = atomic_load(&j->tail);
+            if (tail != atomic_load(&j->head)) {
+                conv_slot_run(j->st, &j->slot[tail % CONV_QLEN], w->nChannels);
+                atomic_store(&j->tail, tail + 1);
+                did = 1;
+            }
+        }
+        if (did) continue;
+        /* a wakeup can be missed when the render thread fails to get the
+         * lock, so never sleep longer than a millisecond */
+        pthread_mutex_lock(&w->lock);
+        if (atomic_load(&w->running)) {
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_nsec += 1000000;
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&w->cond, &w->lock, &ts);
+        }
+        pthread_mutex_unlock(&w->lock);
+    }
+    return NULL;
+}
+
+static void conv_job_compute(struct sp_conv_worker *w, conv_job *j, SPFLOAT in,
+                             SPFLOAT *out)
+{
+    conv_slot *s;
+    unsigned int tail, head;
+    int n, size = j->st->partSize * w->nChannels, found = 0;
+
+    j->inBuf[j->cnt] = in;
+    for (n = 0; n < w->nChannels; n++) {
+        out[n] += j->curOut[n * j->st->partSize + j->cnt];
+    }
+    if (++j->cnt < j->st->partSize) {
+        return;
+    }
+    j->cnt = 0;
+
+    /* pick up the output of the block from two periods ago, passing over
+     * any that came back too late to be played */
+    tail = atomic_load(&j->tail);
+    while (j->rd != tail && j->slot[j->rd % CONV_QLEN].seq + 2 <= j->seq) {
+        s = &j->slot[j->rd % CONV_QLEN];
+        if (s->seq + 2 == j->seq) {
+            memcpy(j->curOut, s->out, size * sizeof(SPFLOAT));
+            found = 1;
+        }
+        j->rd++;
+    }
+    if (!found) memset(j->curOut, 0, size * sizeof(SPFLOAT));
+
+    head = atomic_load(&j->head);
+    if (head - j->rd < CONV_QLEN) {
+        s = &j->slot[head % CONV_QLEN];
+        memcpy(s->in, j->inBuf, j->st->partSize * sizeof(SPFLOAT));
+        s->skip = j->skip;
+        s->seq = j->seq;
+        j->skip = 0;
+        atomic_store(&j->head, head + 1);
+        if (pthread_mutex_trylock(&w->lock) == 0) {
+            pthread_cond_signal(&w->cond);
+            pthread_mutex_unlock(&w->lock);
+        }
+    } else {
+        j->skip++;
+    }
+    j->seq++;
+}
+
+static void conv_worker_stop(sp_conv *p)
+{
+    struct sp_conv_worker *w = p->worker;
+    pthread_mutex_lock(&w->lock);
+    atomic_store(&w->running, 0);
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+    pthread_join(w->thread, NULL);
+    pthread_cond_destroy(&w->cond);
+    pthread_mutex_destroy(&w->lock);
+    sp_auxdata_free(&w->aux);
+    sp_free(w);
+    p->worker = NULL;
+}
+
+int sp_conv_thread_start(sp_conv *p, SPFLOAT iMinPartLen)
+{
+    struct sp_conv_worker *w;
+    sp_conv_stage *st;
+    SPFLOAT *buf;
+    size_t nSmps = 0;
+    int i, k, first;
+
+    if (!p->initDone || p->worker != NULL) return SP_NOT_OK;
+
+    /* the stage must have two blocks of input delay to give up */
+    for (first = 1; first < p->nstages; first++) {
+        st = &p->stage[first];
+        if (st->partSize >= iMinPartLen && st->delay >= 2 * st->partSize) break;
+    }
+    for (k = first; k < p->nstages; k++) {
+        if (p->stage[k].delay < 2 * p->stage[k].partSize) return SP_NOT_OK;
+        nSmps += (1 + CONV_QLEN) * (1 + p->nChannels) * p->stage[k].partSize;
+    }
+    if (first >= p->nstages) return SP_NOT_OK;
+
+    w = sp_malloc(sizeof(struct sp_conv_worker));
+    w->nChannels = p->nChannels;
+    w->first = first;
+    w->njobs = p->nstages - first;
+    sp_auxdata_alloc(&w->aux, nSmps * sizeof(SPFLOAT));
+    buf = w->aux.ptr;
+    for (k = 0; k < w->njobs; k++) {
+        conv_job *j = &w->job[k];
+        j->st = st = &p->stage[first + k];
+        st->delay -= 2 * st->partSize;
+        j->cnt = 0;
+        j->inBuf = buf; buf += st->partSize;
+        j->curOut = buf; buf += st->partSize * p->nChannels;
+        for (i = 0; i < CONV_QLEN; i++) {
+            j->slot[i].in = buf; buf += st->partSize;
+            j->slot[i].out = buf; buf += st->partSize * p->nChannels;
+        }
+        atomic_init(&j->head, 0);
+        atomic_init(&j->tail, 0);
+        j->rd = 0;
+        j->seq = 0;
+        j->skip = 0;
+    }
+    atomic_init(&w->running, 1);
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->cond, NULL);
+    if (pthread_create(&w->thread, NULL, conv_worker_main, w) != 0) {
+        for (k = 0; k < w->njobs; k++) {
+            w->job[k].st->delay += 2 * w->job[k].st->partSize;
+        }
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->lock);
+        sp_auxdata_free(&w->aux);
+        sp_free(w);
+        return SP_NOT_OK;
+    }
+    p->worker = w;
+    return SP_OK;
+}
+
+#else
+
+int sp_conv_thread_start(sp_conv *p, SPFLOAT iMinPartLen)
+{
+    return SP_NOT_OK;
+}
+
+#endif
+
+int sp_conv_create(sp_conv **p)
+{
+    *p = sp_malloc(sizeof(sp_conv));
+    (*p)->initDone = 0;
+    (*p)->worker = NULL;
+    return SP_OK;
+}
+
+int sp_conv_destroy(sp_conv **p)
+{
+    sp_conv *pp = *p;
+    int k;
+#ifndef NO_PTHREADS
+    if (pp->worker != NULL) conv_worker_stop(pp);
+#endif
+    if (pp->initDone) {
+        for (k = 0; k < pp->nstages; k++) conv_stage_destroy(&pp->stage[k]);
+        if (pp->nstages > 1) sp_auxdata_free(&pp->histData);
+    }
+    sp_free(*p);
+    return SP_OK;
+}
+
+/* length of the IR in frames, after skipping and truncation */
+static int conv_ir_length(sp_conv *p, sp_ftbl *ft, int stride, int skipSamples)
+{
+    int n = (int) ft->size / stride;
+    n -= skipSamples;
+
+    if (lrintf(p->iTotLen) > 0 && n > lrintf(p->iTotLen)) {
+        n = (int)lrintf(p->iTotLen);
+    }
+    return n;
+}
+
+int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen)
+{
+    return sp_conv_initn(sp, p, ft, 1, 0, 1, iPartLen, iPartLen);
+}
+
+int sp_conv_init_nonuniform(sp_data *sp, sp_conv *p, sp_ftbl *ft,
+        SPFLOAT iPartLen, SPFLOAT iMaxPartLen)
+{
+    return sp_conv_initn(sp, p, ft, 1, 0, 1, iPartLen, iMaxPartLen);
+}
+
+/*
+ * Each stage adds partSize samples of latency. A stage of size B covering
+ * the IR from offset s is fed the input delayed by s + iPartLen - B, so
+ * that all stages line up with the iPartLen latency of the first one.
+ * With iMaxPartLen == iPartLen this is a single uniform stage.
+ */
+int sp_conv_initn(sp_data *sp, sp_conv *p, sp_ftbl *ft, int stride, int first,
+        int nchan, SPFLOAT iPartLen, SPFLOAT iMaxPartLen)
+{
+    int n, partSize, maxPartSize, skipSamples, start, len, k;
+    uint32_t histSize;
+
+    p->iTotLen = ft->size;
+    p->iSkipSamples = 0;
+    p->iPartLen = iPartLen;
+
+    if (nchan < 1 || nchan > SP_CONV_MAXCHAN || first < 0 ||
+        first + nchan > stride) {
+        fprintf(stderr, "conv: invalid channel layout.\n");
+        return SP_NOT_OK;
+    }
+    p->nChannels = nchan;
+    /* partition length */
+    partSize = (int)lrintf(p->iPartLen);
+    maxPartSize = (int)lrintf(iMaxPartLen);
+    if (partSize < 4 || (partSize & (partSize - 1)) != 0 ||
+        maxPartSize < partSize || (maxPartSize & (maxPartSize - 1)) != 0) {
+        fprintf(stderr, "conv: invalid partition size.\n");
+        return SP_NOT_OK;
+    }
+
+    skipSamples = (int)lrintf(p->iSkipSamples);
+    n = conv_ir_length(p, ft, stride, skipSamples);
+
+    if (n <= 0) {
+        fprintf(stderr, "uh oh.\n");
+        return SP_NOT_OK;
+    }
+
+#ifndef NO_PTHREADS
+    if (p->worker != NULL) conv_worker_stop(p);
+#endif
+    p->nstages = 0;
+    start = 0;
+    for (k = 0; start < n; k++) {
+        /* the last stage takes whatever is left */
+        if (partSize < maxPartSize && k < SP_CONV_MAXSTAGES - 1) {
+            len = partSize * SP_CONV_NUPARTS;
+        } else {
+            len = n - start;
+        }
+        if (len > n - start) len = n - start;
+        conv_stage_init(&p->stage[k], ft, stride, first, p->nChannels,
+                skipSamples + start, len, partSize,
+                start + (int)lrintf(p->iPartLen) - partSize);
+        p->nstages++;
+        start += len;
+        if (partSize < maxPartSize) partSize <<= 1;
+    }
+
+    if (p->nstages > 1) {
+        histSize = 1;
+        while (histSize <= (uint32_t)p->stage[p->nstages - 1].delay) {
+            histSize <<= 1;
+        }
+        sp_auxdata_alloc(&p->histData, histSize * sizeof(SPFLOAT));
+        p->hist = p->histData.ptr;
+        p->histmask = histSize - 1;
+        p->histpos = 0;
+    }
+    p->initDone = 1;
+
+    return SP_OK;
+}
+
+int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
+{
+    sp_conv_stage *st;
+    SPFLOAT in0;
+    int k, n;
+
+    for (n = 0; n < p->nChannels; n++) out[n] = 0;
+
+    if (p->nstages == 1) {
+        conv_stage_compute(&p->stage[0], p->nChannels, *in, out);
+        return SP_OK;
+    }
+
+    p->hist[p->histpos] = *in;
+    for (k = 0; k < p->nstages; k++) {
+        st = &p->stage[k];
+        in0 = p->hist[(p->histpos - st->delay) & p->histmask];
+#ifndef NO_PTHREADS
+        if (p->worker != NULL && k >= p->worker->first) {
+            conv_job_compute(p->worker, &p->worker->job[k - p->worker->first], in0, out);
+            continue;
+        }
+#endif
+        conv_stage_compute(st, p->nChannels, in0, out);
+    }
+    p->histpos = (p->histpos + 1) & p->histmask;
+    return SP_OK;
+}
+
+int sp_conv_compute_block(sp_data *sp, sp_conv *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    if (p->nChannels != 1) return SP_NOT_OK;
+    for(i = 0; i < n; i++) {
+        sp_conv_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
+
+int sp_conv_compute_blockn(sp_data *sp, sp_conv *p, const SPFLOAT *in, SPFLOAT **out, uint32_t n)
+{
+    SPFLOAT tmp[SP_CONV_MAXCHAN];
+    uint32_t i;
+    int c;
+    for(i = 0; i < n; i++) {
+        sp_conv_compute(sp, p, (SPFLOAT *)&in[i], tmp);
+        for(c = 0; c < p->nChannels; c++) out[c][i] = tmp[c];
+    }
     return SP_OK;
 }
@@ -3,13 +3,13 @@
 
 int sp_count_create(sp_count **p)
 {
-    *p = malloc(sizeof(sp_count));
+    *p = sp_malloc(sizeof(sp_count));
     return SP_OK;
 }
 
 int sp_count_destroy(sp_count **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -42,3 +42,12 @@ int sp_count_compute(sp_data *sp, sp_count *p, SPFLOAT *in, SPFLOAT *out)
     *out = p->curcount;
     return SP_OK;
 }
+
+int sp_count_compute_block(sp_data *sp, sp_count *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_count_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
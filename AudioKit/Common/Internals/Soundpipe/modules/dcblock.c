@@ -15,13 +15,13 @@
 
 int sp_dcblock_create(sp_dcblock **p)
 {
-    *p = malloc(sizeof(sp_dcblock));
+    *p = sp_malloc(sizeof(sp_dcblock));
     return SP_OK;
 }
 
 int sp_dcblock_destroy(sp_dcblock **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -36,15 +36,23 @@ int sp_dcblock_init(sp_data *sp, sp_dcblock *p)
 }
 
 int sp_dcblock_compute(sp_data *sp, sp_dcblock *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_dcblock_compute_block(sp, p, in, out, 1);
+}
+
+int sp_dcblock_compute_block(sp_data *sp, sp_dcblock *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT gain = p->gain;
     SPFLOAT outputs = p->outputs;
     SPFLOAT inputs = p->inputs;
+    uint32_t i;
 
-    SPFLOAT sample = *in;
-    outputs = sample - inputs + (gain * outputs);
-    inputs = sample;
-    *out = outputs;
+    for(i = 0; i < n; i++) {
+        SPFLOAT sample = in[i];
+        outputs = sample - inputs + (gain * outputs);
+        inputs = sample;
+        out[i] = outputs;
+    }
     p->outputs = outputs;
     p->inputs = inputs;
     return SP_OK;
@@ -3,15 +3,15 @@
 
 int sp_delay_create(sp_delay **p)
 {
-    *p = malloc(sizeof(sp_delay));
+    *p = sp_malloc(sizeof(sp_delay));
     return SP_OK;
 }
 
 int sp_delay_destroy(sp_delay **p)
 {
     sp_delay *pp = *p;
-    sp_auxdata_free(&pp->buf);
-    free(*p);
+    sp_dline_destroy(&pp->dl);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -19,9 +19,8 @@ int sp_delay_init(sp_data *sp, sp_delay *p, SPFLOAT time)
 {
     p->time = time;
     p->bufsize = time * sp->sr + 1;
-    sp_auxdata_alloc(&p->buf, p->bufsize * sizeof(SPFLOAT));
-    p->init = 1;
-    p->bufpos = 0;
+    sp_dline_init(&p->dl, p->bufsize);
+    p->init = p->bufsize;
     p->feedback = 0;
     p->last = 0;
     return SP_OK;
@@ -29,23 +28,41 @@ int sp_delay_init(sp_data *sp, sp_delay *p, SPFLOAT time)
 
 int sp_delay_compute(sp_data *sp, sp_delay *p, SPFLOAT *in, SPFLOAT *out)
 {
-    SPFLOAT indel, outdel;
-    if(p->init) {
-        *out = 0;
-        indel = *in + p->last;
-        sp_auxdata_setbuf(&p->buf, p->bufpos, &indel);
-        p->bufpos++;
-        if(p->bufpos > p->bufsize - 1) p->init = 0;
-        p->bufpos %= p->bufsize;
-        p->last = *in * p->feedback;
-    } else {
-        indel = *in + p->last;
-        sp_auxdata_getbuf(&p->buf, p->bufpos, &outdel);
-        sp_auxdata_setbuf(&p->buf, p->bufpos, &indel);
-        p->bufpos++;
-        p->bufpos %= p->bufsize;
-        p->last = outdel * p->feedback;
-        *out = outdel;
+    return sp_delay_compute_block(sp, p, in, out, 1);
+}
+
+int sp_delay_compute_block(sp_data *sp, sp_delay *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT outdel[SP_DLINE_CHUNK], indel[SP_DLINE_CHUNK];
+    SPFLOAT feedback = p->feedback;
+    SPFLOAT last = p->last;
+    uint32_t i = 0, j, len;
+
+    while(i < n) {
+        len = n - i;
+        if(len > SP_DLINE_CHUNK) len = SP_DLINE_CHUNK;
+        if(len > p->bufsize) len = p->bufsize;
+        /* the first pass reads back silence and feeds back the input */
+        if(p->init > 0 && len > p->init) len = p->init;
+        sp_dline_read(&p->dl, p->bufsize, outdel, len);
+        if(p->init > 0) {
+            for(j = 0; j < len; j++) {
+                indel[j] = in[i + j] + last;
+                last = in[i + j] * feedback;
+                out[i + j] = 0;
+            }
+            p->init -= len;
+        } else {
+            for(j = 0; j < len; j++) {
+                indel[j] = in[i + j] + last;
+                last = outdel[j] * feedback;
+                out[i + j] = outdel[j];
+            }
+        }
+        sp_dline_write(&p->dl, indel, len);
+        i += len;
     }
+
+    p->last = last;
     return SP_OK;
 }
@@ -16,13 +16,13 @@
 
 int sp_dist_create(sp_dist **p)
 {
-    *p = malloc(sizeof(sp_dist));
+    *p = sp_malloc(sizeof(sp_dist));
     return SP_OK;
 }
 
 int sp_dist_destroy(sp_dist **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -37,10 +37,16 @@ int sp_dist_init(sp_data *sp, sp_dist *p)
 }
 
 int sp_dist_compute(sp_data *sp, sp_dist *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_dist_compute_block(sp, p, in, out, 1);
+}
+
+int sp_dist_compute_block(sp_data *sp, sp_dist *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT pregain = p->pregain, postgain  = p->postgain;
     SPFLOAT shape1 = p->shape1, shape2 = p->shape2;
     SPFLOAT sig;
+    uint32_t i;
     
     if (p->mode < 0.5) { 
         /* mode 0: original Mikelson version */               
@@ -63,11 +69,13 @@ int sp_dist_compute(sp_data *sp, sp_dist *p, SPFLOAT *in, SPFLOAT *out)
     shape1 += pregain;
     shape2 -= pregain;
     postgain *= 0.5;
-    sig = *in;
-    /* Generate tanh distortion and output the result */
-    *out =                          
-    ((exp(sig * shape1) - exp(sig * shape2))
-             / cosh(sig * pregain))
-    * postgain;
+    for(i = 0; i < n; i++) {
+        sig = in[i];
+        /* Generate tanh distortion and output the result */
+        out[i] =
+        ((exp(sig * shape1) - exp(sig * shape2))
+                 / cosh(sig * pregain))
+        * postgain;
+    }
     return SP_OK;
 }
@@ -0,0 +1,207 @@
+/*
+ * dline
+ *
+ * Ring buffer delay line of a power of two samples, shared by the delay
+ * based modules. The storage is 64 byte aligned and keeps one guard sample
+ * before the ring and three after it, mirrored after every write, so an
+ * interpolation stencil starting anywhere in the ring reads straight
+ * through without masking. Reads are split only where the ring wraps.
+ *
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+#include "soundpipe.h"
+
+#define DLINE_ALIGN 16  /* in samples */
+
+int sp_dline_init(sp_dline *d, uint32_t maxdelay)
+{
+    uint32_t size = 4;
+    uintptr_t a;
+
+    while(size < maxdelay + 2) size <<= 1;
+    d->size = size;
+    d->mask = size - 1;
+    d->pos = 0;
+    d->apz = 0;
+    sp_auxdata_alloc(&d->aux, (size + 4 + DLINE_ALIGN) * sizeof(SPFLOAT));
+    a = (uintptr_t)((SPFLOAT *)d->aux.ptr + 1);
+    a = (a + DLINE_ALIGN * sizeof(SPFLOAT) - 1) &
+        ~(uintptr_t)(DLINE_ALIGN * sizeof(SPFLOAT) - 1);
+    d->buf = (SPFLOAT *)a;
+    return SP_OK;
+}
+
+void sp_dline_destroy(sp_dline *d)
+{
+    sp_auxdata_free(&d->aux);
+}
+
+void sp_dline_clear(sp_dline *d)
+{
+    SPFLOAT *buf = d->buf - 1;
+    uint32_t i;
+    for(i = 0; i < d->size + 4; i++) buf[i] = 0;
+    d->pos = 0;
+    d->apz = 0;
+}
+
+static inline void dline_guard(sp_dline *d)
+{
+    SPFLOAT *buf = d->buf;
+    buf[-1] = buf[d->mask];
+    buf[d->size] = buf[0];
+    buf[d->size + 1] = buf[1];
+    buf[d->size + 2] = buf[2];
+}
+
+void sp_dline_write(sp_dline *d, const SPFLOAT *in, uint32_t n)
+{
+    SPFLOAT *buf = d->buf;
+    uint32_t pos = d->pos, len, i;
+
+    while(n > 0) {
+        len = d->size - pos;
+        if(len > n) len = n;
+        for(i = 0; i < len; i++) buf[pos + i] = in[i];
+        in += len;
+        n -= len;
+        pos = (pos + len) & d->mask;
+    }
+    d->pos = pos;
+    dline_guard(d);
+}
+
+void sp_dline_read(sp_dline *d, uint32_t delay, SPFLOAT *out, uint32_t n)
+{
+    const SPFLOAT *buf = d->buf;
+    uint32_t j = (d->pos - delay) & d->mask, len, i;
+
+    while(n > 0) {
+        len = d->size - j;
+        if(len > n) len = n;
+        for(i = 0; i < len; i++) out[i] = buf[j + i];
+        out += len;
+        n -= len;
+        j = 0;
+    }
+}
+
+/* out[i] = a p[i] + b p[i + 1], or added to out[i] if acc is set */
+static void dline_mix(SPFLOAT *out, const SPFLOAT *p, SPFLOAT a, SPFLOAT b,
+        uint32_t n, int acc)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b), v;
+    for(; i + 4 <= n; i += 4) {
+        v = _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(p + i)),
+                _mm_mul_ps(vb, _mm_loadu_ps(p + i + 1)));
+        if(acc) v = _mm_add_ps(v, _mm_loadu_ps(out + i));
+        _mm_storeu_ps(out + i, v);
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t v;
+    for(; i + 4 <= n; i += 4) {
+        v = vmlaq_n_f32(vmulq_n_f32(vld1q_f32(p + i), a),
+                vld1q_f32(p + i + 1), b);
+        if(acc) v = vaddq_f32(v, vld1q_f32(out + i));
+        vst1q_f32(out + i, v);
+    }
+#endif
+    if(acc) {
+        for(; i < n; i++) out[i] += a * p[i] + b * p[i + 1];
+    } else {
+        for(; i < n; i++) out[i] = a * p[i] + b * p[i + 1];
+    }
+}
+
+void sp_dline_readf(sp_dline *d, SPFLOAT delay, int interp, SPFLOAT *out, uint32_t n)
+{
+    const SPFLOAT *buf = d->buf, *p;
+    SPFLOAT di, u, w, x, y, z, eta, apz = d->apz;
+    uint32_t j, len, i;
+
+    if(interp == SP_DLINE_NONE) {
+        sp_dline_read(d, (uint32_t)(delay + 0.5), out, n);
+        return;
+    }
+
+    /* the stencil base sits ceil(delay) back, u of the way to the
+     * next newer sample */
+    di = ceil(delay);
+    u = di - delay;
+    j = (d->pos - (uint32_t)di) & d->mask;
+
+    if(interp == SP_DLINE_CUBIC) {
+        /* the Lagrange coefficients of Csound's vdelay3 */
+        z = u * u; z--;
+        z *= 0.1666666667;
+        y = u;
+        y++; w = (y *= 0.5); w--;
+        x = 3.0 * z; y -= x; w -= z; x -= u;
+    } else if(interp == SP_DLINE_ALLPASS) {
+        eta = u / (2 - u);
+    }
+
+    while(n > 0) {
+        len = d->size - j;
+        if(len > n) len = n;
+        p = buf + j;
+        switch(interp) {
+            case SP_DLINE_CUBIC:
+                /* the stencil starts one before the base */
+                p--;
+                for(i = 0; i < len; i++) {
+                    out[i] = (w*p[i] + x*p[i + 1] + y*p[i + 2] + z*p[i + 3])
+                        * u + p[i + 1];
+                }
+                break;
+            case SP_DLINE_ALLPASS:
+                for(i = 0; i < len; i++) {
+                    apz = eta * (p[i + 1] - apz) + p[i];
+                    out[i] = apz;
+                }
+                break;
+            default:
+                dline_mix(out, p, 1 - u, u, len, 0);
+        }
+        out += len;
+        n -= len;
+        j = 0;
+    }
+    if(interp == SP_DLINE_ALLPASS) d->apz = apz;
+}
+
+void sp_dline_taps(sp_dline *d, const SPFLOAT *delays, const SPFLOAT *gains,
+        int ntaps, SPFLOAT *out, uint32_t n)
+{
+    const SPFLOAT *buf = d->buf;
+    SPFLOAT di, u, *o;
+    uint32_t j, len, m, i;
+    int k;
+
+    for(i = 0; i < n; i++) out[i] = 0;
+    for(k = 0; k < ntaps; k++) {
+        di = ceil(delays[k]);
+        u = di - delays[k];
+        j = (d->pos - (uint32_t)di) & d->mask;
+        o = out;
+        m = n;
+        while(m > 0) {
+            len = d->size - j;
+            if(len > m) len = m;
+            dline_mix(o, buf + j, gains[k] * (1 - u), gains[k] * u, len, 1);
+            o += len;
+            m -= len;
+            j = 0;
+        }
+    }
+}
@@ -3,13 +3,13 @@
 
 int sp_dmetro_create(sp_dmetro **p)
 {
-    *p = malloc(sizeof(sp_dmetro));
+    *p = sp_malloc(sizeof(sp_dmetro));
     return SP_OK;
 }
 
 int sp_dmetro_destroy(sp_dmetro **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -33,3 +33,12 @@ int sp_dmetro_compute(sp_data *sp, sp_dmetro *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_dmetro_compute_block(sp_data *sp, sp_dmetro *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_dmetro_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
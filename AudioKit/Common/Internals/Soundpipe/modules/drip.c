@@ -30,27 +30,27 @@
 #define M_PI		3.14159265358979323846	
 #endif 
 
-static inline int my_random(sp_data *sp, int max)
+static inline int my_random(sp_prng *prng, int max)
 {                      
-    return (sp_rand(sp) % (max + 1));
+    return (sp_prng_rand(prng) % (max + 1));
 }
 
-static SPFLOAT noise_tick(sp_data *sp)                                        
+static SPFLOAT noise_tick(sp_prng *prng)                                        
 {                       
     SPFLOAT temp;                                                                
-    temp = 1.0 * sp_rand(sp) - 1073741823.5;
+    temp = 1.0 * sp_prng_rand(prng) - 1073741823.5;
     return temp * (1.0 / 1073741823.0);
 }                                                                              
 
 int sp_drip_create(sp_drip **p)
 {
-    *p = malloc(sizeof(sp_drip));
+    *p = sp_malloc(sizeof(sp_drip));
     return SP_OK;
 }
 
 int sp_drip_destroy(sp_drip **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -58,6 +58,7 @@ int sp_drip_init(sp_data *sp, sp_drip *p, SPFLOAT dettack)
 {
 
     SPFLOAT temp;
+    sp_prng_init(sp, &p->prng);
     p->dettack = dettack;
     p->num_tubes = 10;
     p->damp = 0.2;
@@ -159,21 +160,21 @@ int sp_drip_compute(sp_data *sp, sp_drip *p, SPFLOAT *trig, SPFLOAT *out)
     shakeEnergy *= systemDecay; /* Exponential system decay */
 
     sndLevel = shakeEnergy;
-    if (my_random(sp, 32767) < num_objects) {
+    if (my_random(&p->prng, 32767) < num_objects) {
         int j;
-        j = my_random(sp, 3);
+        j = my_random(&p->prng, 3);
         if (j == 0) {
             p->center_freqs0 = p->res_freq1 *
-            (0.75 + (0.25 * noise_tick(sp)));
-            p->gains0 = fabs(noise_tick(sp));
+            (0.75 + (0.25 * noise_tick(&p->prng)));
+            p->gains0 = fabs(noise_tick(&p->prng));
         } else if (j == 1) {
             p->center_freqs1 = p->res_freq1 *
-            (1.0 + (0.25 * noise_tick(sp)));
-            p->gains1 = fabs(noise_tick(sp));
+            (1.0 + (0.25 * noise_tick(&p->prng)));
+            p->gains1 = fabs(noise_tick(&p->prng));
         } else  {
             p->center_freqs2 = p->res_freq1 *
-            (1.25 + (0.25 * noise_tick(sp)));
-            p->gains2 = fabs(noise_tick(sp));
+            (1.25 + (0.25 * noise_tick(&p->prng)));
+            p->gains2 = fabs(noise_tick(&p->prng));
         }
     }
 
@@ -198,7 +199,7 @@ int sp_drip_compute(sp_data *sp, sp_drip *p, SPFLOAT *trig, SPFLOAT *out)
 
     sndLevel *= soundDecay;   
     inputs0 = sndLevel;
-    inputs0 *= noise_tick(sp); 
+    inputs0 *= noise_tick(&p->prng); 
     inputs1 = inputs0 * p->gains1;
     inputs2 = inputs0 * p->gains2;
     inputs0 *= p->gains0;
@@ -229,3 +230,12 @@ int sp_drip_compute(sp_data *sp, sp_drip *p, SPFLOAT *trig, SPFLOAT *out)
     p->sndLevel = sndLevel;
     return SP_OK;
 }
+
+int sp_drip_compute_block(sp_data *sp, sp_drip *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_drip_compute(sp, p, (SPFLOAT *)&trig[i], &out[i]);
+    }
+    return SP_OK;
+}
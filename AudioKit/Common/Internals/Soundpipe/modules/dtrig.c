@@ -3,13 +3,13 @@
 
 int sp_dtrig_create(sp_dtrig **p)
 {
-    *p = malloc(sizeof(sp_dtrig));
+    *p = sp_malloc(sizeof(sp_dtrig));
     return SP_OK;
 }
 
 int sp_dtrig_destroy(sp_dtrig **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -49,3 +49,12 @@ int sp_dtrig_compute(sp_data *sp, sp_dtrig *p, SPFLOAT *in, SPFLOAT *out)
     *out = 0;
     return SP_NOT_OK;
 }
+
+int sp_dtrig_compute_block(sp_data *sp, sp_dtrig *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_dtrig_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -16,13 +16,13 @@
 
 int sp_dust_create(sp_dust **p)
 {
-    *p = malloc(sizeof(sp_dust));
+    *p = sp_malloc(sizeof(sp_dust));
     return SP_OK;
 }
 
 int sp_dust_destroy(sp_dust **p) 
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -33,7 +33,8 @@ int sp_dust_init(sp_data *sp, sp_dust *p, SPFLOAT amp, SPFLOAT density)
     p->density0 = 0.0;
     p->thresh = 0.0;
     p->scale = 0.0;
-    p->rand = sp_rand(sp);
+    sp_prng_init(sp, &p->prng);
+    p->rand = sp_prng_rand(&p->prng);
     p->onedsr = 1.0 / sp->sr;
     p->bipolar = 0;
     return SP_OK;
@@ -58,7 +59,7 @@ int sp_dust_compute(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out)
     }
     *out = 0;
     SPFLOAT r;
-    p->rand = sp_rand(sp);
+    p->rand = sp_prng_rand(&p->prng);
     r = (SPFLOAT)p->rand * dv2_31;
 
     if(p->bipolar) {
@@ -69,3 +70,12 @@ int sp_dust_compute(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_dust_compute_block(sp_data *sp, sp_dust *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_dust_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
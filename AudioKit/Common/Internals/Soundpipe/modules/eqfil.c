@@ -11,26 +11,30 @@
  */
 
 #include <stdlib.h>
-#include <math.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 #include "soundpipe.h"
 
 int sp_eqfil_create(sp_eqfil **p)
 {
-    *p = malloc(sizeof(sp_eqfil));
+    *p = sp_malloc(sizeof(sp_eqfil));
     return SP_OK;
 }
 
 int sp_eqfil_destroy(sp_eqfil **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
+/* the allpass coefficients come from the biquad bank's design code */
+static void eqfil_coefs(sp_data *sp, sp_eqfil *p)
+{
+    SPFLOAT c[2];
+    p->frv = p->freq; p->bwv = p->bw;
+    sp_bqbank_eqfil_ap(sp, p->frv, p->bwv, c);
+    p->d = c[0];
+    p->a = c[1];
+}
+
 int sp_eqfil_init(sp_data *sp, sp_eqfil *p)
 {
     p->sr = sp->sr;
@@ -39,34 +43,34 @@ int sp_eqfil_init(sp_data *sp, sp_eqfil *p)
     p->bw = 125;
     p->gain = 2;
 
-    p->frv = p->freq; p->bwv = p->bw;
-    p->d = cos(2 * M_PI * p->frv /p->sr);
-    p->c = tan(M_PI * p->bwv / p->sr);
+    eqfil_coefs(sp, p);
     return SP_OK;
 }
 
 int sp_eqfil_compute(sp_data *sp, sp_eqfil *p, SPFLOAT *in, SPFLOAT *out)
 {
-    SPFLOAT z1 = p->z1, z2 = p->z2, c, d, w, a, y;
+    return sp_eqfil_compute_block(sp, p, in, out, 1);
+}
+
+int sp_eqfil_compute_block(sp_data *sp, sp_eqfil *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT z1 = p->z1, z2 = p->z2, d, w, a, y;
     SPFLOAT g;
+    uint32_t i;
 
-    if(p->bw != p->bwv || p->freq != p->frv) {
-        SPFLOAT sr = sp->sr;
-        p->frv = p->freq; p->bwv = p->bw;
-        p->d = cos(2 * M_PI * p->frv / sr);
-        p->c = tan(M_PI * p->bwv / sr);
-    }
+    if(p->bw != p->bwv || p->freq != p->frv) eqfil_coefs(sp, p);
 
-    c = p->c;
     d = p->d;
-    a = (1.0 - c) / (1.0 + c);
+    a = p->a;
     g = p->gain;
 
-    w = *in + d * (1.0 + a) * z1 - a * z2;
-    y = w * a - d * (1.0 + a) * z1 + z2;
-    z2 = z1;
-    z1 = w;
-    *out = (0.5 * (y + *in + g * (*in - y)));
+    for(i = 0; i < n; i++) {
+        w = in[i] + d * (1.0 + a) * z1 - a * z2;
+        y = w * a - d * (1.0 + a) * z1 + z2;
+        z2 = z1;
+        z1 = w;
+        out[i] = (0.5 * (y + in[i] + g * (in[i] - y)));
+    }
 
     p->z1 = z1;
     p->z2 = z2;
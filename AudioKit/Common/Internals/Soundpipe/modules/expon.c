@@ -16,13 +16,13 @@
 
 int sp_expon_create(sp_expon **p)
 {
-    *p = malloc(sizeof(sp_expon));
+    *p = sp_malloc(sizeof(sp_expon));
     return SP_OK;
 }
 
 int sp_expon_destroy(sp_expon **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -74,3 +74,12 @@ int sp_expon_compute(sp_data *sp, sp_expon *p, SPFLOAT *in, SPFLOAT *out)
     }
     return SP_OK;
 }
+
+int sp_expon_compute_block(sp_data *sp, sp_expon *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_expon_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -22,13 +22,13 @@
 
 int sp_fofilt_create(sp_fofilt **p)
 {
-    *p = malloc(sizeof(sp_fofilt));
+    *p = sp_malloc(sizeof(sp_fofilt));
     return SP_OK;
 }
 
 int sp_fofilt_destroy(sp_fofilt **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -51,6 +51,11 @@ int sp_fofilt_init(sp_data *sp, sp_fofilt *p)
 }
 
 int sp_fofilt_compute(sp_data *sp, sp_fofilt *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_fofilt_compute_block(sp, p, in, out, 1);
+}
+
+int sp_fofilt_compute_block(sp_data *sp, sp_fofilt *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
 
     SPFLOAT freq = p->freq;
@@ -58,31 +63,39 @@ int sp_fofilt_compute(sp_data *sp, sp_fofilt *p, SPFLOAT *in, SPFLOAT *out)
     SPFLOAT dec = p->dec;
     SPFLOAT *delay = p->delay,ang=0,fsc,rrad1=0,rrad2=0;
     SPFLOAT w1,y1,w2,y2;
-    SPFLOAT lfrq = -1.0, lrs = -1.0, ldc = -1.0;
+    SPFLOAT d0 = delay[0], d1 = delay[1], d2 = delay[2], d3 = delay[3];
+    double cos1, cos2;
+    SPFLOAT rsq1, rsq2;
+    uint32_t i;
 
     SPFLOAT frq = freq;
     SPFLOAT rs = ris;
     SPFLOAT dc = dec;
-    if (frq != lfrq || rs != lrs || dc != ldc) {
-        lfrq = frq; lrs = rs; ldc = dc;
-        ang = (SPFLOAT)p->tpidsr*frq;
-        fsc = sin(ang) - 3.0;
+    ang = (SPFLOAT)p->tpidsr*frq;
+    fsc = sin(ang) - 3.0;
 
-        rrad1 =  pow(10.0, fsc/(dc*sp->sr));
-        rrad2 =  pow(10.0, fsc/(rs*sp->sr));
-    }
+    rrad1 =  pow(10.0, fsc/(dc*sp->sr));
+    rrad2 =  pow(10.0, fsc/(rs*sp->sr));
+
+    cos1 = 2.0*rrad1*cos(ang);
+    cos2 = 2.0*rrad2*cos(ang);
+    rsq1 = rrad1*rrad1;
+    rsq2 = rrad2*rrad2;
 
-    w1  = *in + 2.0*rrad1*cos(ang)*delay[0] - rrad1*rrad1*delay[1];
-    y1 =  w1 - delay[1];
-    delay[1] = delay[0];
-    delay[0] = w1;
+    for(i = 0; i < n; i++) {
+        w1  = in[i] + cos1*d0 - rsq1*d1;
+        y1 =  w1 - d1;
+        d1 = d0;
+        d0 = w1;
 
-    w2  = *in + 2.0*rrad2*cos(ang)*delay[2] - rrad2*rrad2*delay[3];
-    y2 =  w2 - delay[3];
-    delay[3] = delay[2];
-    delay[2] = w2;
+        w2  = in[i] + cos2*d2 - rsq2*d3;
+        y2 =  w2 - d3;
+        d3 = d2;
+        d2 = w2;
 
-    *out = (SPFLOAT) (y1 - y2);
+        out[i] = (SPFLOAT) (y1 - y2);
+    }
 
+    delay[0] = d0; delay[1] = d1; delay[2] = d2; delay[3] = d3;
     return SP_OK;
 }
@@ -15,13 +15,13 @@
 
 int sp_fold_create(sp_fold **p)
 {
-    *p = malloc(sizeof(sp_fold));
+    *p = sp_malloc(sizeof(sp_fold));
     return SP_OK;
 }
 
 int sp_fold_destroy(sp_fold **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -51,3 +51,12 @@ int sp_fold_compute(sp_data *sp, sp_fold *p, SPFLOAT *in, SPFLOAT *out)
     p->value = value;
     return SP_OK;
 }
+
+int sp_fold_compute_block(sp_data *sp, sp_fold *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_fold_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
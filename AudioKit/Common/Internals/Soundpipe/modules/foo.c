@@ -11,13 +11,13 @@
 
 int sp_foo_create(sp_foo **p)
 {
-    *p = malloc(sizeof(sp_foo));
+    *p = sp_malloc(sizeof(sp_foo));
     return SP_OK;
 }
 
 int sp_foo_destroy(sp_foo **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -34,3 +34,12 @@ int sp_foo_compute(sp_data *sp, sp_foo *p, SPFLOAT *in, SPFLOAT *out)
     *out = *in;
     return SP_OK;
 }
+
+int sp_foo_compute_block(sp_data *sp, sp_foo *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_foo_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -15,13 +15,13 @@
 
 int sp_fosc_create(sp_fosc **p)
 {
-    *p = malloc(sizeof(sp_fosc));
+    *p = sp_malloc(sizeof(sp_fosc));
     return SP_OK;
 }
 
 int sp_fosc_destroy(sp_fosc **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -42,6 +42,11 @@ int sp_fosc_init(sp_data *sp, sp_fosc *p, sp_ftbl *ft)
 }
 
 int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_fosc_compute_block(sp, p, in, out, 1);
+}
+
+int sp_fosc_compute_block(sp_data *sp, sp_fosc *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
 
     sp_ftbl *ftp;
@@ -49,12 +54,19 @@ int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out)
     SPFLOAT  amp, cps, fract, v1, v2, car, fmod, cfreq, mod;
     SPFLOAT  xcar, xmod, ndx, *ftab;
     int32_t  mphs, cphs, minc, cinc, lobits;
+    uint32_t lomask;
     SPFLOAT  sicvt = p->ft->sicvt;
+    SPFLOAT  lodiv, last, first;
     SPFLOAT  *ft;
+    uint32_t i;
 
     ftp = p->ft;
     ft = ftp->tbl;
     lobits = ftp->lobits;
+    lomask = ftp->lomask;
+    lodiv = ftp->lodiv;
+    last = ft[ftp->size - 1];
+    first = ft[0];
     mphs = p->mphs;
     cphs = p->cphs;
     cps  = p->freq;
@@ -66,34 +78,67 @@ int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out)
     mod = cps * xmod;
     ndx = p->indx * mod;
     minc = (int32_t)(mod * sicvt);
-    mphs &= SP_FT_PHMASK;
-    fract = ((mphs) & ftp->lomask) * ftp->lodiv;
-    ftab = ft + (mphs >> lobits);
-    v1 = ftab[0];
-
-    if(ftab[0] == p->ft->tbl[p->ft->size - 1]) {
-        v2 = p->ft->tbl[0];
-    } else {
-        v2 = ftab[1];
-    }
 
-    fmod = (v1 + (v2 - v1) * fract) * ndx;
-    mphs += minc;
-    cfreq = car + fmod;
-    cinc = (int32_t)(cfreq * sicvt);
-    cphs &= SP_FT_PHMASK;
-    fract = ((cphs) & ftp->lomask) * ftp->lodiv;
-    ftab = ft + (cphs >>lobits);
-    v1 = ftab[0];
-
-    if(ftab[0] == p->ft->tbl[p->ft->size - 1]) {
-        v2 = p->ft->tbl[0];
-    } else {
-        v2 = ftab[1];
+    if(ftp->nmip > 0) {
+        /* the modulator and carrier each read the levels for their own
+         * base frequency. Levels carry a guard point, so no wraparound. */
+        SPFLOAT *mlo, *mhi, *clo, *chi, mmix, cmix, lo, hi;
+        int32_t idx;
+        mmix = sp_ftbl_mip_select(sp, ftp, mod, &mlo, &mhi);
+        cmix = sp_ftbl_mip_select(sp, ftp, car, &clo, &chi);
+        for(i = 0; i < n; i++) {
+            mphs &= SP_FT_PHMASK;
+            fract = ((mphs) & lomask) * lodiv;
+            idx = mphs >> lobits;
+            lo = mlo[idx] + (mlo[idx + 1] - mlo[idx]) * fract;
+            hi = mhi[idx] + (mhi[idx + 1] - mhi[idx]) * fract;
+            fmod = (lo + (hi - lo) * mmix) * ndx;
+            mphs += minc;
+            cfreq = car + fmod;
+            cinc = (int32_t)(cfreq * sicvt);
+            cphs &= SP_FT_PHMASK;
+            fract = ((cphs) & lomask) * lodiv;
+            idx = cphs >> lobits;
+            lo = clo[idx] + (clo[idx + 1] - clo[idx]) * fract;
+            hi = chi[idx] + (chi[idx + 1] - chi[idx]) * fract;
+            out[i] = (lo + (hi - lo) * cmix) * amp;
+            cphs += cinc;
+        }
+        p->mphs = mphs;
+        p->cphs = cphs;
+        return SP_OK;
     }
 
-    *out = (v1 + (v2 - v1) * fract) * amp;
-    cphs += cinc;
+    for(i = 0; i < n; i++) {
+        mphs &= SP_FT_PHMASK;
+        fract = ((mphs) & lomask) * lodiv;
+        ftab = ft + (mphs >> lobits);
+        v1 = ftab[0];
+
+        if(ftab[0] == last) {
+            v2 = first;
+        } else {
+            v2 = ftab[1];
+        }
+
+        fmod = (v1 + (v2 - v1) * fract) * ndx;
+        mphs += minc;
+        cfreq = car + fmod;
+        cinc = (int32_t)(cfreq * sicvt);
+        cphs &= SP_FT_PHMASK;
+        fract = ((cphs) & lomask) * lodiv;
+        ftab = ft + (cphs >>lobits);
+        v1 = ftab[0];
+
+        if(ftab[0] == last) {
+            v2 = first;
+        } else {
+            v2 = ftab[1];
+        }
+
+        out[i] = (v1 + (v2 - v1) * fract) * amp;
+        cphs += cinc;
+    }
     p->mphs = mphs;
     p->cphs = cphs;
 
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "soundpipe.h"
+#include "kiss_fftr.h"
 
 #ifndef M_PI
 #define M_PI		3.14159265358979323846	/* pi */
@@ -10,46 +11,137 @@
 
 int sp_ftbl_create(sp_data *sp, sp_ftbl **ft, size_t size)
 {
-    *ft = malloc(sizeof(sp_ftbl));
+    *ft = sp_malloc(sizeof(sp_ftbl));
     sp_ftbl *ftp = *ft;
     ftp->size = size;
-    ftp->tbl = malloc(sizeof(SPFLOAT) * (size + 1));
+    ftp->tbl = sp_malloc(sizeof(SPFLOAT) * (size + 1));
     memset(ftp->tbl, 0, sizeof(SPFLOAT) * (size + 1));
     ftp->sicvt = 1.0 * SP_FT_MAXLEN / sp->sr;
     ftp->lobits = log2(SP_FT_MAXLEN / size);
 //    ftp->lomask = pow(2, ftp->lobits) - 1;
     ftp->lomask = (2^ftp->lobits) - 1;
     ftp->lodiv = 1.0 / pow(2, ftp->lobits);
+    ftp->mip = NULL;
+    ftp->nmip = 0;
+    ftp->map = NULL;
+    ftp->maplen = 0;
     return SP_OK;
 }
 
 int sp_ftbl_destroy(sp_ftbl **ft)
 {
     sp_ftbl *ftp = *ft;
-    free(ftp->tbl);
-    free(*ft);
+    sp_free(ftp->mip);
+    sp_ftbl_release(ftp);
+    sp_free(*ft);
     return SP_OK;
 }
 
+/* Builds an octave-spaced pyramid from the current table contents. Level k
+ * keeps harmonics 1 to (size / 2) >> k, level 0 being the table itself. */
+int sp_ftbl_mipmap(sp_data *sp, sp_ftbl *ft)
+{
+    kiss_fftr_cfg fft, ifft;
+    kiss_fft_cpx *spec, *tmp;
+    uint32_t size = (uint32_t)ft->size;
+    uint32_t nbins = size / 2;
+    uint32_t nmip = 0, keep, i, k;
+    SPFLOAT scale = 1.0 / size;
+    SPFLOAT *lvl;
+
+    if(size < 4 || (size & 1)) return SP_NOT_OK;
+
+    while((nbins >> (nmip + 1)) > 0) nmip++;
+
+    sp_free(ft->mip);
+    ft->mip = sp_malloc(sizeof(SPFLOAT) * (size + 1) * nmip);
+    ft->nmip = nmip;
+
+    fft = kiss_fftr_alloc(size, 0, NULL, NULL);
+    ifft = kiss_fftr_alloc(size, 1, NULL, NULL);
+    spec = malloc(sizeof(kiss_fft_cpx) * (nbins + 1));
+    tmp = malloc(sizeof(kiss_fft_cpx) * (nbins + 1));
+
+    kiss_fftr(fft, ft->tbl, spec);
+
+    for(k = 1; k <= nmip; k++) {
+        keep = nbins >> k;
+        lvl = ft->mip + (k - 1) * (size + 1);
+        for(i = 0; i <= nbins; i++) {
+            if(i <= keep) {
+                tmp[i] = spec[i];
+            } else {
+                tmp[i].r = 0;
+                tmp[i].i = 0;
+            }
+        }
+        kiss_fftri(ifft, tmp, lvl);
+        for(i = 0; i < size; i++) lvl[i] *= scale;
+        /* guard point for interpolation */
+        lvl[size] = lvl[0];
+    }
+
+    free(spec);
+    free(tmp);
+    kiss_fftr_free(fft);
+    kiss_fftr_free(ifft);
+    return SP_OK;
+}
+
+/* Picks the pair of levels to crossfade for a given frequency. Level
+ * floor(x) + 1 is crossfaded into the next one up, where x is
+ * log2(size * freq / sr), so no harmonic above Nyquist is ever played. */
+SPFLOAT sp_ftbl_mip_select(sp_data *sp, sp_ftbl *ft, SPFLOAT freq,
+        SPFLOAT **lo, SPFLOAT **hi)
+{
+    SPFLOAT x, fx;
+    uint32_t base;
+
+    *lo = *hi = ft->tbl;
+    if(ft->nmip == 0) return 0;
+
+    x = log2(ft->size * fabs(freq) / sp->sr);
+    if(!(x > -1)) return 0;
+
+    fx = floor(x);
+    base = (uint32_t)(fx + 1);
+    if(base >= ft->nmip) {
+        *lo = *hi = ft->mip + (ft->nmip - 1) * (ft->size + 1);
+        return 0;
+    }
+    if(base > 0) *lo = ft->mip + (base - 1) * (ft->size + 1);
+    *hi = ft->mip + base * (ft->size + 1);
+    return x - fx;
+}
+
 int sp_gen_vals(sp_data *sp, sp_ftbl *ft, const char *string)
 {
     char *str1 = NULL, *token = NULL, *t;
     char *saveptr1 = NULL;
     int j;
     char *d;
+    SPFLOAT *tbl;
     d = malloc(sizeof(char) + 1);
     d[0] = ' ';
     d[1] = 0;
     t = malloc(sizeof(char) * (strlen(string) + 1));
+
+    /* count the values first, so the table grows in one step */
+    strcpy(t, string);
+    for (j = 0, str1 = t; strtok_r(str1, d, &saveptr1) != NULL; j++, str1 = NULL);
+    if(ft->size < j) {
+        tbl = sp_malloc(sizeof(SPFLOAT) * (j + 1));
+        memcpy(tbl, ft->tbl, sizeof(SPFLOAT) * ft->size);
+        sp_ftbl_release(ft);
+        ft->tbl = tbl;
+        ft->size = j;
+    }
+
     strcpy(t, string);
     for (j = 0, str1 = t; ; j++, str1 = NULL) {
         token = strtok_r(str1, d, &saveptr1);
         if (token == NULL)
             break;
-        if(ft->size < j + 1){
-            ft->tbl = realloc(ft->tbl, sizeof(SPFLOAT) * (ft->size + 2));
-            ft->size++;
-        }
         ft->tbl[j] = atof(token);
     }
 
@@ -96,8 +188,76 @@ int sp_gen_sine(sp_data *sp, sp_ftbl *ft)
 //}
 #endif
 
+/* runs gen through the table cache, see sp_ftbl_cache() */
+static int ftbl_gen_cached(sp_data *sp, sp_ftbl *ft, const char *name,
+        const char *args, int (*gen)(sp_data *, sp_ftbl *, const char *))
+{
+    int hit, rc;
+    int cache = sp_ftbl_cache_lookup(sp, ft, name, args, &hit) == SP_OK;
+    if(hit) return SP_OK;
+    rc = gen(sp, ft, args);
+    if(cache && rc == SP_OK) sp_ftbl_cache_store(sp, ft, name, args);
+    return rc;
+}
+
+/* sp_gen_sinesum() builds tables with more non-zero partials than this
+ * with one inverse FFT */
+#define SINESUM_DIRECT_MAX 2
+
+/* Adds the partials through one inverse real FFT: the partial at
+ * harmonic h is a negative imaginary component in bin h mod size, folded
+ * below Nyquist with its sign flipped. Power of two sizes go through
+ * sp_ifftr(), other even sizes through kiss_fftri(). */
+static void sinesum_ifft(sp_ftbl *ft, sp_ftbl *args)
+{
+    uint32_t N = (uint32_t)ft->size, nbins = N / 2;
+    uint32_t i, k, n;
+    int M;
+    SPFLOAT amp, scale, *out;
+    kiss_fft_cpx *spec;
+    kiss_fftr_cfg ifft;
+    sp_fft fft;
+
+    for(M = 0; ((uint32_t)1 << M) < N; M++);
+    /* sp_ifftr() scales by 1/N, kiss_fftri() does not */
+    scale = ((uint32_t)1 << M) == N ? -0.5 * N : -0.5;
+    spec = calloc(nbins + 1, sizeof(kiss_fft_cpx));
+    out = malloc(sizeof(SPFLOAT) * N);
+
+    for(i = (uint32_t)args->size; i > 0; i--){
+        amp = args->tbl[args->size - i];
+        k = i % N;
+        if(k > nbins) {
+            k = N - k;
+            amp = -amp;
+        }
+        /* sin(0) and sin(pi n) vanish */
+        if(amp == 0 || k == 0 || k == nbins) continue;
+        spec[k].i += amp * scale;
+    }
+
+    if(((uint32_t)1 << M) == N) {
+        out[0] = out[1] = 0;
+        for(k = 1; k < nbins; k++) {
+            out[2 * k] = 0;
+            out[2 * k + 1] = spec[k].i;
+        }
+        sp_fft_init(&fft, M);
+        sp_ifftr(&fft, out, N);
+        sp_fft_destroy(&fft);
+    } else {
+        ifft = kiss_fftr_alloc(N, 1, NULL, NULL);
+        kiss_fftri(ifft, spec, out);
+        kiss_fftr_free(ifft);
+    }
+
+    for(n = 0; n < N; n++) ft->tbl[n] += out[n];
+    free(out);
+    free(spec);
+}
+
 /* port of GEN10 from Csound */
-int sp_gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring)
+static int gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring)
 {
     sp_ftbl *args;
     sp_ftbl_create(sp, &args, 1);
@@ -108,7 +268,16 @@ int sp_gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring)
     int32_t flen = (int32_t)ft->size;
     SPFLOAT tpdlen = 2.0 * M_PI / (SPFLOAT) flen;
 
-    int32_t i, n;
+    int32_t i, n, npartials = 0;
+
+    for(i = 0; i < (int32_t)args->size; i++) {
+        if(args->tbl[i] != 0) npartials++;
+    }
+    if(npartials > SINESUM_DIRECT_MAX && flen >= 4 && (flen & 1) == 0) {
+        sinesum_ifft(ft, args);
+        sp_ftbl_destroy(&args);
+        return SP_OK;
+    }
 
     for(i = (int32_t)args->size; i > 0; i--){
         amp = args->tbl[args->size - i];
@@ -124,7 +293,12 @@ int sp_gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring)
     return SP_OK;
 }
 
-int sp_gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring)
+int sp_gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring)
+{
+    return ftbl_gen_cached(sp, ft, "sinesum", argstring, gen_sinesum);
+}
+
+static int gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring)
 {
     uint16_t i, n = 0, seglen;
     SPFLOAT incr, amp = 0;
@@ -177,7 +351,12 @@ int sp_gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring)
     return SP_OK;
 }
 
-int sp_gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring)
+int sp_gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring)
+{
+    return ftbl_gen_cached(sp, ft, "line", argstring, gen_line);
+}
+
+static int gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring)
 {
     uint16_t i, n = 0, seglen;
     SPFLOAT mult, amp = 0;
@@ -241,31 +420,28 @@ int sp_gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring)
 }
 
 
-static SPFLOAT gaussrand(sp_randmt *p, SPFLOAT scale)
+int sp_gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring)
 {
-    int64_t r1 = -((int64_t)0xFFFFFFFFU * 6);
-    int n = 12;
-    SPFLOAT x;
-
-    do {
-      r1 += (int64_t)sp_randmt_compute(p);
-    } while (--n);
-
-    x = (SPFLOAT)r1;
-    return (SPFLOAT)(x * ((SPFLOAT)scale * (1.0 / (3.83 * 4294967295.03125))));
+    return ftbl_gen_cached(sp, ft, "xline", argstring, gen_xline);
 }
 
-int sp_gen_gauss(sp_data *sp, sp_ftbl *ft, SPFLOAT scale, uint32_t seed)
+static int gen_gauss(sp_data *sp, sp_ftbl *ft, const char *args)
 {
-    int n;
+    sp_prng prng;
+    double scale;
+    unsigned seed;
 
-    sp_randmt rand;
-
-    sp_randmt_seed(&rand, NULL, seed);
-
-    for(n = 0; n < ft->size; n++) {
-        ft->tbl[n] = gaussrand(&rand, scale);
-    }
+    sscanf(args, "%la %u", &scale, &seed);
+    sp_prng_seed(&prng, seed);
+    /* sum of 12 uniforms, scaled as the Csound gen21 gaussian */
+    sp_prng_gauss(&prng, ft->tbl, ft->size, (SPFLOAT)scale / 3.83);
 
     return SP_OK;
 }
+
+int sp_gen_gauss(sp_data *sp, sp_ftbl *ft, SPFLOAT scale, uint32_t seed)
+{
+    char args[64];
+    snprintf(args, sizeof(args), "%a %u", (double)scale, (unsigned)seed);
+    return ftbl_gen_cached(sp, ft, "gauss", args, gen_gauss);
+}
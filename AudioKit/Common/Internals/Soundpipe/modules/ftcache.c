@@ -0,0 +1,226 @@
+/*
+ * ftcache
+ *
+ * On-disk cache of generated tables. Each table lives in its own file,
+ * named after a 64-bit FNV-1a hash of its key: the generator, its
+ * arguments, the table size, the sample rate and sizeof(SPFLOAT). The
+ * file holds a header, the key itself (so a hash collision reads as a
+ * miss), and the size + 1 samples of the table at a 64 byte aligned
+ * offset. Hits are mapped copy-on-write, so the pages are shared between
+ * every process using the same table until one of them writes to it.
+ * Files are written under a temporary name and renamed into place, so
+ * concurrent writers never expose a partial table.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "soundpipe.h"
+
+#ifndef NO_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define FTCACHE_MAGIC "SPFT"
+#define FTCACHE_VERSION 1
+#define FTCACHE_ALIGN 64
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t floatsize;
+    uint32_t keylen;
+    uint64_t size;
+    uint64_t offset;
+} ftcache_header;
+
+int sp_ftbl_cache(sp_data *sp, const char *dir)
+{
+    free(sp->ftcache);
+    sp->ftcache = NULL;
+    if(dir == NULL) return SP_OK;
+#ifdef NO_MMAP
+    return SP_NOT_OK;
+#else
+    sp->ftcache = malloc(strlen(dir) + 1);
+    strcpy(sp->ftcache, dir);
+    return SP_OK;
+#endif
+}
+
+void sp_ftbl_release(sp_ftbl *ft)
+{
+#ifndef NO_MMAP
+    if(ft->map != NULL) {
+        munmap(ft->map, ft->maplen);
+        ft->map = NULL;
+        ft->maplen = 0;
+        ft->tbl = NULL;
+        return;
+    }
+#endif
+    sp_free(ft->tbl);
+    ft->tbl = NULL;
+}
+
+uint64_t sp_ftbl_cache_hash(const void *data, size_t len, uint64_t h)
+{
+    const unsigned char *c = data;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        h ^= c[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+#ifndef NO_MMAP
+
+/* key and file name of a table; the caller frees the key */
+static char *ftcache_key(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args, char *path, size_t pathlen)
+{
+    size_t len = strlen(gen) + strlen(args) + 64;
+    char *key = malloc(len);
+    uint64_t h;
+    snprintf(key, len, "%s\n%s\n%lu %d %u", gen, args,
+            (unsigned long)ft->size, sp->sr, (unsigned)sizeof(SPFLOAT));
+    h = sp_ftbl_cache_hash(key, strlen(key), 0xCBF29CE484222325ULL);
+    snprintf(path, pathlen, "%s/%016llx.spft", sp->ftcache,
+            (unsigned long long)h);
+    return key;
+}
+
+static int ftcache_zero(sp_ftbl *ft)
+{
+    size_t i;
+    for(i = 0; i < ft->size; i++) {
+        if(ft->tbl[i] != 0) return 0;
+    }
+    return 1;
+}
+
+int sp_ftbl_cache_lookup(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args, int *hit)
+{
+    char path[1024];
+    char *key;
+    ftcache_header *hd;
+    struct stat st;
+    size_t keylen, need;
+    void *map;
+    int fd;
+
+    *hit = 0;
+    /* generators that add to the table only go through the cache when
+     * it starts out empty */
+    if(sp->ftcache == NULL || ft->size == 0 || !ftcache_zero(ft)) {
+        return SP_NOT_OK;
+    }
+
+    key = ftcache_key(sp, ft, gen, args, path, sizeof(path));
+    keylen = strlen(key);
+    fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        free(key);
+        return SP_OK;
+    }
+    map = MAP_FAILED;
+    if(fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ftcache_header)) {
+        map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if(map == MAP_FAILED) {
+        free(key);
+        return SP_OK;
+    }
+
+    hd = map;
+    need = hd->offset + (ft->size + 1) * sizeof(SPFLOAT);
+    if(memcmp(hd->magic, FTCACHE_MAGIC, 4) != 0 ||
+            hd->version != FTCACHE_VERSION ||
+            hd->floatsize != sizeof(SPFLOAT) ||
+            hd->keylen != keylen || hd->size != ft->size ||
+            hd->offset < sizeof(ftcache_header) + keylen ||
+            hd->offset % FTCACHE_ALIGN != 0 ||
+            need > (size_t)st.st_size ||
+            memcmp((char *)map + sizeof(ftcache_header), key, keylen) != 0) {
+        munmap(map, st.st_size);
+        free(key);
+        return SP_OK;
+    }
+    free(key);
+
+    sp_ftbl_release(ft);
+    ft->tbl = (SPFLOAT *)((char *)map + hd->offset);
+    ft->map = map;
+    ft->maplen = st.st_size;
+    *hit = 1;
+    return SP_OK;
+}
+
+int sp_ftbl_cache_store(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args)
+{
+    char path[1024], tmp[1040];
+    char pad[FTCACHE_ALIGN];
+    char *key;
+    ftcache_header hd;
+    size_t keylen, datalen;
+    int fd, ok;
+
+    if(sp->ftcache == NULL) return SP_NOT_OK;
+
+    key = ftcache_key(sp, ft, gen, args, path, sizeof(path));
+    keylen = strlen(key);
+    memcpy(hd.magic, FTCACHE_MAGIC, 4);
+    hd.version = FTCACHE_VERSION;
+    hd.floatsize = sizeof(SPFLOAT);
+    hd.keylen = keylen;
+    hd.size = ft->size;
+    hd.offset = (sizeof(hd) + keylen + FTCACHE_ALIGN - 1) &
+        ~(uint64_t)(FTCACHE_ALIGN - 1);
+    datalen = (ft->size + 1) * sizeof(SPFLOAT);
+    memset(pad, 0, sizeof(pad));
+
+    snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path);
+    fd = mkstemp(tmp);
+    if(fd < 0) {
+        free(key);
+        return SP_NOT_OK;
+    }
+    ok = write(fd, &hd, sizeof(hd)) == (ssize_t)sizeof(hd) &&
+        write(fd, key, keylen) == (ssize_t)keylen &&
+        write(fd, pad, hd.offset - sizeof(hd) - keylen) ==
+            (ssize_t)(hd.offset - sizeof(hd) - keylen) &&
+        write(fd, ft->tbl, datalen) == (ssize_t)datalen;
+    fchmod(fd, 0644);
+    close(fd);
+    free(key);
+    if(!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return SP_NOT_OK;
+    }
+    return SP_OK;
+}
+
+#else
+
+int sp_ftbl_cache_lookup(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args, int *hit)
+{
+    *hit = 0;
+    return SP_NOT_OK;
+}
+
+int sp_ftbl_cache_store(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args)
+{
+    return SP_NOT_OK;
+}
+
+#endif
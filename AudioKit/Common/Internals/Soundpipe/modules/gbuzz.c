@@ -28,13 +28,13 @@ static SPFLOAT intpow1(SPFLOAT x, int32_t n)
 
 int sp_gbuzz_create(sp_gbuzz **p)
 {
-    *p = malloc(sizeof(sp_gbuzz));
+    *p = sp_malloc(sizeof(sp_gbuzz));
     return SP_OK;
 }
 
 int sp_gbuzz_destroy(sp_gbuzz **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -118,3 +118,12 @@ int sp_gbuzz_compute(sp_data *sp, sp_gbuzz *p, SPFLOAT *in, SPFLOAT *out)
     p->lphs = lphs;
     return SP_OK;
 }
+
+int sp_gbuzz_compute_block(sp_data *sp, sp_gbuzz *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_gbuzz_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -3,7 +3,7 @@
 
 int sp_in_create(sp_in **p)
 {
-    *p = malloc(sizeof(sp_in));
+    *p = sp_malloc(sizeof(sp_in));
     return SP_OK;
 }
 
@@ -11,7 +11,7 @@ int sp_in_destroy(sp_in **p)
 {
     sp_in *pp = *p;
     fclose(pp->fp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -27,3 +27,12 @@ int sp_in_compute(sp_data *sp, sp_in *p, SPFLOAT *in, SPFLOAT *out)
     fread(out, sizeof(SPFLOAT), 1, p->fp);
     return SP_OK;
 }
+
+int sp_in_compute_block(sp_data *sp, sp_in *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_in_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
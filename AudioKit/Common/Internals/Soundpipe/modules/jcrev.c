@@ -18,6 +18,8 @@
 #define FAUSTFLOAT SPFLOAT
 #endif
 
+#define SP_JCREV_CHUNK 64
+
 typedef struct {
 
 	float fVec5[4096];
@@ -44,12 +46,12 @@ typedef struct {
 } jcrev;
 
 jcrev* newjcrev() {
-	jcrev* dsp = (jcrev*)malloc(sizeof(jcrev));
+	jcrev* dsp = (jcrev*)sp_malloc(sizeof(jcrev));
 	return dsp;
 }
 
 void deletejcrev(jcrev* dsp) {
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitjcrev(jcrev* dsp, int samplingFreq) {
@@ -292,7 +294,7 @@ void computejcrev(jcrev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outpu
 
 int sp_jcrev_create(sp_jcrev **p)
 {
-    *p = malloc(sizeof(sp_jcrev));
+    *p = sp_malloc(sizeof(sp_jcrev));
     return SP_OK;
 }
 
@@ -301,7 +303,7 @@ int sp_jcrev_destroy(sp_jcrev **p)
     sp_jcrev *pp = *p;
     jcrev *dsp = pp->ud;
     deletejcrev(dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -325,3 +327,22 @@ int sp_jcrev_compute(sp_data *sp, sp_jcrev *p, SPFLOAT *in, SPFLOAT *out)
     *out = out1;
     return SP_OK;
 }
+
+int sp_jcrev_compute_block(sp_data *sp, sp_jcrev *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    jcrev *dsp = p->ud;
+    /* outputs 2-4 are discarded, so they are run in fixed-size chunks */
+    SPFLOAT out2[SP_JCREV_CHUNK], out3[SP_JCREV_CHUNK], out4[SP_JCREV_CHUNK];
+    SPFLOAT *faust_in[1];
+    SPFLOAT *faust_out[] = {NULL, out2, out3, out4};
+    uint32_t pos, len;
+
+    for(pos = 0; pos < n; pos += len) {
+        len = n - pos;
+        if(len > SP_JCREV_CHUNK) len = SP_JCREV_CHUNK;
+        faust_in[0] = (SPFLOAT *)&in[pos];
+        faust_out[0] = &out[pos];
+        computejcrev(dsp, len, faust_in, faust_out);
+    }
+    return SP_OK;
+}
@@ -15,29 +15,29 @@
 
 /* the randgabs are essentially magic incantations from Csound */
 
-static SPFLOAT sp_jitter_randgab(sp_data *sp) 
+static SPFLOAT sp_jitter_randgab(sp_prng *prng) 
 {
-    SPFLOAT out = (SPFLOAT) ((sp_rand(sp) >> 1) & 0x7fffffff) *
+    SPFLOAT out = (SPFLOAT) ((sp_prng_rand(prng) >> 1) & 0x7fffffff) *
     (4.656612875245796924105750827168e-10);
     return out;
 }
 
-static SPFLOAT sp_jitter_birandgab(sp_data *sp) 
+static SPFLOAT sp_jitter_birandgab(sp_prng *prng) 
 {
-    SPFLOAT out = (SPFLOAT) (sp_rand(sp) & 0x7fffffff) *
+    SPFLOAT out = (SPFLOAT) (sp_prng_rand(prng) & 0x7fffffff) *
     (4.656612875245796924105750827168e-10);
     return out;
 }
 
 int sp_jitter_create(sp_jitter **p)
 {
-    *p = malloc(sizeof(sp_jitter));
+    *p = sp_malloc(sizeof(sp_jitter));
     return SP_OK;
 }
 
 int sp_jitter_destroy(sp_jitter **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -46,7 +46,8 @@ int sp_jitter_init(sp_data *sp, sp_jitter *p)
     p->amp = 0.5;
     p->cpsMin = 0.5;
     p->cpsMax = 4; 
-    p->num2 = sp_jitter_birandgab(sp);
+    sp_prng_init(sp, &p->prng);
+    p->num2 = sp_jitter_birandgab(&p->prng);
     p->initflag = 1;
     p->phs=0;
     return SP_OK;
@@ -57,10 +58,10 @@ int sp_jitter_compute(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out)
     if (p->initflag) {
       p->initflag = 0;
       *out = p->num2 * p->amp;
-      p->cps = sp_jitter_randgab(sp) * (p->cpsMax - p->cpsMin) + p->cpsMin;
+      p->cps = sp_jitter_randgab(&p->prng) * (p->cpsMax - p->cpsMin) + p->cpsMin;
       p->phs &= SP_FT_PHMASK;
       p->num1 = p->num2;
-      p->num2 = sp_jitter_birandgab(sp);
+      p->num2 = sp_jitter_birandgab(&p->prng);
       p->dfdmax = 1.0 * (p->num2 - p->num1) / SP_FT_MAXLEN;
       return SP_OK;
     }
@@ -69,11 +70,20 @@ int sp_jitter_compute(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out)
     p->phs += (int32_t)(p->cps * (SPFLOAT)(SP_FT_MAXLEN / sp->sr));
 
     if (p->phs >= SP_FT_MAXLEN) {
-      p->cps   = sp_jitter_randgab(sp) * (p->cpsMax - p->cpsMin) + p->cpsMin;
+      p->cps   = sp_jitter_randgab(&p->prng) * (p->cpsMax - p->cpsMin) + p->cpsMin;
       p->phs   &= SP_FT_PHMASK;
       p->num1   = p->num2;
-      p->num2 =  sp_jitter_birandgab(sp);
+      p->num2 =  sp_jitter_birandgab(&p->prng);
       p->dfdmax = 1.0 * (p->num2 - p->num1) / SP_FT_MAXLEN;
     }
     return SP_OK;
 }
+
+int sp_jitter_compute_block(sp_data *sp, sp_jitter *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_jitter_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -3,13 +3,13 @@
 
 int sp_line_create(sp_line **p)
 {
-    *p = malloc(sizeof(sp_line));
+    *p = sp_malloc(sizeof(sp_line));
     return SP_OK;
 }
 
 int sp_line_destroy(sp_line **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -55,3 +55,12 @@ int sp_line_compute(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_line_compute_block(sp_data *sp, sp_line *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_line_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
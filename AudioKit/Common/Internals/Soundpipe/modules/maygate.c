@@ -3,13 +3,13 @@
 
 int sp_maygate_create(sp_maygate **p)
 {
-    *p = malloc(sizeof(sp_maygate));
+    *p = sp_malloc(sizeof(sp_maygate));
     return SP_OK;
 }
 
 int sp_maygate_destroy(sp_maygate **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -18,6 +18,7 @@ int sp_maygate_init(sp_data *sp, sp_maygate *p)
     p->prob = 0.0;
     p->gate = 0;
     p->mode = 0;
+    sp_prng_init(sp, &p->prng);
     return SP_OK;
 }
 
@@ -32,7 +33,7 @@ int sp_maygate_compute(sp_data *sp, sp_maygate *p, SPFLOAT *in, SPFLOAT *out)
         return SP_OK;
     }
 
-    if((1.0 * sp_rand(sp) / RAND_MAX) <= p->prob) {
+    if((1.0 * sp_prng_rand(&p->prng) / RAND_MAX) <= p->prob) {
         *out = 1;
         p->gate = 1;
     } else {
@@ -41,3 +42,12 @@ int sp_maygate_compute(sp_data *sp, sp_maygate *p, SPFLOAT *in, SPFLOAT *out)
     }
     return SP_OK;
 }
+
+int sp_maygate_compute_block(sp_data *sp, sp_maygate *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_maygate_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -15,13 +15,13 @@
 
 int sp_metro_create(sp_metro **p)
 {
-    *p = malloc(sizeof(sp_metro));
+    *p = sp_malloc(sizeof(sp_metro));
     return SP_OK;
 }
 
 int sp_metro_destroy(sp_metro **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -55,3 +55,12 @@ int sp_metro_compute(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out)
     p->curphs = phs;
     return SP_OK;
 }
+
+int sp_metro_compute_block(sp_data *sp, sp_metro *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_metro_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -8,19 +8,185 @@
  * Year: 2009
  * Location: OOps/pvlock.c
  *
+ * The per-bin phase vocoder math runs on structure-of-arrays spectra,
+ * padded to a multiple of 4 bins, and normalizes phases with a
+ * reciprocal square root instead of hypot(). Output frames are summed
+ * into a single overlap-add ring.
+ *
  */
 
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 #ifndef M_PI
-#define M_PI 3.14159265358979323846	
+#define M_PI 3.14159265358979323846
 #endif
 #include "soundpipe.h"
 
+/* x[i] = 1/sqrt(x[i]), n a multiple of 4. The SSE and NEON estimates are
+ * refined by Newton-Raphson to a relative error below 1e-6. */
+static void mincer_rsqrt(SPFLOAT *x, int n)
+{
+    int i;
+#if defined(__SSE__)
+    const __m128 half = _mm_set1_ps(0.5f), three = _mm_set1_ps(3.0f);
+    for(i = 0; i < n; i += 4) {
+        __m128 v = _mm_loadu_ps(x + i);
+        __m128 y = _mm_rsqrt_ps(v);
+        y = _mm_mul_ps(_mm_mul_ps(half, y),
+                _mm_sub_ps(three, _mm_mul_ps(v, _mm_mul_ps(y, y))));
+        _mm_storeu_ps(x + i, y);
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for(i = 0; i < n; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        float32x4_t y = vrsqrteq_f32(v);
+        y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+        y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+        vst1q_f32(x + i, y);
+    }
+#else
+    for(i = 0; i < n; i++) x[i] = 1.0f / sqrtf(x[i]);
+#endif
+}
+
+/* Phase locking on one hop. b and f are the back and front window spectra,
+ * prev the previous output spectrum, which is overwritten with the new one.
+ * The unit phase rotation taking f to the new output is left in tre/tim.
+ * All arrays hold n bins (a multiple of 4) and b has one zero bin on each
+ * side so the locking sum needs no edge cases. nyq is the Nyquist bin. */
+static void mincer_lock(SPFLOAT *bre, SPFLOAT *bim, const SPFLOAT *fre,
+        const SPFLOAT *fim, SPFLOAT *pre, SPFLOAT *pim, SPFLOAT *tre,
+        SPFLOAT *tim, SPFLOAT *mag, int n, int nyq, int lock)
+{
+    SPFLOAT pr, pi, r;
+    int k;
+
+    /* phases of previous output frame in exponential format, obtained
+     * by dividing by magnitude */
+    for(k = 0; k < n; k++) mag[k] = pre[k]*pre[k] + pim[k]*pim[k] + 1e-30f;
+    mincer_rsqrt(mag, n);
+
+    /* back window magnitudes, phase differences between prev and back
+     * windows */
+    for(k = 0; k < n; k++) {
+        pr = pre[k] * mag[k];
+        pi = pim[k] * mag[k];
+        r = bre[k] * pr + bim[k] * pi;
+        bim[k] = bre[k] * pi - bim[k] * pr;
+        bre[k] = r;
+    }
+
+    if(lock) {
+        for(k = 0; k < n; k++) {
+            tre[k] = bre[k - 1] + bre[k] + bre[k + 1];
+            tim[k] = bim[k - 1] + bim[k] + bim[k + 1];
+        }
+        tim[0] = tim[nyq] = 0;
+    } else {
+        for(k = 0; k < n; k++) {
+            tre[k] = bre[k];
+            tim[k] = bim[k];
+        }
+    }
+
+    for(k = 0; k < n; k++) {
+        tre[k] += 1e-15f;
+        mag[k] = tre[k]*tre[k] + tim[k]*tim[k];
+    }
+    mincer_rsqrt(mag, n);
+
+    /* front window mags, phase sum of tmp and front windows */
+    for(k = 0; k < n; k++) {
+        pr = tre[k] = tre[k] * mag[k];
+        pi = tim[k] = tim[k] * mag[k];
+        pre[k] = fre[k] * pr - fim[k] * pi;
+        pim[k] = fre[k] * pi + fim[k] * pr;
+    }
+}
+
+/* splits a packed real FFT (Nyquist in buf[1]) into re/im arrays, or adds
+ * it to them */
+static void mincer_unpack(const SPFLOAT *buf, SPFLOAT *re, SPFLOAT *im, int N,
+        int add)
+{
+    int k;
+    if(!add) {
+        re[0] = buf[0];
+        im[0] = 0;
+        for(k = 1; k < N/2; k++) {
+            re[k] = buf[2*k];
+            im[k] = buf[2*k + 1];
+        }
+        re[N/2] = buf[1];
+        im[N/2] = 0;
+    } else {
+        re[0] += buf[0];
+        for(k = 1; k < N/2; k++) {
+            re[k] += buf[2*k];
+            im[k] += buf[2*k + 1];
+        }
+        re[N/2] += buf[1];
+    }
+}
+
+/* rotates the bins of a packed real FFT by the unit phasors ur/ui */
+static void mincer_rotate(SPFLOAT *buf, const SPFLOAT *ur, const SPFLOAT *ui,
+        int N)
+{
+    SPFLOAT r;
+    int k;
+    buf[0] *= ur[0];
+    buf[1] *= ur[N/2];
+    for(k = 1; k < N/2; k++) {
+        r = buf[2*k] * ur[k] - buf[2*k + 1] * ui[k];
+        buf[2*k + 1] = buf[2*k] * ui[k] + buf[2*k + 1] * ur[k];
+        buf[2*k] = r;
+    }
+}
+
+/* Fills dst with N windowed table samples of channel chan, or the sum of
+ * all channels when chan < 0, read from pos - offset at a rate of pitch
+ * and linearly interpolated. The interpolation weight is taken from pos,
+ * so the back window reuses the front window's, as in the Csound code. */
+static void mincer_fill(sp_mincer *p, SPFLOAT *dst, SPFLOAT pos,
+        SPFLOAT offset, SPFLOAT pitch, int chan)
+{
+    const SPFLOAT *tab = p->ft->tbl, *t;
+    const SPFLOAT *win = (SPFLOAT *) p->win.ptr;
+    int N = p->N, size = p->tlen, ts = p->tstride;
+    int c0 = chan < 0 ? 0 : chan, c1 = chan < 0 ? p->nchan : chan + 1;
+    int post, c, i;
+    SPFLOAT frac, insig;
+
+    for (i = 0; i < N; i++) {
+        post = (int) (pos - offset);
+        frac = pos - (int) pos;
+        while(post < 0) post += size;
+        while(post >= size) post -= size;
+        insig = 0;
+        for (c = c0; c < c1; c++) {
+            t = tab + c*p->coff;
+            if(post + 1 < size)
+            insig += t[post*ts] + frac*(t[(post + 1)*ts] - t[post*ts]);
+            else insig += t[post*ts];
+        }
+        /* window it */
+        dst[i] = insig * win[i];
+        /* increment read pos according to pitch transposition */
+        pos += pitch;
+    }
+}
+
 int sp_mincer_create(sp_mincer **p)
 {
-    *p = malloc(sizeof(sp_mincer));
+    *p = sp_malloc(sizeof(sp_mincer));
     return SP_OK;
 }
 
@@ -31,51 +197,59 @@ int sp_mincer_destroy(sp_mincer **p)
     sp_auxdata_free(&pp->fwin);
     sp_auxdata_free(&pp->bwin);
     sp_auxdata_free(&pp->prev);
-    sp_auxdata_free(&pp->framecount);
+    sp_auxdata_free(&pp->spec);
     sp_auxdata_free(&pp->outframe);
     sp_auxdata_free(&pp->win);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
-int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft)
+int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int winsize, int decim)
 {
+    return sp_mincer_initn(sp, p, ft, 1, 0, winsize, decim);
+}
+
+int sp_mincer_initn(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int nchan,
+        int planar, int winsize, int decim)
+{
+    int N = winsize, ui, M, nbins;
+    unsigned int size;
+
+    if (decim == 0) decim = 4;
+    for (M = 0; (1 << M) < N; M++);
+    if (N < 16 || (1 << M) != N || decim < 1 || N % decim) return SP_NOT_OK;
+    if (nchan < 1 || ft->size / nchan < 2) return SP_NOT_OK;
+
+    p->nchan = nchan;
+    p->tlen = ft->size / nchan;
+    p->tstride = planar ? 1 : nchan;
+    p->coff = planar ? p->tlen : 1;
     p->ft = ft;
-    p->idecim = 4;
-    p->iN = 2048;
+    p->idecim = decim;
+    p->iN = N;
     p->lock = 1;
     p->pitch = 1;
     p->amp = 1;
     p->time = 0;
-    int N =  p->iN, ui;
-    unsigned int size;
-    int decim = p->idecim;
 
-    /* 2^11 = 2048, the default fftsize, will probably not change */
-    sp_fft_init(&p->fft, 11);
-
-    if (decim == 0) decim = 4;
+    sp_fft_init(&p->fft, M);
 
     p->hsize = N/decim;
     p->cnt = p->hsize;
-    p->curframe = 0;
+    p->olapos = 0;
     p->pos = 0;
 
+    /* N/2 + 1 bins, rounded up to a multiple of 4 */
+    nbins = (N/2 + 4) & ~3;
+
     size = (N+2)*sizeof(SPFLOAT);
-    sp_auxdata_alloc(&p->fwin, size);
+    sp_auxdata_alloc(&p->fwin, nchan*size);
     sp_auxdata_alloc(&p->bwin, size);
-    sp_auxdata_alloc(&p->prev, size);
-    size = decim*sizeof(int);
-    sp_auxdata_alloc(&p->framecount, size);
-    {
-      int k=0;
-        for (k=0; k < decim; k++) {
-            ((int *)(p->framecount.ptr))[k] = k*N;
-        }
-    }
-    size = decim*sizeof(SPFLOAT)*N;
-    sp_auxdata_alloc(&p->outframe, size);
-    
+    sp_auxdata_alloc(&p->prev, 2*nbins*sizeof(SPFLOAT));
+    /* back re/im with a guard bin each side, front re/im, lock re/im, mags */
+    sp_auxdata_alloc(&p->spec, (7*nbins + 4)*sizeof(SPFLOAT));
+    sp_auxdata_alloc(&p->outframe, nchan*N*sizeof(SPFLOAT));
+
     size = N*sizeof(SPFLOAT);
     sp_auxdata_alloc(&p->win, size);
     {
@@ -90,162 +264,118 @@ int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft)
     return SP_OK;
 }
 
-int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
+static void mincer_hop(sp_data *sp, sp_mincer *p)
 {
-    SPFLOAT pitch = p->pitch, time = p->time, lock = p->lock, amp =p->amp;
-    SPFLOAT *tab, frac;
-    sp_ftbl *ft = p->ft;
-    int N = p->N, hsize = p->hsize, cnt = p->cnt;
-    int sizefrs, size, post, i;
-    long spos = p->pos;
-    SPFLOAT pos;
-    SPFLOAT *fwin, *bwin, insig = 0,
-    *prev, *win = (SPFLOAT *) p->win.ptr;
+    SPFLOAT pitch = p->pitch, time = p->time;
+    int N = p->N, hsize = p->hsize, mask = p->N - 1;
+    int nbins = (N/2 + 4) & ~3;
+    int sizefrs, i, c, len;
+    long spos;
+    SPFLOAT *fwin;
+    SPFLOAT *bwin = (SPFLOAT *) p->bwin.ptr;
+    SPFLOAT *win = (SPFLOAT *) p->win.ptr;
     SPFLOAT *outframe;
-    SPFLOAT ph_real, ph_im, tmp_real, tmp_im, divi;
-    int *framecnt;
-    int curframe = p->curframe, decim = p->decim;
-    SPFLOAT scaling = (8./decim)/3.;
-
-    if (cnt == hsize) {
-        tab = ft->tbl;
-        size = (int)ft->size;
-
-        /* spos is the reading position in samples, hsize is hopsize,
-        time[n] is current read position in secs
-        esr is sampling rate
-        */
-        spos  = hsize*(long)((time)*sp->sr/hsize);
-        sizefrs = size;
-        while(spos > sizefrs) spos -= sizefrs;
-        while(spos <= 0)  spos += sizefrs;
-
-
-        pos = spos;
-        bwin = (SPFLOAT *) p->bwin.ptr;
-        fwin = (SPFLOAT *) p->fwin.ptr;
-        prev = (SPFLOAT *)p->prev.ptr;
-        framecnt  = (int *)p->framecount.ptr;
-        outframe= (SPFLOAT *) p->outframe.ptr;
-        /* this loop fills two frames/windows with samples from table,
-        reading is linearly-interpolated,
-        frames are separated by 1 hopsize
-        */
-        for (i=0; i < N; i++) {
-            /* front window, fwin */
-            post = (int) pos;
-            frac = pos  - post;
-            while (post < 0) post += size;
-            while (post >= size) post -= size;
-            if(post + 1 <  size)
-            insig = tab[post] + frac*(tab[post+ 1] - tab[post]);
-            else insig = tab[post];
-
-            /* window it */
-            fwin[i] = insig * win[i]; 
-            /* back windo, bwin */
-            post = (int) (pos - hsize*pitch);
-            post *= 1;
-            post += 0;
-            while(post < 0) post += size;
-            while(post >= size) post -= size;
-            if(post + 1<  size)
-            insig = tab[post] + frac*(tab[post + 1] - tab[post]);
-            else insig = tab[post];
-            bwin[i] = insig * win[i];  /* window it */
-            /* increment read pos according to pitch transposition */
-            pos += pitch;
-        }
+    SPFLOAT *pre = (SPFLOAT *) p->prev.ptr, *pim = pre + nbins;
+    SPFLOAT *bre = (SPFLOAT *) p->spec.ptr + 1, *bim = bre + nbins + 2;
+    SPFLOAT *fre = bim + nbins + 1, *fim = fre + nbins;
+    SPFLOAT *tre = fim + nbins, *tim = tre + nbins, *mag = tim + nbins;
+    int olapos = p->olapos;
+
+    /* spos is the reading position in samples, hsize is hopsize,
+    time[n] is current read position in secs
+    esr is sampling rate
+    */
+    spos  = hsize*(long)((time)*sp->sr/hsize);
+    sizefrs = p->tlen;
+    while(spos > sizefrs) spos -= sizefrs;
+    while(spos <= 0)  spos += sizefrs;
 
-        /* take the FFT of both frames
-        re-order Nyquist bin from pos 1 to N
-        */
-        sp_fftr(&p->fft, bwin, N);
-        bwin[N] = bwin[1];
-        bwin[N+1] = 0.0;
+    /* fill two frames/windows from the table, separated by 1 hopsize:
+    the back window of the channel sum, and a front window per channel.
+    Take their FFTs; the front spectra are summed as the reference.
+    */
+    mincer_fill(p, bwin, spos, hsize*pitch, pitch, -1);
+    sp_fftr(&p->fft, bwin, N);
+    mincer_unpack(bwin, bre, bim, N, 0);
+    for (c = 0; c < p->nchan; c++) {
+        fwin = (SPFLOAT *) p->fwin.ptr + c*(N + 2);
+        mincer_fill(p, fwin, spos, 0, pitch, c);
         sp_fftr(&p->fft, fwin, N);
-        fwin[N] = fwin[1];
-        fwin[N+1] = 0.0;
-
-        /* phase vocoder processing */
-
-        for (i=0; i < N + 2; i+=2) {
-            /* phases of previous output frame in exponential format,
-            obtained by dividing by magnitude */
-            divi =  1.0/(hypot(prev[i], prev[i+1]) + 1e-20);
-            ph_real  =    prev[i]*divi;
-            ph_im =       prev[i+1]*divi;
-
-            /* back window magnitudes, phase differences between
-            prev and back windows */
-            tmp_real =   bwin[i] * ph_real + bwin[i+1] * ph_im;
-            tmp_im =   bwin[i] * ph_im - bwin[i+1] * ph_real;
-            bwin[i] = tmp_real;
-            bwin[i+1] = tmp_im;
-        }
+        mincer_unpack(fwin, fre, fim, N, c > 0);
+    }
 
-        for (i=0; i < N + 2; i+=2) {
-            if (lock) {  /* phase-locking */
-                if (i > 0) {
-                    if (i < N){
-                        tmp_real = bwin[i] + bwin[i-2] + bwin[i+2];
-                        tmp_im = bwin[i+1] + bwin[i-1] + bwin[i+3];
-                    } else { /* Nyquist */
-                        tmp_real = bwin[i] + bwin[i-2];
-                        tmp_im = 0.0;
-                    } 
-                } else { /* 0 Hz */
-                    tmp_real = bwin[i] + bwin[i+2];
-                    tmp_im = 0.0;
-                }
-            } else { /* no locking */
-                tmp_real = bwin[i];
-                tmp_im = bwin[i+1];
-            }
+    /* phase vocoder processing */
+    mincer_lock(bre, bim, fre, fim, pre, pim, tre, tim, mag, nbins, N/2,
+            p->lock != 0);
 
-            tmp_real += 1e-15;
-            divi =  1.0/(hypot(tmp_real, tmp_im));
+    for (c = 0; c < p->nchan; c++) {
+        fwin = (SPFLOAT *) p->fwin.ptr + c*(N + 2);
+        outframe = (SPFLOAT *) p->outframe.ptr + c*N;
+        /* apply the reference's phases and take inverse FFT */
+        mincer_rotate(fwin, tre, tim, N);
+        sp_ifftr(&p->fft, fwin, N);
 
-            /* phases of tmp frame */
-            ph_real = tmp_real*divi;
-            ph_im = tmp_im*divi;
+        /* overlap-add into the output ring, starting at the read position */
+        len = N - olapos;
+        for (i = 0; i < len; i++) outframe[olapos + i] += win[i]*fwin[i];
+        for (; i < N; i++) outframe[(olapos + i) & mask] += win[i]*fwin[i];
+    }
+}
 
-            /* front window mags, phase sum of
-            tmp and front windows */
-            tmp_real =   fwin[i] * ph_real - fwin[i+1] * ph_im;
-            tmp_im =   fwin[i] * ph_im + fwin[i+1] * ph_real;
+int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
+{
+    SPFLOAT *outframe = (SPFLOAT *) p->outframe.ptr;
+    SPFLOAT scaling = (8./p->decim)/3.;
+    int c;
 
-            /* phase vocoder output */
-            prev[i] = fwin[i] = tmp_real;
-            prev[i+1] = fwin[i+1] = tmp_im;
-        }
-        /* re-order bins and take inverse FFT */
-        fwin[1] = fwin[N];
-        sp_ifftr(&p->fft, fwin, N);
-        /* frame counter */
-        framecnt[curframe] = curframe*N;
-        /* write to overlapped output frames */
-        for (i=0;i<N;i++) outframe[framecnt[curframe]+i] = win[i]*fwin[i];
-
-        cnt=0;
-        curframe++;
-        if (curframe == decim) curframe = 0;
+    if (p->cnt == p->hsize) {
+        mincer_hop(sp, p);
+        p->cnt = 0;
     }
 
-    framecnt  = (int *) p->framecount.ptr;
-    outframe  = (SPFLOAT *) p->outframe.ptr;
-    *out = (SPFLOAT)0;
-    /* write output */
-    for (i = 0; i < decim; i++) {
-        *out += outframe[framecnt[i]];
-        framecnt[i]++;
+    /* read and clear one sample of each ring, scale output */
+    for (c = 0; c < p->nchan; c++) {
+        out[c] = outframe[c*p->N + p->olapos] * p->amp * scaling;
+        outframe[c*p->N + p->olapos] = 0;
     }
-    /* scale output */
-    *out *= amp*scaling;
-    cnt++;
+    p->olapos = (p->olapos + 1) & (p->N - 1);
+    p->cnt++;
 
-    p->cnt = cnt;
-    p->curframe = curframe;
+    return SP_OK;
+}
 
+int sp_mincer_compute_block(sp_data *sp, sp_mincer *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    if (p->nchan != 1) return SP_NOT_OK;
+    return sp_mincer_compute_blockn(sp, p, in, &out, n);
+}
+
+int sp_mincer_compute_blockn(sp_data *sp, sp_mincer *p, const SPFLOAT *in, SPFLOAT **out, uint32_t n)
+{
+    SPFLOAT *ring;
+    SPFLOAT gain = p->amp * (SPFLOAT)((8./p->decim)/3.);
+    uint32_t i = 0, j, len;
+    int mask = p->N - 1, c;
+
+    while(i < n) {
+        if (p->cnt == p->hsize) {
+            mincer_hop(sp, p);
+            p->cnt = 0;
+        }
+        /* run up to the next hop or the end of the rings */
+        len = p->hsize - p->cnt;
+        if (len > n - i) len = n - i;
+        if (len > (uint32_t)(p->N - p->olapos)) len = p->N - p->olapos;
+        for (c = 0; c < p->nchan; c++) {
+            ring = (SPFLOAT *) p->outframe.ptr + c*p->N + p->olapos;
+            for (j = 0; j < len; j++) {
+                out[c][i + j] = ring[j] * gain;
+                ring[j] = 0;
+            }
+        }
+        p->olapos = (p->olapos + len) & mask;
+        p->cnt += len;
+        i += len;
+    }
     return SP_OK;
 }
@@ -23,13 +23,13 @@
 
 int sp_mode_create(sp_mode **p)
 {
-    *p = malloc(sizeof(sp_mode));
+    *p = sp_malloc(sizeof(sp_mode));
     return SP_OK;
 }
 
 int sp_mode_destroy(sp_mode **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -49,11 +49,17 @@ int sp_mode_init(sp_data *sp, sp_mode *p)
 }
 
 int sp_mode_compute(sp_data *sp, sp_mode *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_mode_compute_block(sp, p, in, out, 1);
+}
+
+int sp_mode_compute_block(sp_data *sp, sp_mode *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT lfq = p->lfq, lq = p->lq;
 
     SPFLOAT xn, yn, a0=p->a0, a1=p->a1, a2=p->a2,d=p->d;
     SPFLOAT xnm1 = p->xnm1, ynm1 = p->ynm1, ynm2 = p->ynm2;
+    uint32_t i;
 
     SPFLOAT kfq = p->freq;
     SPFLOAT kq  = p->q;
@@ -68,17 +74,20 @@ int sp_mode_compute(sp_data *sp, sp_mode *p, SPFLOAT *in, SPFLOAT *out)
         a1     = a0 * (1.0-2.0*kbeta);
         a2     = a0 * (kbeta-d/kq);
      }
-     xn = *in;
 
-     yn = a0*xnm1 - a1*ynm1 - a2*ynm2;
+    for(i = 0; i < n; i++) {
+        xn = in[i];
+
+        yn = a0*xnm1 - a1*ynm1 - a2*ynm2;
 
-     xnm1 = xn;
-     ynm2 = ynm1;
-     ynm1 = yn;
+        xnm1 = xn;
+        ynm2 = ynm1;
+        ynm1 = yn;
 
-     yn = yn*d;
+        yn = yn*d;
 
-     *out  = yn;
+        out[i]  = yn;
+    }
 
     p->xnm1 = xnm1;  p->ynm1 = ynm1;  p->ynm2 = ynm2;
     p->lfq = lfq;    p->lq = lq;      p->d = d;
@@ -0,0 +1,219 @@
+/*
+ * Moogbank
+ *
+ * A bank of independent moogladder filters, one per channel, sharing one
+ * cutoff and resonance. The ladder state is kept in structure-of-arrays
+ * form and SP_MOOGBANK_LANES channels are run side by side so the stages
+ * vectorize.
+ *
+ * The ladder runs 10 tanh() calls per sample. tanh_mode selects how they
+ * are evaluated. Errors are the maximum over all x, measured against
+ * double precision tanh():
+ *
+ * SP_MOOGBANK_TANH_LIBM     libm tanh(). Matches sp_moogladder exactly.
+ * SP_MOOGBANK_TANH_LAMBERT  7/6 Lambert continued fraction, clamped to
+ *                           +-1. Absolute error < 1e-4 (near |x| = 5),
+ *                           relative error < 3e-7 for |x| < 0.5.
+ * SP_MOOGBANK_TANH_PADE     x(27 + x^2)/(27 + 9x^2), x clamped to +-3.
+ *                           Absolute error < 2.4e-2 (near |x| = 1.6).
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef SP_MOOGBANK_LANES
+#ifdef __AVX__
+#define SP_MOOGBANK_LANES 8
+#else
+#define SP_MOOGBANK_LANES 4
+#endif
+#endif
+
+#define THERMAL (0.000025) /* (1.0 / 40000.0) transistor thermal voltage  */
+
+static inline SPFLOAT tanh_lambert(SPFLOAT x)
+{
+    SPFLOAT x2 = x * x;
+    SPFLOAT y = x * (135135 + x2 * (17325 + x2 * (378 + x2))) /
+        (135135 + x2 * (62370 + x2 * (3150 + 28 * x2)));
+    y = y > 1 ? 1 : y;
+    return y < -1 ? -1 : y;
+}
+
+static inline SPFLOAT tanh_pade(SPFLOAT x)
+{
+    x = x > 3 ? 3 : x;
+    x = x < -3 ? -3 : x;
+    return x * (27 + x * x) / (27 + 9 * x * x);
+}
+
+/* One group of SP_MOOGBANK_LANES channels starting at channel g, per tanh
+ * flavor. in and out point at the group's first channel. REAL is the type
+ * the stages are summed in; the libm version uses double, as sp_moogladder
+ * does. */
+#define MOOGBANK_GROUP(NAME, TANH, ARG, REAL) \
+static void NAME(sp_moogbank *p, uint32_t g, uint32_t nused, \
+        SPFLOAT res4, SPFLOAT tune, const SPFLOAT **in, SPFLOAT **out, uint32_t n) \
+{ \
+    SPFLOAT d0[SP_MOOGBANK_LANES], d1[SP_MOOGBANK_LANES], d2[SP_MOOGBANK_LANES]; \
+    SPFLOAT d3[SP_MOOGBANK_LANES], d4[SP_MOOGBANK_LANES], d5[SP_MOOGBANK_LANES]; \
+    SPFLOAT t0[SP_MOOGBANK_LANES], t1[SP_MOOGBANK_LANES], t2[SP_MOOGBANK_LANES]; \
+    SPFLOAT x[SP_MOOGBANK_LANES]; \
+    SPFLOAT input, s0, s1, s2, s3; \
+    uint32_t i, l; \
+    int j; \
+    for(l = 0; l < SP_MOOGBANK_LANES; l++) { \
+        x[l] = 0; \
+        d0[l] = p->delay[0][g + l]; d1[l] = p->delay[1][g + l]; \
+        d2[l] = p->delay[2][g + l]; d3[l] = p->delay[3][g + l]; \
+        d4[l] = p->delay[4][g + l]; d5[l] = p->delay[5][g + l]; \
+        t0[l] = p->tanhstg[0][g + l]; t1[l] = p->tanhstg[1][g + l]; \
+        t2[l] = p->tanhstg[2][g + l]; \
+    } \
+    for(i = 0; i < n; i++) { \
+        for(l = 0; l < nused; l++) x[l] = in[l][i]; \
+        /* oversampling  */ \
+        for(j = 0; j < 2; j++) { \
+            for(l = 0; l < SP_MOOGBANK_LANES; l++) { \
+                input = x[l] - res4 * d5[l]; \
+                d0[l] = s0 = d0[l] + tune*(TANH(input*ARG) - t0[l]); \
+                t0[l] = TANH(s0*ARG); \
+                d1[l] = s1 = d1[l] + tune*((REAL)t0[l] - t1[l]); \
+                t1[l] = TANH(s1*ARG); \
+                d2[l] = s2 = d2[l] + tune*((REAL)t1[l] - t2[l]); \
+                t2[l] = TANH(s2*ARG); \
+                s3 = d3[l] + tune*(t2[l] - TANH(d3[l]*ARG)); \
+                d3[l] = s3; \
+                /* 1/2-sample delay for phase compensation  */ \
+                d5[l] = (s3 + d4[l])*0.5; \
+                d4[l] = s3; \
+            } \
+        } \
+        for(l = 0; l < nused; l++) out[l][i] = d5[l]; \
+    } \
+    for(l = 0; l < SP_MOOGBANK_LANES; l++) { \
+        p->delay[0][g + l] = d0[l]; p->delay[1][g + l] = d1[l]; \
+        p->delay[2][g + l] = d2[l]; p->delay[3][g + l] = d3[l]; \
+        p->delay[4][g + l] = d4[l]; p->delay[5][g + l] = d5[l]; \
+        p->tanhstg[0][g + l] = t0[l]; p->tanhstg[1][g + l] = t1[l]; \
+        p->tanhstg[2][g + l] = t2[l]; \
+    } \
+}
+
+MOOGBANK_GROUP(moogbank_group_libm, tanh, THERMAL, double)
+MOOGBANK_GROUP(moogbank_group_lambert, tanh_lambert, (SPFLOAT)THERMAL, SPFLOAT)
+MOOGBANK_GROUP(moogbank_group_pade, tanh_pade, (SPFLOAT)THERMAL, SPFLOAT)
+
+int sp_moogbank_create(sp_moogbank **p)
+{
+    *p = sp_malloc(sizeof(sp_moogbank));
+    return SP_OK;
+}
+
+int sp_moogbank_destroy(sp_moogbank **p)
+{
+    sp_moogbank *pp = *p;
+    sp_auxdata_free(&pp->aux);
+    sp_free(*p);
+    return SP_OK;
+}
+
+int sp_moogbank_init(sp_data *sp, sp_moogbank *p, uint32_t nchan)
+{
+    uint32_t nlanes;
+    SPFLOAT *buf;
+    int k;
+
+    if(nchan == 0) return SP_NOT_OK;
+
+    p->freq = 1000;
+    p->res = 0.4;
+    p->tanh_mode = SP_MOOGBANK_TANH_LIBM;
+    p->oldfreq = 0.0;
+    p->oldres = -1.0;     /* ensure calculation on first cycle */
+
+    nlanes = (nchan + SP_MOOGBANK_LANES - 1) / SP_MOOGBANK_LANES;
+    nlanes *= SP_MOOGBANK_LANES;
+    p->nchan = nchan;
+    p->nlanes = nlanes;
+
+    sp_auxdata_alloc(&p->aux, 9 * nlanes * sizeof(SPFLOAT));
+    buf = p->aux.ptr;
+    for(k = 0; k < 6; k++) p->delay[k] = buf + k * nlanes;
+    for(k = 0; k < 3; k++) p->tanhstg[k] = buf + (6 + k) * nlanes;
+
+    return SP_OK;
+}
+
+int sp_moogbank_clear(sp_moogbank *p)
+{
+    uint32_t i;
+    SPFLOAT *buf = p->aux.ptr;
+    for(i = 0; i < 9 * p->nlanes; i++) buf[i] = 0;
+    return SP_OK;
+}
+
+static void moogbank_run(sp_data *sp, sp_moogbank *p, uint32_t g, uint32_t nused,
+        const SPFLOAT **in, SPFLOAT **out, uint32_t n)
+{
+    SPFLOAT res4 = 4.0*(SPFLOAT)p->oldres*p->oldacr;
+    switch(p->tanh_mode) {
+        case SP_MOOGBANK_TANH_LAMBERT:
+            moogbank_group_lambert(p, g, nused, res4, p->oldtune, in, out, n);
+            break;
+        case SP_MOOGBANK_TANH_PADE:
+            moogbank_group_pade(p, g, nused, res4, p->oldtune, in, out, n);
+            break;
+        default:
+            moogbank_group_libm(p, g, nused, res4, p->oldtune, in, out, n);
+    }
+}
+
+static void moogbank_update(sp_data *sp, sp_moogbank *p)
+{
+    SPFLOAT freq = p->freq;
+    SPFLOAT res = p->res;
+
+    if (res < 0) res = 0;
+
+    if (p->oldfreq != freq || p->oldres != res) {
+        p->oldfreq = freq;
+        p->oldres = res;
+        sp_moogladder_tune(sp, freq, &p->oldacr, &p->oldtune);
+    }
+}
+
+int sp_moogbank_compute(sp_data *sp, sp_moogbank *p, SPFLOAT *in, SPFLOAT *out)
+{
+    const SPFLOAT *inp[SP_MOOGBANK_LANES];
+    SPFLOAT *outp[SP_MOOGBANK_LANES];
+    uint32_t g, l, nused;
+
+    moogbank_update(sp, p);
+    for(g = 0; g < p->nchan; g += SP_MOOGBANK_LANES) {
+        nused = p->nchan - g;
+        if(nused > SP_MOOGBANK_LANES) nused = SP_MOOGBANK_LANES;
+        for(l = 0; l < nused; l++) {
+            inp[l] = &in[g + l];
+            outp[l] = &out[g + l];
+        }
+        moogbank_run(sp, p, g, nused, inp, outp, 1);
+    }
+    return SP_OK;
+}
+
+int sp_moogbank_compute_block(sp_data *sp, sp_moogbank *p, const SPFLOAT **in, SPFLOAT **out, uint32_t n)
+{
+    uint32_t g, nused;
+
+    moogbank_update(sp, p);
+    for(g = 0; g < p->nchan; g += SP_MOOGBANK_LANES) {
+        nused = p->nchan - g;
+        if(nused > SP_MOOGBANK_LANES) nused = SP_MOOGBANK_LANES;
+        moogbank_run(sp, p, g, nused, in + g, out + g, n);
+    }
+    return SP_OK;
+}
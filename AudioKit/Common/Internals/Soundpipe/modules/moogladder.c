@@ -20,13 +20,14 @@
 #endif
 
 #define SPFLOAT2LONG(x) lrintf(x)
+#define THERMAL (0.000025) /* (1.0 / 40000.0) transistor thermal voltage  */
 
 int sp_moogladder_create(sp_moogladder **t){
-    *t = malloc(sizeof(sp_moogladder));
+    *t = sp_malloc(sizeof(sp_moogladder));
     return SP_OK;
 }
 int sp_moogladder_destroy(sp_moogladder **t){
-    free(*t);
+    sp_free(*t);
     return SP_OK;
 }
 int sp_moogladder_init(sp_data *sp, sp_moogladder *p){
@@ -46,57 +47,72 @@ int sp_moogladder_init(sp_data *sp, sp_moogladder *p){
     return SP_OK;
 }
 
+int sp_moogladder_tune(sp_data *sp, SPFLOAT freq, SPFLOAT *acr, SPFLOAT *tune)
+{
+    SPFLOAT f, fc, fc2, fc3, fcr;
+    /* sr is half the actual filter sampling rate  */
+    fc =  (SPFLOAT)(freq/sp->sr);
+    f  =  0.5*fc;
+    fc2 = fc*fc;
+    fc3 = fc2*fc;
+    /* frequency & amplitude correction  */
+    fcr = 1.8730*fc3 + 0.4955*fc2 - 0.6490*fc + 0.9988;
+    *acr = -3.9364*fc2 + 1.8409*fc + 0.9968;
+    *tune = (1.0 - exp(-((2 * M_PI)*f*fcr))) / THERMAL;   /* filter tuning  */
+    return SP_OK;
+}
+
 int sp_moogladder_compute(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *out){
+    return sp_moogladder_compute_block(sp, p, in, out, 1);
+}
+
+int sp_moogladder_compute_block(sp_data *sp, sp_moogladder *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n){
     SPFLOAT freq = p->freq;
     SPFLOAT res = p->res;
     SPFLOAT res4;
-    SPFLOAT *delay = p->delay;
-    SPFLOAT *tanhstg = p->tanhstg;
+    SPFLOAT delay[6];
+    SPFLOAT tanhstg[3];
     SPFLOAT stg[4], input;
     SPFLOAT acr, tune;
-#define THERMAL (0.000025) /* (1.0 / 40000.0) transistor thermal voltage  */
     int     j, k;
+    uint32_t i;
 
     if (res < 0) res = 0;
 
     if (p->oldfreq != freq || p->oldres != res) {
-        SPFLOAT f, fc, fc2, fc3, fcr;
         p->oldfreq = freq;
-        /* sr is half the actual filter sampling rate  */
-        fc =  (SPFLOAT)(freq/sp->sr);
-        f  =  0.5*fc;
-        fc2 = fc*fc;
-        fc3 = fc2*fc;
-        /* frequency & amplitude correction  */
-        fcr = 1.8730*fc3 + 0.4955*fc2 - 0.6490*fc + 0.9988;
-        acr = -3.9364*fc2 + 1.8409*fc + 0.9968;
-        tune = (1.0 - exp(-((2 * M_PI)*f*fcr))) / THERMAL;   /* filter tuning  */
         p->oldres = res;
-        p->oldacr = acr;
-        p->oldtune = tune;
-    } else {
-        res = p->oldres;
-        acr = p->oldacr;
-        tune = p->oldtune;
+        sp_moogladder_tune(sp, freq, &p->oldacr, &p->oldtune);
     }
+    res = p->oldres;
+    acr = p->oldacr;
+    tune = p->oldtune;
     res4 = 4.0*(SPFLOAT)res*acr;
 
-    /* oversampling  */
-    for (j = 0; j < 2; j++) {
-        /* filter stages  */
-        input = *in - res4 /*4.0*res*acr*/ *delay[5];
-        delay[0] = stg[0] = delay[0] + tune*(tanh(input*THERMAL) - tanhstg[0]);
-        for (k = 1; k < 4; k++) {
-          input = stg[k-1];
-          stg[k] = delay[k]
-            + tune*((tanhstg[k-1] = tanh(input*THERMAL))
-                    - (k != 3 ? tanhstg[k] : tanh(delay[k]*THERMAL)));
-          delay[k] = stg[k];
+    for (k = 0; k < 6; k++) delay[k] = p->delay[k];
+    for (k = 0; k < 3; k++) tanhstg[k] = p->tanhstg[k];
+
+    for (i = 0; i < n; i++) {
+        /* oversampling  */
+        for (j = 0; j < 2; j++) {
+            /* filter stages  */
+            input = in[i] - res4 /*4.0*res*acr*/ *delay[5];
+            delay[0] = stg[0] = delay[0] + tune*(tanh(input*THERMAL) - tanhstg[0]);
+            for (k = 1; k < 4; k++) {
+              input = stg[k-1];
+              stg[k] = delay[k]
+                + tune*((tanhstg[k-1] = tanh(input*THERMAL))
+                        - (k != 3 ? tanhstg[k] : tanh(delay[k]*THERMAL)));
+              delay[k] = stg[k];
+            }
+            /* 1/2-sample delay for phase compensation  */
+            delay[5] = (stg[3] + delay[4])*0.5;
+            delay[4] = stg[3];
         }
-        /* 1/2-sample delay for phase compensation  */
-        delay[5] = (stg[3] + delay[4])*0.5;
-        delay[4] = stg[3];
+        out[i] = (SPFLOAT) delay[5];
     }
-    *out = (SPFLOAT) delay[5];
+
+    for (k = 0; k < 6; k++) p->delay[k] = delay[k];
+    for (k = 0; k < 3; k++) p->tanhstg[k] = tanhstg[k];
     return SP_OK;
 }
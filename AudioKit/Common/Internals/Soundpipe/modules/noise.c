@@ -4,26 +4,30 @@
 
 int sp_noise_create(sp_noise **ns)
 {
-    *ns = malloc(sizeof(sp_noise));
+    *ns = sp_malloc(sizeof(sp_noise));
     return SP_OK;
 }
 
 int sp_noise_init(sp_data *sp, sp_noise *ns)
 {
     ns->amp = 1.0;
+    sp_prng_init(sp, &ns->prng);
     return SP_OK;
 }
 
 int sp_noise_compute(sp_data *sp, sp_noise *ns, SPFLOAT *in, SPFLOAT *out)
 {
-    *out = ((sp_rand(sp) % RAND_MAX) / (SP_RANDMAX * 1.0));
-    *out = (*out * 2) - 1;
-    *out *= ns->amp;
+    return sp_noise_compute_block(sp, ns, in, out, 1);
+}
+
+int sp_noise_compute_block(sp_data *sp, sp_noise *ns, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    sp_prng_uniform(&ns->prng, out, n, -ns->amp, ns->amp);
     return SP_OK;
 }
 
 int sp_noise_destroy(sp_noise **ns)
 {
-    free(*ns);
+    sp_free(*ns);
     return SP_OK;
 }
@@ -16,13 +16,13 @@
 
 int sp_osc_create(sp_osc **osc)
 {
-    *osc = malloc(sizeof(sp_osc));
+    *osc = sp_malloc(sizeof(sp_osc));
     return SP_OK;
 }
 
 int sp_osc_destroy(sp_osc **osc)
 {
-    free(*osc);
+    sp_free(*osc);
     return SP_NOT_OK;
 }
 
@@ -40,28 +40,59 @@ int sp_osc_init(sp_data *sp, sp_osc *osc, sp_ftbl *ft, SPFLOAT iphs)
 }
 
 int sp_osc_compute(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_osc_compute_block(sp, osc, in, out, 1);
+}
+
+int sp_osc_compute_block(sp_data *sp, sp_osc *osc, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     sp_ftbl *ftp;
     SPFLOAT amp, cps, fract, v1, v2, *ftab, *ft;
-    int32_t phs, lobits;
+    int32_t phs, inc, lobits;
+    uint32_t lomask;
+    SPFLOAT lodiv;
     SPFLOAT sicvt = osc->tbl->sicvt;
+    uint32_t i;
 
     ftp = osc->tbl;
     lobits = osc->tbl->lobits;
+    lomask = ftp->lomask;
+    lodiv = ftp->lodiv;
     amp = osc->amp;
     cps = osc->freq;
     phs = osc->lphs;
     ft = osc->tbl->tbl;
     
     if(sp->k) osc->inc = (int32_t)lrintf(cps * sicvt);
+    inc = osc->inc;
 
-    fract = ((phs) & ftp->lomask) * ftp->lodiv;
-    ftab = ft + (phs >> lobits);
-    v1 = ftab[0];
-    v2 = ftab[1];
-    *out = (v1 + (v2 - v1) * fract) * amp;
-    phs += osc->inc;
-    phs &= SP_FT_PHMASK;
+    if(ftp->nmip > 0) {
+        /* crossfade between the two band-limited levels for this pitch */
+        SPFLOAT *ft2, mix, lo, hi;
+        int32_t idx;
+        mix = sp_ftbl_mip_select(sp, ftp, cps, &ft, &ft2);
+        for(i = 0; i < n; i++) {
+            fract = ((phs) & lomask) * lodiv;
+            idx = phs >> lobits;
+            lo = ft[idx] + (ft[idx + 1] - ft[idx]) * fract;
+            hi = ft2[idx] + (ft2[idx + 1] - ft2[idx]) * fract;
+            out[i] = (lo + (hi - lo) * mix) * amp;
+            phs += inc;
+            phs &= SP_FT_PHMASK;
+        }
+        osc->lphs = phs;
+        return SP_OK;
+    }
+
+    for(i = 0; i < n; i++) {
+        fract = ((phs) & lomask) * lodiv;
+        ftab = ft + (phs >> lobits);
+        v1 = ftab[0];
+        v2 = ftab[1];
+        out[i] = (v1 + (v2 - v1) * fract) * amp;
+        phs += inc;
+        phs &= SP_FT_PHMASK;
+    }
 
     osc->lphs = phs;
     return SP_OK;
@@ -4,13 +4,13 @@
 
 int sp_oscmorph_create(sp_oscmorph **p)
 {
-    *p = malloc(sizeof(sp_oscmorph));
+    *p = sp_malloc(sizeof(sp_oscmorph));
     return SP_OK;
 }
 
 int sp_oscmorph_destroy(sp_oscmorph **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -79,3 +79,12 @@ int sp_oscmorph_compute(sp_data *sp, sp_oscmorph *osc, SPFLOAT *in, SPFLOAT *out
     osc->lphs = phs;
     return SP_OK;
 }
+
+int sp_oscmorph_compute_block(sp_data *sp, sp_oscmorph *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_oscmorph_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -11,56 +11,273 @@
     very easy to port to other compiler/OS.
 */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "soundpipe.h"
 
+#ifndef NO_PTHREADS
+#include <pthread.h>
+#endif
+
 #ifndef M_PI
 #define M_PI		3.14159265358979323846	
 #endif 
 
-int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps, 
-        SPFLOAT f, SPFLOAT bw) 
-{
+#define PADSYNTH_MAXTHREADS 16
+
+/* sqrt(14.71280603): sp_padsynth_profile() is zero further out, in
+ * bandwidths */
+#define PADSYNTH_SPREAD 3.8357275
+
+/*
+ * Tables are built in two rounds. First each thread takes a slice of the
+ * bins of every table, sums the harmonics whose profiles reach it and
+ * writes the packed spectrum into the table; every bin still sums its
+ * harmonics in order, so the spectrum does not depend on the thread
+ * count. Then the threads share out the tables for the inverse FFT.
+ */
+typedef struct {
+    sp_padsynth_job *jobs;
+    SPFLOAT **phase;
+    int njobs, nthreads, t;
+    int sr;
+} padsynth_part;
 
-    int i, nh;
-    int N = (int) ps->size;
-    int number_harmonics = (int) amps->size;
-    SPFLOAT *A = amps->tbl;
-    SPFLOAT *smp = ps->tbl;
+static int padsynth_log2(int N)
+{
+    int M;
+    for (M = 0; (1 << M) < N; M++);
+    return (1 << M) == N ? M : -1;
+}
 
-    SPFLOAT *freq_amp = malloc((N / 2) * sizeof(SPFLOAT));
-    SPFLOAT *freq_phase = malloc((N / 2) * sizeof(SPFLOAT));
+/* bins lo .. hi - 1 of one table */
+static void padsynth_spectrum(sp_padsynth_job *job, const SPFLOAT *phase,
+        int sr, int lo, int hi)
+{
+    int i, nh, a, b;
+    int N = (int) job->ps->size;
+    int number_harmonics = (int) job->amps->size;
+    SPFLOAT *A = job->amps->tbl;
+    SPFLOAT *smp = job->ps->tbl;
+    SPFLOAT f = job->f, bw = job->bw;
+    /* sp_ifftr() scales by 1/N, the FFTwrapper does not */
+    SPFLOAT scale = padsynth_log2(N) >= 0 ? N : 1;
+    double c, h, c0, c1;
+    SPFLOAT *freq_amp;
 
-    for (i=0;i<N/2;i++) freq_amp[i]=0.0;
+    if (hi <= lo) return;
+    freq_amp = malloc((hi - lo) * sizeof(SPFLOAT));
+    for (i = 0; i < hi - lo; i++) freq_amp[i] = 0.0;
 
-    for (nh=1;nh<number_harmonics;nh++) {
+    for (nh = 1; nh < number_harmonics; nh++) {
         SPFLOAT bw_Hz;
         SPFLOAT bwi;
         SPFLOAT fi;
         bw_Hz = (pow(2.0, bw/1200.0) - 1.0) * f * nh;
 
-        bwi = bw_Hz/(2.0*sp->sr);
-        fi = f*nh/sp->sr;
-        for (i = 0; i < N/2 ; i++) {
+        bwi = bw_Hz/(2.0*sr);
+        fi = f*nh/sr;
+
+        /* a bin of slack each side for rounding at the cutoff */
+        c = (double)fi * N;
+        h = PADSYNTH_SPREAD * fabs(bwi) * N + 1;
+        if (c + h < lo || c - h >= hi) continue;
+        /* round first, then clamp to the slice */
+        c0 = floor(c - h);
+        c1 = ceil(c + h) + 1;
+        a = c0 < lo ? lo : (int)c0;
+        b = c1 > hi ? hi : (int)c1;
+        for (i = a; i < b; i++) {
             SPFLOAT hprofile;
             hprofile = sp_padsynth_profile((i / (SPFLOAT) N) - fi, bwi);
-            freq_amp[i] += hprofile*A[nh];
+            freq_amp[i - lo] += hprofile*A[nh];
         }
     }
 
-    for (i=0;i<N/2;i++) {
-        freq_phase[i]= (rand() / (RAND_MAX + 1.0)) * 2.0 * M_PI;
-    };
+    for (i = lo; i < hi; i++) {
+        SPFLOAT amp = freq_amp[i - lo] * scale;
+        /* most bins lie between the harmonics */
+        if (amp == 0) {
+            smp[2 * i] = smp[2 * i + 1] = 0;
+        } else if (i == 0) {
+            smp[0] = amp*cos(phase[0]);
+            smp[1] = 0;
+        } else {
+            smp[2 * i] = amp*cos(phase[i]);
+            smp[2 * i + 1] = amp*sin(phase[i]);
+        }
+    }
+    free(freq_amp);
+}
 
-    sp_padsynth_ifft(N,freq_amp,freq_phase,smp);
-    sp_padsynth_normalize(N,smp);
+/* smp holds a spectrum packed as sp_fftr() does. Power of two sizes use
+ * the shared plan in fft, set up again only when the size changes. */
+static void padsynth_ifft(sp_fft *fft, int N, SPFLOAT *smp)
+{
+    int i, M = padsynth_log2(N);
+    FFTwrapper *fw;
+    FFTFREQS fftfreqs;
 
-    free(freq_amp);
-    free(freq_phase);
+    if (M >= 0) {
+        if (fft->plan != NULL && sp_fft_plan_size(fft->plan) != N) {
+            sp_fft_destroy(fft);
+            fft->plan = NULL;
+        }
+        if (fft->plan == NULL) sp_fft_init(fft, M);
+        sp_ifftr(fft, smp, N);
+        return;
+    }
+
+    FFTwrapper_create(&fw, N);
+    newFFTFREQS(&fftfreqs, N/2);
+    fftfreqs.c[0] = smp[0];
+    for (i = 1; i < N/2; i++) {
+        fftfreqs.c[i] = smp[2 * i];
+        fftfreqs.s[i] = smp[2 * i + 1];
+    }
+    freqs2smps(fw, &fftfreqs, smp);
+    deleteFFTFREQS(&fftfreqs);
+    FFTwrapper_destroy(&fw);
+}
+
+static void *padsynth_spectra(void *ud)
+{
+    padsynth_part *part = ud;
+    int j, N2;
+    for (j = 0; j < part->njobs; j++) {
+        N2 = (int) part->jobs[j].ps->size / 2;
+        padsynth_spectrum(&part->jobs[j], part->phase[j], part->sr,
+                (int)((int64_t)N2 * part->t / part->nthreads),
+                (int)((int64_t)N2 * (part->t + 1) / part->nthreads));
+    }
+    return NULL;
+}
+
+static void *padsynth_tables(void *ud)
+{
+    padsynth_part *part = ud;
+    sp_fft fft;
+    int j;
+    fft.plan = NULL;
+    for (j = part->t; j < part->njobs; j += part->nthreads) {
+        padsynth_ifft(&fft, (int) part->jobs[j].ps->size, part->jobs[j].ps->tbl);
+        sp_padsynth_normalize((int) part->jobs[j].ps->size, part->jobs[j].ps->tbl);
+    }
+    if (fft.plan != NULL) sp_fft_destroy(&fft);
+    return NULL;
+}
+
+/* runs fn on every part, part 0 on the calling thread */
+static void padsynth_run(padsynth_part *part, int nthreads, void *(*fn)(void *))
+{
+    int t;
+#ifndef NO_PTHREADS
+    pthread_t thread[PADSYNTH_MAXTHREADS];
+    int started[PADSYNTH_MAXTHREADS];
+    for (t = 1; t < nthreads; t++) {
+        started[t] = pthread_create(&thread[t], NULL, fn, &part[t]) == 0;
+    }
+    fn(&part[0]);
+    for (t = 1; t < nthreads; t++) {
+        if (started[t]) pthread_join(thread[t], NULL);
+        else fn(&part[t]);
+    }
+#else
+    for (t = 0; t < nthreads; t++) fn(&part[t]);
+#endif
+}
+
+/* the cache key of a job, seed being the phase seed it draws */
+static void padsynth_args(sp_padsynth_job *job, uint32_t seed, char *args,
+        size_t len)
+{
+    uint64_t h = sp_ftbl_cache_hash(job->amps->tbl,
+            job->amps->size * sizeof(SPFLOAT), 0xCBF29CE484222325ULL);
+    snprintf(args, len, "%a %a %lu %016llx %u", (double)job->f,
+            (double)job->bw, (unsigned long)job->amps->size,
+            (unsigned long long)h, (unsigned)seed);
+}
+
+int sp_gen_padsynth_batch(sp_data *sp, sp_padsynth_job *jobs, int njobs,
+        int nthreads)
+{
+    padsynth_part part[PADSYNTH_MAXTHREADS];
+    sp_padsynth_job *todo;
+    SPFLOAT **phase;
+    uint32_t *seed;
+    char args[128];
+    int *cache;
+    sp_prng prng;
+    int j, t, N, ntodo, hit;
+
+    if (njobs < 1) return SP_NOT_OK;
+#ifdef NO_PTHREADS
+    nthreads = 1;
+#endif
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > PADSYNTH_MAXTHREADS) nthreads = PADSYNTH_MAXTHREADS;
+
+    todo = malloc(njobs * sizeof(sp_padsynth_job));
+    phase = malloc(njobs * sizeof(SPFLOAT *));
+    seed = malloc(njobs * sizeof(uint32_t));
+    cache = malloc(njobs * sizeof(int));
+
+    /* the phase seeds are drawn in job order, as one call per table
+     * would, whether or not the table is then found in the cache */
+    ntodo = 0;
+    for (j = 0; j < njobs; j++) {
+        seed[j] = sp_rand(sp);
+        padsynth_args(&jobs[j], seed[j], args, sizeof(args));
+        cache[j] = sp_ftbl_cache_lookup(sp, jobs[j].ps, "padsynth", args,
+                &hit) == SP_OK;
+        if (hit) continue;
+        N = (int) jobs[j].ps->size;
+        todo[ntodo] = jobs[j];
+        phase[ntodo] = malloc((N / 2 + 1) * sizeof(SPFLOAT));
+        sp_prng_seed(&prng, seed[j]);
+        sp_prng_uniform(&prng, phase[ntodo], N/2, 0, 2.0 * M_PI);
+        ntodo++;
+    }
+
+    if (ntodo > 0) {
+        for (t = 0; t < nthreads; t++) {
+            part[t].jobs = todo;
+            part[t].phase = phase;
+            part[t].njobs = ntodo;
+            part[t].nthreads = nthreads;
+            part[t].t = t;
+            part[t].sr = sp->sr;
+        }
+        padsynth_run(part, nthreads, padsynth_spectra);
+        padsynth_run(part, nthreads, padsynth_tables);
+    }
+
+    for (j = 0; j < njobs; j++) {
+        if (!cache[j] || jobs[j].ps->map != NULL) continue;
+        padsynth_args(&jobs[j], seed[j], args, sizeof(args));
+        sp_ftbl_cache_store(sp, jobs[j].ps, "padsynth", args);
+    }
+
+    for (j = 0; j < ntodo; j++) free(phase[j]);
+    free(phase);
+    free(todo);
+    free(seed);
+    free(cache);
     return SP_OK;
 }
 
+int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps, 
+        SPFLOAT f, SPFLOAT bw) 
+{
+    sp_padsynth_job job;
+    job.ps = ps;
+    job.amps = amps;
+    job.f = f;
+    job.bw = bw;
+    return sp_gen_padsynth_batch(sp, &job, 1, 1);
+}
+
 /* This is the profile of one harmonic
    In this case is a Gaussian distribution (e^(-x^2))
    The amplitude is divided by the bandwidth to ensure that the harmonic
@@ -84,18 +301,18 @@ int sp_padsynth_ifft(int N, SPFLOAT *freq_amp,
         SPFLOAT *freq_phase, SPFLOAT *smp) 
 {
     int i;
-    FFTwrapper *fft;
-    FFTwrapper_create(&fft, N);
-    FFTFREQS fftfreqs;
-    newFFTFREQS(&fftfreqs,N/2);
+    SPFLOAT scale = padsynth_log2(N) >= 0 ? N : 1;
+    sp_fft fft;
 
-    for (i=0; i<N/2; i++){
-        fftfreqs.c[i]=freq_amp[i]*cos(freq_phase[i]);
-        fftfreqs.s[i]=freq_amp[i]*sin(freq_phase[i]);
+    smp[0] = freq_amp[0]*cos(freq_phase[0])*scale;
+    smp[1] = 0;
+    for (i=1; i<N/2; i++){
+        smp[2 * i] = freq_amp[i]*cos(freq_phase[i])*scale;
+        smp[2 * i + 1] = freq_amp[i]*sin(freq_phase[i])*scale;
     };
-    freqs2smps(fft, &fftfreqs,smp);
-    deleteFFTFREQS(&fftfreqs);
-    FFTwrapper_destroy(&fft);
+    fft.plan = NULL;
+    padsynth_ifft(&fft, N, smp);
+    if (fft.plan != NULL) sp_fft_destroy(&fft);
     return SP_OK;
 }
 
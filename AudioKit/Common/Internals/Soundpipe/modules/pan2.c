@@ -23,13 +23,13 @@
 
 int sp_pan2_create(sp_pan2 **p)
 {
-    *p = malloc(sizeof(sp_pan2));
+    *p = sp_malloc(sizeof(sp_pan2));
     return SP_OK;
 }
 
 int sp_pan2_destroy(sp_pan2 **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -41,11 +41,18 @@ int sp_pan2_init(sp_data *sp, sp_pan2 *p)
 }
 
 int sp_pan2_compute(sp_data *sp, sp_pan2 *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_pan2_compute_block(sp, p, in, out1, out2, 1);
+}
+
+int sp_pan2_compute_block(sp_data *sp, sp_pan2 *p, const SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
 {
     /* Send the signal's input to the output */
     uint32_t type = p->type;
     SPFLOAT pan = (1 + p->pan) * 0.5;
     SPFLOAT cc, ss, l, r;
+    double gl, gr;
+    uint32_t i;
 
     type %= 4;
 
@@ -53,32 +60,39 @@ int sp_pan2_compute(sp_data *sp, sp_pan2 *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT
         /* Equal power */
         case 0:
         pan = M_PI * 0.5 * pan;
-        *out1 = *in * cos(pan);
-        *out2 = *in * sin(pan);
+        gl = cos(pan);
+        gr = sin(pan);
         break;
 
         /* Square root */
         case 1:
-        *out1 = *in * sqrt(pan);
-        *out2 = *in * sqrt(1.0 - pan);
+        gl = sqrt(pan);
+        gr = sqrt(1.0 - pan);
         break;
 
         /* simple linear */
         case 2:
-        *out1 = *in * (1.0 - pan);
-        *out2 = *in * pan;
+        gl = (1.0 - pan);
+        gr = pan;
         break;
 
         /* Equal power (alternative) */
-        case 3:
+        default:
 
         cc = cos(M_PI * pan * 0.5);
         ss = sin(M_PI * pan * 0.5);
         l = SQRT2 * (cc + ss) * 0.5;
         r = SQRT2 * (cc - ss) * 0.5;
-        *out1 = *in * l;
-        *out2 = *in * r;
-        break;
+        for(i = 0; i < n; i++) {
+            out1[i] = in[i] * l;
+            out2[i] = in[i] * r;
+        }
+        return SP_OK;
+    }
+
+    for(i = 0; i < n; i++) {
+        out1[i] = in[i] * gl;
+        out2[i] = in[i] * gr;
     }
 
     return SP_OK;
@@ -11,13 +11,13 @@
 
 int sp_panst_create(sp_panst **p)
 {
-    *p = malloc(sizeof(sp_panst));
+    *p = sp_malloc(sizeof(sp_panst));
     return SP_OK;
 }
 
 int sp_panst_destroy(sp_panst **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -29,11 +29,18 @@ int sp_panst_init(sp_data *sp, sp_panst *p)
 }
 
 int sp_panst_compute(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_panst_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
+
+int sp_panst_compute_block(sp_data *sp, sp_panst *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
 {
     /* Send the signal's input to the output */
     uint32_t type = p->type;
     SPFLOAT pan = (p->pan + 1.0) * 0.5;
     SPFLOAT cc, ss, l, r;
+    double gl, gr;
+    uint32_t i;
 
     type %= 4;
 
@@ -41,32 +48,39 @@ int sp_panst_compute(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2, SPFLO
         /* Equal power */
         case 0:
         pan = M_PI * 0.5 * pan;
-        *out1 = *in1 * cos(pan);
-        *out2 = *in2 * sin(pan);
+        gl = cos(pan);
+        gr = sin(pan);
         break;
 
         /* Square root */
         case 1:
-        *out1 = *in1 * sqrt(pan);
-        *out2 = *in2 * sqrt(1.0 - pan);
+        gl = sqrt(pan);
+        gr = sqrt(1.0 - pan);
         break;
 
         /* simple linear */
         case 2:
-        *out1 = *in1 * (1.0 - pan);
-        *out2 = *in2 * pan;
+        gl = (1.0 - pan);
+        gr = pan;
         break;
 
         /* Equal power (alternative) */
-        case 3:
+        default:
 
         cc = cos(M_PI * pan * 0.5);
         ss = sin(M_PI * pan * 0.5);
         l = SQRT2 * (cc + ss) * 0.5;
         r = SQRT2 * (cc - ss) * 0.5;
-        *out1 = *in1 * l;
-        *out2 = *in2 * r;
-        break;
+        for(i = 0; i < n; i++) {
+            out1[i] = in1[i] * l;
+            out2[i] = in2[i] * r;
+        }
+        return SP_OK;
+    }
+
+    for(i = 0; i < n; i++) {
+        out1[i] = in1[i] * gl;
+        out2[i] = in2[i] * gr;
     }
 
     return SP_OK;
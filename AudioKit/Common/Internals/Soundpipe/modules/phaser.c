@@ -60,12 +60,12 @@ typedef struct {
 } phaser;
 
 phaser* newphaser() { 
-	phaser* dsp = (phaser*)malloc(sizeof(phaser));
+	phaser* dsp = (phaser*)sp_malloc(sizeof(phaser));
 	return dsp;
 }
 
 void deletephaser(phaser* dsp) { 
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitphaser(phaser* dsp, int samplingFreq) {
@@ -320,7 +320,7 @@ static void addCheckButton (void* ui_interface, const char* label, FAUSTFLOAT* z
 
 int sp_phaser_create(sp_phaser **p)
 {
-    *p = malloc(sizeof(sp_phaser));
+    *p = sp_malloc(sizeof(sp_phaser));
     return SP_OK;
 }
 
@@ -329,7 +329,7 @@ int sp_phaser_destroy(sp_phaser **p)
     sp_phaser *pp = *p;
     phaser *dsp = pp->faust;
     deletephaser (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -369,3 +369,12 @@ int sp_phaser_compute(sp_data *sp, sp_phaser *p,
     computephaser(dsp, 1, faust_in, faust_out);
     return SP_OK;
 }
+
+int sp_phaser_compute_block(sp_data *sp, sp_phaser *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
+{
+    phaser *dsp = p->faust;
+    SPFLOAT *faust_out[] = {out1, out2};
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in1, (SPFLOAT *)in2};
+    computephaser(dsp, n, faust_in, faust_out);
+    return SP_OK;
+}
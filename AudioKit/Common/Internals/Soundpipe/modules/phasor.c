@@ -15,13 +15,13 @@
 
 int sp_phasor_create(sp_phasor **p)
 {
-    *p = malloc(sizeof(sp_phasor));
+    *p = sp_malloc(sizeof(sp_phasor));
     return SP_OK;
 }
 
 int sp_phasor_destroy(sp_phasor **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -35,18 +35,26 @@ int sp_phasor_init(sp_data *sp, sp_phasor *p, SPFLOAT iphs)
 }
 
 int sp_phasor_compute(sp_data *sp, sp_phasor *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_phasor_compute_block(sp, p, in, out, 1);
+}
+
+int sp_phasor_compute_block(sp_data *sp, sp_phasor *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT phase;
     SPFLOAT incr;
+    uint32_t i;
 
     phase = p->curphs;
     incr = p->freq * p->onedsr;
-    *out = phase;
-    phase += incr;
-    if (phase >= 1.0) {
-        phase -= 1.0;
-    } else if (phase < 0.0) {
-        phase += 1.0;
+    for(i = 0; i < n; i++) {
+        out[i] = phase;
+        phase += incr;
+        if (phase >= 1.0) {
+            phase -= 1.0;
+        } else if (phase < 0.0) {
+            phase += 1.0;
+        }
     }
     p->curphs = phase;
     return SP_OK;
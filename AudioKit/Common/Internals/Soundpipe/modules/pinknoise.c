@@ -18,12 +18,12 @@ typedef struct {
 } pinknoise;
 
 pinknoise* newpinknoise() { 
-	pinknoise* dsp = (pinknoise*)malloc(sizeof(pinknoise));
+	pinknoise* dsp = (pinknoise*)sp_malloc(sizeof(pinknoise));
 	return dsp;
 }
 
 void deletepinknoise(pinknoise* dsp) { 
-	free(dsp);
+	sp_free(dsp);
 }
 
 void instanceInitpinknoise(pinknoise* dsp, int samplingFreq) {
@@ -59,16 +59,16 @@ void buildUserInterfacepinknoise(pinknoise* dsp, UIGlue* interface) {
 }
 
 void computepinknoise(pinknoise* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs) {
+	/* white noise in [-1, 1) comes in on inputs[0], from sp_prng */
+	FAUSTFLOAT* input0 = inputs[0];
 	FAUSTFLOAT* output0 = outputs[0];
 	float fSlow0 = (float)dsp->fHslider0;
 	/* C99 loop */
 	{
 		int i;
 		for (i = 0; (i < count); i = (i + 1)) {
-			dsp->iRec1[0] = ((1103515245 * dsp->iRec1[1]) + 12345);
-			dsp->fRec0[0] = (((0.522189f * dsp->fRec0[3]) + ((4.65661e-10f * (float)dsp->iRec1[0]) + (2.49496f * dsp->fRec0[1]))) - (2.01727f * dsp->fRec0[2]));
+			dsp->fRec0[0] = (((0.522189f * dsp->fRec0[3]) + ((float)input0[i] + (2.49496f * dsp->fRec0[1]))) - (2.01727f * dsp->fRec0[2]));
 			output0[i] = (FAUSTFLOAT)(fSlow0 * (((0.049922f * dsp->fRec0[0]) + (0.0506127f * dsp->fRec0[2])) - ((0.0959935f * dsp->fRec0[1]) + (0.00440879f * dsp->fRec0[3]))));
-			dsp->iRec1[1] = dsp->iRec1[0];
 			/* C99 loop */
 			{
 				int j0;
@@ -94,7 +94,7 @@ static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOA
 
 int sp_pinknoise_create(sp_pinknoise **p)
 {
-    *p = malloc(sizeof(sp_pinknoise));
+    *p = sp_malloc(sizeof(sp_pinknoise));
     return SP_OK;
 }
 
@@ -103,7 +103,7 @@ int sp_pinknoise_destroy(sp_pinknoise **p)
     sp_pinknoise *pp = *p;
     pinknoise *dsp = pp->faust;
     deletepinknoise (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -118,6 +118,7 @@ int sp_pinknoise_init(sp_data *sp, sp_pinknoise *p)
     initpinknoise(dsp, sp->sr);
      
     p->amp = p->args[0];
+    sp_prng_init(sp, &p->prng);
 
     p->faust = dsp;
     return SP_OK;
@@ -126,12 +127,24 @@ int sp_pinknoise_init(sp_data *sp, sp_pinknoise *p)
 int sp_pinknoise_compute(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out) 
 {
 
-    pinknoise *dsp = p->faust;
-    SPFLOAT out1 = 0;
-    SPFLOAT *faust_out[] = {&out1};
-    SPFLOAT *faust_in[] = {in};
-    computepinknoise(dsp, 1, faust_in, faust_out);
+    return sp_pinknoise_compute_block(sp, p, in, out, 1);
+}
 
-    *out = out1 * 10.0; // The 10.0 is a quick fix to give this module the same overall amplitude as noise
+int sp_pinknoise_compute_block(sp_data *sp, sp_pinknoise *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    pinknoise *dsp = p->faust;
+    SPFLOAT white[64];
+    SPFLOAT *faust_out[1];
+    SPFLOAT *faust_in[] = {white};
+    uint32_t i, j, len;
+
+    for(i = 0; i < n; i += len) {
+        len = n - i < 64 ? n - i : 64;
+        sp_prng_uniform(&p->prng, white, len, -1, 1);
+        faust_out[0] = out + i;
+        computepinknoise(dsp, len, faust_in, faust_out);
+        // The 10.0 is a quick fix to give this module the same overall amplitude as noise
+        for(j = 0; j < len; j++) out[i + j] *= 10.0;
+    }
     return SP_OK;
 }
@@ -18,7 +18,7 @@
 
 int sp_pitchamdf_create(sp_pitchamdf **p)
 {
-    *p = malloc(sizeof(sp_pitchamdf));
+    *p = sp_malloc(sizeof(sp_pitchamdf));
     return SP_OK;
 }
 
@@ -31,7 +31,7 @@ int sp_pitchamdf_destroy(sp_pitchamdf **p)
         sp_auxdata_free(&pp->rmsmedian);
     }
     sp_auxdata_free(&pp->buffer);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -343,3 +343,12 @@ int sp_pitchamdf_compute(sp_data *sp, sp_pitchamdf *p, SPFLOAT *in,
     p->readp = readp;
     return SP_OK;
 }
+
+int sp_pitchamdf_compute_block(sp_data *sp, sp_pitchamdf *p, const SPFLOAT *in, SPFLOAT *cps, SPFLOAT *rms, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_pitchamdf_compute(sp, p, (SPFLOAT *)&in[i], &cps[i], &rms[i]);
+    }
+    return SP_OK;
+}
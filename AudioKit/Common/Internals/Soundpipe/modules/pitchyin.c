@@ -0,0 +1,242 @@
+/*
+ * pitchyin
+ *
+ * Block-based pitch tracker after the YIN algorithm (de Cheveigne and
+ * Kawahara, 2002). The input is lowpassed and decimated so the analysis
+ * rate is about 8 * maxfreq, and once per hop the difference function of
+ * the last two periods of minfreq is computed with one FFT
+ * cross-correlation. Its cumulative mean normalized form gives the period,
+ * refined by parabolic interpolation, and the confidence (1 minus its
+ * value at that period). amp is the RMS of the input over the last
+ * window, the last four hops.
+ *
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "soundpipe.h"
+
+int sp_pitchyin_create(sp_pitchyin **p)
+{
+    *p = sp_malloc(sizeof(sp_pitchyin));
+    return SP_OK;
+}
+
+int sp_pitchyin_destroy(sp_pitchyin **p)
+{
+    sp_pitchyin *pp = *p;
+    sp_fft_destroy(&pp->fft);
+    sp_auxdata_free(&pp->buf);
+    sp_auxdata_free(&pp->work);
+    sp_free(*p);
+    return SP_OK;
+}
+
+int sp_pitchyin_init(sp_data *sp, sp_pitchyin *p, SPFLOAT minfreq, SPFLOAT maxfreq)
+{
+    int M, k;
+
+    if (minfreq <= 0 || maxfreq <= minfreq || maxfreq >= sp->sr * 0.5) {
+        return SP_NOT_OK;
+    }
+
+    p->minfreq = minfreq;
+    p->maxfreq = maxfreq;
+    p->thresh = 0.15;
+    p->freq = 0;
+    p->amp = 0;
+    p->conf = 0;
+
+    p->decim = (int)(sp->sr / (8 * maxfreq));
+    if (p->decim < 1) p->decim = 1;
+    p->dsr = sp->sr / p->decim;
+    p->dcnt = 0;
+
+    p->minlag = (int)(p->dsr / maxfreq);
+    if (p->minlag < 2) p->minlag = 2;
+    p->maxlag = (int)ceil(p->dsr / minfreq);
+    /* integrate over one period of minfreq, keep lags up to maxlag + 1 */
+    p->wsize = p->maxlag;
+    p->bufsize = p->wsize + p->maxlag + 2;
+    p->bufpos = 0;
+    p->hopsize = p->wsize / 4;
+    if (p->hopsize < 1) p->hopsize = 1;
+    p->hcnt = 0;
+    p->sumsq = 0;
+    for (k = 0; k < 4; k++) p->hopsq[k] = 0;
+    p->hopidx = 0;
+
+    for (M = 0; (1 << M) < p->bufsize; M++);
+    p->N = 1 << M;
+    sp_fft_init(&p->fft, M);
+
+    /* 4th order Butterworth at a quarter of the analysis rate, 2 * maxfreq */
+    for (k = 0; k < 2; k++) {
+        sp_bqbank_butlp(sp, p->dsr * 0.25, p->c[k]);
+        p->z[k][0] = p->z[k][1] = 0;
+    }
+
+    sp_auxdata_alloc(&p->buf, p->bufsize * sizeof(SPFLOAT));
+    /* two FFT buffers and the difference function */
+    sp_auxdata_alloc(&p->work, (2 * p->N + p->maxlag + 2) * sizeof(SPFLOAT));
+
+    return SP_OK;
+}
+
+static void pitchyin_analyze(sp_pitchyin *p)
+{
+    SPFLOAT *ring = p->buf.ptr;
+    SPFLOAT *a = p->work.ptr, *b = a + p->N, *d = b + p->N;
+    int N = p->N, w = p->wsize, maxlag = p->maxlag;
+    int i, k, tau;
+    SPFLOAT e0, et, sum, re, x0, x1, x2, den, shift;
+
+    /* unroll the ring, oldest sample first, zero padded to N */
+    for (i = 0; i < p->bufsize; i++) {
+        b[i] = ring[(p->bufpos + i) % p->bufsize];
+    }
+    for (; i < N; i++) b[i] = 0;
+    e0 = 0;
+    for (i = 0; i < w; i++) {
+        a[i] = b[i];
+        e0 += b[i] * b[i];
+    }
+    for (; i < N; i++) a[i] = 0;
+
+    if (e0 < 1e-10 * w) {
+        p->conf = 0;
+        return;
+    }
+
+    /* d(tau) starts out as e(tau), the energy of x[tau .. tau + w) */
+    et = e0;
+    for (tau = 1; tau <= maxlag + 1; tau++) {
+        et += b[tau - 1 + w] * b[tau - 1 + w] - b[tau - 1] * b[tau - 1];
+        d[tau] = et;
+    }
+
+    /* r(tau) = sum over j < w of x[j] x[j + tau], as IFFT(conj(A) B) */
+    sp_fftr(&p->fft, a, N);
+    sp_fftr(&p->fft, b, N);
+    b[0] *= a[0];
+    b[1] *= a[1];
+    for (k = 2; k < N; k += 2) {
+        re = a[k] * b[k] + a[k + 1] * b[k + 1];
+        b[k + 1] = a[k] * b[k + 1] - a[k + 1] * b[k];
+        b[k] = re;
+    }
+    sp_ifftr(&p->fft, b, N);
+
+    /* d(tau) = e(0) + e(tau) - 2 r(tau), cumulative mean normalized */
+    sum = 0;
+    d[0] = 1;
+    for (tau = 1; tau <= maxlag + 1; tau++) {
+        d[tau] = e0 + d[tau] - 2 * b[tau];
+        if (d[tau] < 0) d[tau] = 0;
+        sum += d[tau];
+        d[tau] = sum > 0 ? d[tau] * tau / sum : 1;
+    }
+
+    /* first dip below the threshold, followed down to its minimum;
+     * otherwise the global minimum */
+    for (tau = p->minlag; tau <= maxlag; tau++) {
+        if (d[tau] < p->thresh) {
+            while (tau < maxlag && d[tau + 1] < d[tau]) tau++;
+            break;
+        }
+    }
+    if (tau > maxlag) {
+        tau = p->minlag;
+        for (k = p->minlag + 1; k <= maxlag; k++) {
+            if (d[k] < d[tau]) tau = k;
+        }
+    }
+
+    x0 = d[tau - 1];
+    x1 = d[tau];
+    x2 = d[tau + 1];
+    den = x0 - 2 * x1 + x2;
+    shift = 0;
+    if (den > 0) {
+        shift = 0.5 * (x0 - x2) / den;
+        if (shift > 1 || shift < -1) shift = 0;
+    }
+
+    p->freq = p->dsr / (tau + shift);
+    p->conf = 1 - x1;
+    if (p->conf < 0) p->conf = 0;
+}
+
+/* runs n input samples through the decimator and the analysis */
+static void pitchyin_run(sp_pitchyin *p, const SPFLOAT *in, uint32_t n)
+{
+    SPFLOAT *ring = p->buf.ptr;
+    SPFLOAT x, t, *c, *z;
+    uint32_t i;
+    int k;
+
+    for (i = 0; i < n; i++) {
+        x = in[i];
+        p->sumsq += x * x;
+        if (p->decim > 1) {
+            for (k = 0; k < 2; k++) {
+                c = p->c[k];
+                z = p->z[k];
+                t = x - c[3] * z[0] - c[4] * z[1];
+                x = t * c[0] + c[1] * z[0] + c[2] * z[1];
+                z[1] = z[0];
+                z[0] = t;
+            }
+            if (++p->dcnt < p->decim) continue;
+            p->dcnt = 0;
+        }
+        ring[p->bufpos] = x;
+        if (++p->bufpos == p->bufsize) p->bufpos = 0;
+        if (++p->hcnt == p->hopsize) {
+            p->hcnt = 0;
+            pitchyin_analyze(p);
+            p->hopsq[p->hopidx] = p->sumsq;
+            p->hopidx = (p->hopidx + 1) & 3;
+            p->sumsq = 0;
+            p->amp = sqrt((p->hopsq[0] + p->hopsq[1] + p->hopsq[2] +
+                        p->hopsq[3]) / (4 * p->hopsize * p->decim));
+        }
+    }
+}
+
+int sp_pitchyin_compute(sp_data *sp, sp_pitchyin *p, SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp, SPFLOAT *conf)
+{
+    pitchyin_run(p, in, 1);
+    *freq = p->freq;
+    *amp = p->amp;
+    *conf = p->conf;
+    return SP_OK;
+}
+
+int sp_pitchyin_compute_block(sp_data *sp, sp_pitchyin *p, const SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp, SPFLOAT *conf, uint32_t n)
+{
+    uint32_t i = 0, j, len;
+
+    if (freq == NULL && amp == NULL && conf == NULL) {
+        pitchyin_run(p, in, n);
+        return SP_OK;
+    }
+
+    /* the outputs only change on a hop, so run up to each one */
+    while (i < n) {
+        len = (uint32_t)((p->hopsize - p->hcnt) * p->decim - p->dcnt);
+        if (len > n - i) len = n - i;
+        for (j = i; j < i + len; j++) {
+            if (freq != NULL) freq[j] = p->freq;
+            if (amp != NULL) amp[j] = p->amp;
+            if (conf != NULL) conf[j] = p->conf;
+        }
+        pitchyin_run(p, in + i, len);
+        i += len;
+        /* the last sample may have completed a hop */
+        if (freq != NULL) freq[i - 1] = p->freq;
+        if (amp != NULL) amp[i - 1] = p->amp;
+        if (conf != NULL) conf[i - 1] = p->conf;
+    }
+    return SP_OK;
+}
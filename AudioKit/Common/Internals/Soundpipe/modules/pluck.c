@@ -19,7 +19,7 @@
  
 int sp_pluck_create(sp_pluck **p)
 {
-    *p = malloc(sizeof(sp_pluck));
+    *p = sp_malloc(sizeof(sp_pluck));
     return SP_OK;
 }
 
@@ -27,7 +27,7 @@ int sp_pluck_destroy(sp_pluck **p)
 {
     sp_pluck *pp = *p;
     sp_auxdata_free(&pp->auxch);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -37,7 +37,7 @@ static void sp_pluck_reinit(sp_data *sp, sp_pluck *p)
     SPFLOAT val = 0;
     SPFLOAT *ap = (SPFLOAT *)p->auxch.ptr;
     for (n=p->npts; n--; ) {   
-        val = (SPFLOAT) ((SPFLOAT) sp_rand(sp) / SP_RANDMAX);
+        val = (SPFLOAT) ((SPFLOAT) sp_prng_rand(&p->prng) / SP_RANDMAX);
         *ap++ = (val * 2) - 1;
     }
     p->phs256 = 0;
@@ -59,6 +59,7 @@ int sp_pluck_init(sp_data *sp, sp_pluck *p, SPFLOAT ifreq)
     p->maxpts = npts;
     p->npts = npts;
 
+    sp_prng_init(sp, &p->prng);
     sp_pluck_reinit(sp, p);
     /* tuned pitch convt */
     p->sicps = (npts * 256.0 + 128.0) * (1.0 / sp->sr);
@@ -109,3 +110,12 @@ int sp_pluck_compute(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out)
     p->phs256 = phs256;
     return SP_OK;
 }
+
+int sp_pluck_compute_block(sp_data *sp, sp_pluck *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_pluck_compute(sp, p, (SPFLOAT *)&trig[i], &out[i]);
+    }
+    return SP_OK;
+}
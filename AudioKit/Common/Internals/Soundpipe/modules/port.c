@@ -24,13 +24,13 @@
 
 int sp_port_create(sp_port **p)
 {
-    *p = malloc(sizeof(sp_port));
+    *p = sp_malloc(sizeof(sp_port));
     return SP_OK;
 }
 
 int sp_port_destroy(sp_port **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -47,12 +47,26 @@ int sp_port_init(sp_data *sp, sp_port *p, SPFLOAT htime)
 
 int sp_port_compute(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out)
 {
+    return sp_port_compute_block(sp, p, in, out, 1);
+}
+
+int sp_port_compute_block(sp_data *sp, sp_port *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT c1, c2, yt1;
+    uint32_t i;
+
     if(p->prvhtim != p->htime){
         p->c2 = pow(0.5, p->onedsr / p->htime);
         p->c1 = 1.0 - p->c2;
         p->prvhtim = p->htime;
     }
 
-    *out = p->yt1 = p->c1 * *in + p->c2 * p->yt1;
+    c1 = p->c1;
+    c2 = p->c2;
+    yt1 = p->yt1;
+    for(i = 0; i < n; i++) {
+        out[i] = yt1 = c1 * in[i] + c2 * yt1;
+    }
+    p->yt1 = yt1;
     return SP_OK;
 }
@@ -15,13 +15,13 @@
 #include "soundpipe.h"
 int sp_posc3_create(sp_posc3 **posc3)
 {
-    *posc3 = malloc(sizeof(sp_posc3));
+    *posc3 = sp_malloc(sizeof(sp_posc3));
     return SP_OK;
 }
 
 int sp_posc3_destroy(sp_posc3 **posc3)
 {
-    free(*posc3);
+    sp_free(*posc3);
     return SP_NOT_OK;
 }
 
@@ -41,46 +41,54 @@ int sp_posc3_init(sp_data *sp, sp_posc3 *posc3, sp_ftbl *ft)
 }
 
 int sp_posc3_compute(sp_data *sp, sp_posc3 *posc3, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_posc3_compute_block(sp, posc3, in, out, 1);
+}
+
+int sp_posc3_compute_block(sp_data *sp, sp_posc3 *posc3, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT *ftab;
     SPFLOAT fract;
     SPFLOAT phs  = posc3->phs;
     SPFLOAT si   = posc3->freq * posc3->tablen * posc3->onedsr;
     SPFLOAT amp = posc3->amp;
+    int32_t tablen = posc3->tablen;
     int x0;
     SPFLOAT y0, y1, ym1, y2;
+    uint32_t i;
 
     ftab = posc3->tbl->tbl;
 
-    x0    = (int32_t )phs;
-    fract = (SPFLOAT)(phs - (SPFLOAT)x0);
-    x0--;
+    for(i = 0; i < n; i++) {
+        x0    = (int32_t )phs;
+        fract = (SPFLOAT)(phs - (SPFLOAT)x0);
+        x0--;
 
-    if (x0<0) {
-        ym1 = ftab[posc3->tablen-1]; x0 = 0;
-    }
-    else ym1 = ftab[x0++];
-    y0    = ftab[x0++];
-    y1    = ftab[x0++];
-    if (x0>posc3->tablen) y2 = ftab[1];
-    else y2 = ftab[x0];
-    {
-        SPFLOAT frsq = fract*fract;
-        SPFLOAT frcu = frsq*ym1;
-        SPFLOAT t1   = y2 + y0+y0+y0;
-        *out     = amp * (y0 + 0.5 *frcu +
-        fract*(y1 - frcu/6.0 - t1/6.0
-        - ym1/3.0) +
-        frsq*fract*(t1/6.0 - 0.5*y1) +
-        frsq*(0.5* y1 - y0));
-    }
-    phs += si;
-    while (phs >= posc3->tablen) {
-        phs -= posc3->tablen;
-    }
-    while (phs < 0.0) {
-        phs += posc3->tablen;
-        posc3->phs = phs;
+        if (x0<0) {
+            ym1 = ftab[tablen-1]; x0 = 0;
+        }
+        else ym1 = ftab[x0++];
+        y0    = ftab[x0++];
+        y1    = ftab[x0++];
+        if (x0>tablen) y2 = ftab[1];
+        else y2 = ftab[x0];
+        {
+            SPFLOAT frsq = fract*fract;
+            SPFLOAT frcu = frsq*ym1;
+            SPFLOAT t1   = y2 + y0+y0+y0;
+            out[i]   = amp * (y0 + 0.5 *frcu +
+            fract*(y1 - frcu/6.0 - t1/6.0
+            - ym1/3.0) +
+            frsq*fract*(t1/6.0 - 0.5*y1) +
+            frsq*(0.5* y1 - y0));
+        }
+        phs += si;
+        while (phs >= tablen) {
+            phs -= tablen;
+        }
+        while (phs < 0.0) {
+            phs += tablen;
+        }
     }
     posc3->phs = phs;
     return SP_OK;
@@ -0,0 +1,140 @@
+/*
+ * prng
+ *
+ * SP_PRNG_LANES interleaved xoshiro128+ generators (Blackman and Vigna,
+ * 2018), seeded through splitmix64. Each step advances all lanes at once;
+ * the values are handed out lane by lane, and calls that need fewer than a
+ * full step take them from buf.
+ *
+ */
+
+#include <stdint.h>
+#include "soundpipe.h"
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* the state goes through locals so the compiler can keep it in vector
+ * registers without worrying that out aliases it */
+static void prng_step(sp_prng *p, uint32_t *out)
+{
+    uint32_t s0[SP_PRNG_LANES], s1[SP_PRNG_LANES];
+    uint32_t s2[SP_PRNG_LANES], s3[SP_PRNG_LANES];
+    uint32_t r[SP_PRNG_LANES], t;
+    int l;
+    for(l = 0; l < SP_PRNG_LANES; l++) {
+        s0[l] = p->s[0][l]; s1[l] = p->s[1][l];
+        s2[l] = p->s[2][l]; s3[l] = p->s[3][l];
+    }
+    for(l = 0; l < SP_PRNG_LANES; l++) {
+        r[l] = s0[l] + s3[l];
+        t = s1[l] << 9;
+        s2[l] ^= s0[l];
+        s3[l] ^= s1[l];
+        s1[l] ^= s2[l];
+        s0[l] ^= s3[l];
+        s2[l] ^= t;
+        s3[l] = (s3[l] << 11) | (s3[l] >> 21);
+    }
+    for(l = 0; l < SP_PRNG_LANES; l++) {
+        p->s[0][l] = s0[l]; p->s[1][l] = s1[l];
+        p->s[2][l] = s2[l]; p->s[3][l] = s3[l];
+        out[l] = r[l];
+    }
+}
+
+void sp_prng_seed(sp_prng *p, uint32_t seed)
+{
+    uint64_t x = seed, a, b;
+    int l;
+    for(l = 0; l < SP_PRNG_LANES; l++) {
+        a = splitmix64(&x);
+        b = splitmix64(&x);
+        p->s[0][l] = (uint32_t)a;
+        p->s[1][l] = (uint32_t)(a >> 32);
+        p->s[2][l] = (uint32_t)b;
+        p->s[3][l] = (uint32_t)(b >> 32);
+        /* the all zero state never leaves zero */
+        if((a | b) == 0) p->s[0][l] = 1;
+    }
+    p->pos = SP_PRNG_LANES;
+    p->gpos = SP_PRNG_LANES;
+}
+
+void sp_prng_init(sp_data *sp, sp_prng *p)
+{
+    sp_prng_seed(p, sp_rand(sp));
+}
+
+uint32_t sp_prng_rand(sp_prng *p)
+{
+    if(p->pos == SP_PRNG_LANES) {
+        prng_step(p, p->buf);
+        p->pos = 0;
+    }
+    return p->buf[p->pos++] >> 1;
+}
+
+void sp_prng_uniform(sp_prng *p, SPFLOAT *out, uint32_t n, SPFLOAT lo, SPFLOAT hi)
+{
+    /* top 24 bits, exact in single precision */
+    SPFLOAT scale = (hi - lo) * (SPFLOAT)(1.0 / 16777216.0);
+    uint32_t r[SP_PRNG_LANES];
+    uint32_t i = 0;
+    int l;
+
+    while(i < n && p->pos < SP_PRNG_LANES) {
+        out[i++] = lo + (SPFLOAT)(p->buf[p->pos++] >> 8) * scale;
+    }
+    for(; i + SP_PRNG_LANES <= n; i += SP_PRNG_LANES) {
+        prng_step(p, r);
+        for(l = 0; l < SP_PRNG_LANES; l++) {
+            out[i + l] = lo + (SPFLOAT)(r[l] >> 8) * scale;
+        }
+    }
+    if(i < n) {
+        prng_step(p, p->buf);
+        p->pos = 0;
+        while(i < n) out[i++] = lo + (SPFLOAT)(p->buf[p->pos++] >> 8) * scale;
+    }
+}
+
+/* SP_PRNG_LANES normal values with unit variance. The uniforms come
+ * straight from the lanes, so this does not use buf. */
+static void prng_gauss_step(sp_prng *p, SPFLOAT *out)
+{
+    uint32_t r[SP_PRNG_LANES];
+    SPFLOAT acc[SP_PRNG_LANES];
+    int k, l;
+    for(l = 0; l < SP_PRNG_LANES; l++) acc[l] = -6;
+    for(k = 0; k < 12; k++) {
+        prng_step(p, r);
+        for(l = 0; l < SP_PRNG_LANES; l++) {
+            acc[l] += (SPFLOAT)(r[l] >> 8) * (SPFLOAT)(1.0 / 16777216.0);
+        }
+    }
+    for(l = 0; l < SP_PRNG_LANES; l++) out[l] = acc[l];
+}
+
+void sp_prng_gauss(sp_prng *p, SPFLOAT *out, uint32_t n, SPFLOAT sigma)
+{
+    SPFLOAT g[SP_PRNG_LANES];
+    uint32_t i = 0;
+    int l;
+
+    while(i < n && p->gpos < SP_PRNG_LANES) out[i++] = p->gbuf[p->gpos++] * sigma;
+    for(; i + SP_PRNG_LANES <= n; i += SP_PRNG_LANES) {
+        prng_gauss_step(p, g);
+        for(l = 0; l < SP_PRNG_LANES; l++) out[i + l] = g[l] * sigma;
+    }
+    if(i < n) {
+        prng_gauss_step(p, p->gbuf);
+        p->gpos = 0;
+        while(i < n) out[i++] = p->gbuf[p->gpos++] * sigma;
+    }
+}
@@ -3,13 +3,13 @@
 
 int sp_progress_create(sp_progress **p)
 {
-    *p = malloc(sizeof(sp_progress));
+    *p = sp_malloc(sizeof(sp_progress));
     return SP_OK;
 }
 
 int sp_progress_destroy(sp_progress **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -46,3 +46,12 @@ int sp_progress_compute(sp_data *sp, sp_progress *p, SPFLOAT *in, SPFLOAT *out)
     p->counter %= p->skip;
     return SP_OK;
 }
+
+int sp_progress_compute_block(sp_data *sp, sp_progress *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_progress_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -23,7 +23,7 @@ PSTATUS_OK
 
 int sp_prop_create(sp_prop **p)
 {
-    *p = malloc(sizeof(sp_prop));
+    *p = sp_malloc(sizeof(sp_prop));
     return SP_OK;
 }
 
@@ -31,7 +31,7 @@ int sp_prop_destroy(sp_prop **p)
 {
     sp_prop *pp = *p;
     prop_destroy(&pp->prp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -71,9 +71,18 @@ int sp_prop_compute(sp_data *sp, sp_prop *p, SPFLOAT *in, SPFLOAT *out)
     return SP_OK;
 }
 
+int sp_prop_compute_block(sp_data *sp, sp_prop *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_prop_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
+
 static void mode_insert(prop_data *pd, char type)
 {
-    prop_event *evt = malloc(sizeof(prop_event));
+    prop_event *evt = sp_malloc(sizeof(prop_event));
     evt->type = type;
     evt->val = pd->mul;
     evt->pos = pd->num;
@@ -117,7 +126,7 @@ static void mode_unsetcons(prop_data *pd)
 
 int prop_create(prop_data **pd)
 {
-    *pd = malloc(sizeof(prop_data));
+    *pd = sp_malloc(sizeof(prop_data));
     prop_data *pdp = *pd;
 
     pdp->num = 0;
@@ -232,11 +241,11 @@ int prop_destroy(prop_data **pd)
 
     for(i = 0; i < pdp->num; i++) {
         next = evt->next;
-        free(evt);
+        sp_free(evt);
         evt = next;
     }
 
-    free(*pd);
+    sp_free(*pd);
     return PSTATUS_OK;
 }
 
@@ -3,13 +3,13 @@
 
 int sp_randh_create(sp_randh **p)
 {
-    *p = malloc(sizeof(sp_randh));
+    *p = sp_malloc(sizeof(sp_randh));
     return SP_OK;
 }
 
 int sp_randh_destroy(sp_randh **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -21,13 +21,14 @@ int sp_randh_init(sp_data *sp, sp_randh *p)
     p->min = 0;
     p->max = 1;
     p->val = 0;
+    sp_prng_init(sp, &p->prng);
     return SP_OK;
 }
 
 int sp_randh_compute(sp_data *sp, sp_randh *p, SPFLOAT *in, SPFLOAT *out)
 {
     if(p->counter == 0) {
-        p->val = p->min + ((SPFLOAT) sp_rand(sp) / SP_RANDMAX) * (p->max - p->min);
+        p->val = p->min + ((SPFLOAT) sp_prng_rand(&p->prng) / SP_RANDMAX) * (p->max - p->min);
         p->dur =(sp->sr / p->freq);
         *out = p->val;
     } else {
@@ -36,3 +37,12 @@ int sp_randh_compute(sp_data *sp, sp_randh *p, SPFLOAT *in, SPFLOAT *out)
     p->counter = (p->counter + 1) % p->dur;
     return SP_OK;
 }
+
+int sp_randh_compute_block(sp_data *sp, sp_randh *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_randh_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -25,13 +25,13 @@
 
 int sp_randi_create(sp_randi **p)
 {
-    *p = malloc(sizeof(sp_randi));
+    *p = sp_malloc(sizeof(sp_randi));
     return SP_OK;
 }
 
 int sp_randi_destroy(sp_randi **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -94,3 +94,12 @@ int sp_randi_compute(sp_data *sp, sp_randi *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_randi_compute_block(sp_data *sp, sp_randi *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_randi_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
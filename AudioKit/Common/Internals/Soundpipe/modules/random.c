@@ -3,13 +3,13 @@
 
 int sp_random_create(sp_random **p)
 {
-    *p = malloc(sizeof(sp_random));
+    *p = sp_malloc(sizeof(sp_random));
     return SP_OK;
 }
 
 int sp_random_destroy(sp_random **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -17,15 +17,25 @@ int sp_random_init(sp_data *sp, sp_random *p)
 {
     p->min = -1;
     p->max = 1;
+    sp_prng_init(sp, &p->prng);
     return SP_OK;
 }
 
 int sp_random_compute(sp_data *sp, sp_random *p, SPFLOAT *in, SPFLOAT *out)
 {
     /* Send the signal's input to the output */
-    SPFLOAT rnd = ((sp_rand(sp) % RAND_MAX) / (RAND_MAX * 1.0));
+    SPFLOAT rnd = ((sp_prng_rand(&p->prng) % RAND_MAX) / (RAND_MAX * 1.0));
     rnd *= (p->max - p->min);
     rnd += p->min;
     *out = rnd;
     return SP_OK;
 }
+
+int sp_random_compute_block(sp_data *sp, sp_random *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_random_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
@@ -4,7 +4,7 @@
 
 int sp_reverse_create(sp_reverse **p)
 {
-    *p = malloc(sizeof(sp_reverse));
+    *p = sp_malloc(sizeof(sp_reverse));
     return SP_OK;
 }
 
@@ -12,7 +12,7 @@ int sp_reverse_destroy(sp_reverse **p)
 {
     sp_reverse *pp = *p;
     sp_auxdata_free(&pp->buf);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -32,3 +32,12 @@ int sp_reverse_compute(sp_data *sp, sp_reverse *p, SPFLOAT *in, SPFLOAT *out)
     p->bufpos = (p->bufpos + 1) % p->bufsize;
     return SP_OK;
 }
+
+int sp_reverse_compute_block(sp_data *sp, sp_reverse *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_reverse_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
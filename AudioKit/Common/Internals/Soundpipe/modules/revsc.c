@@ -8,12 +8,24 @@
  * Year: 1999, 2005
  * Location: Opcodes/reverbsc.c
  *
+ * The 8 delay lines are stored structure-of-arrays and each sample runs
+ * them side by side: with SSE2 or NEON, as two 4-lane vectors, the
+ * pointer updates, the cubic interpolation and the damping filters run in
+ * vector lanes, and only the delay line writes stay scalar. Every line keeps one guard sample before
+ * and two after its buffer, mirrored on write, so the four interpolation
+ * taps never need a wrap-around check. The random delay modulation only
+ * changes at segment ends; blocks are run in spans between them.
+ *
  */
 
 #include <math.h>
 #include <stdlib.h>
 #include <stdint.h>
-#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 #include "soundpipe.h"
 
 #define DEFAULT_SRATE   44100.0
@@ -45,17 +57,17 @@ static const SPFLOAT reverbParams[8][4] = {
 };
 
 static int delay_line_max_samples(SPFLOAT sr, SPFLOAT iPitchMod, int n);
-static int init_delay_line(sp_revsc *p, sp_revsc_dl *lp, int n);
-static int delay_line_bytes_alloc(SPFLOAT sr, SPFLOAT iPitchMod, int n);
+static int init_delay_line(sp_revsc *p, int n);
 static const SPFLOAT outputGain  = 0.35;
 static const SPFLOAT jpScale     = 0.25;
 int sp_revsc_create(sp_revsc **p){
-    *p = malloc(sizeof(sp_revsc));
+    *p = sp_malloc(sizeof(sp_revsc));
     return SP_OK;
 }
 
 int sp_revsc_init(sp_data *sp, sp_revsc *p)
 {
+    int i, nSamples = 0;
     p->iSampleRate = sp->sr;
     p->sampleRate = sp->sr;
     p->feedback = 0.97;
@@ -65,16 +77,14 @@ int sp_revsc_init(sp_data *sp, sp_revsc *p)
     p->dampFact = 1.0;
     p->prv_LPFreq = 0.0;
     p->initDone = 1;
-    int i, nBytes = 0;
-    for(i = 0; i < 8; i++){
-        nBytes += delay_line_bytes_alloc(sp->sr, 1, i);
+    for (i = 0; i < 8; i++) {
+        p->offset[i] = nSamples;
+        /* guard samples: one before the line, two after */
+        nSamples += delay_line_max_samples(sp->sr, 1, i) + 3;
     }
-    sp_auxdata_alloc(&p->aux, nBytes);
-    nBytes = 0;
+    sp_auxdata_alloc(&p->aux, nSamples * sizeof(SPFLOAT));
     for (i = 0; i < 8; i++) {
-        p->delayLines[i].buf = (p->aux.ptr) + nBytes;
-        init_delay_line(p, &p->delayLines[i], i);
-        nBytes += delay_line_bytes_alloc(sp->sr, 1, i);
+        init_delay_line(p, i);
     }
 
     return SP_OK;
@@ -85,7 +95,7 @@ int sp_revsc_destroy(sp_revsc **p)
 {
     sp_revsc *pp = *p;
     sp_auxdata_free(&pp->aux);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -98,179 +108,354 @@ static int delay_line_max_samples(SPFLOAT sr, SPFLOAT iPitchMod, int n)
     return (int) (maxDel * sr + 16.5);
 }
 
-static int delay_line_bytes_alloc(SPFLOAT sr, SPFLOAT iPitchMod, int n)
-{
-    int nBytes = 0;
-
-    nBytes += (delay_line_max_samples(sr, iPitchMod, n) * (int) sizeof(SPFLOAT));
-    return nBytes;
-}
-
-static void next_random_lineseg(sp_revsc *p, sp_revsc_dl *lp, int n)
+static void next_random_lineseg(sp_revsc *p, int n)
 {
     SPFLOAT prvDel, nxtDel, phs_incVal;
+    int seedVal = p->seedVal[n];
 
     /* update random seed */
-    if (lp->seedVal < 0)
-      lp->seedVal += 0x10000;
-    lp->seedVal = (lp->seedVal * 15625 + 1) & 0xFFFF;
-    if (lp->seedVal >= 0x8000)
-      lp->seedVal -= 0x10000;
+    if (seedVal < 0)
+      seedVal += 0x10000;
+    seedVal = (seedVal * 15625 + 1) & 0xFFFF;
+    if (seedVal >= 0x8000)
+      seedVal -= 0x10000;
+    p->seedVal[n] = seedVal;
     /* length of next segment in samples */
-    lp->randLine_cnt = (int) ((p->sampleRate / reverbParams[n][2]) + 0.5);
-    prvDel = (SPFLOAT) lp->writePos;
-    prvDel -= ((SPFLOAT) lp->readPos
-               + ((SPFLOAT) lp->readPosFrac / (SPFLOAT) DELAYPOS_SCALE));
+    p->randLine_cnt[n] = (int) ((p->sampleRate / reverbParams[n][2]) + 0.5);
+    prvDel = (SPFLOAT) p->writePos[n];
+    prvDel -= ((SPFLOAT) p->readPos[n]
+               + ((SPFLOAT) p->readPosFrac[n] / (SPFLOAT) DELAYPOS_SCALE));
     while (prvDel < 0.0)
-      prvDel += lp->bufferSize;
+      prvDel += p->bufferSize[n];
     prvDel = prvDel / p->sampleRate;    /* previous delay time in seconds */
-    nxtDel = (SPFLOAT) lp->seedVal * reverbParams[n][1] / 32768.0;
+    nxtDel = (SPFLOAT) seedVal * reverbParams[n][1] / 32768.0;
     /* next delay time in seconds */
     nxtDel = reverbParams[n][0] + (nxtDel * (SPFLOAT) p->iPitchMod);
     /* calculate phase increment per sample */
-    phs_incVal = (prvDel - nxtDel) / (SPFLOAT) lp->randLine_cnt;
+    phs_incVal = (prvDel - nxtDel) / (SPFLOAT) p->randLine_cnt[n];
     phs_incVal = phs_incVal * p->sampleRate + 1.0;
-    lp->readPosFrac_inc = (int) (phs_incVal * DELAYPOS_SCALE + 0.5);
+    p->readPosFrac_inc[n] = (int) (phs_incVal * DELAYPOS_SCALE + 0.5);
 }
 
-static int init_delay_line(sp_revsc *p, sp_revsc_dl *lp, int n)
+static int init_delay_line(sp_revsc *p, int n)
 {
     SPFLOAT readPos;
-    /* int     i; */
+    SPFLOAT *buf = (SPFLOAT *)p->aux.ptr + p->offset[n];
+    int i;
 
     /* calculate length of delay line */
-    lp->bufferSize = delay_line_max_samples(p->sampleRate, 1, n);
-    lp->dummy = 0;
-    lp->writePos = 0;
+    p->bufferSize[n] = delay_line_max_samples(p->sampleRate, 1, n);
+    p->writePos[n] = 0;
     /* set random seed */
-    lp->seedVal = (int) (reverbParams[n][3] + 0.5);
+    p->seedVal[n] = (int) (reverbParams[n][3] + 0.5);
     /* set initial delay time */
-    readPos = (SPFLOAT) lp->seedVal * reverbParams[n][1] / 32768;
+    readPos = (SPFLOAT) p->seedVal[n] * reverbParams[n][1] / 32768;
     readPos = reverbParams[n][0] + (readPos * (SPFLOAT) p->iPitchMod);
-    readPos = (SPFLOAT) lp->bufferSize - (readPos * p->sampleRate);
-    lp->readPos = (int) readPos;
-    readPos = (readPos - (SPFLOAT) lp->readPos) * (SPFLOAT) DELAYPOS_SCALE;
-    lp->readPosFrac = (int) (readPos + 0.5);
+    readPos = (SPFLOAT) p->bufferSize[n] - (readPos * p->sampleRate);
+    p->readPos[n] = (int) readPos;
+    readPos = (readPos - (SPFLOAT) p->readPos[n]) * (SPFLOAT) DELAYPOS_SCALE;
+    p->readPosFrac[n] = (int) (readPos + 0.5);
     /* initialise first random line segment */
-    next_random_lineseg(p, lp, n);
+    next_random_lineseg(p, n);
     /* clear delay line to zero */
-    lp->filterState = 0.0;
-    memset(lp->buf, 0, sizeof(SPFLOAT) * lp->bufferSize);
+    p->filterState[n] = 0.0;
+    for (i = 0; i < p->bufferSize[n] + 3; i++) buf[i] = 0;
     return SP_OK;
 }
 
-
-int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+#if defined(__SSE2__)
+#define REVSC_SIMD
+typedef __m128 revsc_vf;
+typedef __m128i revsc_vi;
+#define revsc_ld(p) _mm_loadu_ps(p)
+#define revsc_st(p, v) _mm_storeu_ps(p, v)
+#define revsc_dup(x) _mm_set1_ps(x)
+#define revsc_add(a, b) _mm_add_ps(a, b)
+#define revsc_sub(a, b) _mm_sub_ps(a, b)
+#define revsc_mul(a, b) _mm_mul_ps(a, b)
+#define revsc_ild(p) _mm_loadu_si128((const __m128i *)(p))
+#define revsc_ist(p, v) _mm_storeu_si128((__m128i *)(p), v)
+
+/* the read pointer update of 4 lines; returns the fractional positions */
+static inline revsc_vf revsc_advance(revsc_vi *rp, revsc_vi *rpf,
+        revsc_vi inc, revsc_vi bs)
 {
-    SPFLOAT ainL, ainR, aoutL, aoutR;
-    SPFLOAT vm1, v0, v1, v2, am1, a0, a1, a2, frac;
-    sp_revsc_dl *lp;
-    int readPos;
-    uint32_t n;
-    int bufferSize; /* Local copy */
-    SPFLOAT dampFact = p->dampFact;
+    revsc_vf frac;
+    *rp = _mm_add_epi32(*rp, _mm_srli_epi32(*rpf, DELAYPOS_SHIFT));
+    *rpf = _mm_and_si128(*rpf, _mm_set1_epi32(DELAYPOS_MASK));
+    *rp = _mm_sub_epi32(*rp, _mm_andnot_si128(_mm_cmpgt_epi32(bs, *rp), bs));
+    frac = _mm_mul_ps(_mm_cvtepi32_ps(*rpf),
+            _mm_set1_ps((SPFLOAT)(1.0 / DELAYPOS_SCALE)));
+    *rpf = _mm_add_epi32(*rpf, inc);
+    return frac;
+}
 
-    if (p->initDone <= 0) return SP_NOT_OK;
+static inline void revsc_transpose(revsc_vf *r)
+{
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define REVSC_SIMD
+typedef float32x4_t revsc_vf;
+typedef int32x4_t revsc_vi;
+#define revsc_ld(p) vld1q_f32(p)
+#define revsc_st(p, v) vst1q_f32(p, v)
+#define revsc_dup(x) vdupq_n_f32(x)
+#define revsc_add(a, b) vaddq_f32(a, b)
+#define revsc_sub(a, b) vsubq_f32(a, b)
+#define revsc_mul(a, b) vmulq_f32(a, b)
+#define revsc_ild(p) vld1q_s32(p)
+#define revsc_ist(p, v) vst1q_s32(p, v)
+
+static inline revsc_vf revsc_advance(revsc_vi *rp, revsc_vi *rpf,
+        revsc_vi inc, revsc_vi bs)
+{
+    revsc_vf frac;
+    *rp = vaddq_s32(*rp, vreinterpretq_s32_u32(
+                vshrq_n_u32(vreinterpretq_u32_s32(*rpf), DELAYPOS_SHIFT)));
+    *rpf = vandq_s32(*rpf, vdupq_n_s32(DELAYPOS_MASK));
+    *rp = vbslq_s32(vcgtq_s32(bs, *rp), *rp, vsubq_s32(*rp, bs));
+    frac = vmulq_n_f32(vcvtq_f32_s32(*rpf), (SPFLOAT)(1.0 / DELAYPOS_SCALE));
+    *rpf = vaddq_s32(*rpf, inc);
+    return frac;
+}
 
-    /* calculate tone filter coefficient if frequency changed */
+static inline void revsc_transpose(revsc_vf *r)
+{
+    float32x4x2_t t01 = vtrnq_f32(r[0], r[1]);
+    float32x4x2_t t23 = vtrnq_f32(r[2], r[3]);
+    r[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
 
-    if (p->lpfreq != p->prv_LPFreq) {
-        p->prv_LPFreq = p->lpfreq;
-        dampFact = 2.0 - cos(p->prv_LPFreq * (2 * M_PI) / p->sampleRate);
-        dampFact = p->dampFact = dampFact - sqrt(dampFact * dampFact - 1.0);
+#if defined(REVSC_SIMD)
+/* runs all 8 lines for n samples, none of which ends a random segment.
+ * Lines 0-3 and 4-7 are one vector each; the four interpolation taps of a
+ * line are one unaligned load, transposed into tap vectors. */
+static void revsc_span(sp_revsc *p, const SPFLOAT *in1, const SPFLOAT *in2,
+        SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
+{
+    SPFLOAT *buf = p->aux.ptr;
+    const revsc_vf one = revsc_dup(1), half = revsc_dup(0.5f);
+    const revsc_vf three = revsc_dup(3), sixth = revsc_dup((SPFLOAT)(1.0 / 6.0));
+    const revsc_vf feedback = revsc_dup(p->feedback);
+    const revsc_vf dampFact = revsc_dup(p->dampFact);
+    revsc_vf fs[2], frac, tap[4], am1, a0, a1, a2, v0;
+    revsc_vi rp[2], rpf[2], inc[2], bs[2];
+    SPFLOAT fsa[8], ainL, ainR, x, junction;
+    int wp[8], rpa[8], w, l, k;
+    uint32_t i;
+
+    for (k = 0; k < 2; k++) {
+        fs[k] = revsc_ld(p->filterState + 4 * k);
+        rp[k] = revsc_ild(p->readPos + 4 * k);
+        rpf[k] = revsc_ild(p->readPosFrac + 4 * k);
+        inc[k] = revsc_ild(p->readPosFrac_inc + 4 * k);
+        bs[k] = revsc_ild(p->bufferSize + 4 * k);
     }
+    for (l = 0; l < 8; l++) {
+        wp[l] = p->writePos[l];
+        fsa[l] = p->filterState[l];
+    }
+
+    for (i = 0; i < n; i++) {
+
+        /* calculate "resultant junction pressure" and mix to input signals */
+
+        junction = ((fsa[0] + fsa[1]) + (fsa[2] + fsa[3])) +
+            ((fsa[4] + fsa[5]) + (fsa[6] + fsa[7]));
+        junction *= jpScale;
+        ainL = junction + in1[i];
+        ainR = junction + in2[i];
+
+        /* send input signal and feedback to delay line, mirrored into the
+         * guard samples as in the scalar version */
+
+        for (l = 0; l < 8; l++) {
+            w = wp[l];
+            x = (l & 1 ? ainR : ainL) - fsa[l];
+            buf[p->offset[l] + w + 1] = x;
+            if (w < 2) {
+                buf[p->offset[l] + p->bufferSize[l] + 1 + w] = x;
+            } else if (w == p->bufferSize[l] - 1) {
+                buf[p->offset[l]] = x;
+            }
+            wp[l] = w + 1 == p->bufferSize[l] ? 0 : w + 1;
+        }
 
-    /* calculate "resultant junction pressure" and mix to input signals */
+        for (k = 0; k < 2; k++) {
+
+            /* advance the read position and fetch the four taps */
+
+            frac = revsc_advance(&rp[k], &rpf[k], inc[k], bs[k]);
+            revsc_ist(rpa + 4 * k, rp[k]);
+            for (l = 0; l < 4; l++) {
+                tap[l] = revsc_ld(buf + p->offset[4 * k + l] + rpa[4 * k + l]);
+            }
+            revsc_transpose(tap);
+
+            /* cubic interpolation, feedback gain and lowpass filter */
+
+            a2 = revsc_mul(revsc_sub(revsc_mul(frac, frac), one), sixth);
+            a1 = revsc_mul(revsc_add(frac, one), half);
+            am1 = revsc_sub(a1, one);
+            a0 = revsc_mul(three, a2);
+            a1 = revsc_sub(a1, a0);
+            am1 = revsc_sub(am1, a2);
+            a0 = revsc_sub(a0, frac);
+            v0 = revsc_add(revsc_add(revsc_mul(am1, tap[0]), revsc_mul(a0, tap[1])),
+                    revsc_add(revsc_mul(a1, tap[2]), revsc_mul(a2, tap[3])));
+            v0 = revsc_add(revsc_mul(v0, frac), tap[1]);
+            v0 = revsc_mul(v0, feedback);
+            fs[k] = revsc_add(revsc_mul(revsc_sub(fs[k], v0), dampFact), v0);
+            revsc_st(fsa + 4 * k, fs[k]);
+        }
 
-    ainL = aoutL = aoutR = 0.0;
-    for (n = 0; n < 8; n++) {
-        ainL += p->delayLines[n].filterState;
+        /* mix to output */
+
+        out1[i] = (fsa[0] + fsa[2] + fsa[4] + fsa[6]) * outputGain;
+        out2[i] = (fsa[1] + fsa[3] + fsa[5] + fsa[7]) * outputGain;
     }
-    ainL *= jpScale;
-    ainR = ainL + *in2;
-    ainL = ainL + *in1;
 
-    /* loop through all delay lines */
+    for (k = 0; k < 2; k++) {
+        revsc_st(p->filterState + 4 * k, fs[k]);
+        revsc_ist(p->readPos + 4 * k, rp[k]);
+        revsc_ist(p->readPosFrac + 4 * k, rpf[k]);
+    }
+    for (l = 0; l < 8; l++) {
+        p->writePos[l] = wp[l];
+        p->randLine_cnt[l] -= n;
+    }
+}
+#endif
+
+/* runs all 8 lines for n samples, none of which ends a random segment */
+#if !defined(REVSC_SIMD)
+static void revsc_span(sp_revsc *p, const SPFLOAT *in1, const SPFLOAT *in2,
+        SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
+{
+    SPFLOAT *buf = p->aux.ptr;
+    SPFLOAT feedback = p->feedback;
+    SPFLOAT dampFact = p->dampFact;
+    SPFLOAT vm1[8], v0[8], v1[8], v2[8], frac[8], fs[8], ain[8];
+    SPFLOAT am1, a0, a1, a2, junction, aoutL, aoutR;
+    int wp[8], bs[8], rp[8], rpf[8], inc[8], off[8];
+    int l, w, mirror;
+    uint32_t i;
+
+    for (l = 0; l < 8; l++) {
+        wp[l] = p->writePos[l];
+        bs[l] = p->bufferSize[l];
+        rp[l] = p->readPos[l];
+        rpf[l] = p->readPosFrac[l];
+        inc[l] = p->readPosFrac_inc[l];
+        off[l] = p->offset[l];
+        fs[l] = p->filterState[l];
+    }
 
-    for (n = 0; n < 8; n++) {
-        lp = &p->delayLines[n];
-        bufferSize = lp->bufferSize;
+    for (i = 0; i < n; i++) {
 
-        /* send input signal and feedback to delay line */
+        /* calculate "resultant junction pressure" and mix to input signals */
 
-        lp->buf[lp->writePos] = (SPFLOAT) ((n & 1 ? ainR : ainL)
-                                 - lp->filterState);
-        if (++lp->writePos >= bufferSize) {
-            lp->writePos -= bufferSize;
+        junction = 0.0;
+        for (l = 0; l < 8; l++) junction += fs[l];
+        junction *= jpScale;
+        for (l = 0; l < 8; l += 2) {
+            ain[l] = junction + in1[i];
+            ain[l + 1] = junction + in2[i];
         }
 
-        /* read from delay line with cubic interpolation */
+        /* send input signal and feedback to delay line. Sample k of a line
+         * lives at k + 1; k = size - 1 is mirrored to 0 and k < 2 to
+         * size + 1 + k. */
 
-        if (lp->readPosFrac >= DELAYPOS_SCALE) {
-            lp->readPos += (lp->readPosFrac >> DELAYPOS_SHIFT);
-            lp->readPosFrac &= DELAYPOS_MASK;
+        for (l = 0; l < 8; l++) {
+            w = wp[l];
+            mirror = w == bs[l] - 1 ? 0 : (w < 2 ? bs[l] + 1 + w : w + 1);
+            buf[off[l] + w + 1] = ain[l] - fs[l];
+            buf[off[l] + mirror] = ain[l] - fs[l];
+            wp[l] = w + 1 >= bs[l] ? w + 1 - bs[l] : w + 1;
         }
-        if (lp->readPos >= bufferSize)
-        lp->readPos -= bufferSize;
-        readPos = lp->readPos;
-        frac = (SPFLOAT) lp->readPosFrac * (1.0 / (SPFLOAT) DELAYPOS_SCALE);
-
-        /* calculate interpolation coefficients */
 
-        a2 = frac * frac; a2 -= 1.0; a2 *= (1.0 / 6.0);
-        a1 = frac; a1 += 1.0; a1 *= 0.5; am1 = a1 - 1.0;
-        a0 = 3.0 * a2; a1 -= a0; am1 -= a2; a0 -= frac;
+        /* advance the read position and fetch the four taps */
+
+        for (l = 0; l < 8; l++) {
+            rp[l] += rpf[l] >> DELAYPOS_SHIFT;
+            rpf[l] &= DELAYPOS_MASK;
+            rp[l] = rp[l] >= bs[l] ? rp[l] - bs[l] : rp[l];
+            frac[l] = (SPFLOAT) rpf[l] * (SPFLOAT)(1.0 / DELAYPOS_SCALE);
+            rpf[l] += inc[l];
+            vm1[l] = buf[off[l] + rp[l]];
+            v0[l] = buf[off[l] + rp[l] + 1];
+            v1[l] = buf[off[l] + rp[l] + 2];
+            v2[l] = buf[off[l] + rp[l] + 3];
+        }
 
-        /* read four samples for interpolation */
+        /* cubic interpolation, feedback gain and lowpass filter */
 
-        if (readPos > 0 && readPos < (bufferSize - 2)) {
-            vm1 = (SPFLOAT) (lp->buf[readPos - 1]);
-            v0  = (SPFLOAT) (lp->buf[readPos]);
-            v1  = (SPFLOAT) (lp->buf[readPos + 1]);
-            v2  = (SPFLOAT) (lp->buf[readPos + 2]);
-        }
-        else {
-
-        /* at buffer wrap-around, need to check index */
-
-        if (--readPos < 0) readPos += bufferSize;
-            vm1 = (SPFLOAT) lp->buf[readPos];
-        if (++readPos >= bufferSize) readPos -= bufferSize;
-            v0 = (SPFLOAT) lp->buf[readPos];
-        if (++readPos >= bufferSize) readPos -= bufferSize;
-            v1 = (SPFLOAT) lp->buf[readPos];
-        if (++readPos >= bufferSize) readPos -= bufferSize;
-            v2 = (SPFLOAT) lp->buf[readPos];
+        for (l = 0; l < 8; l++) {
+            a2 = frac[l] * frac[l]; a2 -= 1; a2 *= (SPFLOAT)(1.0 / 6.0);
+            a1 = frac[l]; a1 += 1; a1 *= 0.5f; am1 = a1 - 1;
+            a0 = 3 * a2; a1 -= a0; am1 -= a2; a0 -= frac[l];
+            v0[l] = (am1 * vm1[l] + a0 * v0[l] + a1 * v1[l] + a2 * v2[l]) *
+                frac[l] + v0[l];
+            v0[l] *= feedback;
+            fs[l] = (fs[l] - v0[l]) * dampFact + v0[l];
         }
-        v0 = (am1 * vm1 + a0 * v0 + a1 * v1 + a2 * v2) * frac + v0;
 
-        /* update buffer read position */
+        /* mix to output */
 
-        lp->readPosFrac += lp->readPosFrac_inc;
+        aoutL = fs[0] + fs[2] + fs[4] + fs[6];
+        aoutR = fs[1] + fs[3] + fs[5] + fs[7];
+        out1[i] = aoutL * outputGain;
+        out2[i] = aoutR * outputGain;
+    }
+
+    for (l = 0; l < 8; l++) {
+        p->writePos[l] = wp[l];
+        p->readPos[l] = rp[l];
+        p->readPosFrac[l] = rpf[l];
+        p->filterState[l] = fs[l];
+        p->randLine_cnt[l] -= n;
+    }
+}
+#endif
 
-        /* apply feedback gain and lowpass filter */
+int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_revsc_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
 
-        v0 *= (SPFLOAT) p->feedback;
-        v0 = (lp->filterState - v0) * dampFact + v0;
-        lp->filterState = v0;
+int sp_revsc_compute_block(sp_data *sp, sp_revsc *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
+{
+    SPFLOAT dampFact;
+    uint32_t i = 0, len;
+    int l;
 
-        /* mix to output */
+    if (p->initDone <= 0) return SP_NOT_OK;
 
-        if (n & 1) {
-            aoutR += v0;
-        }else{
-            aoutL += v0;
-        }
+    /* calculate tone filter coefficient if frequency changed */
 
-        /* start next random line segment if current one has reached endpoint */
+    if (p->lpfreq != p->prv_LPFreq) {
+        p->prv_LPFreq = p->lpfreq;
+        dampFact = 2.0 - cos(p->prv_LPFreq * (2 * M_PI) / p->sampleRate);
+        p->dampFact = dampFact - sqrt(dampFact * dampFact - 1.0);
+    }
 
-        if (--(lp->randLine_cnt) <= 0) {
-            next_random_lineseg(p, lp, n);
+    while (i < n) {
+        /* run up to the next random segment end */
+        len = n - i;
+        for (l = 0; l < 8; l++) {
+            if ((uint32_t)p->randLine_cnt[l] < len) len = p->randLine_cnt[l];
+        }
+        revsc_span(p, in1 + i, in2 + i, out1 + i, out2 + i, len);
+        i += len;
+        for (l = 0; l < 8; l++) {
+            if (p->randLine_cnt[l] <= 0) next_random_lineseg(p, l);
         }
     }
-    /* someday, use aoutR for multimono out */
-
-    *out1  = aoutL * outputGain;
-    *out2 = aoutR * outputGain;
     return SP_OK;
 }
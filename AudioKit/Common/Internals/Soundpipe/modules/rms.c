@@ -20,13 +20,13 @@
 
 int sp_rms_create(sp_rms **p)
 {
-    *p = malloc(sizeof(sp_rms));
+    *p = sp_malloc(sizeof(sp_rms));
     return SP_OK;
 }
 
 int sp_rms_destroy(sp_rms **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -45,16 +45,24 @@ int sp_rms_init(sp_data *sp, sp_rms *p)
 }
 
 int sp_rms_compute(sp_data *sp, sp_rms *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_rms_compute_block(sp, p, in, out, 1);
+}
+
+int sp_rms_compute_block(sp_data *sp, sp_rms *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT q;
     SPFLOAT c1 = p->c1, c2 = p->c2;
+    uint32_t i;
 
     q = p->prvq;
     
-    SPFLOAT as = *in;
-    q = c1 * as * as + c2 * q;
+    for(i = 0; i < n; i++) {
+        SPFLOAT as = in[i];
+        q = c1 * as * as + c2 * q;
+        out[i] = sqrt(q);
+    }
     
     p->prvq = q;
-    *out = sqrt(q);
     return SP_OK;
 }
@@ -3,7 +3,7 @@
 
 int sp_rpt_create(sp_rpt **p)
 {
-    *p = malloc(sizeof(sp_rpt));
+    *p = sp_malloc(sizeof(sp_rpt));
     return SP_OK;
 }
 
@@ -11,7 +11,7 @@ int sp_rpt_destroy(sp_rpt **p)
 {
     sp_rpt *pp = *p;
     sp_auxdata_free(&pp->aux);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -60,6 +60,15 @@ int sp_rpt_compute(sp_data *sp, sp_rpt *p, SPFLOAT *trig,
     return SP_OK;
 }
 
+int sp_rpt_compute_block(sp_data *sp, sp_rpt *p, const SPFLOAT *trig, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_rpt_compute(sp, p, (SPFLOAT *)&trig[i], (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
+
 int sp_rpt_set(sp_rpt *p, SPFLOAT bpm, int div, int rep)
 {
     uint32_t size = (p->sr * (60.0 / bpm)) / (SPFLOAT) div;
@@ -3,13 +3,13 @@
 
 int sp_samphold_create(sp_samphold **p)
 {
-    *p = malloc(sizeof(sp_samphold));
+    *p = sp_malloc(sizeof(sp_samphold));
     return SP_OK;
 }
 
 int sp_samphold_destroy(sp_samphold **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -27,3 +27,12 @@ int sp_samphold_compute(sp_data *sp, sp_samphold *p, SPFLOAT *trig, SPFLOAT *in,
     *out = p->val;
     return SP_OK;
 }
+
+int sp_samphold_compute_block(sp_data *sp, sp_samphold *p, const SPFLOAT *trig, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_samphold_compute(sp, p, (SPFLOAT *)&trig[i], (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -3,13 +3,13 @@
 
 int sp_scale_create(sp_scale **p)
 {
-    *p = malloc(sizeof(sp_scale));
+    *p = sp_malloc(sizeof(sp_scale));
     return SP_OK;
 }
 
 int sp_scale_destroy(sp_scale **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -22,6 +22,16 @@ int sp_scale_init(sp_data *sp, sp_scale *p)
 
 int sp_scale_compute(sp_data *sp, sp_scale *p, SPFLOAT *in, SPFLOAT *out)
 {
-    *out =  *in * (p->max - p->min) + p->min;
+    return sp_scale_compute_block(sp, p, in, out, 1);
+}
+
+int sp_scale_compute_block(sp_data *sp, sp_scale *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT min = p->min;
+    SPFLOAT range = p->max - p->min;
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        out[i] = in[i] * range + min;
+    }
     return SP_OK;
 }
@@ -3,13 +3,13 @@
 
 int sp_switch_create(sp_switch **p)
 {
-    *p = malloc(sizeof(sp_switch));
+    *p = sp_malloc(sizeof(sp_switch));
     return SP_OK;
 }
 
 int sp_switch_destroy(sp_switch **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -34,3 +34,12 @@ int sp_switch_compute(sp_data *sp, sp_switch *p, SPFLOAT *trig,
 
     return SP_OK;
 }
+
+int sp_switch_compute_block(sp_data *sp, sp_switch *p, const SPFLOAT *trig, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_switch_compute(sp, p, (SPFLOAT *)&trig[i], (SPFLOAT *)&in1[i], (SPFLOAT *)&in2[i], &out[i]);
+    }
+    return SP_OK;
+}
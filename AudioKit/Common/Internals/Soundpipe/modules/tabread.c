@@ -15,13 +15,13 @@
 
 int sp_tabread_create(sp_tabread **p)
 {
-    *p = malloc(sizeof(sp_tabread));
+    *p = sp_malloc(sizeof(sp_tabread));
     return SP_OK;
 }
 
 int sp_tabread_destroy(sp_tabread **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -75,3 +75,12 @@ int sp_tabread_compute(sp_data *sp, sp_tabread *p, SPFLOAT *in, SPFLOAT *out)
     *out = x1 + (x2 - x1) * frac;
     return SP_OK;
 }
+
+int sp_tabread_compute_block(sp_data *sp, sp_tabread *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tabread_compute(sp, p, NULL, &out[i]);
+    }
+    return SP_OK;
+}
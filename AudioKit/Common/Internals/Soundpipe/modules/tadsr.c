@@ -218,13 +218,13 @@ static void ADSR_setValue(sp_data *sp, sp_tadsr *a, SPFLOAT aValue)
 */
 int sp_tadsr_create(sp_tadsr **p)
 {
-    *p = malloc(sizeof(sp_tadsr));
+    *p = sp_malloc(sizeof(sp_tadsr));
     return SP_OK;
 }
 
 int sp_tadsr_destroy(sp_tadsr **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -262,3 +262,12 @@ int sp_tadsr_compute(sp_data *sp, sp_tadsr *p, SPFLOAT *trig, SPFLOAT *out)
     *out = ADSR_tick(p);
     return SP_OK;
 }
+
+int sp_tadsr_compute_block(sp_data *sp, sp_tadsr *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tadsr_compute(sp, p, (SPFLOAT *)&trig[i], &out[i]);
+    }
+    return SP_OK;
+}
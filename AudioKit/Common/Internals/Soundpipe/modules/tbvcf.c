@@ -24,13 +24,13 @@
 
 int sp_tbvcf_create(sp_tbvcf **p)
 {
-    *p = malloc(sizeof(sp_tbvcf));
+    *p = sp_malloc(sizeof(sp_tbvcf));
     return SP_OK;
 }
 
 int sp_tbvcf_destroy(sp_tbvcf **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -55,8 +55,13 @@ int sp_tbvcf_init(sp_data *sp, sp_tbvcf *p)
     return SP_OK;
 }
 
-/* TODO: clean up code here. */
 int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_tbvcf_compute_block(sp, p, in, out, 1);
+}
+
+/* TODO: clean up code here. */
+int sp_tbvcf_compute_block(sp_data *sp, sp_tbvcf *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT x;
     SPFLOAT fco, res, dist, asym;
@@ -64,48 +69,33 @@ int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out)
     /* The initialisations are fake to fool compiler warnings */
     SPFLOAT ih, fdbk, d, ad;
     SPFLOAT fc=0.0, fco1=0.0, q=0.0, q1=0.0;
+    uint32_t i;
 
     ih  = 0.001; /* ih is the incremental factor */
 
- /* Set up the pointers 
-    fcoptr  = p->fco;
-    resptr  = p->res;
-    distptr = p->dist;
-    asymptr = p->asym; */
-
- /* Get the values for the k-rate variables 
-    fco  = (SPFLOAT)*fcoptr;
-    res  = (SPFLOAT)*resptr;
-    dist = (SPFLOAT)*distptr;
-    asym = (SPFLOAT)*asymptr; */
-
     /* This should work in sp world */
     fco = p->fco;
     res = p->res;
     dist = p->dist;
     asym = p->asym;
 
- /* Try to decouple the variables */
-    if ((p->rezcod==0) && (p->fcocod==0)) { /* Calc once only */
-      q1   = res/(1.0 + sqrt(dist));
-      fco1 = pow(fco*260.0/(1.0+q1*0.5),0.58);
-      q    = q1*fco1*fco1*0.0005;
-      fc   = fco1*p->onedsr*(44100.0/8.0);
+    /* the coefficients only depend on the k-rate values, so they are
+     * worked out once per block */
+    q1   = res/(1.0 + sqrt(dist));
+    fco1 = pow(fco*260.0/(1.0+q1*0.5),0.58);
+    q    = q1*fco1*fco1*0.0005;
+    fc   = fco1*p->onedsr*(44100.0/8.0);
+
+    for(i = 0; i < n; i++) {
+        x  = in[i];
+        fdbk = q*y/(1.0 + exp(-3.0*y)*asym);
+        y1  = y1 + ih*((x - y1)*fc - fdbk);
+        d  = -0.1*y*20.0;
+        ad  = (d*d*d + y2)*100.0*dist;
+        y2  = y2 + ih*((y1 - y2)*fc + ad);
+        y  = y + ih*((y2 - y)*fc);
+        out[i] = (y*fc/1000.0*(1.0 + q1)*3.2);
     }
-      if ((p->rezcod!=0) || (p->fcocod!=0)) {
-        q1  = res/(1.0 + sqrt(dist));
-        fco1 = pow(fco*260.0/(1.0+q1*0.5),0.58);
-        q  = q1*fco1*fco1*0.0005;
-        fc  = fco1*p->onedsr*(44100.0/8.0);
-      }
-    x  = *in;
-    fdbk = q*y/(1.0 + exp(-3.0*y)*asym);
-    y1  = y1 + ih*((x - y1)*fc - fdbk);
-    d  = -0.1*y*20.0;
-    ad  = (d*d*d + y2)*100.0*dist;
-    y2  = y2 + ih*((y1 - y2)*fc + ad);
-    y  = y + ih*((y2 - y)*fc);
-    *out = (y*fc/1000.0*(1.0 + q1)*3.2);
 
     p->y = y; p->y1 = y1; p->y2 = y2;
     return SP_OK;
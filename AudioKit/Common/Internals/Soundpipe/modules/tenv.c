@@ -3,7 +3,7 @@
 
 int sp_tenv_create(sp_tenv **p)
 {
-    *p = malloc(sizeof(sp_tenv));
+    *p = sp_malloc(sizeof(sp_tenv));
     sp_tenv *pp = *p;
     sp_tevent_create(&pp->te);
     return SP_OK;
@@ -13,7 +13,7 @@ int sp_tenv_destroy(sp_tenv **p)
 {
     sp_tenv *pp = *p;
     sp_tevent_destroy(&pp->te);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -83,3 +83,12 @@ int sp_tenv_compute(sp_data *sp, sp_tenv *p, SPFLOAT *in, SPFLOAT *out)
     sp_tevent_compute(sp, p->te, in, out);
     return SP_OK;
 }
+
+int sp_tenv_compute_block(sp_data *sp, sp_tenv *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tenv_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -9,13 +9,13 @@ enum {
 
 int sp_tenv2_create(sp_tenv2 **p)
 {
-    *p = malloc(sizeof(sp_tenv2));
+    *p = sp_malloc(sizeof(sp_tenv2));
     return SP_OK;
 }
 
 int sp_tenv2_destroy(sp_tenv2 **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -65,3 +65,12 @@ int sp_tenv2_compute(sp_data *sp, sp_tenv2 *p, SPFLOAT *in, SPFLOAT *out)
     }
     return SP_OK;
 }
+
+int sp_tenv2_compute_block(sp_data *sp, sp_tenv2 *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tenv2_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -4,7 +4,7 @@
 
 int sp_tenvx_create(sp_tenvx **p)
 {
-    *p = malloc(sizeof(sp_tenvx));
+    *p = sp_malloc(sizeof(sp_tenvx));
     sp_tenvx *pp = *p;
     sp_tevent_create(&pp->te);
     return SP_OK;
@@ -14,7 +14,7 @@ int sp_tenvx_destroy(sp_tenvx **p)
 {
     sp_tenvx *pp = *p;
     sp_tevent_destroy(&pp->te);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -92,3 +92,12 @@ int sp_tenvx_compute(sp_data *sp, sp_tenvx *p, SPFLOAT *in, SPFLOAT *out)
     sp_tevent_compute(sp, p->te, in, out);
     return SP_OK;
 }
+
+int sp_tenvx_compute_block(sp_data *sp, sp_tenvx *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tenvx_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -3,13 +3,13 @@
 
 int sp_tevent_create(sp_tevent **te)
 {
-    *te = malloc(sizeof(sp_tevent));
+    *te = sp_malloc(sizeof(sp_tevent));
     return SP_NOT_OK;
 }
 
 int sp_tevent_destroy(sp_tevent **te)
 {
-    free(*te);
+    sp_free(*te);
     return SP_NOT_OK;
 }
 
@@ -38,3 +38,12 @@ int sp_tevent_compute(sp_data *sp, sp_tevent *te, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_tevent_compute_block(sp_data *sp, sp_tevent *te, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tevent_compute(sp, te, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
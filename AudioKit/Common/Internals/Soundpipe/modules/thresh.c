@@ -11,13 +11,13 @@
 
 int sp_thresh_create(sp_thresh **p)
 {
-    *p = malloc(sizeof(sp_thresh));
+    *p = sp_malloc(sizeof(sp_thresh));
     return SP_OK;
 }
 
 int sp_thresh_destroy(sp_thresh **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -65,3 +65,12 @@ int sp_thresh_compute(sp_data *sp, sp_thresh *p, SPFLOAT *in, SPFLOAT *out)
     
     return SP_OK;
 }
+
+int sp_thresh_compute_block(sp_data *sp, sp_thresh *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_thresh_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
@@ -3,13 +3,13 @@
 
 int sp_tin_create(sp_tin **p)
 {
-    *p = malloc(sizeof(sp_tin));
+    *p = sp_malloc(sizeof(sp_tin));
     return SP_OK;
 }
 
 int sp_tin_destroy(sp_tin **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -29,3 +29,12 @@ int sp_tin_compute(sp_data *sp, sp_tin *p, SPFLOAT *in, SPFLOAT *out)
     *out = p->val;
     return SP_OK;
 }
+
+int sp_tin_compute_block(sp_data *sp, sp_tin *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tin_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
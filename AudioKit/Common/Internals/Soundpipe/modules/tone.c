@@ -23,13 +23,13 @@
 
 int sp_tone_create(sp_tone **t)
 {
-    *t = malloc(sizeof(sp_tone));
+    *t = sp_malloc(sizeof(sp_tone));
     return SP_OK;
 }
 
 int sp_tone_destroy(sp_tone **t)
 {
-    free(*t);
+    sp_free(*t);
     return SP_OK;
 }
 
@@ -48,9 +48,15 @@ int sp_tone_init(sp_data *sp, sp_tone *p)
 }
 
 int sp_tone_compute(sp_data *sp, sp_tone *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_tone_compute_block(sp, p, in, out, 1);
+}
+
+int sp_tone_compute_block(sp_data *sp, sp_tone *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
 {
     SPFLOAT c1 = p->c1, c2 = p->c2;
     SPFLOAT yt1 = p->yt1;
+    uint32_t i;
 
     if (p->hp != p->prvhp) {
       SPFLOAT b;
@@ -60,8 +66,10 @@ int sp_tone_compute(sp_data *sp, sp_tone *p, SPFLOAT *in, SPFLOAT *out)
       p->c1 = c1 = 1.0 - c2;
     }
 
-    yt1 = c1 * (*in) + c2 * yt1;
-    *out = yt1;
+    for(i = 0; i < n; i++) {
+        yt1 = c1 * in[i] + c2 * yt1;
+        out[i] = yt1;
+    }
 
     p->yt1 = yt1;
     return SP_OK;
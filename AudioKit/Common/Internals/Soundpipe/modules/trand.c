@@ -3,13 +3,13 @@
 
 int sp_trand_create(sp_trand **p)
 {
-    *p = malloc(sizeof(sp_trand));
+    *p = sp_malloc(sizeof(sp_trand));
     return SP_OK;
 }
 
 int sp_trand_destroy(sp_trand **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -18,16 +18,26 @@ int sp_trand_init(sp_data *sp, sp_trand *p)
     p->min = 0;
     p->max = 1;
     p->val = 0;
+    sp_prng_init(sp, &p->prng);
     return SP_OK;
 }
 
 int sp_trand_compute(sp_data *sp, sp_trand *p, SPFLOAT *in, SPFLOAT *out)
 {
     if(*in != 0) {
-        p->val = p->min + ((SPFLOAT) sp_rand(sp) / SP_RANDMAX) * (p->max - p->min);
+        p->val = p->min + ((SPFLOAT) sp_prng_rand(&p->prng) / SP_RANDMAX) * (p->max - p->min);
         *out = p->val;
     } else {
         *out = p->val;
     }
     return SP_OK;
 }
+
+int sp_trand_compute_block(sp_data *sp, sp_trand *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_trand_compute(sp, p, (SPFLOAT *)&in[i], &out[i]);
+    }
+    return SP_OK;
+}
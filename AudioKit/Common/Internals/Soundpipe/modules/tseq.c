@@ -3,13 +3,13 @@
 
 int sp_tseq_create(sp_tseq **p)
 {
-    *p = malloc(sizeof(sp_tseq));
+    *p = sp_malloc(sizeof(sp_tseq));
     return SP_OK;
 }
 
 int sp_tseq_destroy(sp_tseq **p)
 {
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
@@ -19,6 +19,7 @@ int sp_tseq_init(sp_data *sp, sp_tseq *p, sp_ftbl *ft)
     p->pos = 0;
     p->val = 0;
     p->shuf = 0;
+    sp_prng_init(sp, &p->prng);
     return SP_OK;
 }
 
@@ -27,7 +28,7 @@ int sp_tseq_compute(sp_data *sp, sp_tseq *p, SPFLOAT *trig, SPFLOAT *val)
     if(*trig != 0){
         p->val = p->ft->tbl[p->pos];
         if(p->shuf) {
-            p->pos = rand() % p->ft->size;
+            p->pos = sp_prng_rand(&p->prng) % p->ft->size;
         } else {
             p->pos = (p->pos + 1) % p->ft->size;
         }
@@ -35,3 +36,12 @@ int sp_tseq_compute(sp_data *sp, sp_tseq *p, SPFLOAT *trig, SPFLOAT *val)
     *val = p->val;
     return SP_OK;
 }
+
+int sp_tseq_compute_block(sp_data *sp, sp_tseq *p, const SPFLOAT *trig, SPFLOAT *val, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        sp_tseq_compute(sp, p, (SPFLOAT *)&trig[i], &val[i]);
+    }
+    return SP_OK;
+}
@@ -10,88 +10,73 @@
  *
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include "soundpipe.h"
 
 int sp_vdelay_create(sp_vdelay **p)
 {
-    *p = malloc(sizeof(sp_vdelay));
+    *p = sp_malloc(sizeof(sp_vdelay));
     return SP_OK;
 }
 
 int sp_vdelay_destroy(sp_vdelay **p)
 {
     sp_vdelay *pp = *p;
-    sp_auxdata_free(&pp->buf);
-    free(*p);
+    sp_dline_destroy(&pp->dl);
+    sp_free(*p);
     return SP_OK;
 }
 
 int sp_vdelay_init(sp_data *sp, sp_vdelay *p, SPFLOAT maxdel)
 {
-    uint32_t n = (int32_t)(maxdel * sp->sr)+1;
     p->sr = sp->sr;
     p->del = maxdel * 0.5;
     p->maxdel = maxdel;
-    sp_auxdata_alloc(&p->buf, n * sizeof(SPFLOAT));
-    p->left = 0;
+    p->maxd = (uint32_t)(maxdel * sp->sr);
+    /* room for the longest delay behind a whole chunk */
+    sp_dline_init(&p->dl, p->maxd + SP_DLINE_CHUNK);
     return SP_OK;
 }
 
 int sp_vdelay_compute(sp_data *sp, sp_vdelay *p, SPFLOAT *in, SPFLOAT *out)
 {
-    int32_t maxd, indx;
-    *out = p->sr;
-    SPFLOAT del = p->del;
-    SPFLOAT b0, b1, b2, b3;
-    int32_t v0, v1, v2, v3;
-    SPFLOAT fv1;
-    indx = p->left;
+    return sp_vdelay_compute_block(sp, p, in, out, 1);
+}
+
+int sp_vdelay_compute_block(sp_data *sp, sp_vdelay *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n)
+{
+    SPFLOAT del = p->del * p->sr;
+    int interp, max;
+    uint32_t i = 0, len;
 
-    sp_auxdata_setbuf(&p->buf, indx, in);
+    if(del < 0) del = 0;
+    if(del > p->maxd) del = p->maxd;
 
-    fv1 = del * (-1.0 * sp->sr);
-    v1 = (int32_t)fv1;
-    fv1 -= (SPFLOAT) v1;
-    v1 += (int32_t)indx;
-    maxd = (uint32_t) (p->maxdel * p->sr);
-    /* Make sure we're inside the buffer */
-    if ((v1 < 0) || (fv1 < 0.0)) {
-        fv1++; v1--;
-        while (v1 < 0) {
-            v1 += (int32_t)maxd;
-        }
-    } else {
-        while (v1 >= (int32_t)maxd) {
-        v1 -= (int32_t)maxd;
+    /* the cubic stencil reaches one sample newer than the linear one, so
+     * it needs more than a sample of delay to stay behind the input */
+    interp = (p->maxd < 4 || del <= 1) ? SP_DLINE_LINEAR : SP_DLINE_CUBIC;
+
+    /* read each chunk before writing it, keeping the whole stencil in
+     * samples already written */
+    max = (int)ceil(del) - (interp == SP_DLINE_CUBIC ? 2 : 1);
+    if(max > SP_DLINE_CHUNK) max = SP_DLINE_CHUNK;
+
+    if(max < 1) {
+        /* too short for that: write each sample, then read it back */
+        for(i = 0; i < n; i++) {
+            sp_dline_write(&p->dl, in + i, 1);
+            sp_dline_readf(&p->dl, del + 1, interp, out + i, 1);
         }
+        return SP_OK;
     }
-    /* Find next sample for interpolation      */
-    v2 = (v1 == (int32_t)(maxd - 1UL) ? 0L : v1 + 1L);
 
-    if (maxd<4) {
-        sp_auxdata_getbuf(&p->buf, v1, &b1);
-        sp_auxdata_getbuf(&p->buf, v2, &b2);
-        *out = b1 + fv1 * (b2 - b1);
-    } else {
-        v0 = (v1==0 ? maxd-1 : v1-1);
-        v3 = (v2==(int32_t)maxd-1 ? 0 : v2+1);
-        {
-            SPFLOAT w, x, y, z;
-            z = fv1 * fv1; z--;
-            z *= 0.1666666667;
-            y = fv1;
-            y++; w = (y *= 0.5); w--;
-            x = 3.0 * z; y -= x; w -= z; x -= fv1;
-            sp_auxdata_getbuf(&p->buf, v0, &b0);
-            sp_auxdata_getbuf(&p->buf, v1, &b1);
-            sp_auxdata_getbuf(&p->buf, v2, &b2);
-            sp_auxdata_getbuf(&p->buf, v3, &b3);
-            *out = (w*b0 + x*b1 + y*b2 + z*b3)
-            * fv1 + b1;
-        }
+    while(i < n) {
+        len = n - i;
+        if(len > (uint32_t)max) len = max;
+        sp_dline_readf(&p->dl, del, interp, out + i, len);
+        sp_dline_write(&p->dl, in + i, len);
+        i += len;
     }
-    if (++indx == maxd) indx = 0;
-    p->left = indx;
     return SP_OK;
 }
@@ -18,6 +18,12 @@
 #define max(a,b) ((a < b) ? b : a)
 #define min(a,b) ((a < b) ? a : b)
 
+/* below this, input and reverb tail count as silent (-120 dB) */
+#define ZITAREV_SILENCE 1e-6f
+
+/* floats between delay lines, one cache line */
+#define ZITAREV_PAD 16
+
 #ifndef FAUSTFLOAT
 #define FAUSTFLOAT float
 #endif  
@@ -33,27 +39,56 @@ static float faustpower2_f(float value) {
 }
 float tanf(float dummy0);
 
+/* smallest 2^k - 1 that is at least lag */
+static int zitarev_mask(float lag) {
+	int mask = 1;
+	while (mask < (int)lag) mask = (mask << 1) | 1;
+	return mask;
+}
+
 
 typedef struct {
 	
-	float fVec1[32768];
-	float fVec4[32768];
-	float fVec8[32768];
-	float fVec6[16384];
-	float fVec10[16384];
-	float fVec12[16384];
-	float fVec14[16384];
-	float fVec16[16384];
-	float fVec0[8192];
-	float fVec2[8192];
-	float fVec5[4096];
-	float fVec7[4096];
-	float fVec9[4096];
-	float fVec13[4096];
-	float fVec15[4096];
-	float fVec3[2048];
-	float fVec11[2048];
-	float fVec17[2048];
+	float *fVec1;
+	float *fVec4;
+	float *fVec8;
+	float *fVec6;
+	float *fVec10;
+	float *fVec12;
+	float *fVec14;
+	float *fVec16;
+	float *fVec0;
+	float *fVec2;
+	float *fVec5;
+	float *fVec7;
+	float *fVec9;
+	float *fVec13;
+	float *fVec15;
+	float *fVec3;
+	float *fVec11;
+	float *fVec17;
+	int iMask0;
+	int iMask1;
+	int iMask3;
+	int iMask4;
+	int iMask5;
+	int iMask6;
+	int iMask7;
+	int iMask8;
+	int iMask9;
+	int iMask10;
+	int iMask11;
+	int iMask12;
+	int iMask13;
+	int iMask14;
+	int iMask15;
+	int iMask16;
+	int iMask17;
+	sp_auxdata aux;
+	int iClearLen;
+	int iQuiet;
+	int iQuietLen;
+	float fPeak;
 	float fRec4[3];
 	float fRec5[3];
 	float fRec6[3];
@@ -154,12 +189,13 @@ typedef struct {
 } zitarev;
 
 static zitarev* newzitarev() { 
-	zitarev* dsp = (zitarev*)malloc(sizeof(zitarev));
+	zitarev* dsp = (zitarev*)sp_malloc(sizeof(zitarev));
 	return dsp;
 }
 
 static void deletezitarev(zitarev* dsp) { 
-	free(dsp);
+	sp_auxdata_free(&dsp->aux);
+	sp_free(dsp);
 }
 
 static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
@@ -185,15 +221,6 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 		
 	}
 	dsp->IOTA = 0;
-	/* C99 loop */
-	{
-		int i2;
-		for (i2 = 0; (i2 < 8192); i2 = (i2 + 1)) {
-			dsp->fVec0[i2] = 0.f;
-			
-		}
-		
-	}
 	dsp->iConst0 = min(192000, max(1, dsp->fSamplingFreq));
 	dsp->fConst1 = (6.28319f / (float)dsp->iConst0);
 	dsp->fHslider2 = (FAUSTFLOAT)1500.;
@@ -225,39 +252,16 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i5;
-		for (i5 = 0; (i5 < 32768); i5 = (i5 + 1)) {
-			dsp->fVec1[i5] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst6 = floorf((0.5f + (0.019123f * (float)dsp->iConst0)));
-	dsp->iConst7 = (int)((int)(dsp->fConst2 - dsp->fConst6) & 32767);
-	/* C99 loop */
-	{
-		int i6;
-		for (i6 = 0; (i6 < 8192); i6 = (i6 + 1)) {
-			dsp->fVec2[i6] = 0.f;
-			
-		}
-		
-	}
+	dsp->iMask1 = zitarev_mask(dsp->fConst2 - dsp->fConst6);
+	dsp->iConst7 = (int)((int)(dsp->fConst2 - dsp->fConst6) & dsp->iMask1);
 	dsp->fConst8 = (0.001f * (float)dsp->iConst0);
+	/* in_delay goes up to 100 ms */
+	dsp->iMask0 = zitarev_mask(100.f * dsp->fConst8);
 	dsp->fHslider10 = (FAUSTFLOAT)60.;
-	/* C99 loop */
-	{
-		int i7;
-		for (i7 = 0; (i7 < 2048); i7 = (i7 + 1)) {
-			dsp->fVec3[i7] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst9 = (int)((int)(dsp->fConst6 - 1.f) & 2047);
+	dsp->iMask3 = zitarev_mask(dsp->fConst6 - 1.f);
+	dsp->iConst9 = (int)((int)(dsp->fConst6 - 1.f) & dsp->iMask3);
 	/* C99 loop */
 	{
 		int i8;
@@ -286,28 +290,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i11;
-		for (i11 = 0; (i11 < 32768); i11 = (i11 + 1)) {
-			dsp->fVec4[i11] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst12 = floorf((0.5f + (0.027333f * (float)dsp->iConst0)));
-	dsp->iConst13 = (int)((int)(dsp->fConst10 - dsp->fConst12) & 32767);
-	/* C99 loop */
-	{
-		int i12;
-		for (i12 = 0; (i12 < 4096); i12 = (i12 + 1)) {
-			dsp->fVec5[i12] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst14 = (int)((int)(dsp->fConst12 - 1.f) & 4095);
+	dsp->iMask4 = zitarev_mask(dsp->fConst10 - dsp->fConst12);
+	dsp->iConst13 = (int)((int)(dsp->fConst10 - dsp->fConst12) & dsp->iMask4);
+	dsp->iMask5 = zitarev_mask(dsp->fConst12 - 1.f);
+	dsp->iConst14 = (int)((int)(dsp->fConst12 - 1.f) & dsp->iMask5);
 	/* C99 loop */
 	{
 		int i13;
@@ -336,28 +324,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i16;
-		for (i16 = 0; (i16 < 16384); i16 = (i16 + 1)) {
-			dsp->fVec6[i16] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst17 = floorf((0.5f + (0.029291f * (float)dsp->iConst0)));
-	dsp->iConst18 = (int)((int)(dsp->fConst15 - dsp->fConst17) & 16383);
-	/* C99 loop */
-	{
-		int i17;
-		for (i17 = 0; (i17 < 4096); i17 = (i17 + 1)) {
-			dsp->fVec7[i17] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst19 = (int)((int)(dsp->fConst17 - 1.f) & 4095);
+	dsp->iMask6 = zitarev_mask(dsp->fConst15 - dsp->fConst17);
+	dsp->iConst18 = (int)((int)(dsp->fConst15 - dsp->fConst17) & dsp->iMask6);
+	dsp->iMask7 = zitarev_mask(dsp->fConst17 - 1.f);
+	dsp->iConst19 = (int)((int)(dsp->fConst17 - 1.f) & dsp->iMask7);
 	/* C99 loop */
 	{
 		int i18;
@@ -386,28 +358,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i21;
-		for (i21 = 0; (i21 < 32768); i21 = (i21 + 1)) {
-			dsp->fVec8[i21] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst22 = floorf((0.5f + (0.024421f * (float)dsp->iConst0)));
-	dsp->iConst23 = (int)((int)(dsp->fConst20 - dsp->fConst22) & 32767);
-	/* C99 loop */
-	{
-		int i22;
-		for (i22 = 0; (i22 < 4096); i22 = (i22 + 1)) {
-			dsp->fVec9[i22] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst24 = (int)((int)(dsp->fConst22 - 1.f) & 4095);
+	dsp->iMask8 = zitarev_mask(dsp->fConst20 - dsp->fConst22);
+	dsp->iConst23 = (int)((int)(dsp->fConst20 - dsp->fConst22) & dsp->iMask8);
+	dsp->iMask9 = zitarev_mask(dsp->fConst22 - 1.f);
+	dsp->iConst24 = (int)((int)(dsp->fConst22 - 1.f) & dsp->iMask9);
 	/* C99 loop */
 	{
 		int i23;
@@ -436,28 +392,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i26;
-		for (i26 = 0; (i26 < 16384); i26 = (i26 + 1)) {
-			dsp->fVec10[i26] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst27 = floorf((0.5f + (0.013458f * (float)dsp->iConst0)));
-	dsp->iConst28 = (int)((int)(dsp->fConst25 - dsp->fConst27) & 16383);
-	/* C99 loop */
-	{
-		int i27;
-		for (i27 = 0; (i27 < 2048); i27 = (i27 + 1)) {
-			dsp->fVec11[i27] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst29 = (int)((int)(dsp->fConst27 - 1.f) & 2047);
+	dsp->iMask10 = zitarev_mask(dsp->fConst25 - dsp->fConst27);
+	dsp->iConst28 = (int)((int)(dsp->fConst25 - dsp->fConst27) & dsp->iMask10);
+	dsp->iMask11 = zitarev_mask(dsp->fConst27 - 1.f);
+	dsp->iConst29 = (int)((int)(dsp->fConst27 - 1.f) & dsp->iMask11);
 	/* C99 loop */
 	{
 		int i28;
@@ -486,28 +426,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i31;
-		for (i31 = 0; (i31 < 16384); i31 = (i31 + 1)) {
-			dsp->fVec12[i31] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst32 = floorf((0.5f + (0.031604f * (float)dsp->iConst0)));
-	dsp->iConst33 = (int)((int)(dsp->fConst30 - dsp->fConst32) & 16383);
-	/* C99 loop */
-	{
-		int i32;
-		for (i32 = 0; (i32 < 4096); i32 = (i32 + 1)) {
-			dsp->fVec13[i32] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst34 = (int)((int)(dsp->fConst32 - 1.f) & 4095);
+	dsp->iMask12 = zitarev_mask(dsp->fConst30 - dsp->fConst32);
+	dsp->iConst33 = (int)((int)(dsp->fConst30 - dsp->fConst32) & dsp->iMask12);
+	dsp->iMask13 = zitarev_mask(dsp->fConst32 - 1.f);
+	dsp->iConst34 = (int)((int)(dsp->fConst32 - 1.f) & dsp->iMask13);
 	/* C99 loop */
 	{
 		int i33;
@@ -536,28 +460,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i36;
-		for (i36 = 0; (i36 < 16384); i36 = (i36 + 1)) {
-			dsp->fVec14[i36] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst37 = floorf((0.5f + (0.022904f * (float)dsp->iConst0)));
-	dsp->iConst38 = (int)((int)(dsp->fConst35 - dsp->fConst37) & 16383);
-	/* C99 loop */
-	{
-		int i37;
-		for (i37 = 0; (i37 < 4096); i37 = (i37 + 1)) {
-			dsp->fVec15[i37] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst39 = (int)((int)(dsp->fConst37 - 1.f) & 4095);
+	dsp->iMask14 = zitarev_mask(dsp->fConst35 - dsp->fConst37);
+	dsp->iConst38 = (int)((int)(dsp->fConst35 - dsp->fConst37) & dsp->iMask14);
+	dsp->iMask15 = zitarev_mask(dsp->fConst37 - 1.f);
+	dsp->iConst39 = (int)((int)(dsp->fConst37 - 1.f) & dsp->iMask15);
 	/* C99 loop */
 	{
 		int i38;
@@ -586,28 +494,12 @@ static void instanceInitzitarev(zitarev* dsp, int samplingFreq) {
 			
 		}
 		
-	}
-	/* C99 loop */
-	{
-		int i41;
-		for (i41 = 0; (i41 < 16384); i41 = (i41 + 1)) {
-			dsp->fVec16[i41] = 0.f;
-			
-		}
-		
 	}
 	dsp->fConst42 = floorf((0.5f + (0.020346f * (float)dsp->iConst0)));
-	dsp->iConst43 = (int)((int)(dsp->fConst40 - dsp->fConst42) & 16383);
-	/* C99 loop */
-	{
-		int i42;
-		for (i42 = 0; (i42 < 2048); i42 = (i42 + 1)) {
-			dsp->fVec17[i42] = 0.f;
-			
-		}
-		
-	}
-	dsp->iConst44 = (int)((int)(dsp->fConst42 - 1.f) & 2047);
+	dsp->iMask16 = zitarev_mask(dsp->fConst40 - dsp->fConst42);
+	dsp->iConst43 = (int)((int)(dsp->fConst40 - dsp->fConst42) & dsp->iMask16);
+	dsp->iMask17 = zitarev_mask(dsp->fConst42 - 1.f);
+	dsp->iConst44 = (int)((int)(dsp->fConst42 - 1.f) & dsp->iMask17);
 	/* C99 loop */
 	{
 		int i43;
@@ -779,7 +671,7 @@ static void computezitarev(zitarev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFL
 	float fSlow25 = (1.f + fSlow24);
 	float fSlow26 = (0.f - ((1.f - fSlow24) / fSlow25));
 	float fSlow27 = (1.f / fSlow25);
-	int iSlow28 = (int)((int)(dsp->fConst8 * (float)dsp->fHslider10) & 8191);
+	int iSlow28 = (int)((int)(dsp->fConst8 * (float)dsp->fHslider10) & dsp->iMask0);
 	float fSlow29 = expf((dsp->fConst11 / fSlow12));
 	float fSlow30 = faustpower2_f(fSlow29);
 	float fSlow31 = (1.f - (fSlow15 * fSlow30));
@@ -843,6 +735,7 @@ static void computezitarev(zitarev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFL
 	float fSlow89 = (fSlow87 - fSlow88);
 	float fSlow90 = (((1.f + fSlow88) - fSlow87) * fSlow83);
 	float fSlow91 = ((expf((dsp->fConst41 / fSlow22)) / fSlow83) - 1.f);
+	float fPeak = 0.f;
 	/* C99 loop */
 	{
 		int i;
@@ -851,68 +744,68 @@ static void computezitarev(zitarev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFL
 			dsp->fRec1[0] = ((0.999f * dsp->fRec1[1]) + fSlow1);
 			float fTemp0 = (1.f - dsp->fRec1[0]);
 			float fTemp1 = (float)input0[i];
-			dsp->fVec0[(dsp->IOTA & 8191)] = fTemp1;
+			dsp->fVec0[(dsp->IOTA & dsp->iMask0)] = fTemp1;
 			float fTemp2 = (fSlow6 * dsp->fRec2[1]);
 			float fTemp3 = (fSlow11 * dsp->fRec3[1]);
 			dsp->fRec15[0] = ((fSlow26 * dsp->fRec15[1]) + (fSlow27 * (dsp->fRec11[1] + dsp->fRec11[2])));
 			dsp->fRec14[0] = ((fSlow20 * dsp->fRec14[1]) + (fSlow21 * (dsp->fRec11[1] + (fSlow23 * dsp->fRec15[0]))));
-			dsp->fVec1[(dsp->IOTA & 32767)] = ((0.353553f * dsp->fRec14[0]) + 1e-20f);
+			dsp->fVec1[(dsp->IOTA & dsp->iMask1)] = ((0.353553f * dsp->fRec14[0]) + 1e-20f);
 			float fTemp4 = (float)input1[i];
-			dsp->fVec2[(dsp->IOTA & 8191)] = fTemp4;
-			float fTemp5 = (0.3f * dsp->fVec2[((dsp->IOTA - iSlow28) & 8191)]);
-			float fTemp6 = (((0.6f * dsp->fRec12[1]) + dsp->fVec1[((dsp->IOTA - dsp->iConst7) & 32767)]) - fTemp5);
-			dsp->fVec3[(dsp->IOTA & 2047)] = fTemp6;
-			dsp->fRec12[0] = dsp->fVec3[((dsp->IOTA - dsp->iConst9) & 2047)];
+			dsp->fVec2[(dsp->IOTA & dsp->iMask0)] = fTemp4;
+			float fTemp5 = (0.3f * dsp->fVec2[((dsp->IOTA - iSlow28) & dsp->iMask0)]);
+			float fTemp6 = (((0.6f * dsp->fRec12[1]) + dsp->fVec1[((dsp->IOTA - dsp->iConst7) & dsp->iMask1)]) - fTemp5);
+			dsp->fVec3[(dsp->IOTA & dsp->iMask3)] = fTemp6;
+			dsp->fRec12[0] = dsp->fVec3[((dsp->IOTA - dsp->iConst9) & dsp->iMask3)];
 			float fRec13 = (0.f - (0.6f * fTemp6));
 			dsp->fRec19[0] = ((fSlow26 * dsp->fRec19[1]) + (fSlow27 * (dsp->fRec7[1] + dsp->fRec7[2])));
 			dsp->fRec18[0] = ((fSlow35 * dsp->fRec18[1]) + (fSlow36 * (dsp->fRec7[1] + (fSlow37 * dsp->fRec19[0]))));
-			dsp->fVec4[(dsp->IOTA & 32767)] = ((0.353553f * dsp->fRec18[0]) + 1e-20f);
-			float fTemp7 = (((0.6f * dsp->fRec16[1]) + dsp->fVec4[((dsp->IOTA - dsp->iConst13) & 32767)]) - fTemp5);
-			dsp->fVec5[(dsp->IOTA & 4095)] = fTemp7;
-			dsp->fRec16[0] = dsp->fVec5[((dsp->IOTA - dsp->iConst14) & 4095)];
+			dsp->fVec4[(dsp->IOTA & dsp->iMask4)] = ((0.353553f * dsp->fRec18[0]) + 1e-20f);
+			float fTemp7 = (((0.6f * dsp->fRec16[1]) + dsp->fVec4[((dsp->IOTA - dsp->iConst13) & dsp->iMask4)]) - fTemp5);
+			dsp->fVec5[(dsp->IOTA & dsp->iMask5)] = fTemp7;
+			dsp->fRec16[0] = dsp->fVec5[((dsp->IOTA - dsp->iConst14) & dsp->iMask5)];
 			float fRec17 = (0.f - (0.6f * fTemp7));
 			dsp->fRec23[0] = ((fSlow26 * dsp->fRec23[1]) + (fSlow27 * (dsp->fRec9[1] + dsp->fRec9[2])));
 			dsp->fRec22[0] = ((fSlow44 * dsp->fRec22[1]) + (fSlow45 * (dsp->fRec9[1] + (fSlow46 * dsp->fRec23[0]))));
-			dsp->fVec6[(dsp->IOTA & 16383)] = ((0.353553f * dsp->fRec22[0]) + 1e-20f);
-			float fTemp8 = (dsp->fVec6[((dsp->IOTA - dsp->iConst18) & 16383)] + (fTemp5 + (0.6f * dsp->fRec20[1])));
-			dsp->fVec7[(dsp->IOTA & 4095)] = fTemp8;
-			dsp->fRec20[0] = dsp->fVec7[((dsp->IOTA - dsp->iConst19) & 4095)];
+			dsp->fVec6[(dsp->IOTA & dsp->iMask6)] = ((0.353553f * dsp->fRec22[0]) + 1e-20f);
+			float fTemp8 = (dsp->fVec6[((dsp->IOTA - dsp->iConst18) & dsp->iMask6)] + (fTemp5 + (0.6f * dsp->fRec20[1])));
+			dsp->fVec7[(dsp->IOTA & dsp->iMask7)] = fTemp8;
+			dsp->fRec20[0] = dsp->fVec7[((dsp->IOTA - dsp->iConst19) & dsp->iMask7)];
 			float fRec21 = (0.f - (0.6f * fTemp8));
 			dsp->fRec27[0] = ((fSlow26 * dsp->fRec27[1]) + (fSlow27 * (dsp->fRec5[1] + dsp->fRec5[2])));
 			dsp->fRec26[0] = ((fSlow53 * dsp->fRec26[1]) + (fSlow54 * (dsp->fRec5[1] + (fSlow55 * dsp->fRec27[0]))));
-			dsp->fVec8[(dsp->IOTA & 32767)] = ((0.353553f * dsp->fRec26[0]) + 1e-20f);
-			float fTemp9 = (fTemp5 + ((0.6f * dsp->fRec24[1]) + dsp->fVec8[((dsp->IOTA - dsp->iConst23) & 32767)]));
-			dsp->fVec9[(dsp->IOTA & 4095)] = fTemp9;
-			dsp->fRec24[0] = dsp->fVec9[((dsp->IOTA - dsp->iConst24) & 4095)];
+			dsp->fVec8[(dsp->IOTA & dsp->iMask8)] = ((0.353553f * dsp->fRec26[0]) + 1e-20f);
+			float fTemp9 = (fTemp5 + ((0.6f * dsp->fRec24[1]) + dsp->fVec8[((dsp->IOTA - dsp->iConst23) & dsp->iMask8)]));
+			dsp->fVec9[(dsp->IOTA & dsp->iMask9)] = fTemp9;
+			dsp->fRec24[0] = dsp->fVec9[((dsp->IOTA - dsp->iConst24) & dsp->iMask9)];
 			float fRec25 = (0.f - (0.6f * fTemp9));
 			dsp->fRec31[0] = ((fSlow26 * dsp->fRec31[1]) + (fSlow27 * (dsp->fRec10[1] + dsp->fRec10[2])));
 			dsp->fRec30[0] = ((fSlow62 * dsp->fRec30[1]) + (fSlow63 * (dsp->fRec10[1] + (fSlow64 * dsp->fRec31[0]))));
-			dsp->fVec10[(dsp->IOTA & 16383)] = ((0.353553f * dsp->fRec30[0]) + 1e-20f);
-			float fTemp10 = (0.3f * dsp->fVec0[((dsp->IOTA - iSlow28) & 8191)]);
-			float fTemp11 = (dsp->fVec10[((dsp->IOTA - dsp->iConst28) & 16383)] - (fTemp10 + (0.6f * dsp->fRec28[1])));
-			dsp->fVec11[(dsp->IOTA & 2047)] = fTemp11;
-			dsp->fRec28[0] = dsp->fVec11[((dsp->IOTA - dsp->iConst29) & 2047)];
+			dsp->fVec10[(dsp->IOTA & dsp->iMask10)] = ((0.353553f * dsp->fRec30[0]) + 1e-20f);
+			float fTemp10 = (0.3f * dsp->fVec0[((dsp->IOTA - iSlow28) & dsp->iMask0)]);
+			float fTemp11 = (dsp->fVec10[((dsp->IOTA - dsp->iConst28) & dsp->iMask10)] - (fTemp10 + (0.6f * dsp->fRec28[1])));
+			dsp->fVec11[(dsp->IOTA & dsp->iMask11)] = fTemp11;
+			dsp->fRec28[0] = dsp->fVec11[((dsp->IOTA - dsp->iConst29) & dsp->iMask11)];
 			float fRec29 = (0.6f * fTemp11);
 			dsp->fRec35[0] = ((fSlow26 * dsp->fRec35[1]) + (fSlow27 * (dsp->fRec6[1] + dsp->fRec6[2])));
 			dsp->fRec34[0] = ((fSlow71 * dsp->fRec34[1]) + (fSlow72 * (dsp->fRec6[1] + (fSlow73 * dsp->fRec35[0]))));
-			dsp->fVec12[(dsp->IOTA & 16383)] = ((0.353553f * dsp->fRec34[0]) + 1e-20f);
-			float fTemp12 = (dsp->fVec12[((dsp->IOTA - dsp->iConst33) & 16383)] - (fTemp10 + (0.6f * dsp->fRec32[1])));
-			dsp->fVec13[(dsp->IOTA & 4095)] = fTemp12;
-			dsp->fRec32[0] = dsp->fVec13[((dsp->IOTA - dsp->iConst34) & 4095)];
+			dsp->fVec12[(dsp->IOTA & dsp->iMask12)] = ((0.353553f * dsp->fRec34[0]) + 1e-20f);
+			float fTemp12 = (dsp->fVec12[((dsp->IOTA - dsp->iConst33) & dsp->iMask12)] - (fTemp10 + (0.6f * dsp->fRec32[1])));
+			dsp->fVec13[(dsp->IOTA & dsp->iMask13)] = fTemp12;
+			dsp->fRec32[0] = dsp->fVec13[((dsp->IOTA - dsp->iConst34) & dsp->iMask13)];
 			float fRec33 = (0.6f * fTemp12);
 			dsp->fRec39[0] = ((fSlow26 * dsp->fRec39[1]) + (fSlow27 * (dsp->fRec8[1] + dsp->fRec8[2])));
 			dsp->fRec38[0] = ((fSlow80 * dsp->fRec38[1]) + (fSlow81 * (dsp->fRec8[1] + (fSlow82 * dsp->fRec39[0]))));
-			dsp->fVec14[(dsp->IOTA & 16383)] = ((0.353553f * dsp->fRec38[0]) + 1e-20f);
-			float fTemp13 = ((fTemp10 + dsp->fVec14[((dsp->IOTA - dsp->iConst38) & 16383)]) - (0.6f * dsp->fRec36[1]));
-			dsp->fVec15[(dsp->IOTA & 4095)] = fTemp13;
-			dsp->fRec36[0] = dsp->fVec15[((dsp->IOTA - dsp->iConst39) & 4095)];
+			dsp->fVec14[(dsp->IOTA & dsp->iMask14)] = ((0.353553f * dsp->fRec38[0]) + 1e-20f);
+			float fTemp13 = ((fTemp10 + dsp->fVec14[((dsp->IOTA - dsp->iConst38) & dsp->iMask14)]) - (0.6f * dsp->fRec36[1]));
+			dsp->fVec15[(dsp->IOTA & dsp->iMask15)] = fTemp13;
+			dsp->fRec36[0] = dsp->fVec15[((dsp->IOTA - dsp->iConst39) & dsp->iMask15)];
 			float fRec37 = (0.6f * fTemp13);
 			dsp->fRec43[0] = ((fSlow26 * dsp->fRec43[1]) + (fSlow27 * (dsp->fRec4[1] + dsp->fRec4[2])));
 			dsp->fRec42[0] = ((fSlow89 * dsp->fRec42[1]) + (fSlow90 * (dsp->fRec4[1] + (fSlow91 * dsp->fRec43[0]))));
-			dsp->fVec16[(dsp->IOTA & 16383)] = ((0.353553f * dsp->fRec42[0]) + 1e-20f);
-			float fTemp14 = ((dsp->fVec16[((dsp->IOTA - dsp->iConst43) & 16383)] + fTemp10) - (0.6f * dsp->fRec40[1]));
-			dsp->fVec17[(dsp->IOTA & 2047)] = fTemp14;
-			dsp->fRec40[0] = dsp->fVec17[((dsp->IOTA - dsp->iConst44) & 2047)];
+			dsp->fVec16[(dsp->IOTA & dsp->iMask16)] = ((0.353553f * dsp->fRec42[0]) + 1e-20f);
+			float fTemp14 = ((dsp->fVec16[((dsp->IOTA - dsp->iConst43) & dsp->iMask16)] + fTemp10) - (0.6f * dsp->fRec40[1]));
+			dsp->fVec17[(dsp->IOTA & dsp->iMask17)] = fTemp14;
+			dsp->fRec40[0] = dsp->fVec17[((dsp->IOTA - dsp->iConst44) & dsp->iMask17)];
 			float fRec41 = (0.6f * fTemp14);
 			float fTemp15 = (fRec41 + fRec37);
 			float fTemp16 = (fRec29 + (fRec33 + fTemp15));
@@ -929,6 +822,11 @@ static void computezitarev(zitarev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFL
 			float fTemp21 = (fRec41 + fRec29);
 			dsp->fRec10[0] = (0.f - ((dsp->fRec16[1] + (dsp->fRec20[1] + (dsp->fRec32[1] + (dsp->fRec36[1] + (fRec17 + (fRec21 + fTemp20)))))) - (dsp->fRec12[1] + (dsp->fRec24[1] + (dsp->fRec28[1] + (dsp->fRec40[1] + (fRec13 + (fRec25 + fTemp21))))))));
 			dsp->fRec11[0] = (0.f - ((dsp->fRec12[1] + (dsp->fRec24[1] + (dsp->fRec32[1] + (dsp->fRec36[1] + (fRec13 + (fRec25 + fTemp20)))))) - (dsp->fRec16[1] + (dsp->fRec20[1] + (dsp->fRec28[1] + (dsp->fRec40[1] + (fRec17 + (fRec21 + fTemp21))))))));
+			/* energy of the 8 feedback paths, every 16th sample */
+			if ((dsp->IOTA & 15) == 0) {
+				float fTemp32 = (faustpower2_f(dsp->fRec4[0]) + faustpower2_f(dsp->fRec5[0]) + faustpower2_f(dsp->fRec6[0]) + faustpower2_f(dsp->fRec7[0]) + faustpower2_f(dsp->fRec8[0]) + faustpower2_f(dsp->fRec9[0]) + faustpower2_f(dsp->fRec10[0]) + faustpower2_f(dsp->fRec11[0]));
+				fPeak = max(fPeak, fTemp32);
+			}
 			float fTemp22 = (0.37f * (dsp->fRec5[0] + dsp->fRec6[0]));
 			dsp->fRec3[0] = (0.f - ((fTemp3 + (fSlow10 * dsp->fRec3[2])) - fTemp22));
 			float fTemp23 = (fSlow10 * dsp->fRec3[0]);
@@ -1000,6 +898,7 @@ static void computezitarev(zitarev* dsp, int count, FAUSTFLOAT** inputs, FAUSTFL
 		}
 		
 	}
+	dsp->fPeak = fPeak;
 	
 }
 
@@ -1012,7 +911,7 @@ static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOA
 
 int sp_zitarev_create(sp_zitarev **p)
 {
-    *p = malloc(sizeof(sp_zitarev));
+    *p = sp_malloc(sizeof(sp_zitarev));
     return SP_OK;
 }
 
@@ -1021,10 +920,87 @@ int sp_zitarev_destroy(sp_zitarev **p)
     sp_zitarev *pp = *p;
     zitarev *dsp = pp->faust;
     deletezitarev (dsp);
-    free(*p);
+    sp_free(*p);
     return SP_OK;
 }
 
+/* The delay lines are sized for the sample rate (and in_delay for its
+ * 100 ms maximum) and share one allocation, which is not cleared up
+ * front: zitarev_clear() zeroes only the slots that are read before
+ * they are first written. The rings are power-of-two sized, so they are
+ * staggered by a cache line; otherwise all 18 write positions fall into
+ * the same cache set. */
+static void zitarev_alloc(zitarev* dsp)
+{
+    float **vec[18] = {
+        &dsp->fVec0, &dsp->fVec1, &dsp->fVec2, &dsp->fVec3, &dsp->fVec4,
+        &dsp->fVec5, &dsp->fVec6, &dsp->fVec7, &dsp->fVec8, &dsp->fVec9,
+        &dsp->fVec10, &dsp->fVec11, &dsp->fVec12, &dsp->fVec13,
+        &dsp->fVec14, &dsp->fVec15, &dsp->fVec16, &dsp->fVec17
+    };
+    int mask[18] = {
+        dsp->iMask0, dsp->iMask1, dsp->iMask0, dsp->iMask3, dsp->iMask4,
+        dsp->iMask5, dsp->iMask6, dsp->iMask7, dsp->iMask8, dsp->iMask9,
+        dsp->iMask10, dsp->iMask11, dsp->iMask12, dsp->iMask13,
+        dsp->iMask14, dsp->iMask15, dsp->iMask16, dsp->iMask17
+    };
+    float *buf;
+    int i, total = 0, longest = 0;
+
+    for (i = 0; i < 18; i++) {
+        total += mask[i] + 1 + ZITAREV_PAD;
+        longest = max(longest, mask[i] + 1);
+    }
+    sp_auxdata_reserve(&dsp->aux, total * sizeof(float));
+    buf = dsp->aux.ptr;
+    for (i = 0; i < 18; i++) {
+        *vec[i] = buf;
+        buf += mask[i] + 1 + ZITAREV_PAD;
+    }
+    /* every lag is below the longest ring, so by then all reads
+     * land on written samples */
+    dsp->iClearLen = longest;
+    /* input through in_delay, a comb and its allpass */
+    dsp->iQuietLen = dsp->iMask0 + 1 + 2 * longest;
+    dsp->iQuiet = 0;
+    dsp->fPeak = 0.f;
+}
+
+static void zitarev_zero(float *vec, int mask, int iota, int lag, int count)
+{
+    int t;
+    for (t = iota; t < iota + count && t < lag; t++) {
+        vec[(t - lag) & mask] = 0.f;
+    }
+}
+
+/* zeroes what the next count samples read before it is written */
+static void zitarev_clear(zitarev* dsp, int count)
+{
+    int iota = dsp->IOTA;
+    int iSlow28;
+    if (iota >= dsp->iClearLen) return;
+    iSlow28 = (int)((int)(dsp->fConst8 * (float)dsp->fHslider10) & dsp->iMask0);
+    zitarev_zero(dsp->fVec0, dsp->iMask0, iota, iSlow28, count);
+    zitarev_zero(dsp->fVec2, dsp->iMask0, iota, iSlow28, count);
+    zitarev_zero(dsp->fVec1, dsp->iMask1, iota, dsp->iConst7, count);
+    zitarev_zero(dsp->fVec3, dsp->iMask3, iota, dsp->iConst9, count);
+    zitarev_zero(dsp->fVec4, dsp->iMask4, iota, dsp->iConst13, count);
+    zitarev_zero(dsp->fVec5, dsp->iMask5, iota, dsp->iConst14, count);
+    zitarev_zero(dsp->fVec6, dsp->iMask6, iota, dsp->iConst18, count);
+    zitarev_zero(dsp->fVec7, dsp->iMask7, iota, dsp->iConst19, count);
+    zitarev_zero(dsp->fVec8, dsp->iMask8, iota, dsp->iConst23, count);
+    zitarev_zero(dsp->fVec9, dsp->iMask9, iota, dsp->iConst24, count);
+    zitarev_zero(dsp->fVec10, dsp->iMask10, iota, dsp->iConst28, count);
+    zitarev_zero(dsp->fVec11, dsp->iMask11, iota, dsp->iConst29, count);
+    zitarev_zero(dsp->fVec12, dsp->iMask12, iota, dsp->iConst33, count);
+    zitarev_zero(dsp->fVec13, dsp->iMask13, iota, dsp->iConst34, count);
+    zitarev_zero(dsp->fVec14, dsp->iMask14, iota, dsp->iConst38, count);
+    zitarev_zero(dsp->fVec15, dsp->iMask15, iota, dsp->iConst39, count);
+    zitarev_zero(dsp->fVec16, dsp->iMask16, iota, dsp->iConst43, count);
+    zitarev_zero(dsp->fVec17, dsp->iMask17, iota, dsp->iConst44, count);
+}
+
 int sp_zitarev_init(sp_data *sp, sp_zitarev *p)
 {
     zitarev *dsp = newzitarev(); 
@@ -1034,6 +1010,7 @@ int sp_zitarev_init(sp_data *sp, sp_zitarev *p)
     UI.uiInterface = p;
     buildUserInterfacezitarev(dsp, &UI);
     initzitarev(dsp, sp->sr);
+    zitarev_alloc(dsp);
 
     p->in_delay = p->args[0]; 
     p->lf_x = p->args[1]; 
@@ -1053,10 +1030,39 @@ int sp_zitarev_init(sp_data *sp, sp_zitarev *p)
 
 int sp_zitarev_compute(sp_data *sp, sp_zitarev *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2) 
 {
+    return sp_zitarev_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
 
+int sp_zitarev_compute_block(sp_data *sp, sp_zitarev *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n)
+{
     zitarev *dsp = p->faust;
     SPFLOAT *faust_out[] = {out1, out2};
-    SPFLOAT *faust_in[] = {in1, in2};
-    computezitarev(dsp, 1, faust_in, faust_out);
+    SPFLOAT *faust_in[] = {(SPFLOAT *)in1, (SPFLOAT *)in2};
+    SPFLOAT peak = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (fabsf(in1[i]) > peak) peak = fabsf(in1[i]);
+        if (fabsf(in2[i]) > peak) peak = fabsf(in2[i]);
+    }
+
+    /* the tail has died away and nothing new comes in */
+    if (peak < ZITAREV_SILENCE && dsp->iQuiet >= dsp->iQuietLen) {
+        for (i = 0; i < n; i++) {
+            out1[i] = 0;
+            out2[i] = 0;
+        }
+        return SP_OK;
+    }
+
+    zitarev_clear(dsp, n);
+    computezitarev(dsp, n, faust_in, faust_out);
+
+    if (peak < ZITAREV_SILENCE &&
+            dsp->fPeak < ZITAREV_SILENCE * ZITAREV_SILENCE) {
+        if (dsp->iQuiet < dsp->iQuietLen) dsp->iQuiet += n;
+    } else {
+        dsp->iQuiet = 0;
+    }
     return SP_OK;
 }
@@ -25,6 +25,11 @@ typedef struct sp_auxdata {
     void *ptr;
 } sp_auxdata;
 
+/* bump allocator handing out SP_ARENA_ALIGN aligned chunks, see base.c */
+#define SP_ARENA_ALIGN 64
+
+typedef struct sp_arena sp_arena;
+
 typedef struct sp_data { 
     SPFLOAT *out;
     int sr;
@@ -34,6 +39,9 @@ typedef struct sp_data {
     char filename[200];
     int k;
     uint32_t rand;
+    sp_arena *arena;
+    /* table cache directory, see sp_ftbl_cache() */
+    char *ftcache;
 } sp_data; 
 
 typedef struct {
@@ -42,6 +50,8 @@ typedef struct {
 } sp_param;
 
 int sp_auxdata_alloc(sp_auxdata *aux, size_t size);
+/* like sp_auxdata_alloc(), but the memory is not cleared */
+int sp_auxdata_reserve(sp_auxdata *aux, size_t size);
 int sp_auxdata_free(sp_auxdata *aux);
 int sp_auxdata_getbuf(sp_auxdata *aux, uint32_t pos, SPFLOAT *out);
 int sp_auxdata_setbuf(sp_auxdata *aux, uint32_t pos, SPFLOAT *in);
@@ -50,11 +60,48 @@ int sp_create(sp_data **spp);
 int sp_createn(sp_data **spp, int nchan);
 
 int sp_destroy(sp_data **spp);
+
+/*
+ * Arena allocation
+ *
+ * sp_create_arena() works like sp_create(), but also gives sp_data an arena
+ * of the given size and binds it to the calling thread. While an arena is
+ * bound, module structs, sp_auxdata buffers and sp_ftbl storage are carved
+ * from it instead of the heap; requests that do not fit fall back to
+ * malloc(). Destroying a module whose memory came from an arena releases
+ * nothing, whichever thread does it; once every such module is destroyed,
+ * sp_arena_reset() makes the whole arena available again, and returns
+ * SP_NOT_OK while any is left. Call it only while no thread is creating
+ * modules from the arena.
+ *
+ * sp_create_* takes no sp_data, so allocations find the arena through the
+ * thread binding, which only sp_create_arena() and sp_arena_bind() change.
+ * Call sp_arena_bind() on any other thread that creates modules for this
+ * sp_data, and sp_arena_bind(NULL) to go back to the heap. Several threads
+ * may be bound to one arena at once. A binding to an arena whose sp_data
+ * has been destroyed is dropped on that thread's next sp_malloc(), which
+ * then uses the heap; the arena's memory is freed once its sp_data, its
+ * blocks and its bindings are all gone.
+ *
+ * Memory from sp_malloc() must be given back with sp_free(), never free().
+ */
+int sp_create_arena(sp_data **spp, size_t size);
+int sp_arena_bind(sp_data *sp);
+int sp_arena_reset(sp_data *sp);
+void *sp_malloc(size_t size);
+void sp_free(void *ptr);
 int sp_process(sp_data *sp, void *ud, void (*callback)(sp_data *, void *));
 int sp_process_raw(sp_data *sp, void *ud, void (*callback)(sp_data *, void *));
 
 SPFLOAT sp_midi2cps(SPFLOAT nn);
 
+/*
+ * Every module also has a sp_*_compute_block() variant that processes n
+ * samples at once, taking one buffer per argument of sp_*_compute(). Module
+ * parameters are read once per block. Generators ignore their input buffer,
+ * which may be NULL.
+ */
+
 int sp_set(sp_param *p, SPFLOAT val);
 
 int sp_out(sp_data *sp, uint32_t chan, SPFLOAT val);
@@ -62,17 +109,101 @@ int sp_out(sp_data *sp, uint32_t chan, SPFLOAT val);
 uint32_t sp_rand(sp_data *sp);
 void sp_srand(sp_data *sp, uint32_t val);
 
+/*
+ * Per instance random numbers
+ *
+ * sp_prng runs SP_PRNG_LANES xoshiro128+ generators side by side, so the
+ * block functions vectorize. The values drawn depend only on the seed, not
+ * on how they are split into blocks or calls. Modules own one each and
+ * seed it with sp_prng_init(), which draws the seed from sp_rand(): modules
+ * initialized in the same order after the same sp_srand() produce the same
+ * output, whichever thread runs them.
+ */
+#define SP_PRNG_LANES 8
 
 typedef struct {
-    SPFLOAT *utbl;
-    int16_t *BRLow;
+    uint32_t s[4][SP_PRNG_LANES];
+    uint32_t buf[SP_PRNG_LANES];
+    SPFLOAT gbuf[SP_PRNG_LANES];
+    int pos, gpos;
+} sp_prng;
+
+void sp_prng_init(sp_data *sp, sp_prng *p);
+void sp_prng_seed(sp_prng *p, uint32_t seed);
+/* 31 bit value below SP_RANDMAX, a drop-in for sp_rand() */
+uint32_t sp_prng_rand(sp_prng *p);
+/* n values uniform in [lo, hi) */
+void sp_prng_uniform(sp_prng *p, SPFLOAT *out, uint32_t n, SPFLOAT lo, SPFLOAT hi);
+/* n values approximately normal (sum of 12 uniforms, so bounded at 6 sigma) */
+void sp_prng_gauss(sp_prng *p, SPFLOAT *out, uint32_t n, SPFLOAT sigma);
+
+
+/* Real FFT plan for size 2^M, shared by every user of that size. The
+ * spectrum is packed as Re(0), Re(N/2), Re(1), Im(1), ... and the inverse
+ * is scaled by 1/N. work must hold sp_fft_plan_worksize() bytes, set up
+ * once with sp_fft_plan_work_init(), and is needed because a plan may be
+ * used from several threads at once; give each thread its own. */
+typedef struct sp_fft_plan sp_fft_plan;
+
+sp_fft_plan *sp_fft_plan_get(int M);
+void sp_fft_plan_release(sp_fft_plan *plan);
+int sp_fft_plan_size(sp_fft_plan *plan);
+size_t sp_fft_plan_worksize(sp_fft_plan *plan);
+void sp_fft_plan_work_init(sp_fft_plan *plan, void *work);
+void sp_fft_plan_forward(sp_fft_plan *plan, SPFLOAT *buf, void *work);
+void sp_fft_plan_inverse(sp_fft_plan *plan, SPFLOAT *buf, void *work);
+
+/* per instance handle on a shared plan */
+typedef struct {
+    sp_fft_plan *plan;
+    void *work;
 } sp_fft;
 
-void sp_fft_create(sp_fft **fft);
 void sp_fft_init(sp_fft *fft, int M);
 void sp_fftr(sp_fft *fft, SPFLOAT *buf, int FFTsize);
 void sp_ifftr(sp_fft *fft, SPFLOAT *buf, int FFTsize);
 void sp_fft_destroy(sp_fft *fft);
+
+/*
+ * Delay lines
+ *
+ * sp_dline is a ring buffer of a power of two samples, at least
+ * maxdelay + 2. Reads look back from pos, the slot the next sample goes
+ * to: sample i of a read with delay D is the one written D - i samples
+ * before pos. A read only sees samples already written, so loops that
+ * feed a line back into itself run in chunks no longer than the delay,
+ * reading each chunk before writing it; interpolated reads also touch the
+ * sample after ceil(D), and the cubic one the sample after that.
+ *
+ * sp_dline_readf() takes a fractional delay and one of the SP_DLINE_*
+ * interpolations. SP_DLINE_ALLPASS is recursive and keeps its state in
+ * the line, so use it for one tap per line. sp_dline_taps() mixes ntaps
+ * linearly interpolated taps, each scaled by its gain.
+ */
+#define SP_DLINE_NONE 0
+#define SP_DLINE_LINEAR 1
+#define SP_DLINE_CUBIC 2
+#define SP_DLINE_ALLPASS 3
+
+/* block size the delay based modules run their feedback loops in */
+#define SP_DLINE_CHUNK 64
+
+typedef struct {
+    SPFLOAT *buf;
+    uint32_t size, mask;
+    uint32_t pos;
+    SPFLOAT apz;
+    sp_auxdata aux;
+} sp_dline;
+
+int sp_dline_init(sp_dline *d, uint32_t maxdelay);
+void sp_dline_destroy(sp_dline *d);
+void sp_dline_clear(sp_dline *d);
+void sp_dline_write(sp_dline *d, const SPFLOAT *in, uint32_t n);
+void sp_dline_read(sp_dline *d, uint32_t delay, SPFLOAT *out, uint32_t n);
+void sp_dline_readf(sp_dline *d, SPFLOAT delay, int interp, SPFLOAT *out, uint32_t n);
+void sp_dline_taps(sp_dline *d, const SPFLOAT *delays, const SPFLOAT *gains,
+        int ntaps, SPFLOAT *out, uint32_t n);
 #ifndef kiss_fft_scalar
 #define kiss_fft_scalar SPFLOAT
 #endif
@@ -93,21 +224,64 @@ typedef struct sp_ftbl{
     SPFLOAT lodiv;
     SPFLOAT sicvt;
     SPFLOAT *tbl;
+    /* optional band-limited copies, see sp_ftbl_mipmap() */
+    SPFLOAT *mip;
+    uint32_t nmip;
+    /* file mapping tbl points into, when it came from the table cache */
+    void *map;
+    size_t maplen;
 }sp_ftbl;
 
 int sp_ftbl_create(sp_data *sp, sp_ftbl **ft, size_t size);
 int sp_ftbl_destroy(sp_ftbl **ft);
+/* builds band-limited octave levels used by osc and fosc. Call after the
+ * table has been filled; the levels are shared by every reader */
+int sp_ftbl_mipmap(sp_data *sp, sp_ftbl *ft);
+/* returns the crossfade amount from *lo to *hi for a given frequency */
+SPFLOAT sp_ftbl_mip_select(sp_data *sp, sp_ftbl *ft, SPFLOAT freq,
+        SPFLOAT **lo, SPFLOAT **hi);
 
 int sp_gen_vals(sp_data *sp, sp_ftbl *ft, const char *string);
 
 int sp_gen_sine(sp_data *sp, sp_ftbl *ft);
 int sp_gen_file(sp_data *sp, sp_ftbl *ft, const char *filename);
+/* Above two non-zero partials, even sized tables are built with one
+ * inverse FFT. Either way samples stay within 1e-6 times the sum of the
+ * absolute amplitudes of the exact sum. */
 int sp_gen_sinesum(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_gauss(sp_data *sp, sp_ftbl *ft, SPFLOAT scale, uint32_t seed);
 
 int sp_ftbl_loadfile(sp_data *sp, sp_ftbl **ft, const char *filename);
+
+/*
+ * Table cache
+ *
+ * sp_ftbl_cache() points sp_gen_sinesum(), sp_gen_line(), sp_gen_xline(),
+ * sp_gen_gauss() and sp_gen_padsynth() at a directory, which must exist,
+ * of previously generated tables; NULL turns the cache off. A generator
+ * that finds its table there maps the file in place of the table's
+ * samples instead of computing them. Mapped samples are copy-on-write:
+ * writing to them is allowed but unshares the page. The cache is only
+ * consulted for tables that are still all zeros.
+ *
+ * Other generators use the cache through sp_ftbl_cache_lookup(), which
+ * returns SP_OK when the cache applies to ft and sets *hit when ft was
+ * loaded, and sp_ftbl_cache_store() once the table has been generated
+ * after a miss. gen names the generator and args must capture everything
+ * else the contents depend on; the size and sample rate are added.
+ */
+int sp_ftbl_cache(sp_data *sp, const char *dir);
+int sp_ftbl_cache_lookup(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args, int *hit);
+int sp_ftbl_cache_store(sp_data *sp, sp_ftbl *ft, const char *gen,
+        const char *args);
+/* FNV-1a, for folding table contents into args; start h at
+ * 0xCBF29CE484222325 */
+uint64_t sp_ftbl_cache_hash(const void *data, size_t len, uint64_t h);
+/* frees the samples of ft, mapped or not */
+void sp_ftbl_release(sp_ftbl *ft);
 typedef struct{
     void (*reinit)(void *);
     void (*compute)(void *, SPFLOAT *out);
@@ -120,6 +294,7 @@ int sp_tevent_destroy(sp_tevent **te);
 int sp_tevent_init(sp_data *sp, sp_tevent *te, 
         void (*reinit)(void*), void (*compute)(void *, SPFLOAT *out), void *ud);
 int sp_tevent_compute(sp_data *sp, sp_tevent *te, SPFLOAT *in, SPFLOAT *out);
+int sp_tevent_compute_block(sp_data *sp, sp_tevent *te, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT atk;
     SPFLOAT dec;
@@ -138,11 +313,11 @@ int sp_adsr_create(sp_adsr **p);
 int sp_adsr_destroy(sp_adsr **p);
 int sp_adsr_init(sp_data *sp, sp_adsr *p);
 int sp_adsr_compute(sp_data *sp, sp_adsr *p, SPFLOAT *in, SPFLOAT *out);
+int sp_adsr_compute_block(sp_data *sp, sp_adsr *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT revtime, looptime;
     SPFLOAT coef, prvt;
-    sp_auxdata aux;
-    uint32_t bufpos;
+    sp_dline dl;
     uint32_t bufsize;
 } sp_allpass;
 
@@ -150,6 +325,7 @@ int sp_allpass_create(sp_allpass **p);
 int sp_allpass_destroy(sp_allpass **p);
 int sp_allpass_init(sp_data *sp, sp_allpass *p, SPFLOAT looptime);
 int sp_allpass_compute(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out);
+int sp_allpass_compute_block(sp_data *sp, sp_allpass *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT hp;
     SPFLOAT c1, c2, yt1, prvhp;
@@ -160,6 +336,7 @@ int sp_atone_create(sp_atone **p);
 int sp_atone_destroy(sp_atone **p);
 int sp_atone_init(sp_data *sp, sp_atone *p);
 int sp_atone_compute(sp_data *sp, sp_atone *p, SPFLOAT *in, SPFLOAT *out);
+int sp_atone_compute_block(sp_data *sp, sp_atone *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *faust;
     int argpos;
@@ -173,6 +350,7 @@ int sp_autowah_create(sp_autowah **p);
 int sp_autowah_destroy(sp_autowah **p);
 int sp_autowah_init(sp_data *sp, sp_autowah *p);
 int sp_autowah_compute(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out);
+int sp_autowah_compute_block(sp_data *sp, sp_autowah *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_bal{
     SPFLOAT asig, csig, ihp;
     SPFLOAT c1, c2, prvq, prvr, prva;
@@ -182,6 +360,7 @@ int sp_bal_create(sp_bal **p);
 int sp_bal_destroy(sp_bal **p);
 int sp_bal_init(sp_data *sp, sp_bal *p);
 int sp_bal_compute(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp, SPFLOAT *out);
+int sp_bal_compute_block(sp_data *sp, sp_bal *p, const SPFLOAT *sig, const SPFLOAT *comp, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT bcL, bcR, iK, ib, scan, T30;
     SPFLOAT pos, vel, wid;
@@ -197,6 +376,7 @@ int sp_bar_create(sp_bar **p);
 int sp_bar_destroy(sp_bar **p);
 int sp_bar_init(sp_data *sp, sp_bar *p, SPFLOAT iK, SPFLOAT ib);
 int sp_bar_compute(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out);
+int sp_bar_compute_block(sp_data *sp, sp_bar *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct{
     SPFLOAT b0, b1, b2, a0, a1, a2, reinit, xnm1, xnm2, ynm1, ynm2, cutoff, res;
     SPFLOAT sr;
@@ -207,6 +387,7 @@ int sp_biquad_create(sp_biquad **p);
 int sp_biquad_destroy(sp_biquad **p);
 int sp_biquad_init(sp_data *sp, sp_biquad *p);
 int sp_biquad_compute(sp_data *sp, sp_biquad *p, SPFLOAT *in, SPFLOAT *out);
+int sp_biquad_compute_block(sp_data *sp, sp_biquad *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT min, max;
 } sp_biscale;
@@ -215,6 +396,7 @@ int sp_biscale_create(sp_biscale **p);
 int sp_biscale_destroy(sp_biscale **p);
 int sp_biscale_init(sp_data *sp, sp_biscale *p);
 int sp_biscale_compute(sp_data *sp, sp_biscale *p, SPFLOAT *in, SPFLOAT *out);
+int sp_biscale_compute_block(sp_data *sp, sp_biscale *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *ud;
     int argpos;
@@ -227,6 +409,7 @@ int sp_blsaw_create(sp_blsaw **p);
 int sp_blsaw_destroy(sp_blsaw **p);
 int sp_blsaw_init(sp_data *sp, sp_blsaw *p);
 int sp_blsaw_compute(sp_data *sp, sp_blsaw *p, SPFLOAT *in, SPFLOAT *out);
+int sp_blsaw_compute_block(sp_data *sp, sp_blsaw *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *ud;
     int argpos;
@@ -240,6 +423,7 @@ int sp_blsquare_create(sp_blsquare **p);
 int sp_blsquare_destroy(sp_blsquare **p);
 int sp_blsquare_init(sp_data *sp, sp_blsquare *p);
 int sp_blsquare_compute(sp_data *sp, sp_blsquare *p, SPFLOAT *in, SPFLOAT *out);
+int sp_blsquare_compute_block(sp_data *sp, sp_blsquare *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *ud;
     int argpos;
@@ -252,6 +436,7 @@ int sp_bltriangle_create(sp_bltriangle **p);
 int sp_bltriangle_destroy(sp_bltriangle **p);
 int sp_bltriangle_init(sp_data *sp, sp_bltriangle *p);
 int sp_bltriangle_compute(sp_data *sp, sp_bltriangle *p, SPFLOAT *in, SPFLOAT *out);
+int sp_bltriangle_compute_block(sp_data *sp, sp_bltriangle *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 
 typedef struct {
     SPFLOAT incr;
@@ -264,6 +449,7 @@ int sp_fold_create(sp_fold **p);
 int sp_fold_destroy(sp_fold **p);
 int sp_fold_init(sp_data *sp, sp_fold *p);
 int sp_fold_compute(sp_data *sp, sp_fold *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fold_compute_block(sp_data *sp, sp_fold *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT bitdepth;
     SPFLOAT srate;
@@ -274,6 +460,7 @@ int sp_bitcrush_create(sp_bitcrush **p);
 int sp_bitcrush_destroy(sp_bitcrush **p);
 int sp_bitcrush_init(sp_data *sp, sp_bitcrush *p);
 int sp_bitcrush_compute(sp_data *sp, sp_bitcrush *p, SPFLOAT *in, SPFLOAT *out);
+int sp_bitcrush_compute_block(sp_data *sp, sp_bitcrush *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT sr, freq, bw, istor;
     SPFLOAT lkf, lkb;
@@ -285,6 +472,7 @@ int sp_butbp_create(sp_butbp **p);
 int sp_butbp_destroy(sp_butbp **p);
 int sp_butbp_init(sp_data *sp, sp_butbp *p);
 int sp_butbp_compute(sp_data *sp, sp_butbp *p, SPFLOAT *in, SPFLOAT *out);
+int sp_butbp_compute_block(sp_data *sp, sp_butbp *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT sr, freq, bw, istor;
     SPFLOAT lkf, lkb;
@@ -296,6 +484,7 @@ int sp_butbr_create(sp_butbr **p);
 int sp_butbr_destroy(sp_butbr **p);
 int sp_butbr_init(sp_data *sp, sp_butbr *p);
 int sp_butbr_compute(sp_data *sp, sp_butbr *p, SPFLOAT *in, SPFLOAT *out);
+int sp_butbr_compute_block(sp_data *sp, sp_butbr *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct  {
     SPFLOAT sr, freq, istor;
     SPFLOAT lkf;
@@ -307,6 +496,7 @@ int sp_buthp_create(sp_buthp **p);
 int sp_buthp_destroy(sp_buthp **p);
 int sp_buthp_init(sp_data *sp, sp_buthp *p);
 int sp_buthp_compute(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out);
+int sp_buthp_compute_block(sp_data *sp, sp_buthp *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct  {
     SPFLOAT sr, freq, istor;
     SPFLOAT lkf;
@@ -318,6 +508,42 @@ int sp_butlp_create(sp_butlp **p);
 int sp_butlp_destroy(sp_butlp **p);
 int sp_butlp_init(sp_data *sp, sp_butlp *p);
 int sp_butlp_compute(sp_data *sp, sp_butlp *p, SPFLOAT *in, SPFLOAT *out);
+int sp_butlp_compute_block(sp_data *sp, sp_butlp *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
+typedef struct {
+    uint32_t nchan, nlanes;
+    SPFLOAT *b0, *b1, *b2, *a1, *a2;
+    SPFLOAT *z1, *z2;
+    sp_auxdata aux;
+} sp_bqbank;
+
+int sp_bqbank_create(sp_bqbank **p);
+int sp_bqbank_destroy(sp_bqbank **p);
+int sp_bqbank_init(sp_data *sp, sp_bqbank *p, uint32_t nchan);
+int sp_bqbank_set(sp_bqbank *p, uint32_t chan, const SPFLOAT *c);
+int sp_bqbank_clear(sp_bqbank *p);
+/* in and out hold one sample per channel */
+int sp_bqbank_compute(sp_data *sp, sp_bqbank *p, SPFLOAT *in, SPFLOAT *out);
+/* in and out hold one buffer of n samples per channel */
+int sp_bqbank_compute_block(sp_data *sp, sp_bqbank *p, const SPFLOAT **in, SPFLOAT **out, uint32_t n);
+
+/*
+ * Coefficient design for sp_bqbank_set(). Each writes {b0, b1, b2, a1, a2}
+ * to c, matching the filter of the module with the same name. pareq modes
+ * are 0 (peaking), 1 (low shelf) and 2 (high shelf). Like the modules,
+ * the butterworth filters output 0 when freq (lp, hp) or bw (bp, br) is
+ * not above 0.
+ *
+ * sp_bqbank_eqfil_ap() writes {d, a} for the allpass section that eqfil
+ * mixes with its input, (a - d (1 + a) z^-1 + z^-2) /
+ * (1 - d (1 + a) z^-1 + a z^-2). The eqfil module runs it in that form.
+ */
+int sp_bqbank_butlp(sp_data *sp, SPFLOAT freq, SPFLOAT *c);
+int sp_bqbank_buthp(sp_data *sp, SPFLOAT freq, SPFLOAT *c);
+int sp_bqbank_butbp(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c);
+int sp_bqbank_butbr(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c);
+int sp_bqbank_pareq(sp_data *sp, int mode, SPFLOAT fc, SPFLOAT v, SPFLOAT q, SPFLOAT *c);
+int sp_bqbank_eqfil(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT gain, SPFLOAT *c);
+int sp_bqbank_eqfil_ap(sp_data *sp, SPFLOAT freq, SPFLOAT bw, SPFLOAT *c);
 typedef struct{
     SPFLOAT arg, lim, k1, k2;
     int meth;
@@ -327,11 +553,11 @@ int sp_clip_create(sp_clip **p);
 int sp_clip_destroy(sp_clip **p);
 int sp_clip_init(sp_data *sp, sp_clip *p);
 int sp_clip_compute(sp_data *sp, sp_clip *p, SPFLOAT *in, SPFLOAT *out);
+int sp_clip_compute_block(sp_data *sp, sp_clip *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_comb{
     SPFLOAT revtime, looptime;
     SPFLOAT coef, prvt;
-    sp_auxdata aux;
-    uint32_t bufpos;
+    sp_dline dl;
     uint32_t bufsize;
 } sp_comb;
 
@@ -339,6 +565,7 @@ int sp_comb_create(sp_comb **p);
 int sp_comb_destroy(sp_comb **p);
 int sp_comb_init(sp_data *sp, sp_comb *p, SPFLOAT looptime);
 int sp_comb_compute(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out);
+int sp_comb_compute_block(sp_data *sp, sp_comb *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_count{
     int32_t count, curcount;
     int mode;
@@ -348,31 +575,82 @@ int sp_count_create(sp_count **p);
 int sp_count_destroy(sp_count **p);
 int sp_count_init(sp_data *sp, sp_count *p);
 int sp_count_compute(sp_data *sp, sp_count *p, SPFLOAT *in, SPFLOAT *out);
+int sp_count_compute_block(sp_data *sp, sp_count *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
+#ifndef SP_CONV_MAXSTAGES
+#define SP_CONV_MAXSTAGES 16
+#endif
+
+#ifndef SP_CONV_MAXCHAN
+#define SP_CONV_MAXCHAN 4
+#endif
+
+/* partitions per stage before the non-uniform engine doubles the size */
+#ifndef SP_CONV_NUPARTS
+#define SP_CONV_NUPARTS 8
+#endif
+
+/* one uniformly partitioned section of the impulse response */
 typedef struct {
-    SPFLOAT aOut[1];
-    SPFLOAT aIn;
-    SPFLOAT iPartLen;
-    SPFLOAT iSkipSamples;
-    SPFLOAT iTotLen;
-    int initDone;
-    int nChannels;
     int cnt;
     int nPartitions;
     int partSize;
     int rbCnt;
+    int delay;
     SPFLOAT *tmpBuf;
     SPFLOAT *ringBuf;
-    SPFLOAT *IR_Data[1];
-    SPFLOAT *outBuffers[1];
+    SPFLOAT *IR_Data[SP_CONV_MAXCHAN];
+    SPFLOAT *outBuffers[SP_CONV_MAXCHAN];
     sp_auxdata auxData;
-    sp_ftbl *ftbl;
     sp_fft fft;
+} sp_conv_stage;
+
+typedef struct {
+    SPFLOAT aOut[1];
+    SPFLOAT aIn;
+    SPFLOAT iPartLen;
+    SPFLOAT iSkipSamples;
+    SPFLOAT iTotLen;
+    int initDone;
+    int nChannels;
+    int nstages;
+    sp_conv_stage stage[SP_CONV_MAXSTAGES];
+    SPFLOAT *hist;
+    uint32_t histmask;
+    uint32_t histpos;
+    sp_auxdata histData;
+    struct sp_conv_worker *worker;
+    sp_ftbl *ftbl;
 } sp_conv;
 
 int sp_conv_create(sp_conv **p);
 int sp_conv_destroy(sp_conv **p);
 int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen);
+/* Non-uniform partitioning: the head of the IR uses iPartLen partitions,
+ * and the partition size doubles every SP_CONV_NUPARTS partitions up to
+ * iMaxPartLen. Latency stays at iPartLen samples. */
+int sp_conv_init_nonuniform(sp_data *sp, sp_conv *p, sp_ftbl *ft,
+        SPFLOAT iPartLen, SPFLOAT iMaxPartLen);
+/* Moves the stages with partitions of at least iMinPartLen samples to a
+ * worker thread, so the render thread cost no longer spikes when a large
+ * partition completes. Call after sp_conv_init_nonuniform() and before the
+ * first sp_conv_compute(). Output is unchanged as long as the worker keeps
+ * up; a block it returns late is played as silence rather than waited
+ * for. Returns SP_NOT_OK when no stage qualifies or threads are
+ * unavailable. */
+int sp_conv_thread_start(sp_conv *p, SPFLOAT iMinPartLen);
+/* Multichannel: one input convolved with nchan IRs, read from channels
+ * first .. first + nchan - 1 of a table holding stride interleaved
+ * channels. The input spectrum is computed once and shared by all IRs.
+ * For true stereo with a 4 channel (LL LR RL RR) table, use one sp_conv
+ * per input with (stride 4, first 0, nchan 2) and (4, 2, 2), and sum
+ * their outputs. */
+int sp_conv_initn(sp_data *sp, sp_conv *p, sp_ftbl *ft, int stride, int first,
+        int nchan, SPFLOAT iPartLen, SPFLOAT iMaxPartLen);
+/* writes nChannels outputs */
 int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out);
+/* mono only; use sp_conv_compute_blockn() when nChannels > 1 */
+int sp_conv_compute_block(sp_data *sp, sp_conv *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
+int sp_conv_compute_blockn(sp_data *sp, sp_conv *p, const SPFLOAT *in, SPFLOAT **out, uint32_t n);
 typedef struct {
     SPFLOAT gg;
     SPFLOAT outputs;
@@ -384,20 +662,22 @@ int sp_dcblock_create(sp_dcblock **p);
 int sp_dcblock_destroy(sp_dcblock **p);
 int sp_dcblock_init(sp_data *sp, sp_dcblock *p);
 int sp_dcblock_compute(sp_data *sp, sp_dcblock *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dcblock_compute_block(sp_data *sp, sp_dcblock *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT time;
     SPFLOAT feedback;
     SPFLOAT last;
-    sp_auxdata buf;
+    sp_dline dl;
     uint32_t bufsize;
-    uint32_t bufpos;
-    int init;
+    /* samples left in the first pass through the line */
+    uint32_t init;
 } sp_delay;
 
 int sp_delay_create(sp_delay **p);
 int sp_delay_destroy(sp_delay **p);
 int sp_delay_init(sp_data *sp, sp_delay *p, SPFLOAT time);
 int sp_delay_compute(sp_data *sp, sp_delay *p, SPFLOAT *in, SPFLOAT *out);
+int sp_delay_compute_block(sp_data *sp, sp_delay *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_dist{
     SPFLOAT pregain, postgain, shape1, shape2, mode;
 } sp_dist;
@@ -406,6 +686,7 @@ int sp_dist_create(sp_dist **p);
 int sp_dist_destroy(sp_dist **p);
 int sp_dist_init(sp_data *sp, sp_dist *p);
 int sp_dist_compute(sp_data *sp, sp_dist *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dist_compute_block(sp_data *sp, sp_dist *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT time;
     uint32_t counter;
@@ -415,6 +696,7 @@ int sp_dmetro_create(sp_dmetro **p);
 int sp_dmetro_destroy(sp_dmetro **p);
 int sp_dmetro_init(sp_data *sp, sp_dmetro *p);
 int sp_dmetro_compute(sp_data *sp, sp_dmetro *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dmetro_compute_block(sp_data *sp, sp_dmetro *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_drip{
 
     SPFLOAT amp; /* How loud */
@@ -461,12 +743,14 @@ typedef struct sp_drip{
     SPFLOAT res_freq2;
     SPFLOAT shake_damp;
     int kloop;
+    sp_prng prng;
 } sp_drip;
 
 int sp_drip_create(sp_drip **p);
 int sp_drip_destroy(sp_drip **p);
 int sp_drip_init(sp_data *sp, sp_drip *p, SPFLOAT dettack);
 int sp_drip_compute(sp_data *sp, sp_drip *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_drip_compute_block(sp_data *sp, sp_drip *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n);
 typedef struct sp_dtrig{
     sp_ftbl *ft;
     uint32_t counter;
@@ -480,31 +764,35 @@ int sp_dtrig_create(sp_dtrig **p);
 int sp_dtrig_destroy(sp_dtrig **p);
 int sp_dtrig_init(sp_data *sp, sp_dtrig *p, sp_ftbl *ft);
 int sp_dtrig_compute(sp_data *sp, sp_dtrig *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dtrig_compute_block(sp_data *sp, sp_dtrig *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_dust{
     SPFLOAT amp, density; 
     SPFLOAT density0, thresh, scale;
     SPFLOAT onedsr;
     int bipolar; /* 1 = bipolar 0 = unipolar */
     uint32_t rand;
+    sp_prng prng;
 } sp_dust;
 
 int sp_dust_create(sp_dust **p);
 int sp_dust_destroy(sp_dust **p);
 int sp_dust_init(sp_data *sp, sp_dust *p, SPFLOAT amp, SPFLOAT density);
 int sp_dust_compute(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dust_compute_block(sp_data *sp, sp_dust *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 
 
 typedef struct {
   SPFLOAT freq, bw, gain;
   SPFLOAT z1,z2, sr;
   SPFLOAT frv, bwv;
-  SPFLOAT c,d;
+  SPFLOAT a,d;
 } sp_eqfil;
 
 int sp_eqfil_create(sp_eqfil **p);
 int sp_eqfil_destroy(sp_eqfil **p);
 int sp_eqfil_init(sp_data *sp, sp_eqfil *p);
 int sp_eqfil_compute(sp_data *sp, sp_eqfil *p, SPFLOAT *in, SPFLOAT *out);
+int sp_eqfil_compute_block(sp_data *sp, sp_eqfil *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT a, dur, b;
     SPFLOAT val, incr; 
@@ -516,6 +804,7 @@ int sp_expon_create(sp_expon **p);
 int sp_expon_destroy(sp_expon **p);
 int sp_expon_init(sp_data *sp, sp_expon *p);
 int sp_expon_compute(sp_data *sp, sp_expon *p, SPFLOAT *in, SPFLOAT *out);
+int sp_expon_compute_block(sp_data *sp, sp_expon *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct{
     SPFLOAT freq, atk, dec, istor;
     SPFLOAT tpidsr;
@@ -527,6 +816,7 @@ int sp_fofilt_create(sp_fofilt **t);
 int sp_fofilt_destroy(sp_fofilt **t);
 int sp_fofilt_init(sp_data *sp, sp_fofilt *p);
 int sp_fofilt_compute(sp_data *sp, sp_fofilt *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fofilt_compute_block(sp_data *sp, sp_fofilt *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 
 typedef struct {
     SPFLOAT bar;
@@ -536,6 +826,7 @@ int sp_foo_create(sp_foo **p);
 int sp_foo_destroy(sp_foo **p);
 int sp_foo_init(sp_data *sp, sp_foo *p);
 int sp_foo_compute(sp_data *sp, sp_foo *p, SPFLOAT *in, SPFLOAT *out);
+int sp_foo_compute_block(sp_data *sp, sp_foo *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_fosc{
     SPFLOAT amp, freq, car, mod, indx, iphs;
     int32_t mphs, cphs;
@@ -546,6 +837,7 @@ int sp_fosc_create(sp_fosc **p);
 int sp_fosc_destroy(sp_fosc **p);
 int sp_fosc_init(sp_data *sp, sp_fosc *p, sp_ftbl *ft);
 int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fosc_compute_block(sp_data *sp, sp_fosc *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
         SPFLOAT amp, freq, nharm, lharm, mul, iphs;
         int16_t ampcod, cpscod, prvn;
@@ -560,6 +852,7 @@ int sp_gbuzz_create(sp_gbuzz **p);
 int sp_gbuzz_destroy(sp_gbuzz **p);
 int sp_gbuzz_init(sp_data *sp, sp_gbuzz *p, sp_ftbl *ft, SPFLOAT iphs);
 int sp_gbuzz_compute(sp_data *sp, sp_gbuzz *p, SPFLOAT *in, SPFLOAT *out);
+int sp_gbuzz_compute_block(sp_data *sp, sp_gbuzz *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     FILE *fp;
 } sp_in;
@@ -568,6 +861,7 @@ int sp_in_create(sp_in **p);
 int sp_in_destroy(sp_in **p);
 int sp_in_init(sp_data *sp, sp_in *p);
 int sp_in_compute(sp_data *sp, sp_in *p, SPFLOAT *in, SPFLOAT *out);
+int sp_in_compute_block(sp_data *sp, sp_in *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *ud;
 } sp_jcrev;
@@ -576,18 +870,21 @@ int sp_jcrev_create(sp_jcrev **p);
 int sp_jcrev_destroy(sp_jcrev **p);
 int sp_jcrev_init(sp_data *sp, sp_jcrev *p);
 int sp_jcrev_compute(sp_data *sp, sp_jcrev *p, SPFLOAT *in, SPFLOAT *out);
+int sp_jcrev_compute_block(sp_data *sp, sp_jcrev *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_jitter{
     SPFLOAT amp, cpsMin, cpsMax;
     SPFLOAT cps;
     int32_t phs;
     int initflag;
     SPFLOAT num1, num2, dfdmax;
+    sp_prng prng;
 } sp_jitter;
 
 int sp_jitter_create(sp_jitter **p);
 int sp_jitter_destroy(sp_jitter **p);
 int sp_jitter_init(sp_data *sp, sp_jitter *p);
 int sp_jitter_compute(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out);
+int sp_jitter_compute_block(sp_data *sp, sp_jitter *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT a, dur, b;
     SPFLOAT val, incr; 
@@ -599,6 +896,7 @@ int sp_line_create(sp_line **p);
 int sp_line_destroy(sp_line **p);
 int sp_line_init(sp_data *sp, sp_line *p);
 int sp_line_compute(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out);
+int sp_line_compute_block(sp_data *sp, sp_line *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_lpf18{
     SPFLOAT cutoff, res, dist;
     SPFLOAT ay1, ay2, aout, lastin, onedsr;
@@ -608,16 +906,19 @@ int sp_lpf18_create(sp_lpf18 **p);
 int sp_lpf18_destroy(sp_lpf18 **p);
 int sp_lpf18_init(sp_data *sp, sp_lpf18 *p);
 int sp_lpf18_compute(sp_data *sp, sp_lpf18 *p, SPFLOAT *in, SPFLOAT *out);
+int sp_lpf18_compute_block(sp_data *sp, sp_lpf18 *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_maygate{
     SPFLOAT prob;
     SPFLOAT gate;
     int mode;
+    sp_prng prng;
 } sp_maygate;
 
 int sp_maygate_create(sp_maygate **p);
 int sp_maygate_destroy(sp_maygate **p);
 int sp_maygate_init(sp_data *sp, sp_maygate *p);
 int sp_maygate_compute(sp_data *sp, sp_maygate *p, SPFLOAT *in, SPFLOAT *out);
+int sp_maygate_compute_block(sp_data *sp, sp_maygate *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_metro{
     SPFLOAT sr, freq, iphs;
     SPFLOAT curphs;
@@ -629,14 +930,20 @@ int sp_metro_create(sp_metro **p);
 int sp_metro_destroy(sp_metro **p);
 int sp_metro_init(sp_data *sp, sp_metro *p);
 int sp_metro_compute(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out);
+int sp_metro_compute_block(sp_data *sp, sp_metro *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT time, amp, pitch, lock, iN,
         idecim, onset, offset, dbthresh;
-    int cnt, hsize, curframe, N, decim,tscale;
+    int cnt, hsize, N, decim,tscale;
+    /* outframe holds one N sample overlap-add ring per channel, olapos is
+     * their read position */
+    int olapos;
+    /* channel c, frame i of the table is at tbl[c*coff + i*tstride] */
+    int nchan, tstride, coff, tlen;
     SPFLOAT pos;
     SPFLOAT accum;
     sp_auxdata outframe, win, bwin, fwin,
-    nwin, prev, framecount, indata[2];
+    nwin, prev, spec, indata[2];
     SPFLOAT *tab;
     int curbuf;
     SPFLOAT resamp;
@@ -646,8 +953,20 @@ typedef struct {
 
 int sp_mincer_create(sp_mincer **p);
 int sp_mincer_destroy(sp_mincer **p);
-int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft);
+/* winsize is the FFT size (a power of two, 2048 was the old fixed value),
+ * decim the overlap factor; the hop size is winsize/decim (decim 4). */
+int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int winsize, int decim);
+/* Multichannel: ft holds nchan channels, interleaved or (planar != 0) one
+ * after the other. The phase-locking reference is computed once from the
+ * sum of the channels and applied to every channel, which keeps their
+ * relative phases and saves one window fill and FFT per extra channel. */
+int sp_mincer_initn(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int nchan,
+        int planar, int winsize, int decim);
+/* writes nchan outputs */
 int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in, SPFLOAT *out);
+/* mono only; use sp_mincer_compute_blockn() when nchan > 1 */
+int sp_mincer_compute_block(sp_data *sp, sp_mincer *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
+int sp_mincer_compute_blockn(sp_data *sp, sp_mincer *p, const SPFLOAT *in, SPFLOAT **out, uint32_t n);
 typedef struct{
     SPFLOAT freq, q, xnm1, ynm1, ynm2, a0, a1, a2, d, lfq, lq;
     SPFLOAT sr;
@@ -657,6 +976,7 @@ int sp_mode_create(sp_mode **p);
 int sp_mode_destroy(sp_mode **p);
 int sp_mode_init(sp_data *sp, sp_mode *p);
 int sp_mode_compute(sp_data *sp, sp_mode *p, SPFLOAT *in, SPFLOAT *out);
+int sp_mode_compute_block(sp_data *sp, sp_mode *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT freq;
     SPFLOAT res;
@@ -674,13 +994,46 @@ int sp_moogladder_create(sp_moogladder **t);
 int sp_moogladder_destroy(sp_moogladder **t);
 int sp_moogladder_init(sp_data *sp, sp_moogladder *p);
 int sp_moogladder_compute(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *out);
+int sp_moogladder_compute_block(sp_data *sp, sp_moogladder *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
+/* computes the amplitude correction and tuning used for a cutoff of freq */
+int sp_moogladder_tune(sp_data *sp, SPFLOAT freq, SPFLOAT *acr, SPFLOAT *tune);
+
+#define SP_MOOGBANK_TANH_LIBM 0
+#define SP_MOOGBANK_TANH_LAMBERT 1
+#define SP_MOOGBANK_TANH_PADE 2
+
+typedef struct {
+    SPFLOAT freq;
+    SPFLOAT res;
+    int tanh_mode;
+
+    uint32_t nchan, nlanes;
+    SPFLOAT *delay[6];
+    SPFLOAT *tanhstg[3];
+    SPFLOAT oldfreq;
+    SPFLOAT oldres;
+    SPFLOAT oldacr;
+    SPFLOAT oldtune;
+    sp_auxdata aux;
+} sp_moogbank;
+
+int sp_moogbank_create(sp_moogbank **p);
+int sp_moogbank_destroy(sp_moogbank **p);
+int sp_moogbank_init(sp_data *sp, sp_moogbank *p, uint32_t nchan);
+int sp_moogbank_clear(sp_moogbank *p);
+/* in and out hold one sample per channel */
+int sp_moogbank_compute(sp_data *sp, sp_moogbank *p, SPFLOAT *in, SPFLOAT *out);
+/* in and out hold one buffer of n samples per channel */
+int sp_moogbank_compute_block(sp_data *sp, sp_moogbank *p, const SPFLOAT **in, SPFLOAT **out, uint32_t n);
 typedef struct{
     SPFLOAT amp;
+    sp_prng prng;
 }sp_noise;
 
 int sp_noise_create(sp_noise **ns);
 int sp_noise_init(sp_data *sp, sp_noise *ns);
 int sp_noise_compute(sp_data *sp, sp_noise *ns, SPFLOAT *in, SPFLOAT *out);
+int sp_noise_compute_block(sp_data *sp, sp_noise *ns, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 int sp_noise_destroy(sp_noise **ns);
 typedef struct {
     SPFLOAT freq, amp, iphs;
@@ -693,6 +1046,7 @@ int sp_osc_create(sp_osc **osc);
 int sp_osc_destroy(sp_osc **osc);
 int sp_osc_init(sp_data *sp, sp_osc *osc, sp_ftbl *ft, SPFLOAT iphs);
 int sp_osc_compute(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out);
+int sp_osc_compute_block(sp_data *sp, sp_osc *osc, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT freq, amp, iphs;
     int32_t lphs;
@@ -706,6 +1060,7 @@ int sp_oscmorph_create(sp_oscmorph **p);
 int sp_oscmorph_destroy(sp_oscmorph **p);
 int sp_oscmorph_init(sp_data *sp, sp_oscmorph *osc, sp_ftbl **ft, int nft, SPFLOAT iphs);
 int sp_oscmorph_compute(sp_data *sp, sp_oscmorph *p, SPFLOAT *in, SPFLOAT *out);
+int sp_oscmorph_compute_block(sp_data *sp, sp_oscmorph *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT pan;
     uint32_t type;
@@ -715,6 +1070,7 @@ int sp_pan2_create(sp_pan2 **p);
 int sp_pan2_destroy(sp_pan2 **p);
 int sp_pan2_init(sp_data *sp, sp_pan2 *p);
 int sp_pan2_compute(sp_data *sp, sp_pan2 *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2);
+int sp_pan2_compute_block(sp_data *sp, sp_pan2 *p, const SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2, uint32_t n);
 typedef struct {
     SPFLOAT pan;
     uint32_t type;
@@ -724,6 +1080,7 @@ int sp_panst_create(sp_panst **p);
 int sp_panst_destroy(sp_panst **p);
 int sp_panst_init(sp_data *sp, sp_panst *p);
 int sp_panst_compute(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_panst_compute_block(sp_data *sp, sp_panst *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n);
 typedef struct {
     SPFLOAT fc, v, q, mode;
 
@@ -738,6 +1095,7 @@ int sp_pareq_create(sp_pareq **p);
 int sp_pareq_destroy(sp_pareq **p);
 int sp_pareq_init(sp_data *sp, sp_pareq *p);
 int sp_pareq_compute(sp_data *sp, sp_pareq *p, SPFLOAT *in, SPFLOAT *out);
+int sp_pareq_compute_block(sp_data *sp, sp_pareq *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *faust;
     int argpos;
@@ -759,6 +1117,7 @@ int sp_phaser_destroy(sp_phaser **p);
 int sp_phaser_init(sp_data *sp, sp_phaser *p);
 int sp_phaser_compute(sp_data *sp, sp_phaser *p, 
 	SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_phaser_compute_block(sp_data *sp, sp_phaser *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n);
 typedef struct sp_phasor{
     SPFLOAT freq, phs;
     SPFLOAT curphs, onedsr;
@@ -768,17 +1127,20 @@ int sp_phasor_create(sp_phasor **p);
 int sp_phasor_destroy(sp_phasor **p);
 int sp_phasor_init(sp_data *sp, sp_phasor *p, SPFLOAT iphs);
 int sp_phasor_compute(sp_data *sp, sp_phasor *p, SPFLOAT *in, SPFLOAT *out);
+int sp_phasor_compute_block(sp_data *sp, sp_phasor *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *faust;
     int argpos;
     SPFLOAT *args[1];
     SPFLOAT *amp;
+    sp_prng prng;
 } sp_pinknoise;
 
 int sp_pinknoise_create(sp_pinknoise **p);
 int sp_pinknoise_destroy(sp_pinknoise **p);
 int sp_pinknoise_init(sp_data *sp, sp_pinknoise *p);
 int sp_pinknoise_compute(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out);
+int sp_pinknoise_compute_block(sp_data *sp, sp_pinknoise *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 
 typedef struct {
     SPFLOAT imincps, imaxcps, icps;
@@ -807,18 +1169,50 @@ int sp_pitchamdf_create(sp_pitchamdf **p);
 int sp_pitchamdf_destroy(sp_pitchamdf **p);
 int sp_pitchamdf_init(sp_data *sp, sp_pitchamdf *p, SPFLOAT imincps, SPFLOAT imaxcps);
 int sp_pitchamdf_compute(sp_data *sp, sp_pitchamdf *p, SPFLOAT *in, SPFLOAT *cps, SPFLOAT *rms);
+int sp_pitchamdf_compute_block(sp_data *sp, sp_pitchamdf *p, const SPFLOAT *in, SPFLOAT *cps, SPFLOAT *rms, uint32_t n);
+
+typedef struct {
+    /* outputs, updated once per hop */
+    SPFLOAT freq, amp, conf;
+    /* YIN absolute threshold, 0.15 */
+    SPFLOAT thresh;
+    SPFLOAT minfreq, maxfreq;
+    /* analysis rate, sr/decim */
+    SPFLOAT dsr;
+    int decim, dcnt;
+    /* lags and sizes are in decimated samples */
+    int minlag, maxlag, wsize, bufsize, bufpos, hopsize, hcnt, N;
+    /* input energy of the current and the last four hops */
+    SPFLOAT sumsq, hopsq[4];
+    int hopidx;
+    /* two biquad sections of the decimation lowpass */
+    SPFLOAT c[2][5], z[2][2];
+    sp_auxdata buf, work;
+    sp_fft fft;
+} sp_pitchyin;
+
+int sp_pitchyin_create(sp_pitchyin **p);
+int sp_pitchyin_destroy(sp_pitchyin **p);
+/* Tracks pitches between minfreq and maxfreq. The input is lowpassed and
+ * decimated to about 8 * maxfreq before analysis. */
+int sp_pitchyin_init(sp_data *sp, sp_pitchyin *p, SPFLOAT minfreq, SPFLOAT maxfreq);
+int sp_pitchyin_compute(sp_data *sp, sp_pitchyin *p, SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp, SPFLOAT *conf);
+/* any of freq, amp and conf may be NULL */
+int sp_pitchyin_compute_block(sp_data *sp, sp_pitchyin *p, const SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp, SPFLOAT *conf, uint32_t n);
 typedef struct {
     SPFLOAT amp, freq, ifreq;
     SPFLOAT sicps;
     int32_t phs256, npts, maxpts;
     sp_auxdata auxch;
     char init;
+    sp_prng prng;
 } sp_pluck;
 
 int sp_pluck_create(sp_pluck **p);
 int sp_pluck_destroy(sp_pluck **p);
 int sp_pluck_init(sp_data *sp, sp_pluck *p, SPFLOAT ifreq);
 int sp_pluck_compute(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_pluck_compute_block(sp_data *sp, sp_pluck *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n);
 typedef struct{
     SPFLOAT htime;
     SPFLOAT c1, c2, yt1, prvhtim;
@@ -829,6 +1223,7 @@ int sp_port_create(sp_port **p);
 int sp_port_destroy(sp_port **p);
 int sp_port_init(sp_data *sp, sp_port *p, SPFLOAT htime);
 int sp_port_compute(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out);
+int sp_port_compute_block(sp_data *sp, sp_port *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT freq, amp, iphs;
     sp_ftbl *tbl;
@@ -842,6 +1237,7 @@ int sp_posc3_create(sp_posc3 **posc3);
 int sp_posc3_destroy(sp_posc3 **posc3);
 int sp_posc3_init(sp_data *sp, sp_posc3 *posc3, sp_ftbl *ft);
 int sp_posc3_compute(sp_data *sp, sp_posc3 *posc3, SPFLOAT *in, SPFLOAT *out);
+int sp_posc3_compute_block(sp_data *sp, sp_posc3 *posc3, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     int nbars, skip;
     int counter;
@@ -852,6 +1248,7 @@ int sp_progress_create(sp_progress **p);
 int sp_progress_destroy(sp_progress **p);
 int sp_progress_init(sp_data *sp, sp_progress *p);
 int sp_progress_compute(sp_data *sp, sp_progress *p, SPFLOAT *in, SPFLOAT *out);
+int sp_progress_compute_block(sp_data *sp, sp_progress *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct prop_event {
     char type;
     uint32_t pos;
@@ -894,17 +1291,20 @@ int sp_prop_create(sp_prop **p);
 int sp_prop_destroy(sp_prop **p);
 int sp_prop_init(sp_data *sp, sp_prop *p, const char *str);
 int sp_prop_compute(sp_data *sp, sp_prop *p, SPFLOAT *in, SPFLOAT *out);
+int sp_prop_compute_block(sp_data *sp, sp_prop *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT freq;
     SPFLOAT min, max;
     SPFLOAT val;
     uint32_t counter, dur;
+    sp_prng prng;
 } sp_randh;
 
 int sp_randh_create(sp_randh **p);
 int sp_randh_destroy(sp_randh **p);
 int sp_randh_init(sp_data *sp, sp_randh *p);
 int sp_randh_compute(sp_data *sp, sp_randh *p, SPFLOAT *in, SPFLOAT *out);
+int sp_randh_compute_block(sp_data *sp, sp_randh *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT min, max, cps, mode, fstval;
     int16_t cpscod;
@@ -918,6 +1318,7 @@ int sp_randi_create(sp_randi **p);
 int sp_randi_destroy(sp_randi **p);
 int sp_randi_init(sp_data *sp, sp_randi *p);
 int sp_randi_compute(sp_data *sp, sp_randi *p, SPFLOAT *in, SPFLOAT *out);
+int sp_randi_compute_block(sp_data *sp, sp_randi *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     int mti;
     /* do not change value 624 */
@@ -931,12 +1332,14 @@ uint32_t sp_randmt_compute(sp_randmt *p);
 typedef struct { 
     SPFLOAT min;
     SPFLOAT max;
+    sp_prng prng;
 } sp_random;
 
 int sp_random_create(sp_random **p);
 int sp_random_destroy(sp_random **p);
 int sp_random_init(sp_data *sp, sp_random *p);
 int sp_random_compute(sp_data *sp, sp_random *p, SPFLOAT *in, SPFLOAT *out);
+int sp_random_compute_block(sp_data *sp, sp_random *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct  {
     SPFLOAT delay;
     uint32_t bufpos;
@@ -948,23 +1351,13 @@ int sp_reverse_create(sp_reverse **p);
 int sp_reverse_destroy(sp_reverse **p); 
 int sp_reverse_init(sp_data *sp, sp_reverse *p, SPFLOAT delay);
 int sp_reverse_compute(sp_data *sp, sp_reverse *p, SPFLOAT *in, SPFLOAT *out);
+int sp_reverse_compute_block(sp_data *sp, sp_reverse *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct{
 size_t size;
 void *auxp;
 }auxData;
-typedef struct {
-    int     writePos;
-    int     bufferSize;
-    int     readPos;
-    int     readPosFrac;
-    int     readPosFrac_inc;
-    int     dummy;
-    int     seedVal;
-    int     randLine_cnt;
-    SPFLOAT filterState;
-    SPFLOAT *buf;
-} sp_revsc_dl;
-
+/* The 8 delay lines are kept in structure-of-arrays form so that one
+ * sample of all of them runs in vector lanes. */
 typedef struct  {
     SPFLOAT feedback, lpfreq;
     SPFLOAT iSampleRate, iPitchMod, iSkipInit;
@@ -972,7 +1365,15 @@ typedef struct  {
     SPFLOAT dampFact;
     SPFLOAT prv_LPFreq;
     int initDone;
-    sp_revsc_dl delayLines[8];
+    int writePos[8];
+    int bufferSize[8];
+    int readPos[8];
+    int readPosFrac[8];
+    int readPosFrac_inc[8];
+    int seedVal[8];
+    int randLine_cnt[8];
+    int offset[8];
+    SPFLOAT filterState[8];
     sp_auxdata aux;
 } sp_revsc;
 
@@ -980,6 +1381,7 @@ int sp_revsc_create(sp_revsc **p);
 int sp_revsc_destroy(sp_revsc **p);
 int sp_revsc_init(sp_data *sp, sp_revsc *p);
 int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_revsc_compute_block(sp_data *sp, sp_revsc *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n);
 typedef struct sp_rms{
     SPFLOAT ihp, istor;
     SPFLOAT c1, c2, prvq;
@@ -989,6 +1391,7 @@ int sp_rms_create(sp_rms **p);
 int sp_rms_destroy(sp_rms **p);
 int sp_rms_init(sp_data *sp, sp_rms *p);
 int sp_rms_compute(sp_data *sp, sp_rms *p, SPFLOAT *in, SPFLOAT *out);
+int sp_rms_compute_block(sp_data *sp, sp_rms *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_rpt{
     uint32_t playpos;
     uint32_t bufpos;
@@ -1006,6 +1409,7 @@ int sp_rpt_destroy(sp_rpt **p);
 int sp_rpt_init(sp_data *sp, sp_rpt *p, SPFLOAT maxdur);
 int sp_rpt_compute(sp_data *sp, sp_rpt *p, SPFLOAT *trig, 
         SPFLOAT *in, SPFLOAT *out);
+int sp_rpt_compute_block(sp_data *sp, sp_rpt *p, const SPFLOAT *trig, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 
 int sp_rpt_set(sp_rpt *p, SPFLOAT bpm, int div, int rep);
 typedef struct {
@@ -1016,6 +1420,7 @@ int sp_samphold_create(sp_samphold **p);
 int sp_samphold_destroy(sp_samphold **p);
 int sp_samphold_init(sp_data *sp, sp_samphold *p);
 int sp_samphold_compute(sp_data *sp, sp_samphold *p, SPFLOAT *trig, SPFLOAT *in, SPFLOAT *out);
+int sp_samphold_compute_block(sp_data *sp, sp_samphold *p, const SPFLOAT *trig, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT min, max;
 } sp_scale;
@@ -1024,18 +1429,19 @@ int sp_scale_create(sp_scale **p);
 int sp_scale_destroy(sp_scale **p);
 int sp_scale_init(sp_data *sp, sp_scale *p);
 int sp_scale_compute(sp_data *sp, sp_scale *p, SPFLOAT *in, SPFLOAT *out);
+int sp_scale_compute_block(sp_data *sp, sp_scale *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct{
     SPFLOAT freq, fdbgain;
     SPFLOAT LPdelay, APdelay;
-    SPFLOAT *Cdelay;
-    sp_auxdata buf;
-    int wpointer, rpointer, size;
+    sp_dline dl;
+    int size;
 }sp_streson;
 
 int sp_streson_create(sp_streson **p);
 int sp_streson_destroy(sp_streson **p);
 int sp_streson_init(sp_data *sp, sp_streson *p);
 int sp_streson_compute(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out);
+int sp_streson_compute_block(sp_data *sp, sp_streson *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT mode;
 } sp_switch;
@@ -1045,6 +1451,7 @@ int sp_switch_destroy(sp_switch **p);
 int sp_switch_init(sp_data *sp, sp_switch *p);
 int sp_switch_compute(sp_data *sp, sp_switch *p, SPFLOAT *trig,
     SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out);
+int sp_switch_compute_block(sp_data *sp, sp_switch *p, const SPFLOAT *trig, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT sig;
     SPFLOAT index, mode, offset, wrap;
@@ -1059,6 +1466,7 @@ int sp_tabread_create(sp_tabread **p);
 int sp_tabread_destroy(sp_tabread **p);
 int sp_tabread_init(sp_data *sp, sp_tabread *p, sp_ftbl *ft);
 int sp_tabread_compute(sp_data *sp, sp_tabread *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tabread_compute_block(sp_data *sp, sp_tabread *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT value;
     SPFLOAT target;
@@ -1081,6 +1489,7 @@ int sp_tadsr_create(sp_tadsr **p);
 int sp_tadsr_destroy(sp_tadsr **p);
 int sp_tadsr_init(sp_data *sp, sp_tadsr *p);
 int sp_tadsr_compute(sp_data *sp, sp_tadsr *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_tadsr_compute_block(sp_data *sp, sp_tadsr *p, const SPFLOAT *trig, SPFLOAT *out, uint32_t n);
 typedef struct{
     SPFLOAT fco, res, dist, asym, iskip, y, y1, y2;
     int fcocod, rezcod;
@@ -1093,6 +1502,7 @@ int sp_tbvcf_create(sp_tbvcf **p);
 int sp_tbvcf_destroy(sp_tbvcf **p);
 int sp_tbvcf_init(sp_data *sp, sp_tbvcf *p);
 int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tbvcf_compute_block(sp_data *sp, sp_tbvcf *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_tenv{
     sp_tevent *te;
     uint32_t pos, atk_end, rel_start, sr, totaldur;
@@ -1107,6 +1517,7 @@ int sp_tenv_create(sp_tenv **p);
 int sp_tenv_destroy(sp_tenv **p);
 int sp_tenv_init(sp_data *sp, sp_tenv *p);
 int sp_tenv_compute(sp_data *sp, sp_tenv *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tenv_compute_block(sp_data *sp, sp_tenv *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     int state;
     SPFLOAT atk, rel;
@@ -1120,6 +1531,7 @@ int sp_tenv2_create(sp_tenv2 **p);
 int sp_tenv2_destroy(sp_tenv2 **p);
 int sp_tenv2_init(sp_data *sp, sp_tenv2 *p);
 int sp_tenv2_compute(sp_data *sp, sp_tenv2 *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tenv2_compute_block(sp_data *sp, sp_tenv2 *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_tenvx{
     sp_tevent *te;
     uint32_t pos, atk_end, rel_start, sr, totaldur;
@@ -1134,6 +1546,7 @@ int sp_tenvx_create(sp_tenvx **p);
 int sp_tenvx_destroy(sp_tenvx **p);
 int sp_tenvx_init(sp_data *sp, sp_tenvx *p);
 int sp_tenvx_compute(sp_data *sp, sp_tenvx *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tenvx_compute_block(sp_data *sp, sp_tenvx *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     int mode, init;
     SPFLOAT prev, thresh;
@@ -1143,6 +1556,7 @@ int sp_thresh_create(sp_thresh **p);
 int sp_thresh_destroy(sp_thresh **p);
 int sp_thresh_init(sp_data *sp, sp_thresh *p);
 int sp_thresh_compute(sp_data *sp, sp_thresh *p, SPFLOAT *in, SPFLOAT *out);
+int sp_thresh_compute_block(sp_data *sp, sp_thresh *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     FILE *fp;
     SPFLOAT val;
@@ -1152,6 +1566,7 @@ int sp_tin_create(sp_tin **p);
 int sp_tin_destroy(sp_tin **p);
 int sp_tin_init(sp_data *sp, sp_tin *p);
 int sp_tin_compute(sp_data *sp, sp_tin *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tin_compute_block(sp_data *sp, sp_tin *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT hp;
     SPFLOAT c1, c2, yt1, prvhp;
@@ -1162,36 +1577,42 @@ int sp_tone_create(sp_tone **t);
 int sp_tone_destroy(sp_tone **t);
 int sp_tone_init(sp_data *sp, sp_tone *t);
 int sp_tone_compute(sp_data *sp, sp_tone *t, SPFLOAT *in, SPFLOAT *out);
+int sp_tone_compute_block(sp_data *sp, sp_tone *t, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     SPFLOAT min, max, val;
+    sp_prng prng;
 } sp_trand;
 
 int sp_trand_create(sp_trand **p);
 int sp_trand_destroy(sp_trand **p);
 int sp_trand_init(sp_data *sp, sp_trand *p);
 int sp_trand_compute(sp_data *sp, sp_trand *p, SPFLOAT *in, SPFLOAT *out);
+int sp_trand_compute_block(sp_data *sp, sp_trand *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct sp_tseq {
     sp_ftbl *ft;
     SPFLOAT val;
     uint32_t pos;
     int shuf;
+    sp_prng prng;
 } sp_tseq;
 
 int sp_tseq_create(sp_tseq **p);
 int sp_tseq_destroy(sp_tseq **p);
 int sp_tseq_init(sp_data *sp, sp_tseq *p, sp_ftbl *ft);
 int sp_tseq_compute(sp_data *sp, sp_tseq *p, SPFLOAT *trig, SPFLOAT *val);
+int sp_tseq_compute_block(sp_data *sp, sp_tseq *p, const SPFLOAT *trig, SPFLOAT *val, uint32_t n);
 typedef struct sp_vdelay{
     SPFLOAT del, maxdel;
     SPFLOAT sr;
-    sp_auxdata buf;
-    int32_t left;
+    sp_dline dl;
+    uint32_t maxd;
 } sp_vdelay;
 
 int sp_vdelay_create(sp_vdelay **p);
 int sp_vdelay_destroy(sp_vdelay **p);
 int sp_vdelay_init(sp_data *sp, sp_vdelay *p, SPFLOAT maxdel);
 int sp_vdelay_compute(sp_data *sp, sp_vdelay *p, SPFLOAT *in, SPFLOAT *out);
+int sp_vdelay_compute_block(sp_data *sp, sp_vdelay *p, const SPFLOAT *in, SPFLOAT *out, uint32_t n);
 typedef struct {
     void *faust;
     int argpos;
@@ -1213,6 +1634,7 @@ int sp_zitarev_create(sp_zitarev **p);
 int sp_zitarev_destroy(sp_zitarev **p);
 int sp_zitarev_init(sp_data *sp, sp_zitarev *p);
 int sp_zitarev_compute(sp_data *sp, sp_zitarev *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_zitarev_compute_block(sp_data *sp, sp_zitarev *p, const SPFLOAT *in1, const SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, uint32_t n);
 
 #ifdef USE_FFTW3
 #include <fftw3.h>
@@ -1253,6 +1675,20 @@ typedef struct sp_padsynth {
 
 int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps, SPFLOAT f, SPFLOAT bw);
 
+/* one table of a batch, as the arguments of sp_gen_padsynth() */
+typedef struct {
+    sp_ftbl *ps;
+    sp_ftbl *amps;
+    SPFLOAT f, bw;
+} sp_padsynth_job;
+
+/* Fills the tables of njobs jobs, for example one per key zone, sharing
+ * the work between nthreads threads (up to 16, the caller's included).
+ * The result is the same as calling sp_gen_padsynth() on each job in
+ * order, whatever the thread count. */
+int sp_gen_padsynth_batch(sp_data *sp, sp_padsynth_job *jobs, int njobs,
+        int nthreads);
+
 SPFLOAT sp_padsynth_profile(SPFLOAT fi, SPFLOAT bwi);
 
 int sp_padsynth_ifft(int N, SPFLOAT *freq_amp, 
@@ -0,0 +1,50 @@
+/* BLOCK_TEST(module, md5 of the output), see t/t_block.c */
+BLOCK_TEST(allpass, "78cf7188e8680b2e4ad27648d9dceb2a")
+BLOCK_TEST(atone, "38a4387152648b5f7b40a8f63baeb9f4")
+BLOCK_TEST(autowah, "05c35edaf26b2016f1e408bd6c8585e8")
+BLOCK_TEST(bal, "17dc2fc26c4f859bd219ee9f70c5cc4b")
+BLOCK_TEST(biquad, "4171f36fe52041e1be088fae523d7882")
+BLOCK_TEST(biscale, "2b1f486d20ca91b3c281031d52e9de29")
+BLOCK_TEST(blsaw, "d601f0b86dad3b28442c554c04e1acd3")
+BLOCK_TEST(blsquare, "09c224d901b3537cde4bfe36b5e9bd47")
+BLOCK_TEST(bltriangle, "15efa35ac3ef50f85f2ca0e8696011f9")
+BLOCK_TEST(bqbank, "9dc87278ae3475f6bc6ddfa5f92baa25")
+BLOCK_TEST(butbp, "358bf12ea2a2d330c0c04fdda0e0ae1b")
+BLOCK_TEST(butbr, "3c7d422e20a720ec8f87149d60652be5")
+BLOCK_TEST(buthp, "47a6a5dd6af5a6414deeb0c3728a7d5a")
+BLOCK_TEST(butlp, "03dfb708c6bb5921d8d4b7958888c57b")
+BLOCK_TEST(clip, "55a32fda9db4ea292d6048406b1c4bfe")
+BLOCK_TEST(comb, "2c2b522c47ce34f9ef24870c939eefc3")
+BLOCK_TEST(dcblock, "cf5dfe58fc8a9db4da395e5eb93abff6")
+BLOCK_TEST(delay, "b31406d103c9ef0c782edf7b688fe965")
+BLOCK_TEST(dist, "92ff1eb81c413ff360f624046e28c1f8")
+BLOCK_TEST(eqfil, "180b8eade5f5f7fad61fca8665e15c95")
+BLOCK_TEST(fofilt, "86b351d56865a636a4be1ea750ca8522")
+BLOCK_TEST(fosc, "ca49fbf3a0c81c48582ea4ebd29f59dd")
+BLOCK_TEST(jcrev, "2a9c0b8dae5e76b76f141bc24c0129ee")
+BLOCK_TEST(lpf18, "482a8d241748decd8617a63385015cb4")
+BLOCK_TEST(metro, "5a327e5a422c1baebebb47f15ee56b59")
+BLOCK_TEST(mincer, "2c7e6446de8da8bd9c8204beab97a14b")
+BLOCK_TEST(mincern, "3a1a33d2c6ed357f21a97c89ff040469")
+BLOCK_TEST(mode, "3ba223cc07da5b074f566103fb71a076")
+BLOCK_TEST(moogbank, "4d2b9386aaaede1684e881bdb83ba995")
+BLOCK_TEST(moogladder, "c10c0386b5e1f44a7be141c82170b933")
+BLOCK_TEST(noise, "32fe32177a4205e0cb037f9bd12d56a6")
+BLOCK_TEST(osc, "515b693e4df2d9cb241d882c4d751925")
+BLOCK_TEST(pan2, "fe2e4d5af85bea552d50c0e6d35a0387")
+BLOCK_TEST(panst, "2d6f799cab0bc28665d9da3dddba48a0")
+BLOCK_TEST(pareq, "cff07d3aaea5a6b946f89acb43e163d1")
+BLOCK_TEST(phaser, "ff0f823d0a8801c238334ffc72d2cb54")
+BLOCK_TEST(phasor, "815fdcc3a23db4370b781182f165f471")
+BLOCK_TEST(pinknoise, "da417e270cc82f33d326bf6ed992658b")
+BLOCK_TEST(pitchyin, "a13eb04055825cc6cf2cacbcde354186")
+BLOCK_TEST(port, "01bf351ac11708e18b599a2608c755bc")
+BLOCK_TEST(posc3, "5d7d1888b2bdb418f77d725daa08d99d")
+BLOCK_TEST(revsc, "e678b4dd572dec597591980e6ccbdab9")
+BLOCK_TEST(rms, "54d1de17e0b9fa38ec1d01f47eab7f8a")
+BLOCK_TEST(scale, "cbd75807ca665a4cf1db2abcbb5316a3")
+BLOCK_TEST(streson, "55885e56324eacfdaf9b0c7f48c8e6b6")
+BLOCK_TEST(tbvcf, "ffeb70ff7b99062ed71c255c8daff14e")
+BLOCK_TEST(tone, "3180948ed2c4cac6fb3b2929ca8abbc1")
+BLOCK_TEST(vdelay, "de5b977c40cbdb56bad71c5ddcd28f2f")
+BLOCK_TEST(zitarev, "712a30b64039436beaf22fb931ea7d42")
@@ -0,0 +1,138 @@
+/*
+ * Moog ladder benchmark
+ *
+ * Compares sp_moogladder (one instance per voice) with sp_moogbank in each
+ * tanh mode, and reports how many real-time voices one core can run, along
+ * with the largest deviation from the sp_moogladder output.
+ *
+ * Not part of the library build. From Soundpipe/:
+ *
+ * cc -O3 -DNO_LIBSNDFILE -I. -Ilib/kissfft test/bench_moogladder.c \
+ *     modules/moogladder.c modules/moogbank.c modules/base.c modules/ftbl.c \
+ *     modules/ftcache.c modules/prng.c modules/randmt.c lib/fft/fft.c \
+ *     lib/kissfft/kiss_fft.c lib/kissfft/kiss_fftr.c -lm -lpthread \
+ *     -o bench_moogladder
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "soundpipe.h"
+
+#define VOICES 16
+#define BLKSIZE 64
+#define SECONDS 4
+
+static SPFLOAT inbuf[VOICES][BLKSIZE];
+static SPFLOAT outbuf[VOICES][BLKSIZE];
+static SPFLOAT refbuf[VOICES][BLKSIZE];
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill_input(uint32_t blk)
+{
+    uint32_t v, i;
+    for(v = 0; v < VOICES; v++) {
+        for(i = 0; i < BLKSIZE; i++) {
+            inbuf[v][i] = 0.5 * sin((blk * BLKSIZE + i) * 0.01 * (v + 1));
+        }
+    }
+}
+
+static void report(const char *name, double secs, uint32_t nblocks, double maxerr)
+{
+    double audio = (double)nblocks * BLKSIZE / 44100;
+    printf("%-22s %8.1f voices/core   max error %g\n",
+            name, VOICES * audio / secs, maxerr);
+}
+
+static void bench_moogladder(sp_data *sp, uint32_t nblocks)
+{
+    sp_moogladder *ml[VOICES];
+    uint32_t b, v;
+    double t;
+
+    for(v = 0; v < VOICES; v++) {
+        sp_moogladder_create(&ml[v]);
+        sp_moogladder_init(sp, ml[v]);
+        ml[v]->freq = 1500;
+        ml[v]->res = 0.6;
+    }
+
+    t = now();
+    for(b = 0; b < nblocks; b++) {
+        fill_input(b);
+        for(v = 0; v < VOICES; v++) {
+            sp_moogladder_compute_block(sp, ml[v], inbuf[v], outbuf[v], BLKSIZE);
+        }
+    }
+    report("moogladder", now() - t, nblocks, 0);
+
+    for(v = 0; v < VOICES; v++) sp_moogladder_destroy(&ml[v]);
+}
+
+static void bench_moogbank(sp_data *sp, uint32_t nblocks, int mode, const char *name)
+{
+    sp_moogladder *ml[VOICES];
+    sp_moogbank *mb;
+    const SPFLOAT *in[VOICES];
+    SPFLOAT *out[VOICES];
+    uint32_t b, v, i;
+    double t, secs = 0, err, maxerr = 0;
+
+    sp_moogbank_create(&mb);
+    sp_moogbank_init(sp, mb, VOICES);
+    mb->freq = 1500;
+    mb->res = 0.6;
+    mb->tanh_mode = mode;
+
+    for(v = 0; v < VOICES; v++) {
+        sp_moogladder_create(&ml[v]);
+        sp_moogladder_init(sp, ml[v]);
+        ml[v]->freq = 1500;
+        ml[v]->res = 0.6;
+        in[v] = inbuf[v];
+        out[v] = outbuf[v];
+    }
+
+    for(b = 0; b < nblocks; b++) {
+        fill_input(b);
+        t = now();
+        sp_moogbank_compute_block(sp, mb, in, out, BLKSIZE);
+        secs += now() - t;
+        /* compare with one sp_moogladder per voice */
+        for(v = 0; v < VOICES; v++) {
+            sp_moogladder_compute_block(sp, ml[v], inbuf[v], refbuf[v], BLKSIZE);
+            for(i = 0; i < BLKSIZE; i++) {
+                err = fabs(outbuf[v][i] - refbuf[v][i]);
+                if(err > maxerr) maxerr = err;
+            }
+        }
+    }
+    report(name, secs, nblocks, maxerr);
+
+    for(v = 0; v < VOICES; v++) sp_moogladder_destroy(&ml[v]);
+    sp_moogbank_destroy(&mb);
+}
+
+int main()
+{
+    sp_data *sp;
+    uint32_t nblocks = SECONDS * 44100 / BLKSIZE;
+
+    sp_create(&sp);
+    printf("%d voices, %d sample blocks\n", VOICES, BLKSIZE);
+    bench_moogladder(sp, nblocks);
+    bench_moogbank(sp, nblocks, SP_MOOGBANK_TANH_LIBM, "moogbank (libm)");
+    bench_moogbank(sp, nblocks, SP_MOOGBANK_TANH_LAMBERT, "moogbank (lambert)");
+    bench_moogbank(sp, nblocks, SP_MOOGBANK_TANH_PADE, "moogbank (pade)");
+    sp_destroy(&sp);
+    return 0;
+}
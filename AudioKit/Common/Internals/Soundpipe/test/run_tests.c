@@ -0,0 +1,47 @@
+/*
+ * Test runner
+ *
+ * Runs every entry in all_tests.h and compares its output with the md5
+ * hash listed there. The block tests in t/t_block.c render each module one
+ * sample at a time and through sp_*_compute_block, and both must match the
+ * same hash. Prints TAP and returns nonzero if anything failed.
+ *
+ * Not part of the library build; test/run_tests.sh builds and runs it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "test.h"
+
+#define BLOCK_TEST(name, hash) int t_##name(sp_test *tst, sp_data *sp, const char *h);
+#include "all_tests.h"
+#undef BLOCK_TEST
+
+static sp_test_entry tests[] = {
+#define BLOCK_TEST(name, hash) {t_##name, #name, hash},
+#include "all_tests.h"
+#undef BLOCK_TEST
+};
+
+int main(void)
+{
+    uint32_t ntests = sizeof(tests) / sizeof(*tests), n;
+    int fail = 0, err;
+    sp_data *sp;
+    sp_test *tst;
+
+    printf("1..%d\n", ntests);
+    for(n = 0; n < ntests; n++) {
+        sp_create(&sp);
+        sp_srand(sp, 123456);
+        sp_test_create(&tst, sp->sr * 5);
+        err = tests[n].func(tst, sp, tests[n].hash);
+        printf("%s %d - %s\n", err ? "not ok" : "ok", n + 1, tests[n].desc);
+        fail |= err;
+        sp_test_destroy(&tst);
+        sp_destroy(&sp);
+    }
+    return fail;
+}
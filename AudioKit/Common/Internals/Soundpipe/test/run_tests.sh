@@ -0,0 +1,22 @@
+#!/bin/sh
+#
+# Soundpipe tests
+#
+# Builds run_tests against the Soundpipe sources and runs it. See
+# run_tests.c and t/t_block.c.
+#
+# usage: sh Soundpipe/test/run_tests.sh    (from Internals/, or anywhere)
+#
+
+D=$(cd "$(dirname "$0")" && pwd)
+S=$(cd "$D/.." && pwd)
+T=$(mktemp -d)
+trap 'rm -rf "$T"' EXIT
+
+CC=${CC:-cc}
+CFLAGS="-O2 -DNO_LIBSNDFILE -I$S -I$S/lib/kissfft -I$S/lib/inih \
+-I$S/lib/faust -I$D"
+
+$CC $CFLAGS -w "$D/run_tests.c" "$D/test.c" "$D/md5.c" "$D/t/t_block.c" \
+    "$S"/modules/*.c "$S"/lib/*/*.c -lm -lpthread -o "$T/run_tests" || exit 1
+"$T/run_tests"
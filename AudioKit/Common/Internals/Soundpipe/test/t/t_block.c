@@ -0,0 +1,650 @@
+/*
+ * Block tests
+ *
+ * Every module with its own sp_*_compute_block loop has a render function
+ * here. It creates and inits the module, then renders the test signal in
+ * irregular blocks, changing parameters at each block edge, either one
+ * sample at a time through sp_*_compute or a block at a time. Both must
+ * give the hash listed for the module in all_tests.h.
+ *
+ * Most modules fit MONO (one input, one output) or STEREO (two of each),
+ * which only need the module's init and sweep functions below. The rest
+ * are written out.
+ */
+
+#include <math.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "test.h"
+
+typedef void (*block_render)(sp_test *tst, sp_data *sp, int block);
+
+/* table shared by the modules that read one, freed after each render */
+static sp_ftbl *ft = NULL;
+
+static void ft_sine(sp_data *sp)
+{
+    sp_ftbl_create(sp, &ft, 2048);
+    sp_gen_sine(sp, ft);
+}
+
+static void ft_free(void)
+{
+    if(ft != NULL) sp_ftbl_destroy(&ft);
+    ft = NULL;
+}
+
+/* the second input of two input modules */
+static SPFLOAT input2(uint32_t pos)
+{
+    return 0.5 * sp_test_input(pos + 12345);
+}
+
+#define MONO(name) \
+static void r_##name(sp_test *tst, sp_data *sp, int block) \
+{ \
+    sp_##name *p; \
+    SPFLOAT in[SP_TEST_BLOCK], out[SP_TEST_BLOCK]; \
+    uint32_t pos, len, i; \
+    sp_##name##_create(&p); \
+    name##_init(sp, p); \
+    for(pos = 0; pos < tst->size; pos += len) { \
+        len = sp_test_block_len(pos, tst->size); \
+        name##_sweep(p, pos); \
+        for(i = 0; i < len; i++) in[i] = sp_test_input(pos + i); \
+        if(block) { \
+            sp_##name##_compute_block(sp, p, in, out, len); \
+        } else { \
+            for(i = 0; i < len; i++) sp_##name##_compute(sp, p, &in[i], &out[i]); \
+        } \
+        for(i = 0; i < len; i++) sp_test_add_sample(tst, out[i]); \
+    } \
+    sp_##name##_destroy(&p); \
+    ft_free(); \
+}
+
+/* two samples per frame */
+#define STEREO(name) \
+static void r_##name(sp_test *tst, sp_data *sp, int block) \
+{ \
+    sp_##name *p; \
+    SPFLOAT in1[SP_TEST_BLOCK], in2[SP_TEST_BLOCK]; \
+    SPFLOAT out1[SP_TEST_BLOCK], out2[SP_TEST_BLOCK]; \
+    uint32_t pos, len, i; \
+    sp_##name##_create(&p); \
+    name##_init(sp, p); \
+    for(pos = 0; pos < tst->size / 2; pos += len) { \
+        len = sp_test_block_len(pos, tst->size / 2); \
+        name##_sweep(p, pos); \
+        for(i = 0; i < len; i++) { \
+            in1[i] = sp_test_input(pos + i); \
+            in2[i] = input2(pos + i); \
+        } \
+        if(block) { \
+            sp_##name##_compute_block(sp, p, in1, in2, out1, out2, len); \
+        } else { \
+            for(i = 0; i < len; i++) { \
+                sp_##name##_compute(sp, p, &in1[i], &in2[i], &out1[i], &out2[i]); \
+            } \
+        } \
+        for(i = 0; i < len; i++) { \
+            sp_test_add_sample(tst, out1[i]); \
+            sp_test_add_sample(tst, out2[i]); \
+        } \
+    } \
+    sp_##name##_destroy(&p); \
+}
+
+static void allpass_init(sp_data *sp, sp_allpass *p) { sp_allpass_init(sp, p, 0.05); }
+static void allpass_sweep(sp_allpass *p, uint32_t pos)
+{
+    p->revtime = 0.1 + 0.00002 * (pos % 40000);
+}
+MONO(allpass)
+
+static void atone_init(sp_data *sp, sp_atone *p) { sp_atone_init(sp, p); }
+static void atone_sweep(sp_atone *p, uint32_t pos) { p->hp = 100 + (pos % 3000); }
+MONO(atone)
+
+static void autowah_init(sp_data *sp, sp_autowah *p) { sp_autowah_init(sp, p); }
+static void autowah_sweep(sp_autowah *p, uint32_t pos)
+{
+    *p->wah = 0.0001 * (pos % 10000);
+    *p->mix = 50 + 0.0005 * (pos % 100000);
+}
+MONO(autowah)
+
+static void biquad_init(sp_data *sp, sp_biquad *p) { sp_biquad_init(sp, p); }
+static void biquad_sweep(sp_biquad *p, uint32_t pos)
+{
+    p->cutoff = 300 + (pos % 4000);
+    p->res = 0.1 + 0.00005 * (pos % 15000);
+}
+MONO(biquad)
+
+static void biscale_init(sp_data *sp, sp_biscale *p) { sp_biscale_init(sp, p); }
+static void biscale_sweep(sp_biscale *p, uint32_t pos)
+{
+    p->min = -0.00001 * (pos % 50000);
+    p->max = 1 + 0.00001 * (pos % 70000);
+}
+MONO(biscale)
+
+static void blsaw_init(sp_data *sp, sp_blsaw *p) { sp_blsaw_init(sp, p); }
+static void blsaw_sweep(sp_blsaw *p, uint32_t pos)
+{
+    *p->freq = 110 + (pos % 880);
+    *p->amp = 0.5;
+}
+MONO(blsaw)
+
+static void blsquare_init(sp_data *sp, sp_blsquare *p) { sp_blsquare_init(sp, p); }
+static void blsquare_sweep(sp_blsquare *p, uint32_t pos)
+{
+    *p->freq = 110 + (pos % 880);
+    *p->amp = 0.5;
+    *p->width = 0.1 + 0.00001 * (pos % 80000);
+}
+MONO(blsquare)
+
+static void bltriangle_init(sp_data *sp, sp_bltriangle *p) { sp_bltriangle_init(sp, p); }
+static void bltriangle_sweep(sp_bltriangle *p, uint32_t pos)
+{
+    *p->freq = 110 + (pos % 880);
+    *p->amp = 0.5;
+}
+MONO(bltriangle)
+
+static void butlp_init(sp_data *sp, sp_butlp *p) { sp_butlp_init(sp, p); }
+static void butlp_sweep(sp_butlp *p, uint32_t pos) { p->freq = 200 + (pos % 5000); }
+MONO(butlp)
+
+static void buthp_init(sp_data *sp, sp_buthp *p) { sp_buthp_init(sp, p); }
+static void buthp_sweep(sp_buthp *p, uint32_t pos) { p->freq = 100 + (pos % 3000); }
+MONO(buthp)
+
+static void butbp_init(sp_data *sp, sp_butbp *p) { sp_butbp_init(sp, p); }
+static void butbp_sweep(sp_butbp *p, uint32_t pos)
+{
+    p->freq = 300 + (pos % 4000);
+    p->bw = 50 + (pos % 700);
+}
+MONO(butbp)
+
+static void butbr_init(sp_data *sp, sp_butbr *p) { sp_butbr_init(sp, p); }
+static void butbr_sweep(sp_butbr *p, uint32_t pos)
+{
+    p->freq = 300 + (pos % 4000);
+    p->bw = 50 + (pos % 700);
+}
+MONO(butbr)
+
+static void clip_init(sp_data *sp, sp_clip *p) { sp_clip_init(sp, p); }
+static void clip_sweep(sp_clip *p, uint32_t pos)
+{
+    p->lim = 0.2 + 0.00001 * (pos % 80000);
+    p->meth = (pos / 40000) % 3;
+}
+MONO(clip)
+
+static void comb_init(sp_data *sp, sp_comb *p) { sp_comb_init(sp, p, 0.05); }
+static void comb_sweep(sp_comb *p, uint32_t pos)
+{
+    p->revtime = 0.5 + 0.00005 * (pos % 20000);
+}
+MONO(comb)
+
+static void dcblock_init(sp_data *sp, sp_dcblock *p) { sp_dcblock_init(sp, p); }
+static void dcblock_sweep(sp_dcblock *p, uint32_t pos) { }
+MONO(dcblock)
+
+static void delay_init(sp_data *sp, sp_delay *p) { sp_delay_init(sp, p, 0.1); }
+static void delay_sweep(sp_delay *p, uint32_t pos)
+{
+    p->feedback = 0.0001 * (pos % 9000);
+}
+MONO(delay)
+
+static void dist_init(sp_data *sp, sp_dist *p) { sp_dist_init(sp, p); }
+static void dist_sweep(sp_dist *p, uint32_t pos)
+{
+    p->pregain = 1 + 0.0001 * (pos % 20000);
+    p->shape1 = 0.00001 * (pos % 50000);
+}
+MONO(dist)
+
+static void eqfil_init(sp_data *sp, sp_eqfil *p) { sp_eqfil_init(sp, p); }
+static void eqfil_sweep(sp_eqfil *p, uint32_t pos)
+{
+    p->freq = 300 + (pos % 3000);
+    p->bw = 50 + (pos % 500);
+    p->gain = 0.5 + 0.0001 * (pos % 20000);
+}
+MONO(eqfil)
+
+static void fofilt_init(sp_data *sp, sp_fofilt *p) { sp_fofilt_init(sp, p); }
+static void fofilt_sweep(sp_fofilt *p, uint32_t pos) { p->freq = 300 + (pos % 2000); }
+MONO(fofilt)
+
+static void fosc_init(sp_data *sp, sp_fosc *p)
+{
+    ft_sine(sp);
+    sp_fosc_init(sp, p, ft);
+}
+static void fosc_sweep(sp_fosc *p, uint32_t pos)
+{
+    p->freq = 110 + (pos % 440);
+    p->indx = 0.0001 * (pos % 30000);
+}
+MONO(fosc)
+
+static void jcrev_init(sp_data *sp, sp_jcrev *p) { sp_jcrev_init(sp, p); }
+static void jcrev_sweep(sp_jcrev *p, uint32_t pos) { }
+MONO(jcrev)
+
+static void lpf18_init(sp_data *sp, sp_lpf18 *p) { sp_lpf18_init(sp, p); }
+static void lpf18_sweep(sp_lpf18 *p, uint32_t pos)
+{
+    p->cutoff = 500 + (pos % 5000);
+    p->res = 0.0001 * (pos % 8000);
+}
+MONO(lpf18)
+
+/* reads the test signal from a table */
+static void mincer_init(sp_data *sp, sp_mincer *p)
+{
+    uint32_t i;
+    sp_ftbl_create(sp, &ft, 44100);
+    for(i = 0; i < ft->size; i++) ft->tbl[i] = sp_test_input(i);
+    sp_mincer_init(sp, p, ft, 2048, 4);
+}
+static void mincer_sweep(sp_mincer *p, uint32_t pos)
+{
+    p->time = 0.00001 * (pos % 80000);
+    p->pitch = 0.5 + 0.00001 * (pos % 100000);
+}
+MONO(mincer)
+
+static void mode_init(sp_data *sp, sp_mode *p) { sp_mode_init(sp, p); }
+static void mode_sweep(sp_mode *p, uint32_t pos)
+{
+    p->freq = 300 + (pos % 2000);
+    p->q = 10 + (pos % 90);
+}
+MONO(mode)
+
+static void moogladder_init(sp_data *sp, sp_moogladder *p) { sp_moogladder_init(sp, p); }
+static void moogladder_sweep(sp_moogladder *p, uint32_t pos)
+{
+    p->freq = 400 + (pos % 6000);
+    p->res = 0.1 + 0.0001 * (pos % 8000);
+}
+MONO(moogladder)
+
+static void metro_init(sp_data *sp, sp_metro *p) { sp_metro_init(sp, p); }
+static void metro_sweep(sp_metro *p, uint32_t pos) { p->freq = 2 + (pos % 40); }
+MONO(metro)
+
+static void noise_init(sp_data *sp, sp_noise *p) { sp_noise_init(sp, p); }
+static void noise_sweep(sp_noise *p, uint32_t pos) { p->amp = 0.00001 * (pos % 100000); }
+MONO(noise)
+
+static void osc_init(sp_data *sp, sp_osc *p)
+{
+    ft_sine(sp);
+    sp_osc_init(sp, p, ft, 0);
+}
+static void osc_sweep(sp_osc *p, uint32_t pos)
+{
+    p->freq = 110 + (pos % 880);
+    p->amp = 0.5;
+}
+MONO(osc)
+
+static void pareq_init(sp_data *sp, sp_pareq *p) { sp_pareq_init(sp, p); }
+static void pareq_sweep(sp_pareq *p, uint32_t pos)
+{
+    p->fc = 500 + (pos % 2500);
+    p->v = 0.5 + 0.0002 * (pos % 10000);
+    p->mode = (pos / 20000) % 3;
+}
+MONO(pareq)
+
+static void phasor_init(sp_data *sp, sp_phasor *p) { sp_phasor_init(sp, p, 0); }
+static void phasor_sweep(sp_phasor *p, uint32_t pos) { p->freq = 50 + (pos % 400); }
+MONO(phasor)
+
+static void pinknoise_init(sp_data *sp, sp_pinknoise *p) { sp_pinknoise_init(sp, p); }
+static void pinknoise_sweep(sp_pinknoise *p, uint32_t pos)
+{
+    *p->amp = 0.00001 * (pos % 100000);
+}
+MONO(pinknoise)
+
+static void port_init(sp_data *sp, sp_port *p) { sp_port_init(sp, p, 0.02); }
+static void port_sweep(sp_port *p, uint32_t pos)
+{
+    p->htime = 0.001 + 0.000001 * (pos % 30000);
+}
+MONO(port)
+
+static void posc3_init(sp_data *sp, sp_posc3 *p)
+{
+    ft_sine(sp);
+    sp_posc3_init(sp, p, ft);
+}
+static void posc3_sweep(sp_posc3 *p, uint32_t pos)
+{
+    p->freq = 110 + (pos % 880);
+    p->amp = 0.5;
+}
+MONO(posc3)
+
+static void rms_init(sp_data *sp, sp_rms *p) { sp_rms_init(sp, p); }
+static void rms_sweep(sp_rms *p, uint32_t pos) { }
+MONO(rms)
+
+static void scale_init(sp_data *sp, sp_scale *p) { sp_scale_init(sp, p); }
+static void scale_sweep(sp_scale *p, uint32_t pos)
+{
+    p->min = -0.00001 * (pos % 50000);
+    p->max = 1 + 0.00001 * (pos % 70000);
+}
+MONO(scale)
+
+static void streson_init(sp_data *sp, sp_streson *p) { sp_streson_init(sp, p); }
+static void streson_sweep(sp_streson *p, uint32_t pos)
+{
+    p->freq = 100 + (pos % 1000);
+    p->fdbgain = 0.8 + 0.000001 * (pos % 100000);
+}
+MONO(streson)
+
+static void tbvcf_init(sp_data *sp, sp_tbvcf *p) { sp_tbvcf_init(sp, p); }
+static void tbvcf_sweep(sp_tbvcf *p, uint32_t pos)
+{
+    p->fco = 500 + (pos % 4000);
+    p->res = 0.1 + 0.00001 * (pos % 60000);
+}
+MONO(tbvcf)
+
+static void tone_init(sp_data *sp, sp_tone *p) { sp_tone_init(sp, p); }
+static void tone_sweep(sp_tone *p, uint32_t pos) { p->hp = 100 + (pos % 3000); }
+MONO(tone)
+
+static void vdelay_init(sp_data *sp, sp_vdelay *p) { sp_vdelay_init(sp, p, 1.0); }
+static void vdelay_sweep(sp_vdelay *p, uint32_t pos)
+{
+    /* alternate between a few samples, down to none, and up to half a second */
+    if((pos / 25000) % 2) {
+        p->del = 0.00001 * (pos % 50000);
+    } else {
+        p->del = 0.000000003 * (pos % 25000);
+    }
+}
+MONO(vdelay)
+
+static void panst_init(sp_data *sp, sp_panst *p) { sp_panst_init(sp, p); }
+static void panst_sweep(sp_panst *p, uint32_t pos)
+{
+    p->pan = -1 + 0.0001 * (pos % 20000);
+    p->type = (pos / 30000) % 2;
+}
+STEREO(panst)
+
+static void phaser_init(sp_data *sp, sp_phaser *p) { sp_phaser_init(sp, p); }
+static void phaser_sweep(sp_phaser *p, uint32_t pos)
+{
+    *p->depth = 0.00001 * (pos % 100000);
+    *p->lfobpm = 30 + 0.001 * (pos % 60000);
+}
+STEREO(phaser)
+
+static void revsc_init(sp_data *sp, sp_revsc *p) { sp_revsc_init(sp, p); }
+static void revsc_sweep(sp_revsc *p, uint32_t pos)
+{
+    p->feedback = 0.6 + 0.000003 * (pos % 100000);
+    p->lpfreq = 2000 + (pos % 8000);
+}
+STEREO(revsc)
+
+static void zitarev_init(sp_data *sp, sp_zitarev *p) { sp_zitarev_init(sp, p); }
+static void zitarev_sweep(sp_zitarev *p, uint32_t pos)
+{
+    *p->rt60_mid = 1 + 0.00002 * (pos % 100000);
+}
+STEREO(zitarev)
+
+static void r_pan2(sp_test *tst, sp_data *sp, int block)
+{
+    sp_pan2 *p;
+    SPFLOAT in[SP_TEST_BLOCK], out1[SP_TEST_BLOCK], out2[SP_TEST_BLOCK];
+    uint32_t pos, len, i;
+
+    sp_pan2_create(&p);
+    sp_pan2_init(sp, p);
+    for(pos = 0; pos < tst->size / 2; pos += len) {
+        len = sp_test_block_len(pos, tst->size / 2);
+        p->pan = -1 + 0.0001 * (pos % 20000);
+        p->type = (pos / 30000) % 4;
+        for(i = 0; i < len; i++) in[i] = sp_test_input(pos + i);
+        if(block) {
+            sp_pan2_compute_block(sp, p, in, out1, out2, len);
+        } else {
+            for(i = 0; i < len; i++) {
+                sp_pan2_compute(sp, p, &in[i], &out1[i], &out2[i]);
+            }
+        }
+        for(i = 0; i < len; i++) {
+            sp_test_add_sample(tst, out1[i]);
+            sp_test_add_sample(tst, out2[i]);
+        }
+    }
+    sp_pan2_destroy(&p);
+}
+
+static void r_bal(sp_test *tst, sp_data *sp, int block)
+{
+    sp_bal *p;
+    SPFLOAT sig[SP_TEST_BLOCK], comp[SP_TEST_BLOCK], out[SP_TEST_BLOCK];
+    uint32_t pos, len, i;
+
+    sp_bal_create(&p);
+    sp_bal_init(sp, p);
+    for(pos = 0; pos < tst->size; pos += len) {
+        len = sp_test_block_len(pos, tst->size);
+        for(i = 0; i < len; i++) {
+            sig[i] = sp_test_input(pos + i);
+            comp[i] = input2(pos + i) * (pos % 3000) / 3000;
+        }
+        if(block) {
+            sp_bal_compute_block(sp, p, sig, comp, out, len);
+        } else {
+            for(i = 0; i < len; i++) sp_bal_compute(sp, p, &sig[i], &comp[i], &out[i]);
+        }
+        for(i = 0; i < len; i++) sp_test_add_sample(tst, out[i]);
+    }
+    sp_bal_destroy(&p);
+}
+
+/* three samples per frame: frequency, amplitude and confidence */
+static void r_pitchyin(sp_test *tst, sp_data *sp, int block)
+{
+    sp_pitchyin *p;
+    SPFLOAT in[SP_TEST_BLOCK];
+    SPFLOAT freq[SP_TEST_BLOCK], amp[SP_TEST_BLOCK], conf[SP_TEST_BLOCK];
+    uint32_t pos, len, i;
+
+    sp_pitchyin_create(&p);
+    sp_pitchyin_init(sp, p, 100, 1000);
+    for(pos = 0; pos < tst->size / 3; pos += len) {
+        len = sp_test_block_len(pos, tst->size / 3);
+        p->thresh = 0.1 + 0.000001 * (pos % 100000);
+        for(i = 0; i < len; i++) {
+            in[i] = 0.5 * sin(2 * M_PI * (200 + (pos % 600)) * (pos + i) / sp->sr) +
+                0.1 * sp_test_input(pos + i);
+        }
+        if(block) {
+            sp_pitchyin_compute_block(sp, p, in, freq, amp, conf, len);
+        } else {
+            for(i = 0; i < len; i++) {
+                sp_pitchyin_compute(sp, p, &in[i], &freq[i], &amp[i], &conf[i]);
+            }
+        }
+        for(i = 0; i < len; i++) {
+            sp_test_add_sample(tst, freq[i]);
+            sp_test_add_sample(tst, amp[i]);
+            sp_test_add_sample(tst, conf[i]);
+        }
+    }
+    sp_pitchyin_destroy(&p);
+}
+
+#define NCHAN 3
+
+/* NCHAN channels, each with its own design, interleaved */
+static void r_bqbank(sp_test *tst, sp_data *sp, int block)
+{
+    sp_bqbank *p;
+    SPFLOAT in[NCHAN][SP_TEST_BLOCK], out[NCHAN][SP_TEST_BLOCK];
+    const SPFLOAT *inp[NCHAN];
+    SPFLOAT *outp[NCHAN];
+    SPFLOAT c[5], fin[NCHAN], fout[NCHAN];
+    uint32_t pos, len, i, k;
+
+    for(k = 0; k < NCHAN; k++) {
+        inp[k] = in[k];
+        outp[k] = out[k];
+    }
+    sp_bqbank_create(&p);
+    sp_bqbank_init(sp, p, NCHAN);
+    for(pos = 0; pos < tst->size / NCHAN; pos += len) {
+        len = sp_test_block_len(pos, tst->size / NCHAN);
+        sp_bqbank_butlp(sp, 200 + (pos % 5000), c);
+        sp_bqbank_set(p, 0, c);
+        sp_bqbank_butbp(sp, 300 + (pos % 4000), 50 + (pos % 700), c);
+        sp_bqbank_set(p, 1, c);
+        sp_bqbank_pareq(sp, (pos / 20000) % 3, 500 + (pos % 2500),
+                0.5 + 0.0002 * (pos % 10000), 0.707, c);
+        sp_bqbank_set(p, 2, c);
+        for(i = 0; i < len; i++) {
+            for(k = 0; k < NCHAN; k++) in[k][i] = sp_test_input(pos + i + 1000 * k);
+        }
+        if(block) {
+            sp_bqbank_compute_block(sp, p, inp, outp, len);
+        } else {
+            for(i = 0; i < len; i++) {
+                for(k = 0; k < NCHAN; k++) fin[k] = in[k][i];
+                sp_bqbank_compute(sp, p, fin, fout);
+                for(k = 0; k < NCHAN; k++) out[k][i] = fout[k];
+            }
+        }
+        for(i = 0; i < len; i++) {
+            for(k = 0; k < NCHAN; k++) sp_test_add_sample(tst, out[k][i]);
+        }
+    }
+    sp_bqbank_destroy(&p);
+}
+
+static void r_moogbank(sp_test *tst, sp_data *sp, int block)
+{
+    sp_moogbank *p;
+    SPFLOAT in[NCHAN][SP_TEST_BLOCK], out[NCHAN][SP_TEST_BLOCK];
+    const SPFLOAT *inp[NCHAN];
+    SPFLOAT *outp[NCHAN];
+    SPFLOAT fin[NCHAN], fout[NCHAN];
+    uint32_t pos, len, i, k;
+
+    for(k = 0; k < NCHAN; k++) {
+        inp[k] = in[k];
+        outp[k] = out[k];
+    }
+    sp_moogbank_create(&p);
+    sp_moogbank_init(sp, p, NCHAN);
+    for(pos = 0; pos < tst->size / NCHAN; pos += len) {
+        len = sp_test_block_len(pos, tst->size / NCHAN);
+        p->freq = 400 + (pos % 6000);
+        p->res = 0.1 + 0.0001 * (pos % 8000);
+        p->tanh_mode = (pos / 25000) % 3;
+        for(i = 0; i < len; i++) {
+            for(k = 0; k < NCHAN; k++) in[k][i] = sp_test_input(pos + i + 1000 * k);
+        }
+        if(block) {
+            sp_moogbank_compute_block(sp, p, inp, outp, len);
+        } else {
+            for(i = 0; i < len; i++) {
+                for(k = 0; k < NCHAN; k++) fin[k] = in[k][i];
+                sp_moogbank_compute(sp, p, fin, fout);
+                for(k = 0; k < NCHAN; k++) out[k][i] = fout[k];
+            }
+        }
+        for(i = 0; i < len; i++) {
+            for(k = 0; k < NCHAN; k++) sp_test_add_sample(tst, out[k][i]);
+        }
+    }
+    sp_moogbank_destroy(&p);
+}
+
+/* two channel table, interleaved */
+static void r_mincern(sp_test *tst, sp_data *sp, int block)
+{
+    sp_mincer *p;
+    SPFLOAT in[SP_TEST_BLOCK], out[2][SP_TEST_BLOCK], fout[2];
+    SPFLOAT *outp[2];
+    uint32_t pos, len, i;
+
+    outp[0] = out[0];
+    outp[1] = out[1];
+    sp_ftbl_create(sp, &ft, 2 * 44100);
+    for(i = 0; i < ft->size; i++) ft->tbl[i] = sp_test_input(i);
+    sp_mincer_create(&p);
+    sp_mincer_initn(sp, p, ft, 2, 0, 1024, 4);
+    for(pos = 0; pos < tst->size / 2; pos += len) {
+        len = sp_test_block_len(pos, tst->size / 2);
+        p->time = 0.00001 * (pos % 80000);
+        p->pitch = 0.5 + 0.00001 * (pos % 100000);
+        for(i = 0; i < len; i++) in[i] = 0;
+        if(block) {
+            sp_mincer_compute_blockn(sp, p, in, outp, len);
+        } else {
+            for(i = 0; i < len; i++) {
+                sp_mincer_compute(sp, p, &in[i], fout);
+                out[0][i] = fout[0];
+                out[1][i] = fout[1];
+            }
+        }
+        for(i = 0; i < len; i++) {
+            sp_test_add_sample(tst, out[0][i]);
+            sp_test_add_sample(tst, out[1][i]);
+        }
+    }
+    sp_mincer_destroy(&p);
+    ft_free();
+}
+
+/* renders one sample at a time, then a block at a time, from the same
+ * random seed, and checks both against the hash */
+static int block_test(sp_test *tst, sp_data *sp, const char *hash,
+        block_render render)
+{
+    sp_test *blk;
+    int fail;
+
+    sp_srand(sp, 123456);
+    render(tst, sp, 0);
+    fail = sp_test_verify(tst, hash);
+    sp_test_create(&blk, tst->size);
+    sp_srand(sp, 123456);
+    render(blk, sp, 1);
+    fail |= sp_test_verify(blk, hash);
+    sp_test_destroy(&blk);
+    return fail;
+}
+
+#define BLOCK_TEST(name, hash) \
+int t_##name(sp_test *tst, sp_data *sp, const char *h) \
+{ \
+    return block_test(tst, sp, h, r_##name); \
+}
+#include "all_tests.h"
+#undef BLOCK_TEST
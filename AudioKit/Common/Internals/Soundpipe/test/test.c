@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 #include "soundpipe.h"
 #include "md5.h"
 #include "test.h"
@@ -86,3 +87,17 @@ int sp_test_verify(sp_test *t, const char *refhash)
     }
     return fail;
 }
+
+uint32_t sp_test_block_len(uint32_t pos, uint32_t size)
+{
+    uint32_t len = 1 + (pos * 7919 + 13) % SP_TEST_BLOCK;
+    if(len > size - pos) len = size - pos;
+    return len;
+}
+
+SPFLOAT sp_test_input(uint32_t pos)
+{
+    /* two detuned sines and a little deterministic hash noise */
+    SPFLOAT n = (SPFLOAT)((pos * 1103515245u + 12345u) >> 16 & 0x7fff) / 32767.0;
+    return 0.4 * sin(pos * 0.0314) + 0.4 * sin(pos * 0.00517) + 0.2 * (2 * n - 1);
+}
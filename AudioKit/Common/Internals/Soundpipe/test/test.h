@@ -22,3 +22,11 @@ int sp_test_compare(sp_test *t, const char *md5hash);
 /* verify wraps compare and error message up together */
 int sp_test_verify(sp_test *t, const char *refhash);
 int sp_test_write_raw(sp_test *t, uint32_t index);
+
+/* block tests render in blocks of 1 to SP_TEST_BLOCK samples */
+#define SP_TEST_BLOCK 512
+/* length of the block starting at pos, irregular so block edges land
+ * everywhere */
+uint32_t sp_test_block_len(uint32_t pos, uint32_t size);
+/* a deterministic test signal in [-1, 1] */
+SPFLOAT sp_test_input(uint32_t pos);
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "plumber.h"
+
+/*
+ * Block mode
+ *
+ * plumber_compute_block runs a compiled patch PLUMBER_BLOCK samples at a
+ * time instead of walking the code once per sample. Each stack slot becomes
+ * a plumber_vec: literals fill one with a constant, ugens listed in
+ * ublocks.h process the whole block, and every other ugen is run once per
+ * sample over its own slots. Slot depths are worked out when the patch is
+ * compiled, from how many floats each ugen took and left at create time.
+ * Patches that cannot be run this way fall back to one sample at a time,
+ * which is what the hosts did before.
+ */
+
+#define SPORTH_BLOCK(ugen, func) \
+    int ugen(sporth_stack *stack, void *ud); \
+    int func(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n);
+#define SPORTH_SAMPLE(ugen) int ugen(sporth_stack *stack, void *ud);
+#include "ublocks.h"
+#undef SPORTH_BLOCK
+#undef SPORTH_SAMPLE
+
+typedef struct {
+    int (*ugen)(sporth_stack *, void *);
+    plumber_blockfun func;
+} plumber_block_entry;
+
+static const plumber_block_entry block_list[] = {
+#define SPORTH_BLOCK(ugen, func) {ugen, func},
+#define SPORTH_SAMPLE(ugen) {ugen, NULL},
+#include "ublocks.h"
+#undef SPORTH_BLOCK
+#undef SPORTH_SAMPLE
+    {NULL, NULL}
+};
+
+static const plumber_block_entry *block_find(int (*ugen)(sporth_stack *, void *))
+{
+    const plumber_block_entry *e;
+    for(e = block_list; e->ugen != NULL; e++) {
+        if(e->ugen == ugen) return e;
+    }
+    return NULL;
+}
+
+static int block_bind(plumber_instr *ip)
+{
+    const plumber_block_entry *e;
+    if(ip->op != PLUMBER_OP_UGEN) return PLUMBER_OK;
+    if(ip->nin < 0) return PLUMBER_NOTOK;
+    e = block_find(ip->fun);
+    if(e != NULL && e->func == NULL) return PLUMBER_NOTOK;
+    ip->bfun = e != NULL ? e->func : NULL;
+    return PLUMBER_OK;
+}
+
+int plumbing_compile_block(plumber_data *plumb, plumbing *pipes)
+{
+    plumber_instr *ip;
+    plumber_ctrl *c;
+    int depth = 0, max = 0, n;
+
+    plumbing_destroy_block(pipes);
+    for(ip = pipes->code; ip->op != PLUMBER_OP_END; ip++) {
+        if(block_bind(ip) != PLUMBER_OK) return PLUMBER_NOTOK;
+        /* hoisted code is run in place when it reads per sample p values */
+        if(ip->op == PLUMBER_OP_CTRL) {
+            c = ip->ud;
+            for(n = 0; c->code[n].op != PLUMBER_OP_END; n++) {
+                if(block_bind(&c->code[n]) != PLUMBER_OK) return PLUMBER_NOTOK;
+            }
+            if(depth + c->depth > max) max = depth + c->depth;
+        }
+        depth -= ip->nin;
+        /* reaches into what the create and init passes left behind */
+        if(depth < 0) return PLUMBER_NOTOK;
+        depth += ip->nout;
+        if(depth > max) max = depth;
+    }
+
+    pipes->vec = sp_malloc(sizeof(plumber_vec) * (max + 1));
+    pipes->vbuf = sp_malloc(sizeof(SPFLOAT) * PLUMBER_BLOCK * (max + 1));
+    if(pipes->vec == NULL || pipes->vbuf == NULL) {
+        plumbing_destroy_block(pipes);
+        return PLUMBER_NOTOK;
+    }
+    for(n = 0; n <= max; n++) {
+        pipes->vec[n].buf = pipes->vbuf + n * PLUMBER_BLOCK;
+        pipes->vec[n].cnst = 0;
+    }
+    pipes->nres = depth;
+    pipes->block = 1;
+    return PLUMBER_OK;
+}
+
+int plumbing_destroy_block(plumbing *pipes)
+{
+    sp_free(pipes->vec);
+    sp_free(pipes->vbuf);
+    pipes->vec = NULL;
+    pipes->vbuf = NULL;
+    pipes->block = 0;
+    pipes->nres = 0;
+    return PLUMBER_OK;
+}
+
+void plumber_vec_fill(plumber_vec *v, uint32_t n)
+{
+    uint32_t i;
+    if(!v->cnst) return;
+    for(i = 1; i < n; i++) v->buf[i] = v->buf[0];
+    v->cnst = 0;
+}
+
+/* runs a ugen the usual way, once per sample, on the stack above whatever
+ * the patch has left there */
+static void block_samples(plumber_data *plumb, plumber_instr *ip,
+        plumber_vec *v, uint32_t n)
+{
+    sporth_stack *stack = &plumb->sporth.stack;
+    int base = stack->pos;
+    int k, c;
+    uint32_t i;
+
+    /* outputs go over the inputs sample by sample */
+    for(k = 0; k < ip->nin && k < ip->nout; k++) plumber_vec_fill(&v[k], n);
+
+    for(i = 0; i < n; i++) {
+        for(c = 0; c < plumb->npin; c++) plumb->p[c] = plumb->pin[c][i];
+        for(k = 0; k < ip->nin; k++) {
+            stack->fval[base + k] = v[k].cnst ? v[k].buf[0] : v[k].buf[i];
+        }
+        stack->pos = base + ip->nin;
+        ip->fun(stack, ip->ud);
+        for(k = 0; k < ip->nout; k++) v[k].buf[i] = stack->fval[base + k];
+    }
+    stack->pos = base;
+    for(k = 0; k < ip->nout; k++) v[k].cnst = 0;
+}
+
+static void plumbing_run_block(plumber_data *plumb, plumber_instr *ip,
+        plumber_vec *v, uint32_t n)
+{
+    plumber_ctrl *c;
+    uint32_t pmask = (1 << plumb->npin) - 1;
+    int depth = 0;
+
+    for(; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_FLOAT) {
+            v[depth].buf[0] = ip->fval;
+            v[depth].cnst = 1;
+            depth++;
+            continue;
+        }
+        if(ip->op == PLUMBER_OP_CTRL) {
+            c = ip->ud;
+            if(c->mask & pmask) {
+                plumbing_run_block(plumb, c->code, v + depth, n);
+            } else {
+                v[depth].buf[0] = c->val;
+                v[depth].cnst = 1;
+            }
+            depth++;
+            continue;
+        }
+        depth -= ip->nin;
+        plumb->last = ip->pipe;
+        if(ip->bfun == NULL ||
+           ip->bfun(plumb, ip->pipe->ud, v + depth, n) != PLUMBER_OK) {
+            block_samples(plumb, ip, v + depth, n);
+        }
+        depth += ip->nout;
+    }
+}
+
+int plumber_compute_block(plumber_data *plumb, const SPFLOAT **in, int nin,
+        SPFLOAT **out, int nout, uint32_t n)
+{
+    plumbing *pipes = plumb->pipes;
+    sporth_stack *stack = &plumb->sporth.stack;
+    plumber_vec *v;
+    uint32_t i, off, len;
+    int c;
+
+    if(nin > 16) nin = 16;
+
+    if(!pipes->block || pipes->nres != nout || stack->error > 0 ||
+       stack->pos + pipes->depth > SPORTH_STACK_SIZE) {
+        for(i = 0; i < n; i++) {
+            for(c = 0; c < nin; c++) plumb->p[c] = in[c][i];
+            plumber_compute(plumb, PLUMBER_COMPUTE);
+            for(c = 0; c < nout; c++) {
+                out[c][i] = sporth_stack_pop_float(stack);
+            }
+        }
+        return PLUMBER_OK;
+    }
+
+    plumb->mode = PLUMBER_COMPUTE;
+    /* the p registers past nin only change between calls */
+    if(pipes->nctrl > 0) plumbing_control(plumb, pipes);
+    plumb->npin = nin;
+    for(off = 0; off < n; off += len) {
+        len = n - off;
+        if(len > PLUMBER_BLOCK) len = PLUMBER_BLOCK;
+        for(c = 0; c < nin; c++) plumb->pin[c] = in[c] + off;
+        plumbing_run_block(plumb, pipes->code, pipes->vec, len);
+        /* the first channel is the top of the stack */
+        for(c = 0; c < nout; c++) {
+            v = &pipes->vec[nout - 1 - c];
+            if(v->cnst) {
+                for(i = 0; i < len; i++) out[c][off + i] = v->buf[0];
+            } else {
+                memcpy(out[c] + off, v->buf, sizeof(SPFLOAT) * len);
+            }
+        }
+    }
+    plumb->npin = 0;
+    if(n > 0) {
+        for(c = 0; c < nin; c++) plumb->p[c] = in[c][n - 1];
+    }
+    return PLUMBER_OK;
+}
@@ -50,19 +50,21 @@ int sporth_check_args(sporth_stack *stack, const char *args)
         return SPORTH_NOTOK;
     }
     int pos = stack->pos - len;
+    /* the arguments count as used even if create leaves them in place */
+    if(pos < stack->lo) stack->lo = pos;
     for(i = 0; i < len; i++) {
         switch(args[i]) {
             case 'f':
-                if(stack->stack[pos].type != SPORTH_FLOAT) {
+                if(stack->type[pos] != SPORTH_FLOAT) {
                    fprintf(stderr,"Argument %d was expecting a float\n", i);
                     stack->error++;
                     return SPORTH_NOTOK;
                 }
                 break;
             case 's':
-                if(stack->stack[pos].type != SPORTH_STRING) {
+                if(stack->type[pos] != SPORTH_STRING) {
                    fprintf(stderr,"Argument %d was expecting a string, got value %g instead\n",
-                            i, stack->stack[pos].fval);
+                            i, stack->fval[pos]);
                     stack->error++;
                     return SPORTH_NOTOK;
                 }
@@ -47,6 +47,8 @@ typedef struct plumber_pipe {
     size_t size;
     void *ud;
     struct plumber_pipe *next;
+    /* floats taken from and left on the stack at compute time */
+    int nin, nout;
 } plumber_pipe;
 
 typedef struct {
@@ -54,10 +56,72 @@ typedef struct {
     void *ud;
 } sporth_func_d;
 
+#define PLUMBER_BLOCK 64
+
+/* one stack slot in block mode: PLUMBER_BLOCK samples, or a single value
+ * in buf[0] when cnst is set */
+typedef struct {
+    SPFLOAT *buf;
+    int cnst;
+} plumber_vec;
+
+struct plumber_data;
+
+/* processes n samples with the arguments in v[0 .. nin - 1], leaving the
+ * outputs in v[0 .. nout - 1]. Returns PLUMBER_NOTOK, before touching
+ * anything, if it cannot handle these arguments; the ugen then runs once
+ * per sample instead. */
+typedef int (*plumber_blockfun)(struct plumber_data *pd, void *ud,
+        plumber_vec *v, uint32_t n);
+
+/* compiled instructions, see plumbing_compile */
+enum {
+PLUMBER_OP_FLOAT,
+PLUMBER_OP_UGEN,
+PLUMBER_OP_CTRL,
+PLUMBER_OP_END
+};
+
+typedef struct {
+    int op;
+    float fval;
+    int (*fun)(sporth_stack *, void *);
+    void *ud;
+    plumber_pipe *pipe;
+    int nin, nout;
+    plumber_blockfun bfun;
+} plumber_instr;
+
+/* a subexpression of literals and p registers, hoisted out of the code by
+ * plumbing_optimize and pushed by a PLUMBER_OP_CTRL instruction. It is run
+ * again only when one of the p registers in mask changes. */
+typedef struct {
+    plumber_instr *code;
+    uint32_t mask;
+    /* deepest its code takes the stack, from where it starts */
+    int depth;
+    SPFLOAT val;
+} plumber_ctrl;
+
 typedef struct {
     uint32_t npipes;
     plumber_pipe root;
     plumber_pipe *last;
+    plumber_instr *code;
+    /* deepest the stack gets while running code */
+    int depth;
+    /* block mode: set if the patch can run a block at a time, with nres
+     * values left per sample and vec holding the block stack */
+    int block;
+    int nres;
+    plumber_vec *vec;
+    SPFLOAT *vbuf;
+    /* hoisted subexpressions, and the p registers they were last run with */
+    plumber_ctrl *ctrl;
+    int nctrl;
+    plumber_instr *ccode;
+    SPFLOAT psnap[16];
+    int pvalid;
 } plumbing;
 
 typedef struct plumber_data {
@@ -85,6 +149,9 @@ typedef struct plumber_data {
     void *ud;
     plumber_pipe *next;
     plumber_pipe *last;
+    /* block mode: per sample values of p[0 .. npin - 1] for this block */
+    const SPFLOAT *pin[16];
+    int npin;
 } plumber_data;
 
 int plumber_init(plumber_data *plumb);
@@ -96,6 +163,8 @@ int plumber_add_string(plumber_data *plumb, plumbing *pipes, const char *str);
 int plumber_add_ugen(plumber_data *plumb, uint32_t id, void *ud);
 
 int plumber_compute(plumber_data *plumb, int mode);
+int plumber_compute_block(plumber_data *plumb, const SPFLOAT **in, int nin,
+        SPFLOAT **out, int nout, uint32_t n);
 
 int plumber_parse(plumber_data *plumb);
 int plumber_parse_string(plumber_data *plumb, char *str);
@@ -127,5 +196,12 @@ int plumbing_init(plumbing *pipes);
 int plumbing_destroy(plumbing *pipes);
 int plumbing_add_pipe(plumbing *pipes, plumber_pipe *pipe);
 int plumbing_compute(plumber_data *plumb, plumbing *pipes, int mode);
+int plumbing_compile(plumber_data *plumb, plumbing *pipes);
+int plumbing_optimize(plumber_data *plumb, plumbing *pipes);
+int plumbing_destroy_optimize(plumbing *pipes);
+int plumbing_control(plumber_data *plumb, plumbing *pipes);
+int plumbing_compile_block(plumber_data *plumb, plumbing *pipes);
+int plumbing_destroy_block(plumbing *pipes);
+void plumber_vec_fill(plumber_vec *v, uint32_t n);
 int plumbing_parse(plumber_data *plumb, plumbing *pipes);
 int plumbing_parse_string(plumber_data *plumb, plumbing *pipes, char *str);
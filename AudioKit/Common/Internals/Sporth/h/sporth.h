@@ -15,16 +15,21 @@ SPORTH_OK
 #define SPORTH_MAXCHAR 200
 #define SPORTH_STACK_SIZE 32
 
-typedef struct {
-    float fval;
-    char sval[SPORTH_MAXCHAR];
-    int type;
-} sporth_stack_val;
+/*
+ * The floats are kept dense at the front so compute time only touches a
+ * few cache lines. Strings only live on the stack at create and init time,
+ * in the sval side table; free slots always have type SPORTH_FLOAT.
+ * lo and hi are the lowest and highest depth seen by the checked calls,
+ * which the parser uses to size up a patch.
+ */
 
 typedef struct {
     int pos;
     uint32_t error;
-    sporth_stack_val stack[SPORTH_STACK_SIZE];
+    float fval[SPORTH_STACK_SIZE];
+    char type[SPORTH_STACK_SIZE];
+    int lo, hi;
+    char sval[SPORTH_STACK_SIZE][SPORTH_MAXCHAR];
 } sporth_stack;
 
 typedef struct sporth_entry {
@@ -68,6 +73,19 @@ int sporth_stack_push_string(sporth_stack *stack, const char *str);
 float sporth_stack_pop_float(sporth_stack *stack);
 char * sporth_stack_pop_string(sporth_stack *stack);
 int sporth_check_args(sporth_stack *stack, const char *args);
+
+/* unchecked versions for compute time, when the parser has already checked
+ * the types and the depth of the stack */
+static inline void sporth_stack_push_fast(sporth_stack *stack, float val)
+{
+    stack->fval[stack->pos++] = val;
+}
+
+static inline float sporth_stack_pop_fast(sporth_stack *stack)
+{
+    return stack->fval[--stack->pos];
+}
+
 int sporth_register_func(sporth_data *sporth, sporth_func *flist);
 int sporth_exec(sporth_data *sporth, const char *keyword);
 int sporth_init(sporth_data *sporth);
@@ -0,0 +1,34 @@
+/* Block mode. SPORTH_BLOCK pairs a ugen with a function that can process a
+ * block at a time; ugens not listed here run once per sample inside a
+ * block. SPORTH_SAMPLE marks a ugen that keeps the whole patch on the per
+ * sample path, because it shares state with other ugens in the patch or
+ * does not use the stack the same way every sample. */
+
+SPORTH_BLOCK(sporth_add, sporth_add_block)
+SPORTH_BLOCK(sporth_sub, sporth_sub_block)
+SPORTH_BLOCK(sporth_mul, sporth_mul_block)
+SPORTH_BLOCK(sporth_divide, sporth_divide_block)
+SPORTH_BLOCK(sporth_dup, sporth_dup_block)
+SPORTH_BLOCK(sporth_swap, sporth_swap_block)
+SPORTH_BLOCK(sporth_drop, sporth_drop_block)
+SPORTH_BLOCK(sporth_rot, sporth_rot_block)
+SPORTH_BLOCK(sporth_mtof, sporth_mtof_block)
+SPORTH_BLOCK(sporth_sine, sporth_sine_block)
+SPORTH_BLOCK(sporth_p, sporth_p_block)
+SPORTH_BLOCK(sporth_osc, sporth_osc_block)
+SPORTH_BLOCK(sporth_phasor, sporth_phasor_block)
+SPORTH_BLOCK(sporth_metro, sporth_metro_block)
+SPORTH_BLOCK(sporth_butlp, sporth_butlp_block)
+SPORTH_BLOCK(sporth_buthp, sporth_buthp_block)
+SPORTH_BLOCK(sporth_moogladder, sporth_moogladder_block)
+
+SPORTH_SAMPLE(sporth_constant)
+SPORTH_SAMPLE(sporth_mix)
+SPORTH_SAMPLE(sporth_pset)
+SPORTH_SAMPLE(sporth_tset)
+SPORTH_SAMPLE(sporth_tblrec)
+SPORTH_SAMPLE(sporth_poly)
+SPORTH_SAMPLE(sporth_tpoly)
+SPORTH_SAMPLE(sporth_f)
+SPORTH_SAMPLE(sporth_in)
+SPORTH_SAMPLE(sporth_tin)
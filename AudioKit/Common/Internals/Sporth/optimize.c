@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "plumber.h"
+
+/*
+ * Constant folding and control rate hoisting
+ *
+ * plumbing_optimize walks the compiled code keeping track of what each stack
+ * slot holds: a literal, a value worked out only from literals and p
+ * registers, or anything else. Stateless ugens whose arguments are all
+ * literals are run once here and replaced with the literals they leave.
+ * Expressions of literals and p registers are moved out of the code into
+ * their own, and a PLUMBER_OP_CTRL instruction pushes the last value that
+ * code left. plumbing_control runs it again when its p registers change.
+ *
+ * Only ugens that read nothing but their arguments are touched, so the
+ * output is the same as before, sample for sample.
+ */
+
+enum {
+OPT_CONST,
+OPT_CTRL,
+OPT_AUDIO
+};
+
+/* a stack slot, and the instructions in out[] that leave it there, from
+ * head to tail through link[] */
+typedef struct {
+    int kind;
+    int head, tail;
+    uint32_t mask;
+} opt_slot;
+
+typedef struct {
+    plumber_instr *out;
+    int *link;
+    char *dead;
+    int nout;
+    int ncode;
+} opt_data;
+
+static int opt_pure(uint32_t type)
+{
+    switch(type) {
+        case SPORTH_ADD:
+        case SPORTH_ADDv2:
+        case SPORTH_SUB:
+        case SPORTH_SUBv2:
+        case SPORTH_MUL:
+        case SPORTH_MULv2:
+        case SPORTH_DIV:
+        case SPORTH_DIVv2:
+        case SPORTH_MTOF:
+        case SPORTH_MAX:
+        case SPORTH_MIN:
+        case SPORTH_ABS:
+        case SPORTH_FLOOR:
+        case SPORTH_FRAC:
+        case SPORTH_LOG:
+        case SPORTH_LOG10:
+        case SPORTH_ROUND:
+        case SPORTH_EQ:
+        case SPORTH_LT:
+        case SPORTH_GT:
+        case SPORTH_NE:
+        case SPORTH_BRANCH:
+        case SPORTH_DUP:
+        case SPORTH_SWAP:
+        case SPORTH_DROP:
+        case SPORTH_ROT:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int opt_emit(opt_data *o, const plumber_instr *ip)
+{
+    o->out[o->nout] = *ip;
+    o->link[o->nout] = -1;
+    o->dead[o->nout] = 0;
+    return o->nout++;
+}
+
+static void opt_kill(opt_data *o, opt_slot *s)
+{
+    int i;
+    for(i = s->head; i != -1; i = o->link[i]) o->dead[i] = 1;
+}
+
+/* runs a stateless ugen on literal arguments, leaving literals in their
+ * place */
+static void opt_fold(plumber_data *plumb, opt_data *o, const plumber_instr *ip,
+        opt_slot *s)
+{
+    sporth_stack stack;
+    plumber_instr lit;
+    int mode = plumb->mode;
+    int k;
+
+    sporth_stack_init(&stack);
+    for(k = 0; k < ip->nin; k++) {
+        sporth_stack_push_fast(&stack, o->out[s[k].head].fval);
+        o->dead[s[k].head] = 1;
+    }
+    plumb->mode = PLUMBER_COMPUTE;
+    ip->fun(&stack, ip->ud);
+    plumb->mode = mode;
+
+    memset(&lit, 0, sizeof(plumber_instr));
+    lit.op = PLUMBER_OP_FLOAT;
+    lit.pipe = ip->pipe;
+    lit.nout = 1;
+    for(k = 0; k < ip->nout; k++) {
+        lit.fval = stack.fval[k];
+        s[k].kind = OPT_CONST;
+        s[k].head = s[k].tail = opt_emit(o, &lit);
+        s[k].mask = 0;
+    }
+}
+
+/* moves the expression for a slot into its own code, leaving a
+ * PLUMBER_OP_CTRL instruction where it ended */
+static void opt_hoist(plumbing *pipes, opt_data *o, opt_slot *s)
+{
+    plumber_ctrl *ctrl = &pipes->ctrl[pipes->nctrl++];
+    plumber_instr *root = &o->out[s->tail];
+    int depth = 0, i;
+
+    ctrl->code = pipes->ccode + o->ncode;
+    ctrl->mask = s->mask;
+    ctrl->depth = 0;
+    ctrl->val = 0;
+    for(i = s->head; i != -1; i = o->link[i]) {
+        pipes->ccode[o->ncode++] = o->out[i];
+        depth += o->out[i].nout - o->out[i].nin;
+        if(depth > ctrl->depth) ctrl->depth = depth;
+        if(i != s->tail) o->dead[i] = 1;
+    }
+    pipes->ccode[o->ncode++].op = PLUMBER_OP_END;
+
+    root->op = PLUMBER_OP_CTRL;
+    root->ud = ctrl;
+    root->nin = 0;
+    root->nout = 1;
+    root->bfun = NULL;
+    s->kind = OPT_AUDIO;
+    s->head = s->tail;
+    s->mask = 0;
+}
+
+int plumbing_optimize(plumber_data *plumb, plumbing *pipes)
+{
+    plumber_instr *ip;
+    opt_data o;
+    opt_slot *st, *s;
+    int ncode = 0, depth = 0, max = 0, hoist = 1;
+    int k, i, n, nconst, naudio;
+
+    plumbing_destroy_optimize(pipes);
+
+    for(ip = pipes->code; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_UGEN) {
+            if(ip->nin < 0) return PLUMBER_NOTOK;
+            switch(ip->pipe->type) {
+                /* these reach past their arguments or share state */
+                case SPORTH_CONSTANT:
+                case SPORTH_MIX:
+                case SPORTH_F:
+                    return PLUMBER_NOTOK;
+                /* p registers can change partway through a sample */
+                case SPORTH_PSET:
+                    hoist = 0;
+                    break;
+            }
+        }
+        depth -= ip->nin;
+        if(depth < 0) return PLUMBER_NOTOK;
+        depth += ip->nout;
+        if(depth > max) max = depth;
+        ncode++;
+    }
+
+    o.out = malloc(sizeof(plumber_instr) * (3 * ncode + 1));
+    o.link = malloc(sizeof(int) * (3 * ncode + 1));
+    o.dead = malloc(3 * ncode + 1);
+    st = malloc(sizeof(opt_slot) * (max + 1));
+    pipes->ctrl = sp_malloc(sizeof(plumber_ctrl) * (ncode + 1));
+    pipes->ccode = sp_malloc(sizeof(plumber_instr) * (2 * ncode + 1));
+    if(o.out == NULL || o.link == NULL || o.dead == NULL || st == NULL ||
+       pipes->ctrl == NULL || pipes->ccode == NULL) {
+        free(o.out);
+        free(o.link);
+        free(o.dead);
+        free(st);
+        plumbing_destroy_optimize(pipes);
+        return PLUMBER_NOTOK;
+    }
+    o.nout = 0;
+    o.ncode = 0;
+
+    depth = 0;
+    for(ip = pipes->code; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_FLOAT) {
+            s = &st[depth++];
+            s->kind = OPT_CONST;
+            s->head = s->tail = opt_emit(&o, ip);
+            s->mask = 0;
+            continue;
+        }
+
+        depth -= ip->nin;
+        s = &st[depth];
+        nconst = naudio = 0;
+        for(k = 0; k < ip->nin; k++) {
+            if(s[k].kind == OPT_CONST) nconst++;
+            if(s[k].kind == OPT_AUDIO) naudio++;
+        }
+
+        if(ip->pipe->type == SPORTH_P && nconst == 1) {
+            n = (int)o.out[s->head].fval;
+            if(n >= 16) {
+                opt_fold(plumb, &o, ip, s);
+                depth += ip->nout;
+                continue;
+            } else if(n >= 0 && hoist) {
+                i = opt_emit(&o, ip);
+                o.link[s->tail] = i;
+                s->kind = OPT_CTRL;
+                s->tail = i;
+                s->mask = 1 << n;
+                depth += ip->nout;
+                continue;
+            }
+        } else if(opt_pure(ip->pipe->type)) {
+            if(nconst == ip->nin) {
+                opt_fold(plumb, &o, ip, s);
+                depth += ip->nout;
+                continue;
+            } else if(naudio == 0 && ip->nout == 1) {
+                i = opt_emit(&o, ip);
+                for(k = 1; k < ip->nin; k++) {
+                    o.link[s[k - 1].tail] = s[k].head;
+                    s->mask |= s[k].mask;
+                }
+                o.link[s[ip->nin - 1].tail] = i;
+                s->kind = OPT_CTRL;
+                s->tail = i;
+                depth += ip->nout;
+                continue;
+            } else if(naudio == 0 && ip->nout == 0) {
+                for(k = 0; k < ip->nin; k++) opt_kill(&o, &s[k]);
+                continue;
+            }
+        }
+
+        for(k = 0; k < ip->nin; k++) {
+            if(s[k].kind == OPT_CTRL) opt_hoist(pipes, &o, &s[k]);
+        }
+        i = opt_emit(&o, ip);
+        for(k = 0; k < ip->nout; k++) {
+            s[k].kind = OPT_AUDIO;
+            s[k].head = s[k].tail = i;
+            s[k].mask = 0;
+        }
+        depth += ip->nout;
+    }
+    for(k = 0; k < depth; k++) {
+        if(st[k].kind == OPT_CTRL) opt_hoist(pipes, &o, &st[k]);
+    }
+
+    /* never longer than what it replaces */
+    ip = pipes->code;
+    for(i = 0; i < o.nout; i++) {
+        if(!o.dead[i]) *ip++ = o.out[i];
+    }
+    ip->op = PLUMBER_OP_END;
+
+    free(o.out);
+    free(o.link);
+    free(o.dead);
+    free(st);
+    if(pipes->nctrl == 0) plumbing_destroy_optimize(pipes);
+    return PLUMBER_OK;
+}
+
+int plumbing_destroy_optimize(plumbing *pipes)
+{
+    sp_free(pipes->ctrl);
+    sp_free(pipes->ccode);
+    pipes->ctrl = NULL;
+    pipes->ccode = NULL;
+    pipes->nctrl = 0;
+    pipes->pvalid = 0;
+    return PLUMBER_OK;
+}
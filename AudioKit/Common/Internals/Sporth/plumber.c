@@ -61,6 +61,16 @@ int plumbing_init(plumbing *pipes)
 {
     pipes->last = &pipes->root;
     pipes->npipes = 0;
+    pipes->code = NULL;
+    pipes->depth = 0;
+    pipes->block = 0;
+    pipes->nres = 0;
+    pipes->vec = NULL;
+    pipes->vbuf = NULL;
+    pipes->ctrl = NULL;
+    pipes->nctrl = 0;
+    pipes->ccode = NULL;
+    pipes->pvalid = 0;
     return PLUMBER_OK;
 }
 
@@ -78,12 +88,147 @@ int plumber_init(plumber_data *plumb)
     plumber_ftmap_init(plumb);
     plumb->seed = (int) time(NULL);
     plumb->fp = NULL;
+    plumb->npin = 0;
     int pos;
     for(pos = 0; pos < 16; pos++) plumb->p[pos] = 0;
     for(pos = 0; pos < 16; pos++) plumb->f[pos] = sporth_f_default;
     return PLUMBER_OK;
 }
 
+/*
+ * The compute pass only needs the literals and the ugens, so after a
+ * successful parse the pipe list is flattened into an array of them, ending
+ * in PLUMBER_OP_END. Literals are stored inline, strings (only pushed at
+ * init time) are left out, and each ugen carries its function and user
+ * data, so a sample no longer chases the list or looks up flist.
+ * plumbing_optimize then folds what it can, see optimize.c.
+ */
+
+int plumbing_compile(plumber_data *plumb, plumbing *pipes)
+{
+    plumber_pipe *pipe = pipes->root.next;
+    plumber_instr *ip;
+    sporth_func *f;
+    uint32_t n;
+
+    sp_free(pipes->code);
+    pipes->code = sp_malloc(sizeof(plumber_instr) * (pipes->npipes + 1));
+    if(pipes->code == NULL) {
+        fprintf(stderr,"Memory error\n");
+        plumb->sporth.stack.error++;
+        return PLUMBER_NOTOK;
+    }
+    /* every ugen has had its arguments checked by now, and the stack
+     * reaches the same depth, relative to where it starts, every sample */
+    pipes->depth = plumb->sporth.stack.hi;
+    ip = pipes->code;
+    for(n = 0; n < pipes->npipes; n++) {
+        switch(pipe->type) {
+            case SPORTH_FLOAT:
+                ip->op = PLUMBER_OP_FLOAT;
+                ip->fval = *(float *)pipe->ud;
+                ip->pipe = pipe;
+                ip->nin = 0;
+                ip->nout = 1;
+                ip->bfun = NULL;
+                ip++;
+                break;
+            case SPORTH_STRING:
+                break;
+            default:
+                f = &plumb->sporth.flist[pipe->type - SPORTH_FOFFSET];
+                ip->op = PLUMBER_OP_UGEN;
+                ip->fun = f->func;
+                ip->ud = f->ud;
+                ip->pipe = pipe;
+                ip->nin = pipe->nin;
+                ip->nout = pipe->nout;
+                ip->bfun = NULL;
+                ip++;
+                break;
+        }
+        pipe = pipe->next;
+    }
+    ip->op = PLUMBER_OP_END;
+    plumbing_optimize(plumb, pipes);
+    /* a patch that cannot run a block at a time still runs per sample */
+    plumbing_compile_block(plumb, pipes);
+    return PLUMBER_OK;
+}
+
+/* runs compiled code in compute mode. Ugens still find their data through
+ * plumb->last; plumb->next is not kept up to date here. Nothing is checked
+ * per instruction: plumbing_compute makes sure the stack has room for the
+ * deepest point of the patch before starting. */
+static void plumbing_run(plumber_data *plumb, plumber_instr *ip)
+{
+    sporth_stack *stack = &plumb->sporth.stack;
+#if defined(__GNUC__)
+    static void *dispatch[] = {&&op_float, &&op_ugen, &&op_ctrl, &&op_end};
+
+    goto *dispatch[ip->op];
+op_float:
+    sporth_stack_push_fast(stack, ip->fval);
+    ip++;
+    goto *dispatch[ip->op];
+op_ugen:
+    plumb->last = ip->pipe;
+    ip->fun(stack, ip->ud);
+    ip++;
+    goto *dispatch[ip->op];
+op_ctrl:
+    sporth_stack_push_fast(stack, ((plumber_ctrl *)ip->ud)->val);
+    ip++;
+    goto *dispatch[ip->op];
+op_end:
+    return;
+#else
+    for(; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_FLOAT) {
+            sporth_stack_push_fast(stack, ip->fval);
+        } else if(ip->op == PLUMBER_OP_CTRL) {
+            sporth_stack_push_fast(stack, ((plumber_ctrl *)ip->ud)->val);
+        } else {
+            plumb->last = ip->pipe;
+            ip->fun(stack, ip->ud);
+        }
+    }
+#endif
+}
+
+/* brings the hoisted subexpressions up to date with the p registers. Runs
+ * in compute mode, with the same room on the stack as the patch. */
+int plumbing_control(plumber_data *plumb, plumbing *pipes)
+{
+    sporth_stack *stack = &plumb->sporth.stack;
+    plumber_ctrl *ctrl;
+    uint32_t changed = 0;
+    int n;
+
+    if(pipes->pvalid) {
+        if(!memcmp(pipes->psnap, plumb->p, sizeof(pipes->psnap))) {
+            return PLUMBER_OK;
+        }
+        for(n = 0; n < 16; n++) {
+            if(memcmp(&pipes->psnap[n], &plumb->p[n], sizeof(SPFLOAT))) {
+                changed |= 1 << n;
+            }
+        }
+    } else {
+        changed = 0xffff;
+    }
+    memcpy(pipes->psnap, plumb->p, sizeof(pipes->psnap));
+    pipes->pvalid = 1;
+    for(n = 0; n < pipes->nctrl; n++) {
+        ctrl = &pipes->ctrl[n];
+        if(ctrl->mask & changed) {
+            plumbing_run(plumb, ctrl->code);
+            ctrl->val = sporth_stack_pop_fast(stack);
+        }
+    }
+    return PLUMBER_OK;
+}
+
 int plumbing_compute(plumber_data *plumb, plumbing *pipes, int mode)
 {
     plumb->mode = mode;
@@ -95,6 +240,25 @@ int plumbing_compute(plumber_data *plumb, plumbing *pipes, int mode)
     /* swap out the current plumbing */
     plumbing *prev = plumb->pipes;
     plumb->pipes = pipes;
+    if(mode == PLUMBER_COMPUTE) {
+        /* the ugens use the unchecked stack calls at compute time, so a
+         * patch that did not parse is not run at all */
+        if(sporth->stack.error > 0 || pipes->code == NULL) {
+            plumb->pipes = prev;
+            return PLUMBER_NOTOK;
+        }
+        if(sporth->stack.pos + pipes->depth > SPORTH_STACK_SIZE) {
+            fprintf(stderr, "Stack limit of %d reached, cannot compute.\n",
+                    SPORTH_STACK_SIZE);
+            sporth->stack.error++;
+            plumb->pipes = prev;
+            return PLUMBER_NOTOK;
+        }
+        if(pipes->nctrl > 0) plumbing_control(plumb, pipes);
+        plumbing_run(plumb, pipes->code);
+        plumb->pipes = prev;
+        return PLUMBER_OK;
+    }
     for(n = 0; n < pipes->npipes; n++) {
         plumb->next = pipe->next;
         switch(pipe->type) {
@@ -162,10 +326,14 @@ int plumbing_destroy(plumbing *pipes)
 #endif
 
         if(pipe->type == SPORTH_FLOAT || pipe->type == SPORTH_STRING)
-            free(pipe->ud);
-        free(pipe);
+            sp_free(pipe->ud);
+        sp_free(pipe);
         pipe = next;
     }
+    sp_free(pipes->code);
+    pipes->code = NULL;
+    plumbing_destroy_optimize(pipes);
+    plumbing_destroy_block(pipes);
     return PLUMBER_OK;
 }
 
@@ -190,7 +358,7 @@ int plumbing_add_pipe(plumbing *pipes, plumber_pipe *pipe)
 
 int plumber_add_float(plumber_data *plumb, plumbing *pipes, float num)
 {
-    plumber_pipe *new = malloc(sizeof(plumber_pipe));
+    plumber_pipe *new = sp_malloc(sizeof(plumber_pipe));
 
     if(new == NULL) {
         fprintf(stderr,"Memory error\n");
@@ -198,8 +366,10 @@ int plumber_add_float(plumber_data *plumb, plumbing *pipes, float num)
     }
 
     new->type = SPORTH_FLOAT;
+    new->nin = 0;
+    new->nout = 1;
     new->size = sizeof(SPFLOAT);
-    new->ud = malloc(new->size);
+    new->ud = sp_malloc(new->size);
     float *val = new->ud;
     *val = num;
     if(new->ud == NULL) {
@@ -213,7 +383,7 @@ int plumber_add_float(plumber_data *plumb, plumbing *pipes, float num)
 
 int plumber_add_string(plumber_data *plumb, plumbing *pipes, const char *str)
 {
-    plumber_pipe *new = malloc(sizeof(plumber_pipe));
+    plumber_pipe *new = sp_malloc(sizeof(plumber_pipe));
 
     if(new == NULL) {
         fprintf(stderr,"Memory error\n");
@@ -221,8 +391,10 @@ int plumber_add_string(plumber_data *plumb, plumbing *pipes, const char *str)
     }
 
     new->type = SPORTH_STRING;
+    new->nin = 0;
+    new->nout = 0;
     new->size = sizeof(char) * strlen(str) + 1;
-    new->ud = malloc(new->size);
+    new->ud = sp_malloc(new->size);
     char *sval = new->ud;
     strncpy(sval, str, new->size);
     if(new->ud == NULL) {
@@ -236,7 +408,7 @@ int plumber_add_string(plumber_data *plumb, plumbing *pipes, const char *str)
 
 int plumber_add_ugen(plumber_data *plumb, uint32_t id, void *ud)
 {
-    plumber_pipe *new = malloc(sizeof(plumber_pipe));
+    plumber_pipe *new = sp_malloc(sizeof(plumber_pipe));
 
     if(new == NULL) {
         fprintf(stderr,"Memory error\n");
@@ -245,6 +417,9 @@ int plumber_add_ugen(plumber_data *plumb, uint32_t id, void *ud)
 
     new->type = id;
     new->ud = ud;
+    /* unknown until plumber_lexer has seen the ugen run */
+    new->nin = -1;
+    new->nout = -1;
 
     plumbing_add_pipe(plumb->tmp, new);
     return PLUMBER_OK;
@@ -255,10 +430,31 @@ int plumber_parse_string(plumber_data *plumb, char *str)
     return plumbing_parse_string(plumb, plumb->pipes, str);
 }
 
+/* the floats a ugen took from and left on the stack at create time, which
+ * it does the same way at compute time: type holds the stack types from
+ * before it ran, at depth pos, and stack->lo is as deep as it went */
+static void plumber_arity(plumber_pipe *pipe, sporth_stack *stack,
+        const char *type, int pos)
+{
+    int n;
+    pipe->nin = 0;
+    pipe->nout = 0;
+    for(n = stack->lo; n < pos; n++) {
+        if(type[n] == SPORTH_FLOAT) pipe->nin++;
+    }
+    for(n = stack->lo; n < stack->pos; n++) {
+        if(stack->type[n] == SPORTH_FLOAT) pipe->nout++;
+    }
+}
+
 int plumber_lexer(plumber_data *plumb, plumbing *pipes, char *out, uint32_t len)
 {
     char *tmp;
     float flt = 0;
+    sporth_stack *stack = &plumb->sporth.stack;
+    char type[SPORTH_STACK_SIZE];
+    uint32_t npipes;
+    int pos;
     switch(sporth_lexer(out, len)) {
         case SPORTH_FLOAT:
 #ifdef DEBUG_MODE
@@ -282,6 +478,10 @@ int plumber_lexer(plumber_data *plumb, plumbing *pipes, char *out, uint32_t len)
 #ifdef DEBUG_MODE
             fprintf(stderr, "%s is a function!\n", out);
 #endif
+            npipes = plumb->tmp->npipes;
+            pos = stack->pos;
+            memcpy(type, stack->type, pos);
+            stack->lo = pos;
             if(sporth_exec(&plumb->sporth, out) == PLUMBER_NOTOK) {
 #ifdef DEBUG_MODE
             fprintf(stderr, "plumber_lexer: error with function %s\n", out);
@@ -289,6 +489,9 @@ int plumber_lexer(plumber_data *plumb, plumbing *pipes, char *out, uint32_t len)
                 plumb->sporth.stack.error++;
                 return PLUMBER_NOTOK;
             }
+            if(plumb->tmp->npipes == npipes + 1) {
+                plumber_arity(plumb->tmp->last, stack, type, pos);
+            }
             break;
         case SPORTH_IGNORE:
             break;
@@ -323,6 +526,9 @@ int plumbing_parse(plumber_data *plumb, plumbing *pipes)
         }
     }
     free(line);
+    if(err == PLUMBER_OK && plumb->sporth.stack.error == 0) {
+        err = plumbing_compile(plumb, pipes);
+    }
     return err;
 
 }
@@ -343,6 +549,9 @@ int plumbing_parse_string(plumber_data *plumb, plumbing *pipes, char *str)
         free(out);
         if(err == PLUMBER_NOTOK) break;
     }
+    if(err == PLUMBER_OK && plumb->sporth.stack.error == 0) {
+        err = plumbing_compile(plumb, pipes);
+    }
     return err;
 }
 
@@ -495,11 +704,11 @@ int plumber_ftmap_add(plumber_data *plumb, const char *str, sp_ftbl *ft)
     uint32_t pos = sporth_hash(str);
     plumber_ftentry *entry = &plumb->ftmap[pos];
     entry->nftbl++;
-    plumber_ftbl *new = malloc(sizeof(plumber_ftbl));
+    plumber_ftbl *new = sp_malloc(sizeof(plumber_ftbl));
     new->ud = (void *)ft;
     new->type = 1;
     new->to_delete = plumb->delete_ft;
-    new->name = malloc(sizeof(char) * strlen(str) + 1);
+    new->name = sp_malloc(sizeof(char) * strlen(str) + 1);
     strcpy(new->name, str);
     entry->last->next = new;
     entry->last = new;
@@ -543,12 +752,12 @@ int plumber_ftmap_destroy(plumber_data *plumb)
         ftbl = plumb->ftmap[pos].root.next;
         for(n = 0; n < plumb->ftmap[pos].nftbl; n++) {
             next = ftbl->next;
-            free(ftbl->name);
+            sp_free(ftbl->name);
             if(ftbl->to_delete) {
                 if(ftbl->type == 1) sp_ftbl_destroy((sp_ftbl **)&ftbl->ud);
                 else free(ftbl->ud);
             }
-            free(ftbl);
+            sp_free(ftbl);
             ftbl = next;
         }
     }
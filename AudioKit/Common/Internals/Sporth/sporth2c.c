@@ -0,0 +1,596 @@
+/*
+ * sporth2c
+ *
+ * Turns a Sporth patch into a C translation unit, so a patch that ships
+ * with an app can skip the interpreter at compute time. The patch is parsed
+ * with the usual lexer and sporth_exec, then every stack slot becomes a
+ * local variable and each compiled instruction becomes a line of C: math,
+ * stack shuffling, p and mtof are written out inline, a handful of ugens
+ * (osc, phasor, metro, butlp, buthp, moogladder) call their sp_*_compute
+ * directly, and the rest are called through their plumber functions on
+ * the Sporth stack. Literals folded by plumbing_optimize come out as
+ * literals, and expressions it hoisted read their value from the
+ * plumber_ctrl, updated once per call through plumbing_control.
+ *
+ * The generated code still uses plumber for create, init and destroy, which
+ * is where strings and tables get resolved, and checks at init time that
+ * the patch compiles to the same instructions it was generated from.
+ *
+ * usage: sporth2c [-n name] [-t samples] [-o out.c] (file.sp | -e 'patch')
+ *
+ * -n sets the prefix of the generated functions (default sporth_patch).
+ * -t also writes a main() that renders the patch both ways for the given
+ * number of samples and compares them with the sp_test md5 harness.
+ *
+ * Not part of the library build. From Internals/, link it against the
+ * Soundpipe and Sporth sources, with Soundpipe/test/{test,md5}.c added when
+ * building a test:
+ *
+ * cc -O2 -DNO_LIBSNDFILE -ISoundpipe -ISporth/h Sporth/sporth2c.c \
+ *     <Soundpipe and Sporth sources> -lm -o sporth2c
+ *
+ * test/sporth2c.sh builds it and checks the patches in test/ this way.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "plumber.h"
+
+static const char *ugen_names[][2] = {
+#define SPORTH_UGEN(key, func, macro) {key, #macro},
+#include "ugens.h"
+#undef SPORTH_UGEN
+};
+
+typedef struct {
+    FILE *fp;
+    const char *name;
+    plumber_instr *code;
+    int ninstr;
+    int nres;
+    /* set for slots holding a literal, with its value */
+    int cnst[SPORTH_STACK_SIZE];
+    float val[SPORTH_STACK_SIZE];
+} sporth2c_d;
+
+static const char *ugen_key(int type)
+{
+    return ugen_names[type - SPORTH_FOFFSET][0];
+}
+
+static const char *ugen_macro(int type)
+{
+    if(type == SPORTH_FLOAT) return "SPORTH_FLOAT";
+    return ugen_names[type - SPORTH_FOFFSET][1];
+}
+
+static char *read_patch(const char *filename)
+{
+    FILE *fp = fopen(filename, "r");
+    char *str, *tmp;
+    size_t size = 0, len;
+
+    if(fp == NULL) {
+        fprintf(stderr, "sporth2c: could not open %s\n", filename);
+        return NULL;
+    }
+    str = malloc(1);
+    str[0] = '\0';
+    tmp = NULL;
+    while(getline(&tmp, &len, fp) != -1) {
+        str = realloc(str, size + strlen(tmp) + 1);
+        strcpy(str + size, tmp);
+        size += strlen(tmp);
+    }
+    free(tmp);
+    fclose(fp);
+    return str;
+}
+
+/* the patch as one line of tokens, which is how the generated code hands it
+ * to plumber_parse_string. Comments run to the end of their line, so they
+ * are dropped here rather than swallowing everything after them. */
+static char *join_tokens(char *str)
+{
+    char *out = malloc(strlen(str) + 1);
+    char *line = str, *end, *tok;
+    uint32_t pos, size;
+    size_t len = 0;
+
+    out[0] = '\0';
+    while(*line != '\0') {
+        end = strchr(line, '\n');
+        size = end != NULL ? (uint32_t)(end - line) : (uint32_t)strlen(line);
+        pos = 0;
+        while(pos < size) {
+            tok = sporth_tokenizer(line, size, &pos);
+            if(tok[0] != '\0') {
+                if(len > 0) out[len++] = ' ';
+                strcpy(out + len, tok);
+                len += strlen(tok);
+            }
+            free(tok);
+        }
+        if(end == NULL) break;
+        line = end + 1;
+    }
+    return out;
+}
+
+static void emit_string(FILE *fp, const char *str)
+{
+    fputc('"', fp);
+    for(; *str != '\0'; str++) {
+        if(*str == '"' || *str == '\\') fputc('\\', fp);
+        fputc(*str, fp);
+    }
+    fputc('"', fp);
+}
+
+static void emit_float(FILE *fp, float v)
+{
+    if(isnan(v)) fprintf(fp, "NAN");
+    else if(isinf(v)) fprintf(fp, v > 0 ? "INFINITY" : "-INFINITY");
+    else fprintf(fp, "%af", v);
+}
+
+/* has its own field in the generated struct, holding the ugen's data */
+static const char *direct_type(int type)
+{
+    switch(type) {
+        case SPORTH_OSC: return "sp_osc";
+        case SPORTH_PHASOR: return "sp_phasor";
+        case SPORTH_METRO: return "sp_metro";
+        case SPORTH_BUTLP: return "sp_butlp";
+        case SPORTH_BUTHP: return "sp_buthp";
+        case SPORTH_MOOGLADDER: return "sp_moogladder";
+        default: return NULL;
+    }
+}
+
+/* returns the deepest the stack gets, or -1 if the slots cannot be worked
+ * out ahead of time: that needs every ugen to use the stack the same way
+ * every sample */
+static int check_code(sporth2c_d *sc)
+{
+    plumber_instr *ip;
+    int depth = 0, max = 0;
+
+    for(ip = sc->code; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_UGEN) {
+            switch(ip->pipe->type) {
+                case SPORTH_CONSTANT:
+                case SPORTH_MIX:
+                case SPORTH_F:
+                    fprintf(stderr, "sporth2c: %s is not supported\n",
+                            ugen_key(ip->pipe->type));
+                    return -1;
+                default:
+                    break;
+            }
+            if(ip->nin < 0) {
+                fprintf(stderr, "sporth2c: could not work out the stack use of %s\n",
+                        ugen_key(ip->pipe->type));
+                return -1;
+            }
+        }
+        depth -= ip->nin;
+        if(depth < 0) {
+            fprintf(stderr, "sporth2c: the patch reads values left over from init\n");
+            return -1;
+        }
+        depth += ip->nout;
+        if(depth > max) max = depth;
+        sc->ninstr++;
+    }
+    sc->nres = depth;
+    return max;
+}
+
+static void emit_fallback(sporth2c_d *sc, int k, int a)
+{
+    FILE *fp = sc->fp;
+    plumber_instr *ip = &sc->code[k];
+    int i;
+
+    for(i = 0; i < ip->nin; i++) {
+        fprintf(fp, "    stack->fval[base + %d] = s%d;\n", i, a + i);
+    }
+    fprintf(fp, "    stack->pos = base + %d;\n", ip->nin);
+    fprintf(fp, "    pd->last = x->code[%d].pipe;\n", k);
+    fprintf(fp, "    x->code[%d].fun(stack, x->code[%d].ud);\n", k, k);
+    for(i = 0; i < ip->nout; i++) {
+        fprintf(fp, "    s%d = stack->fval[base + %d];\n", a + i, i);
+    }
+}
+
+static void emit_ugen(sporth2c_d *sc, int k, int a)
+{
+    FILE *fp = sc->fp;
+    plumber_instr *ip = &sc->code[k];
+    int idx;
+
+    switch(ip->pipe->type) {
+        case SPORTH_ADD:
+        case SPORTH_ADDv2:
+            fprintf(fp, "    s%d = s%d + s%d;\n", a, a + 1, a);
+            break;
+        case SPORTH_MUL:
+        case SPORTH_MULv2:
+            fprintf(fp, "    s%d = s%d * s%d;\n", a, a + 1, a);
+            break;
+        case SPORTH_SUB:
+        case SPORTH_SUBv2:
+            fprintf(fp, "    s%d = s%d - s%d;\n", a, a, a + 1);
+            break;
+        case SPORTH_DIV:
+        case SPORTH_DIVv2:
+            fprintf(fp, "    s%d = s%d / s%d;\n", a, a, a + 1);
+            break;
+        case SPORTH_DUP:
+            fprintf(fp, "    s%d = s%d;\n", a + 1, a);
+            break;
+        case SPORTH_SWAP:
+            fprintf(fp, "    t = s%d; s%d = s%d; s%d = t;\n", a, a, a + 1, a + 1);
+            break;
+        case SPORTH_ROT:
+            fprintf(fp, "    t = s%d; s%d = s%d; s%d = s%d; s%d = t;\n",
+                    a, a, a + 1, a + 1, a + 2, a + 2);
+            break;
+        case SPORTH_DROP:
+            break;
+        case SPORTH_MTOF:
+            fprintf(fp, "    s%d = sp_midi2cps(s%d);\n", a, a);
+            break;
+        case SPORTH_P:
+            idx = (int)sc->val[a];
+            if(!sc->cnst[a] || idx < 0) {
+                emit_fallback(sc, k, a);
+            } else if(idx < 16) {
+                fprintf(fp, "    s%d = pd->p[%d];\n", a, idx);
+            } else {
+                fprintf(fp, "    s%d = 0;\n", a);
+            }
+            break;
+        case SPORTH_OSC:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a);
+            fprintf(fp, "    x->u%d->amp = s%d;\n", k, a + 1);
+            fprintf(fp, "    sp_osc_compute(sp, x->u%d, NULL, &s%d);\n", k, a);
+            break;
+        case SPORTH_PHASOR:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a);
+            fprintf(fp, "    sp_phasor_compute(sp, x->u%d, NULL, &s%d);\n", k, a);
+            break;
+        case SPORTH_METRO:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a);
+            fprintf(fp, "    sp_metro_compute(sp, x->u%d, NULL, &s%d);\n", k, a);
+            break;
+        case SPORTH_BUTLP:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a + 1);
+            fprintf(fp, "    sp_butlp_compute(sp, x->u%d, &s%d, &s%d);\n", k, a, a);
+            break;
+        case SPORTH_BUTHP:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a + 1);
+            fprintf(fp, "    sp_buthp_compute(sp, x->u%d, &s%d, &s%d);\n", k, a, a);
+            break;
+        case SPORTH_MOOGLADDER:
+            fprintf(fp, "    x->u%d->freq = s%d;\n", k, a + 1);
+            fprintf(fp, "    x->u%d->res = s%d;\n", k, a + 2);
+            fprintf(fp, "    sp_moogladder_compute(sp, x->u%d, &s%d, &s%d);\n", k, a, a);
+            break;
+        default:
+            emit_fallback(sc, k, a);
+            break;
+    }
+}
+
+static void emit_test(sporth2c_d *sc, const char *patch, int nsmp)
+{
+    FILE *fp = sc->fp;
+    const char *n = sc->name;
+
+    fprintf(fp,
+"\n"
+"/* renders the patch through the interpreter and through %s_compute,\n"
+" * and compares the two with the sp_test md5 harness */\n"
+"\n"
+"#include \"md5.h\"\n"
+"#include \"test.h\"\n"
+"\n"
+"int main(int argc, char **argv)\n"
+"{\n"
+"    uint32_t size = %d, n;\n"
+"    int c, fail;\n"
+"    char str[] = ", n, nsmp);
+    emit_string(fp, patch);
+    fprintf(fp, ";\n"
+"    SPFLOAT out[%d + 1];\n"
+"    sp_data *sp[2];\n"
+"    sp_test *t[2];\n"
+"    plumber_data pd;\n"
+"    %s *x;\n"
+"\n"
+"    sp_create(&sp[0]);\n"
+"    sp_create(&sp[1]);\n"
+"    sp_test_create(&t[0], size * %d);\n"
+"    sp_test_create(&t[1], size * %d);\n"
+"\n"
+"    plumber_register(&pd);\n"
+"    plumber_init(&pd);\n"
+"    pd.sp = sp[0];\n"
+"    if(plumber_parse_string(&pd, str) != PLUMBER_OK) return 1;\n"
+"    plumber_compute(&pd, PLUMBER_INIT);\n"
+"    for(n = 0; n < size; n++) {\n"
+"        plumber_compute(&pd, PLUMBER_COMPUTE);\n"
+"        for(c = 0; c < %d; c++) {\n"
+"            sp_test_add_sample(t[0], sporth_stack_pop_float(&pd.sporth.stack));\n"
+"        }\n"
+"    }\n"
+"\n"
+"    %s_create(&x);\n"
+"    if(%s_init(sp[1], x) != SP_OK) return 1;\n"
+"    for(n = 0; n < size; n++) {\n"
+"        %s_compute(sp[1], x, out);\n"
+"        for(c = 0; c < %d; c++) sp_test_add_sample(t[1], out[c]);\n"
+"    }\n"
+"\n"
+"    sp_test_compare(t[0], \"00000000000000000000000000000000\");\n"
+"    fail = sp_test_verify(t[1], t[0]->md5);\n"
+"    printf(\"%%s %%s\\n\", fail ? \"FAIL\" : \"ok\", t[0]->md5);\n"
+"\n"
+"    %s_destroy(&x);\n"
+"    plumber_clean(&pd);\n"
+"    sp_test_destroy(&t[0]);\n"
+"    sp_test_destroy(&t[1]);\n"
+"    sp_destroy(&sp[0]);\n"
+"    sp_destroy(&sp[1]);\n"
+"    return fail;\n"
+"}\n",
+        sc->nres, n, sc->nres, sc->nres, sc->nres, n, n, n, sc->nres, n);
+}
+
+static int emit(sporth2c_d *sc, const char *patch, int nsmp)
+{
+    FILE *fp = sc->fp;
+    const char *n = sc->name;
+    plumber_instr *ip;
+    const char *type;
+    int max, depth, k, i, fallback = 0, ctrl = 0;
+
+    max = check_code(sc);
+    if(max < 0) return PLUMBER_NOTOK;
+
+    for(ip = sc->code; ip->op != PLUMBER_OP_END; ip++) {
+        if(ip->op == PLUMBER_OP_CTRL) ctrl = 1;
+        if(ip->op == PLUMBER_OP_UGEN && direct_type(ip->pipe->type) == NULL) {
+            switch(ip->pipe->type) {
+                case SPORTH_ADD: case SPORTH_ADDv2:
+                case SPORTH_MUL: case SPORTH_MULv2:
+                case SPORTH_SUB: case SPORTH_SUBv2:
+                case SPORTH_DIV: case SPORTH_DIVv2:
+                case SPORTH_DUP: case SPORTH_SWAP: case SPORTH_ROT:
+                case SPORTH_DROP: case SPORTH_MTOF:
+                    break;
+                default:
+                    /* p with a computed index included */
+                    fallback = 1;
+                    break;
+            }
+        }
+    }
+
+    fprintf(fp, "/* generated by sporth2c from:\n *\n * ");
+    for(i = 0; patch[i] != '\0'; i++) {
+        if(patch[i] == '*' && patch[i + 1] == '/') fputc(' ', fp);
+        fputc(patch[i], fp);
+    }
+    fprintf(fp, "\n *\n"
+" * typedef struct %s %s;\n"
+" * int %s_create(%s **x);\n"
+" * int %s_init(sp_data *sp, %s *x);\n"
+" * int %s_compute(sp_data *sp, %s *x, SPFLOAT *out);\n"
+" * int %s_destroy(%s **x);\n"
+" *\n"
+" * compute writes %d value(s) to out, in the order a host would pop them\n"
+" * off the Sporth stack. p registers are in x->pd.p.\n"
+" */\n\n", n, n, n, n, n, n, n, n, n, n, sc->nres);
+
+    fprintf(fp, "#include <stdlib.h>\n#include <math.h>\n#include \"plumber.h\"\n\n");
+
+    fprintf(fp, "typedef struct %s {\n    plumber_data pd;\n    plumber_instr *code;\n", n);
+    for(k = 0; k < sc->ninstr; k++) {
+        ip = &sc->code[k];
+        if(ip->op != PLUMBER_OP_UGEN) continue;
+        type = direct_type(ip->pipe->type);
+        if(type != NULL) fprintf(fp, "    %s *u%d;\n", type, k);
+    }
+    fprintf(fp, "} %s;\n\n", n);
+
+    /* folded literals keep the pipe of the ugen they came from */
+    fprintf(fp, "static const int %s_types[%d][2] = {\n", n, sc->ninstr);
+    for(k = 0; k < sc->ninstr; k++) {
+        ip = &sc->code[k];
+        fprintf(fp, "    {%s, %s},\n",
+                ip->op == PLUMBER_OP_FLOAT ? "PLUMBER_OP_FLOAT" :
+                ip->op == PLUMBER_OP_CTRL ? "PLUMBER_OP_CTRL" : "PLUMBER_OP_UGEN",
+                ugen_macro(ip->pipe->type));
+    }
+    fprintf(fp, "};\n\n");
+
+    fprintf(fp,
+"int %s_create(%s **x)\n"
+"{\n"
+"    *x = malloc(sizeof(%s));\n"
+"    return *x != NULL ? SP_OK : SP_NOT_OK;\n"
+"}\n\n", n, n, n);
+
+    fprintf(fp,
+"int %s_init(sp_data *sp, %s *x)\n"
+"{\n"
+"    char str[] = ", n, n);
+    emit_string(fp, patch);
+    fprintf(fp, ";\n"
+"    plumber_instr *ip;\n"
+"    int k = 0;\n"
+"\n"
+"    plumber_register(&x->pd);\n"
+"    plumber_init(&x->pd);\n"
+"    x->pd.sp = sp;\n"
+"    if(plumber_parse_string(&x->pd, str) != PLUMBER_OK) return SP_NOT_OK;\n"
+"    x->code = x->pd.pipes->code;\n"
+"    /* the code below was written for these instructions */\n"
+"    for(ip = x->code; ip->op != PLUMBER_OP_END; ip++, k++) {\n"
+"        if(k == %d || ip->op != %s_types[k][0] ||\n"
+"           ip->pipe->type != %s_types[k][1]) return SP_NOT_OK;\n"
+"    }\n"
+"    if(k != %d) return SP_NOT_OK;\n"
+"    plumber_compute(&x->pd, PLUMBER_INIT);\n", sc->ninstr, n, n, sc->ninstr);
+    for(k = 0; k < sc->ninstr; k++) {
+        ip = &sc->code[k];
+        if(ip->op == PLUMBER_OP_UGEN && direct_type(ip->pipe->type) != NULL) {
+            fprintf(fp, "    x->u%d = x->code[%d].pipe->ud;\n", k, k);
+        }
+    }
+    fprintf(fp, "    return SP_OK;\n}\n\n");
+
+    fprintf(fp,
+"int %s_compute(sp_data *sp, %s *x, SPFLOAT *out)\n"
+"{\n"
+"    plumber_data *pd = &x->pd;\n", n, n);
+    /* hoisted expressions are run on the stack too */
+    if(ctrl) fallback = 1;
+    if(fallback) {
+        fprintf(fp,
+"    sporth_stack *stack = &pd->sporth.stack;\n"
+"    int base = stack->pos;\n");
+    }
+    if(max > 0) {
+        fprintf(fp, "    SPFLOAT t");
+        for(i = 0; i < max; i++) fprintf(fp, ", s%d", i);
+        fprintf(fp, ";\n");
+    }
+    fprintf(fp, "\n    (void)pd;\n");
+    if(max > 0) fprintf(fp, "    (void)t;\n");
+    if(fallback) {
+        fprintf(fp,
+"    /* the ugens called through plumber work on the stack */\n"
+"    if(stack->error > 0 || base + pd->pipes->depth > SPORTH_STACK_SIZE) {\n"
+"        return SP_NOT_OK;\n"
+"    }\n"
+"    pd->mode = PLUMBER_COMPUTE;\n");
+    }
+    if(ctrl) fprintf(fp, "    plumbing_control(pd, pd->pipes);\n");
+    fprintf(fp, "\n");
+
+    depth = 0;
+    for(k = 0; k < sc->ninstr; k++) {
+        ip = &sc->code[k];
+        if(ip->op == PLUMBER_OP_FLOAT) {
+            fprintf(fp, "    s%d = ", depth);
+            emit_float(fp, ip->fval);
+            fprintf(fp, "; /* %g */\n", ip->fval);
+            sc->cnst[depth] = 1;
+            sc->val[depth] = ip->fval;
+            depth++;
+            continue;
+        }
+        if(ip->op == PLUMBER_OP_CTRL) {
+            fprintf(fp, "    s%d = ((plumber_ctrl *)x->code[%d].ud)->val;\n",
+                    depth, k);
+            sc->cnst[depth] = 0;
+            depth++;
+            continue;
+        }
+        depth -= ip->nin;
+        fprintf(fp, "    /* %s */\n", ugen_key(ip->pipe->type));
+        emit_ugen(sc, k, depth);
+        for(i = 0; i < ip->nout; i++) sc->cnst[depth + i] = 0;
+        depth += ip->nout;
+    }
+
+    fprintf(fp, "\n");
+    if(fallback) fprintf(fp, "    stack->pos = base;\n");
+    for(i = 0; i < sc->nres; i++) {
+        fprintf(fp, "    out[%d] = s%d;\n", i, sc->nres - 1 - i);
+    }
+    fprintf(fp, "    return SP_OK;\n}\n\n");
+
+    fprintf(fp,
+"int %s_destroy(%s **x)\n"
+"{\n"
+"    plumber_clean(&(*x)->pd);\n"
+"    free(*x);\n"
+"    return SP_OK;\n"
+"}\n", n, n);
+
+    if(nsmp > 0) emit_test(sc, patch, nsmp);
+    return PLUMBER_OK;
+}
+
+int main(int argc, char **argv)
+{
+    sporth2c_d sc;
+    sp_data *sp;
+    plumber_data pd;
+    const char *name = "sporth_patch";
+    const char *outname = NULL;
+    char *src = NULL, *patch, *tmp;
+    int nsmp = 0, err;
+
+    while(argc > 1 && argv[1][0] == '-') {
+        if(argc < 3) break;
+        switch(argv[1][1]) {
+            case 'n': name = argv[2]; break;
+            case 't': nsmp = atoi(argv[2]); break;
+            case 'o': outname = argv[2]; break;
+            case 'e': src = strdup(argv[2]); break;
+            default:
+                fprintf(stderr, "sporth2c: unknown option %s\n", argv[1]);
+                return 1;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+    if(src == NULL && argc > 1) src = read_patch(argv[1]);
+    if(src == NULL) {
+        fprintf(stderr,
+            "usage: sporth2c [-n name] [-t samples] [-o out.c] (file.sp | -e 'patch')\n");
+        return 1;
+    }
+
+    patch = join_tokens(src);
+    tmp = strdup(patch);
+
+    sp_create(&sp);
+    plumber_register(&pd);
+    plumber_init(&pd);
+    pd.sp = sp;
+    err = plumber_parse_string(&pd, tmp);
+    if(err != PLUMBER_OK || pd.sporth.stack.error > 0 || pd.pipes->code == NULL) {
+        fprintf(stderr, "sporth2c: could not parse the patch\n");
+        err = PLUMBER_NOTOK;
+    } else {
+        memset(&sc, 0, sizeof(sc));
+        sc.fp = outname != NULL ? fopen(outname, "w") : stdout;
+        sc.name = name;
+        sc.code = pd.pipes->code;
+        if(sc.fp == NULL) {
+            fprintf(stderr, "sporth2c: could not open %s\n", outname);
+            err = PLUMBER_NOTOK;
+        } else {
+            err = emit(&sc, patch, nsmp);
+            if(sc.fp != stdout) fclose(sc.fp);
+        }
+    }
+
+    plumber_clean(&pd);
+    sp_destroy(&sp);
+    free(tmp);
+    free(patch);
+    free(src);
+    return err == PLUMBER_OK ? 0 : 1;
+}
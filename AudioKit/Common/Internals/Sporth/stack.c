@@ -9,11 +9,11 @@ int sporth_stack_push_float(sporth_stack *stack, float val)
 {
     if(stack->error > 0) return SPORTH_NOTOK;
 
-    if(stack->pos <= SPORTH_STACK_SIZE) {
+    if(stack->pos < SPORTH_STACK_SIZE) {
         //printf("Pushing value %g.\n", val);
+        stack->fval[stack->pos] = val;
         stack->pos++;
-        stack->stack[stack->pos - 1].fval = val;
-        stack->stack[stack->pos - 1].type = SPORTH_FLOAT;
+        if(stack->pos > stack->hi) stack->hi = stack->pos;
         return SPORTH_OK;
     } else {
         fprintf(stderr, "Stack limit of %d reached, cannot push float value.\n", stack->pos);
@@ -27,16 +27,17 @@ int sporth_stack_push_string(sporth_stack *stack, const char *str)
 {
     if(stack->error > 0) return SPORTH_NOTOK;
 
-    sporth_stack_val *pstack;
-    if(stack->pos <= SPORTH_STACK_SIZE) {
+    int pos = stack->pos;
+    if(pos < SPORTH_STACK_SIZE) {
+        strncpy(stack->sval[pos], str, SPORTH_MAXCHAR - 1);
+        stack->sval[pos][SPORTH_MAXCHAR - 1] = '\0';
+        stack->fval[pos] = strlen(stack->sval[pos]);
+        stack->type[pos] = SPORTH_STRING;
         stack->pos++;
-        pstack = &stack->stack[stack->pos - 1];
-        strncpy(pstack->sval, str, SPORTH_MAXCHAR);
-        pstack->fval = strlen(str);
-        pstack->type = SPORTH_STRING;
+        if(stack->pos > stack->hi) stack->hi = stack->pos;
         return SPORTH_OK;
     } else {
-        fprintf(stderr, "Stack limit of %d reached, cannot push float value.\n", stack->pos);
+        fprintf(stderr, "Stack limit of %d reached, cannot push string value.\n", stack->pos);
         stack->error++;
         return SPORTH_NOTOK;
     }
@@ -47,23 +48,21 @@ float sporth_stack_pop_float(sporth_stack *stack)
 {
     if(stack->error > 0) return 0;
 
-    sporth_stack_val *pstack;
-
     if(stack->pos == 0) {
        fprintf(stderr, "Stack is empty.\n");
        stack->error++;
        return SPORTH_NOTOK;
     }
-    pstack = &stack->stack[stack->pos - 1];
 
-    if(pstack->type != SPORTH_FLOAT) {
+    if(stack->type[stack->pos - 1] != SPORTH_FLOAT) {
         fprintf(stderr, "Value is not a float.\n");
         stack->error++;
         return SPORTH_NOTOK;
     }
 
     stack->pos--;
-    return pstack->fval;
+    if(stack->pos < stack->lo) stack->lo = stack->pos;
+    return stack->fval[stack->pos];
 }
 
 char * sporth_stack_pop_string(sporth_stack *stack)
@@ -71,30 +70,36 @@ char * sporth_stack_pop_string(sporth_stack *stack)
     if(stack->error > 0) return NULL;
 
     char *str;
-    sporth_stack_val *pstack;
+    int pos;
 
     if(stack->pos == 0) {
        fprintf(stderr, "Stack is empty.\n");
        stack->error++;
        return NULL;
     }
-    pstack = &stack->stack[stack->pos - 1];
+    pos = stack->pos - 1;
 
-    if(pstack->type != SPORTH_STRING) {
+    if(stack->type[pos] != SPORTH_STRING) {
         fprintf(stderr, "Value is not a string.\n");
         stack->error++;
         return NULL;
     }
 
-    str = malloc(sizeof(char) * (pstack->fval + 1));
-    strcpy(str, pstack->sval);
+    str = malloc(sizeof(char) * (stack->fval[pos] + 1));
+    strcpy(str, stack->sval[pos]);
+    stack->type[pos] = SPORTH_FLOAT;
     stack->pos--;
+    if(stack->pos < stack->lo) stack->lo = stack->pos;
     return str;
 }
 
 int sporth_stack_init(sporth_stack *stack)
 {
+    int i;
     stack->pos = 0;
     stack->error = 0;
+    stack->lo = 0;
+    stack->hi = 0;
+    for(i = 0; i < SPORTH_STACK_SIZE; i++) stack->type[i] = SPORTH_FLOAT;
     return SPORTH_OK;
 }
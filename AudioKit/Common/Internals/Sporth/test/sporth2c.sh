@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# sporth2c test
+#
+# Every patch listed in sporth2c.md5 is turned into C with sporth2c -t, and
+# the generated program renders it both through plumber_compute and through
+# the generated code. The two must match each other and the listed md5.
+#
+# usage: sh Sporth/test/sporth2c.sh    (from Internals/, or anywhere)
+#
+
+D=$(cd "$(dirname "$0")" && pwd)
+R=$(cd "$D/../.." && pwd)
+T=$(mktemp -d)
+trap 'rm -rf "$T"' EXIT
+
+CC=${CC:-cc}
+CFLAGS="-O2 -DNO_LIBSNDFILE -I$R/Soundpipe -I$R/Soundpipe/lib/kissfft \
+-I$R/Soundpipe/lib/inih -I$R/Soundpipe/lib/faust -I$R/Soundpipe/test \
+-I$R/Sporth/h -I$R/Sporth/ugens/poly"
+
+for f in "$R"/Soundpipe/modules/*.c "$R"/Soundpipe/lib/*/*.c \
+        "$R"/Sporth/*.c "$R"/Sporth/ugens/*.c "$R"/Sporth/ugens/poly/*.c \
+        "$R"/Soundpipe/test/test.c "$R"/Soundpipe/test/md5.c; do
+    case $f in
+        */sporth2c.c) continue;;
+    esac
+    $CC $CFLAGS -w -c "$f" -o "$T/$(basename "$(dirname "$f")")_$(basename "$f").o" \
+        || exit 1
+done
+ar rcs "$T/libsporth.a" "$T"/*.o || exit 1
+$CC $CFLAGS "$R/Sporth/sporth2c.c" "$T/libsporth.a" -lm -lpthread \
+    -o "$T/sporth2c" || exit 1
+
+fail=0
+n=0
+while read -r hash patch; do
+    n=$((n + 1))
+    out=$("$T/sporth2c" -t 44100 -o "$T/gen.c" "$D/$patch" &&
+        $CC $CFLAGS -w "$T/gen.c" "$T/libsporth.a" -lm -lpthread -o "$T/gen" &&
+        "$T/gen" 2>/dev/null)
+    if [ "$out" = "ok $hash" ]; then
+        echo "ok $n - $patch"
+    else
+        echo "not ok $n - $patch: $out"
+        fail=1
+    fi
+done < "$D/sporth2c.md5"
+echo "1..$n"
+exit $fail
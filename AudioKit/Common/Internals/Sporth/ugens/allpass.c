@@ -42,13 +42,13 @@ int sporth_allpass(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            looptime = sporth_stack_pop_float(stack);
-            revtime = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            looptime = sporth_stack_pop_fast(stack);
+            revtime = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             allpass = pd->last->ud;
             allpass->revtime = revtime;
             sp_allpass_compute(pd->sp, allpass, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             allpass = pd->last->ud;
@@ -38,12 +38,12 @@ int sporth_atone(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            hp = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            hp = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             atone = pd->last->ud;
             atone->hp = hp;
             sp_atone_compute(pd->sp, atone, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             atone = pd->last->ud;
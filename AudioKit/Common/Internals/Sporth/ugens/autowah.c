@@ -44,16 +44,16 @@ int sporth_autowah(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            mix = sporth_stack_pop_float(stack);
-            wah = sporth_stack_pop_float(stack);
-            level = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            mix = sporth_stack_pop_fast(stack);
+            wah = sporth_stack_pop_fast(stack);
+            level = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             autowah = pd->last->ud;
             *autowah->level = level;
             *autowah->wah = wah;
             *autowah->mix = mix;
             sp_autowah_compute(pd->sp, autowah, &input, &output);
-            sporth_stack_push_float(stack, output);
+            sporth_stack_push_fast(stack, output);
             break;
         case PLUMBER_DESTROY:
             autowah = pd->last->ud;
@@ -39,16 +39,11 @@ int sporth_bal(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "ff") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for bal\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            sig = sporth_stack_pop_float(stack);
-            comp = sporth_stack_pop_float(stack);
+            sig = sporth_stack_pop_fast(stack);
+            comp = sporth_stack_pop_fast(stack);
             bal = pd->last->ud;
             sp_bal_compute(pd->sp, bal, &sig, &comp, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             bal = pd->last->ud;
@@ -36,10 +36,10 @@ int sporth_mix(sporth_stack *stack, void *ud)
             count = stack->pos;
             if(count > 1) {
                 for(n = 1; n <= count; n++){
-                    val = sporth_stack_pop_float(stack);
+                    val = sporth_stack_pop_fast(stack);
                     sum += val;
                 }
-                sporth_stack_push_float(stack, sum);
+                sporth_stack_push_fast(stack, sum);
             }
 
             break;
@@ -64,7 +64,7 @@ int sporth_drop(sporth_stack *stack, void *ud)
             sporth_stack_pop_float(stack);
             break;
         case PLUMBER_COMPUTE:
-            sporth_stack_pop_float(stack);
+            sporth_stack_pop_fast(stack);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -75,6 +75,11 @@ int sporth_drop(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_drop_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    return PLUMBER_OK;
+}
+
 int sporth_rot(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -106,13 +111,13 @@ int sporth_rot(sporth_stack *stack, void *ud)
 
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            v3 = sporth_stack_pop_float(stack);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            v3 = sporth_stack_pop_fast(stack);
 
-            sporth_stack_push_float(stack, v2);
-            sporth_stack_push_float(stack, v1);
-            sporth_stack_push_float(stack, v3);
+            sporth_stack_push_fast(stack, v2);
+            sporth_stack_push_fast(stack, v1);
+            sporth_stack_push_fast(stack, v3);
 
             break;
         case PLUMBER_DESTROY:
@@ -124,6 +129,15 @@ int sporth_rot(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_rot_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    plumber_vec tmp = v[0];
+    v[0] = v[1];
+    v[1] = v[2];
+    v[2] = tmp;
+    return PLUMBER_OK;
+}
+
 int sporth_dup(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -141,14 +155,9 @@ int sporth_dup(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, val);
             break;
         case PLUMBER_COMPUTE:
-            if(stack->pos == 0) {
-               fprintf(stderr,"Nothing to duplicate\n");
-            } else {
-
-                val = sporth_stack_pop_float(stack);
-                sporth_stack_push_float(stack, val);
-                sporth_stack_push_float(stack, val);
-            }
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, val);
+            sporth_stack_push_fast(stack, val);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -159,6 +168,13 @@ int sporth_dup(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_dup_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    v[1].cnst = v[0].cnst;
+    memcpy(v[1].buf, v[0].buf, sizeof(SPFLOAT) * (v[0].cnst ? 1 : n));
+    return PLUMBER_OK;
+}
+
 int sporth_swap(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -178,10 +194,10 @@ int sporth_swap(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1);
-            sporth_stack_push_float(stack, v2);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, v1);
+            sporth_stack_push_fast(stack, v2);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -192,6 +208,14 @@ int sporth_swap(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_swap_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    plumber_vec tmp = v[0];
+    v[0] = v[1];
+    v[1] = tmp;
+    return PLUMBER_OK;
+}
+
 int sporth_constant(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -247,7 +271,7 @@ int sporth_sine(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
            fprintf(stderr,"creating sine function... \n");
 #endif
-            data = malloc(sizeof(sporth_sine_d));
+            data = sp_malloc(sizeof(sporth_sine_d));
             sp_osc_create(&data->osc);
             sp_ftbl_create(pd->sp, &data->ft, 4096);
             plumber_add_ugen(pd, SPORTH_SINE, data);
@@ -269,16 +293,13 @@ int sporth_sine(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "ff") != SPORTH_OK) {
-                return SPORTH_NOTOK;
-            }
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
             data = pd->last->ud;
             data->osc->freq = freq;
             data->osc->amp = amp;
             sp_osc_compute(pd->sp, data->osc, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
 #ifdef DEBUG_MODE
@@ -288,7 +309,7 @@ int sporth_sine(sporth_stack *stack, void *ud)
             data = pipe->ud;
             sp_ftbl_destroy(&data->ft);
             sp_osc_destroy(&data->osc);
-            free(data);
+            sp_free(data);
             break;
         default:
           fprintf(stderr,"Error: Unknown mode!");
@@ -297,6 +318,39 @@ int sporth_sine(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_sine_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sporth_sine_d *data = ud;
+    if(!v[0].cnst || !v[1].cnst) return PLUMBER_NOTOK;
+    data->osc->freq = v[0].buf[0];
+    data->osc->amp = v[1].buf[0];
+    sp_osc_compute_block(pd->sp, data->osc, NULL, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
+
+/* block mode arguments of the two input math ugens. The result is written
+ * over an argument that is not constant, so a constant one can be read the
+ * whole way through; if both are constant, so is the result. Returns how
+ * many values to work out. */
+static uint32_t math_block_args(plumber_vec *v, uint32_t n,
+        const SPFLOAT **a, uint32_t *sa, const SPFLOAT **b, uint32_t *sb)
+{
+    SPFLOAT *tmp;
+    *a = v[0].buf;
+    *b = v[1].buf;
+    *sa = v[0].cnst ? 0 : 1;
+    *sb = v[1].cnst ? 0 : 1;
+    if(v[0].cnst && v[1].cnst) return 1;
+    if(v[0].cnst) {
+        tmp = v[0].buf;
+        v[0].buf = v[1].buf;
+        v[1].buf = tmp;
+        v[0].cnst = 0;
+    }
+    return n;
+}
+
 int sporth_add(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -320,9 +374,9 @@ int sporth_add(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 + v2);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 + v2);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, v1 + v2);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -335,6 +389,15 @@ int sporth_add(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_add_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    const SPFLOAT *a, *b;
+    uint32_t i, sa, sb;
+    n = math_block_args(v, n, &a, &sa, &b, &sb);
+    for(i = 0; i < n; i++) v[0].buf[i] = b[i * sb] + a[i * sa];
+    return PLUMBER_OK;
+}
+
 int sporth_mul(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -358,12 +421,9 @@ int sporth_mul(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v1 * v2);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "ff") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT) v1 * v2);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT) v1 * v2);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -376,6 +436,15 @@ int sporth_mul(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_mul_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    const SPFLOAT *a, *b;
+    uint32_t i, sa, sb;
+    n = math_block_args(v, n, &a, &sa, &b, &sb);
+    for(i = 0; i < n; i++) v[0].buf[i] = b[i * sb] * a[i * sa];
+    return PLUMBER_OK;
+}
+
 int sporth_sub(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -399,9 +468,9 @@ int sporth_sub(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v2 - v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v2 - v1);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, v2 - v1);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -414,6 +483,15 @@ int sporth_sub(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_sub_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    const SPFLOAT *a, *b;
+    uint32_t i, sa, sb;
+    n = math_block_args(v, n, &a, &sa, &b, &sb);
+    for(i = 0; i < n; i++) v[0].buf[i] = a[i * sa] - b[i * sb];
+    return PLUMBER_OK;
+}
+
 int sporth_divide(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -437,9 +515,9 @@ int sporth_divide(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 / v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT) v2 / v1);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT) v2 / v1);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -452,6 +530,15 @@ int sporth_divide(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_divide_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    const SPFLOAT *a, *b;
+    uint32_t i, sa, sb;
+    n = math_block_args(v, n, &a, &sa, &b, &sb);
+    for(i = 0; i < n; i++) v[0].buf[i] = a[i * sa] / b[i * sb];
+    return PLUMBER_OK;
+}
+
 int sporth_max(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -475,9 +562,9 @@ int sporth_max(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 > v1 ? v2 : v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)  v2 > v1 ? v2 : v1);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)  v2 > v1 ? v2 : v1);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -511,9 +598,9 @@ int sporth_min(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 > v1 ? v1 : v2);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)  v2 > v1 ? v1 : v2);
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)  v2 > v1 ? v1 : v2);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -547,8 +634,8 @@ int sporth_abs(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)fabsf(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)fabsf(val));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)fabsf(val));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -582,8 +669,8 @@ int sporth_floor(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)floorf(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)floorf(val));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)floorf(val));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -617,11 +704,8 @@ int sporth_frac(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)(val - floorf(val)));
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)(val - floorf(val)));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)(val - floorf(val)));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -655,8 +739,8 @@ int sporth_log(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)log(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)logf(val));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)logf(val));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -690,8 +774,8 @@ int sporth_log10(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)log10f(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)log10f(val));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)log10f(val));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -726,8 +810,8 @@ int sporth_round(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)roundf(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)roundf(val));
+            val = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (SPFLOAT)roundf(val));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -761,11 +845,8 @@ int sporth_mtof(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, sp_midi2cps(nn));
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            nn = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, sp_midi2cps(nn));
+            nn = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, sp_midi2cps(nn));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -778,6 +859,14 @@ int sporth_mtof(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+int sporth_mtof_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    uint32_t i;
+    if(v[0].cnst) n = 1;
+    for(i = 0; i < n; i++) v[0].buf[i] = sp_midi2cps(v[0].buf[i]);
+    return PLUMBER_OK;
+}
+
 int sporth_eq(sporth_stack *stack, void *ud)
 {
     if(stack->error > 0) return PLUMBER_NOTOK;
@@ -808,9 +897,9 @@ int sporth_eq(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 == v1 ? 1 : 0));
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (v2 == v1 ? 1 : 0));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -853,9 +942,9 @@ int sporth_lt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 < v1 ? 1 : 0));
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (v2 < v1 ? 1 : 0));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -898,9 +987,9 @@ int sporth_gt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 > v1 ? 1 : 0));
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (v2 > v1 ? 1 : 0));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -943,9 +1032,9 @@ int sporth_ne(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 != v1 ? 1 : 0));
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (v2 != v1 ? 1 : 0));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -990,10 +1079,10 @@ int sporth_branch(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            cond = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (cond != 0 ? v2 : v1));
+            v1 = sporth_stack_pop_fast(stack);
+            v2 = sporth_stack_pop_fast(stack);
+            cond = sporth_stack_pop_fast(stack);
+            sporth_stack_push_fast(stack, (cond != 0 ? v2 : v1));
             break;
         case PLUMBER_DESTROY:
             break;
@@ -1016,6 +1105,7 @@ int sporth_pos(sporth_stack *stack, void *ud)
             fprintf(stderr, "pos: Creating\n");
 #endif
             plumber_add_ugen(pd, SPORTH_POS, NULL);
+            sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_INIT:
 #ifdef DEBUG_MODE
@@ -1024,7 +1114,7 @@ int sporth_pos(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            sporth_stack_push_float(stack, (SPFLOAT) pd->sp->pos / pd->sp->sr);
+            sporth_stack_push_fast(stack, (SPFLOAT) pd->sp->pos / pd->sp->sr);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -1048,8 +1138,9 @@ int sporth_dur(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "dur: Creating\n");
 #endif
-            dur = malloc(sizeof(SPFLOAT));
+            dur = sp_malloc(sizeof(SPFLOAT));
             plumber_add_ugen(pd, SPORTH_DUR, dur);
+            sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_INIT:
 #ifdef DEBUG_MODE
@@ -1061,11 +1152,11 @@ int sporth_dur(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             dur = pd->last->ud;
-            sporth_stack_push_float(stack, *dur);
+            sporth_stack_push_fast(stack, *dur);
             break;
         case PLUMBER_DESTROY:
             dur = pd->last->ud;
-            free(dur);
+            sp_free(dur);
             break;
         default:
             fprintf(stderr,"pos: unknown mode!");
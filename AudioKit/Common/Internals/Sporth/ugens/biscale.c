@@ -41,14 +41,14 @@ int sporth_biscale(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            max = sporth_stack_pop_float(stack);
-            min = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            max = sporth_stack_pop_fast(stack);
+            min = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             biscale = pd->last->ud;
             biscale->min = min;
             biscale->max = max;
             sp_biscale_compute(pd->sp, biscale, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             biscale = pd->last->ud;
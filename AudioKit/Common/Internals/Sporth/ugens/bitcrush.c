@@ -41,14 +41,14 @@ int sporth_bitcrush(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            srate = sporth_stack_pop_float(stack);
-            bitdepth = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            srate = sporth_stack_pop_fast(stack);
+            bitdepth = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             bitcrush = pd->last->ud;
             bitcrush->bitdepth = bitdepth;
             bitcrush->srate = srate;
             sp_bitcrush_compute(pd->sp, bitcrush, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             bitcrush = pd->last->ud;
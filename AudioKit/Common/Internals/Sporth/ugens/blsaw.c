@@ -38,13 +38,13 @@ int sporth_blsaw(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
             blsaw = pd->last->ud;
             *blsaw->freq = freq;
             *blsaw->amp = amp;
             sp_blsaw_compute(pd->sp, blsaw, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             blsaw = pd->last->ud;
@@ -42,20 +42,15 @@ int sporth_blsquare(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for blsquare\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            width = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            width = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
             blsquare = pd->last->ud;
             *blsquare->freq = freq;
             *blsquare->amp = amp;
             *blsquare->width = width;
             sp_blsquare_compute(pd->sp, blsquare, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             blsquare = pd->last->ud;
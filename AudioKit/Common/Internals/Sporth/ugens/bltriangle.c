@@ -38,13 +38,13 @@ int sporth_bltriangle(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
             bltriangle = pd->last->ud;
             *bltriangle->freq = freq;
             *bltriangle->amp = amp;
             sp_bltriangle_compute(pd->sp, bltriangle, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             bltriangle = pd->last->ud;
@@ -38,12 +38,12 @@ int sporth_butlp(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            freq = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            freq = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             butlp = pd->last->ud;
             butlp->freq = freq;
             sp_butlp_compute(pd->sp, butlp, &input, &output);
-            sporth_stack_push_float(stack, output);
+            sporth_stack_push_fast(stack, output);
             break;
         case PLUMBER_DESTROY:
             butlp = pd->last->ud;
@@ -55,3 +55,14 @@ int sporth_butlp(sporth_stack *stack, void *ud)
     }
     return PLUMBER_OK;
 }
+
+int sporth_butlp_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sp_butlp *butlp = ud;
+    if(!v[1].cnst) return PLUMBER_NOTOK;
+    butlp->freq = v[1].buf[0];
+    plumber_vec_fill(&v[0], n);
+    sp_butlp_compute_block(pd->sp, butlp, v[0].buf, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
@@ -38,12 +38,12 @@ int sporth_clip(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            lim = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            lim = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             clip = pd->last->ud;
             clip->lim = lim;
             sp_clip_compute(pd->sp, clip, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             clip = pd->last->ud;
@@ -54,11 +54,11 @@ int sporth_conv(sporth_stack *stack, void *ud)
             free(ftname);
             break;
         case PLUMBER_COMPUTE:
-            sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             conv = pd->last->ud;
             sp_conv_compute(pd->sp, conv, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             conv = pd->last->ud;
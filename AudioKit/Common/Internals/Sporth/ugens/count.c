@@ -41,14 +41,14 @@ int sporth_count(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            mode = sporth_stack_pop_float(stack);
-            count = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            mode = sporth_stack_pop_fast(stack);
+            count = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             cnt = pd->last->ud;
             cnt->count = count;
             cnt->mode = mode;
             sp_count_compute(pd->sp, cnt, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             cnt = pd->last->ud;
@@ -30,9 +30,9 @@ int sporth_dcblock(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             data = pd->last->ud;
-            in = sporth_stack_pop_float(stack);
+            in = sporth_stack_pop_fast(stack);
             sp_dcblock_compute(pd->sp, data, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             data = pd->last->ud;
@@ -42,13 +42,13 @@ int sporth_delay(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            time = sporth_stack_pop_float(stack);
-            feedback = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            time = sporth_stack_pop_fast(stack);
+            feedback = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             delay = pd->last->ud;
             delay->feedback = feedback;
             sp_delay_compute(pd->sp, delay, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             delay = pd->last->ud;
@@ -47,18 +47,18 @@ int sporth_dist(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            shape2 = sporth_stack_pop_float(stack);
-            shape1 = sporth_stack_pop_float(stack);
-            postgain = sporth_stack_pop_float(stack);
-            pregain = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            shape2 = sporth_stack_pop_fast(stack);
+            shape1 = sporth_stack_pop_fast(stack);
+            postgain = sporth_stack_pop_fast(stack);
+            pregain = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             dist = pd->last->ud;
             dist->pregain = pregain;
             dist->postgain = postgain;
             dist->shape1 = shape1;
             dist->shape2 = shape2;
             sp_dist_compute(pd->sp, dist, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             dist = pd->last->ud;
@@ -36,16 +36,11 @@ int sporth_dmetro(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for dmetro\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            time = sporth_stack_pop_float(stack);
+            time = sporth_stack_pop_fast(stack);
             dmetro = pd->last->ud;
             dmetro->time = time;
             sp_dmetro_compute(pd->sp, dmetro, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             dmetro = pd->last->ud;
@@ -41,16 +41,16 @@ int sporth_expon(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            b = sporth_stack_pop_float(stack);
-            dur = sporth_stack_pop_float(stack);
-            a = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            b = sporth_stack_pop_fast(stack);
+            dur = sporth_stack_pop_fast(stack);
+            a = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             expon = pd->last->ud;
             expon->a = a;
             expon->dur = dur;
             expon->b = b;
             sp_expon_compute(pd->sp, expon, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             expon = pd->last->ud;
@@ -12,7 +12,7 @@ int sporth_f(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "aux (f)unction: creating\n");
 #endif
-            fd = malloc(sizeof(sporth_func_d));
+            fd = sp_malloc(sizeof(sporth_func_d));
             plumber_add_ugen(pd, SPORTH_F, fd);
            if(sporth_check_args(stack, "f") != SPORTH_OK) {
                 fprintf(stderr,"Not enough arguments for aux (f)unction\n");
@@ -48,7 +48,7 @@ int sporth_f(sporth_stack *stack, void *ud)
             break;
 
         case PLUMBER_COMPUTE:
-            fnum = (int)sporth_stack_pop_float(stack);
+            fnum = (int)sporth_stack_pop_fast(stack);
             fd = pd->last->ud;
             fd->fun(stack, ud);
             break;
@@ -56,7 +56,7 @@ int sporth_f(sporth_stack *stack, void *ud)
         case PLUMBER_DESTROY:
             fd = pd->last->ud;
             fd->fun(stack, ud);
-            free(fd);
+            sp_free(fd);
             break;
         default:
             fprintf(stderr, "aux (f)unction: unknown mode!\n");
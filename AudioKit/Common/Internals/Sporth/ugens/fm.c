@@ -21,7 +21,7 @@ int sporth_fm(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
            fprintf(stderr,"creating FM function... \n");
 #endif
-            fm = malloc(sizeof(sporth_fm_d));
+            fm = sp_malloc(sizeof(sporth_fm_d));
             sp_ftbl_create(pd->sp, &fm->ft, 4096);
             sp_fosc_create(&fm->osc);
             plumber_add_ugen(pd, SPORTH_FM, fm);
@@ -53,16 +53,12 @@ int sporth_fm(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             fm = pd->last->ud;
-            if(sporth_check_args(stack, "fffff") != SPORTH_OK) {
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
 
-            index = sporth_stack_pop_float(stack);
-            mod = sporth_stack_pop_float(stack);
-            car = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            index = sporth_stack_pop_fast(stack);
+            mod = sporth_stack_pop_fast(stack);
+            car = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
 
             fm->osc->freq = freq;
             fm->osc->amp = amp;
@@ -71,13 +67,13 @@ int sporth_fm(sporth_stack *stack, void *ud)
             fm->osc->indx = index;
 
             sp_fosc_compute(pd->sp, fm->osc, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             fm = pd->last->ud;
             sp_fosc_destroy(&fm->osc);
             sp_ftbl_destroy(&fm->ft);
-            free(fm);
+            sp_free(fm);
             break;
         default:
            fprintf(stderr,"Error: Unknown mode!");
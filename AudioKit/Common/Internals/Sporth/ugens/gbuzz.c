@@ -24,7 +24,7 @@ int sporth_gbuzz(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "gbuzz: Creating\n");
 #endif
-            gbuzz = malloc(sizeof(sporth_gbuzz_d));
+            gbuzz = sp_malloc(sizeof(sporth_gbuzz_d));
             sp_ftbl_create(pd->sp, &gbuzz->ft, 4096);
             sp_gbuzz_create(&gbuzz->gbuzz);
             plumber_add_ugen(pd, SPORTH_GBUZZ, gbuzz);
@@ -58,11 +58,11 @@ int sporth_gbuzz(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            mul = sporth_stack_pop_float(stack);
-            lharm = sporth_stack_pop_float(stack);
-            nharm = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            mul = sporth_stack_pop_fast(stack);
+            lharm = sporth_stack_pop_fast(stack);
+            nharm = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
 
             gbuzz = pd->last->ud;
 
@@ -73,13 +73,13 @@ int sporth_gbuzz(sporth_stack *stack, void *ud)
             gbuzz->gbuzz->mul = mul;
             SPFLOAT dumb = 0;
             sp_gbuzz_compute(pd->sp, gbuzz->gbuzz, &dumb, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             gbuzz = pd->last->ud;
             sp_gbuzz_destroy(&gbuzz->gbuzz);
             sp_ftbl_destroy(&gbuzz->ft);
-            free(gbuzz);
+            sp_free(gbuzz);
             break;
         default:
             fprintf(stderr, "gbuzz: Uknown mode!\n");
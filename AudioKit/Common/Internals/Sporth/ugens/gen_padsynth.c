@@ -56,9 +56,9 @@ int sporth_gen_padsynth(sporth_stack *stack, void *ud)
             break;
 
         case PLUMBER_COMPUTE:
-            sporth_stack_pop_float(stack);
-            sporth_stack_pop_float(stack);
-            sporth_stack_pop_float(stack);
+            sporth_stack_pop_fast(stack);
+            sporth_stack_pop_fast(stack);
+            sporth_stack_pop_fast(stack);
             break;
 
         case PLUMBER_DESTROY:
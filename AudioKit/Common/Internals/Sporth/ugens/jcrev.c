@@ -35,10 +35,10 @@ int sporth_jcrev(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            input = sporth_stack_pop_float(stack);
+            input = sporth_stack_pop_fast(stack);
             jcrev = pd->last->ud;
             sp_jcrev_compute(pd->sp, jcrev, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             jcrev = pd->last->ud;
@@ -41,20 +41,15 @@ int sporth_jitter(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for jitter\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            cpsMax = sporth_stack_pop_float(stack);
-            cpsMin = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
+            cpsMax = sporth_stack_pop_fast(stack);
+            cpsMin = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
             jitter = pd->last->ud;
             jitter->amp = amp;
             jitter->cpsMin = cpsMin;
             jitter->cpsMax = cpsMax;
             sp_jitter_compute(pd->sp, jitter, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             jitter = pd->last->ud;
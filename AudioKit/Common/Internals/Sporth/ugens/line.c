@@ -41,16 +41,16 @@ int sporth_line(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            b = sporth_stack_pop_float(stack);
-            dur = sporth_stack_pop_float(stack);
-            a = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            b = sporth_stack_pop_fast(stack);
+            dur = sporth_stack_pop_fast(stack);
+            a = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             line = pd->last->ud;
             line->a = a;
             line->dur = dur;
             line->b = b;
             sp_line_compute(pd->sp, line, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             line = pd->last->ud;
@@ -41,12 +41,12 @@ int sporth_maytrig(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            prob = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            prob = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             maygate = pd->last->ud;
             maygate->prob = prob;
             sp_maygate_compute(pd->sp, maygate, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             maygate = pd->last->ud;
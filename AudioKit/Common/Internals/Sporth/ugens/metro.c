@@ -25,11 +25,11 @@ int sporth_metro(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            freq = sporth_stack_pop_float(stack);
+            freq = sporth_stack_pop_fast(stack);
             data = pd->last->ud;
             data->freq = freq;
             sp_metro_compute(pd->sp, data, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             data = pd->last->ud;
@@ -41,3 +41,13 @@ int sporth_metro(sporth_stack *stack, void *ud)
     }
     return PLUMBER_OK;
 }
+
+int sporth_metro_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sp_metro *data = ud;
+    if(!v[0].cnst) return PLUMBER_NOTOK;
+    data->freq = v[0].buf[0];
+    sp_metro_compute_block(pd->sp, data, NULL, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
@@ -54,19 +54,19 @@ int sporth_mincer(sporth_stack *stack, void *ud)
             }
 
             free(ftname);
-            sp_mincer_init(pd->sp, mincer, ft);
+            sp_mincer_init(pd->sp, mincer, ft, 2048, 4);
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            pitch = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            time = sporth_stack_pop_float(stack);
+            pitch = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            time = sporth_stack_pop_fast(stack);
             mincer = pd->last->ud;
             mincer->time = time;
             mincer->amp = amp;
             mincer->pitch = pitch;
             sp_mincer_compute(pd->sp, mincer, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             free(ftname);
             break;
         case PLUMBER_DESTROY:
@@ -42,14 +42,14 @@ int sporth_mode(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            q = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            q = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             mode = pd->last->ud;
             mode->freq = freq;
             mode->q = q;
             sp_mode_compute(pd->sp, mode, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             mode = pd->last->ud;
@@ -41,14 +41,14 @@ int sporth_moogladder(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            res = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            res = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             moogladder = pd->last->ud;
             moogladder->freq = freq;
             moogladder->res = res;
             sp_moogladder_compute(pd->sp, moogladder, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             moogladder = pd->last->ud;
@@ -60,3 +60,15 @@ int sporth_moogladder(sporth_stack *stack, void *ud)
     }
     return PLUMBER_OK;
 }
+
+int sporth_moogladder_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sp_moogladder *moogladder = ud;
+    if(!(v[1].cnst && v[2].cnst)) return PLUMBER_NOTOK;
+    moogladder->freq = v[1].buf[0];
+    moogladder->res = v[2].buf[0];
+    plumber_vec_fill(&v[0], n);
+    sp_moogladder_compute_block(pd->sp, moogladder, v[0].buf, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
@@ -29,11 +29,11 @@ int sporth_noise(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            amp = sporth_stack_pop_float(stack);
+            amp = sporth_stack_pop_fast(stack);
             data = pd->last->ud;
             data->amp = amp;
             sp_noise_compute(pd->sp, data, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             data = pd->last->ud;
@@ -59,15 +59,15 @@ int sporth_osc(sporth_stack *stack, void *ud)
         case PLUMBER_COMPUTE:
             osc = pd->last->ud;
 
-            phs = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            phs = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
 
             osc->amp = amp;
             osc->freq = freq;
 
             sp_osc_compute(pd->sp, osc, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             osc = pd->last->ud;
@@ -81,3 +81,14 @@ int sporth_osc(sporth_stack *stack, void *ud)
     }
     return PLUMBER_OK;
 }
+
+int sporth_osc_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sp_osc *osc = ud;
+    if(!(v[0].cnst && v[1].cnst)) return PLUMBER_NOTOK;
+    osc->freq = v[0].buf[0];
+    osc->amp = v[1].buf[0];
+    sp_osc_compute_block(pd->sp, osc, NULL, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
@@ -67,11 +67,11 @@ int sporth_oscmorph4(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "oscmorph: Creating\n");
 #endif
-            oscmorph = malloc(sizeof(sporth_oscmorph));
+            oscmorph = sp_malloc(sizeof(sporth_oscmorph));
             sp_oscmorph_create(&oscmorph->data);
             oscmorph->nft = 4;
-            oscmorph->ft = malloc(sizeof(sp_ftbl *) * 4);
-            oscmorph->ftname = malloc(sizeof(char *) * 4);
+            oscmorph->ft = sp_malloc(sizeof(sp_ftbl *) * 4);
+            oscmorph->ftname = sp_malloc(sizeof(char *) * 4);
             plumber_add_ugen(pd, SPORTH_OSCMORPH4, oscmorph);
 
             if(sporth_check_args(stack, "ffffssss") != SPORTH_OK) {
@@ -114,14 +114,14 @@ int sporth_oscmorph4(sporth_stack *stack, void *ud)
             set_args(oscmorph);
 
             sp_oscmorph_compute(pd->sp, oscmorph->data, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             oscmorph = pd->last->ud;
-            free(oscmorph->ftname);
-            free(oscmorph->ft);
+            sp_free(oscmorph->ftname);
+            sp_free(oscmorph->ft);
             sp_oscmorph_destroy(&oscmorph->data);
-            free(oscmorph);
+            sp_free(oscmorph);
             break;
         default:
             fprintf(stderr, "oscmorph: Uknown mode!\n");
@@ -143,11 +143,11 @@ int sporth_oscmorph2(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "oscmorph2: Creating\n");
 #endif
-            oscmorph = malloc(sizeof(sporth_oscmorph));
+            oscmorph = sp_malloc(sizeof(sporth_oscmorph));
             sp_oscmorph_create(&oscmorph->data);
             oscmorph->nft = 2;
-            oscmorph->ft = malloc(sizeof(sp_ftbl *) * 2);
-            oscmorph->ftname = malloc(sizeof(char *) * 2);
+            oscmorph->ft = sp_malloc(sizeof(sp_ftbl *) * 2);
+            oscmorph->ftname = sp_malloc(sizeof(char *) * 2);
             plumber_add_ugen(pd, SPORTH_OSCMORPH2, oscmorph);
 
             if(sporth_check_args(stack, "ffffss") != SPORTH_OK) {
@@ -190,14 +190,14 @@ int sporth_oscmorph2(sporth_stack *stack, void *ud)
             set_args(oscmorph);
 
             sp_oscmorph_compute(pd->sp, oscmorph->data, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             oscmorph = pd->last->ud;
-            free(oscmorph->ftname);
-            free(oscmorph->ft);
+            sp_free(oscmorph->ftname);
+            sp_free(oscmorph->ft);
             sp_oscmorph_destroy(&oscmorph->data);
-            free(oscmorph);
+            sp_free(oscmorph);
             break;
         default:
             fprintf(stderr, "oscmorph2: Uknown mode!\n");
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "plumber.h"
 
 int sporth_p(sporth_stack *stack, void *ud)
@@ -23,13 +24,20 @@ int sporth_p(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_INIT:
-        case PLUMBER_COMPUTE:
             n = (int)sporth_stack_pop_float(stack);
             if(n < 16)
                 sporth_stack_push_float(stack, pd->p[n]);
             else
                 sporth_stack_push_float(stack, 0);
 
+            break;
+        case PLUMBER_COMPUTE:
+            n = (int)sporth_stack_pop_fast(stack);
+            if(n < 16)
+                sporth_stack_push_fast(stack, pd->p[n]);
+            else
+                sporth_stack_push_fast(stack, 0);
+
             break;
         case PLUMBER_DESTROY:
             break;
@@ -40,6 +48,24 @@ int sporth_p(sporth_stack *stack, void *ud)
     return PLUMBER_OK;
 }
 
+/* p registers the host sets every sample come in through pd->pin */
+int sporth_p_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    int idx;
+    if(!v[0].cnst) return PLUMBER_NOTOK;
+    idx = (int)v[0].buf[0];
+    if(idx < 0) return PLUMBER_NOTOK;
+    if(idx < pd->npin) {
+        memcpy(v[0].buf, pd->pin[idx], sizeof(SPFLOAT) * n);
+        v[0].cnst = 0;
+    } else if(idx < 16) {
+        v[0].buf[0] = pd->p[idx];
+    } else {
+        v[0].buf[0] = 0;
+    }
+    return PLUMBER_OK;
+}
+
 int sporth_pset(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -63,11 +89,16 @@ int sporth_pset(sporth_stack *stack, void *ud)
             sporth_stack_pop_float(stack);
             break;
         case PLUMBER_INIT:
-        case PLUMBER_COMPUTE:
             n = (int)sporth_stack_pop_float(stack);
             val = sporth_stack_pop_float(stack);
             if(n < 16) pd->p[n] = val;
 
+            break;
+        case PLUMBER_COMPUTE:
+            n = (int)sporth_stack_pop_fast(stack);
+            val = sporth_stack_pop_fast(stack);
+            if(n < 16) pd->p[n] = val;
+
             break;
         case PLUMBER_DESTROY:
             break;
@@ -41,13 +41,13 @@ int sporth_pan2(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            pan = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            pan = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             pan2 = pd->last->ud;
             pan2->pan = pan;
             sp_pan2_compute(pd->sp, pan2, &in, &out_left, &out_right);
-            sporth_stack_push_float(stack, out_left);
-            sporth_stack_push_float(stack, out_right);
+            sporth_stack_push_fast(stack, out_left);
+            sporth_stack_push_fast(stack, out_right);
             break;
         case PLUMBER_DESTROY:
             pan2 = pd->last->ud;
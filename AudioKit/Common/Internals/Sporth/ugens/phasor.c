@@ -38,12 +38,12 @@ int sporth_phasor(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            iphs = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
+            iphs = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
             phasor = pd->last->ud;
             phasor->freq = freq;
             sp_phasor_compute(pd->sp, phasor, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             phasor = pd->last->ud;
@@ -55,3 +55,13 @@ int sporth_phasor(sporth_stack *stack, void *ud)
     }
     return PLUMBER_OK;
 }
+
+int sporth_phasor_block(plumber_data *pd, void *ud, plumber_vec *v, uint32_t n)
+{
+    sp_phasor *phasor = ud;
+    if(!v[0].cnst) return PLUMBER_NOTOK;
+    phasor->freq = v[0].buf[0];
+    sp_phasor_compute_block(pd->sp, phasor, NULL, v[0].buf, n);
+    v[0].cnst = 0;
+    return PLUMBER_OK;
+}
@@ -36,11 +36,11 @@ int sporth_pinknoise(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            amp = sporth_stack_pop_float(stack);
+            amp = sporth_stack_pop_fast(stack);
             pinknoise = pd->last->ud;
             *pinknoise->amp = amp;
             sp_pinknoise_compute(pd->sp, pinknoise, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             pinknoise = pd->last->ud;
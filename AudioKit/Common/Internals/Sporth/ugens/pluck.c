@@ -61,16 +61,16 @@ int sporth_pluck(sporth_stack *stack, void *ud)
         case PLUMBER_COMPUTE:
             pluck = pd->last->ud;
 
-            ifreq = sporth_stack_pop_float(stack);
-            amp = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            ifreq = sporth_stack_pop_fast(stack);
+            amp = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
 
             pluck->freq = freq;
             pluck->amp = amp;
 
             sp_pluck_compute(pd->sp, pluck, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             pluck = pd->last->ud;
@@ -30,7 +30,7 @@ int sporth_poly(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "poly: Creating\n");
 #endif
-            poly = malloc(sizeof(sporth_poly_d));
+            poly = sp_malloc(sizeof(sporth_poly_d));
             plumber_add_ugen(pd, SPORTH_POLY, poly);
             if(sporth_check_args(stack, "ffss") != SPORTH_OK) {
                 fprintf(stderr,"Invalid arguments for poly\n");
@@ -43,7 +43,7 @@ int sporth_poly(sporth_stack *stack, void *ud)
             poly->max_params = (uint32_t)sporth_stack_pop_float(stack);
             poly->max_voices = (uint32_t)sporth_stack_pop_float(stack);
 
-            poly->dur = malloc(sizeof(uint32_t) * poly->max_voices);
+            poly->dur = sp_malloc(sizeof(uint32_t) * poly->max_voices);
 
             poly_init(&poly->poly);
             if(poly_binary_parse(&poly->poly, file, pd->sp->sr) != 0) {
@@ -76,8 +76,8 @@ int sporth_poly(sporth_stack *stack, void *ud)
             free(file);
             break;
         case PLUMBER_COMPUTE:
-            sporth_stack_pop_float(stack);
-            sporth_stack_pop_float(stack);
+            sporth_stack_pop_fast(stack);
+            sporth_stack_pop_fast(stack);
             poly = pd->last->ud;
 
             poly_compute(&poly->poly);
@@ -118,8 +118,8 @@ int sporth_poly(sporth_stack *stack, void *ud)
             poly = pd->last->ud;
             poly_cluster_destroy(&poly->clust);
             poly_destroy(&poly->poly);
-            free(poly->dur);
-            free(poly);
+            sp_free(poly->dur);
+            sp_free(poly);
             break;
         default:
             fprintf(stderr, "poly: Uknown mode!\n");
@@ -145,7 +145,7 @@ int sporth_tpoly(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "poly: Creating\n");
 #endif
-            poly = malloc(sizeof(sporth_poly_d));
+            poly = sp_malloc(sizeof(sporth_poly_d));
             plumber_add_ugen(pd, SPORTH_TPOLY, poly);
             if(sporth_check_args(stack, "fffss") != SPORTH_OK) {
                 fprintf(stderr,"Invalid arguments for tpoly\n");
@@ -167,7 +167,7 @@ int sporth_tpoly(sporth_stack *stack, void *ud)
                 return PLUMBER_NOTOK;
             }
 
-            poly->dur = malloc(sizeof(uint32_t) * poly->max_voices);
+            poly->dur = sp_malloc(sizeof(uint32_t) * poly->max_voices);
 
             poly_cluster_init(&poly->clust, poly->max_voices);
 
@@ -198,9 +198,9 @@ int sporth_tpoly(sporth_stack *stack, void *ud)
             free(arg_ft);
             break;
         case PLUMBER_COMPUTE:
-            sporth_stack_pop_float(stack);
-            sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            sporth_stack_pop_fast(stack);
+            sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             poly = pd->last->ud;
 
             for(n = 0; n < poly->max_voices; n++) {
@@ -244,8 +244,8 @@ int sporth_tpoly(sporth_stack *stack, void *ud)
         case PLUMBER_DESTROY:
             poly = pd->last->ud;
             poly_cluster_destroy(&poly->clust);
-            free(poly->dur);
-            free(poly);
+            sp_free(poly->dur);
+            sp_free(poly);
             break;
         default:
             fprintf(stderr, "tpoly: Uknown mode!\n");
@@ -268,7 +268,7 @@ int sporth_polyget(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "polyget: Creating\n");
 #endif
-            poly = malloc(sizeof(sporth_poly_d));
+            poly = sp_malloc(sizeof(sporth_poly_d));
             plumber_add_ugen(pd, SPORTH_POLYGET, poly);
             if(sporth_check_args(stack, "ffs") != SPORTH_OK) {
                 fprintf(stderr,"Invalid arguments for polyget\n");
@@ -300,15 +300,15 @@ int sporth_polyget(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             poly = pd->last->ud;
-            param = (uint32_t)sporth_stack_pop_float(stack);
-            voice = (uint32_t)sporth_stack_pop_float(stack);
+            param = (uint32_t)sporth_stack_pop_fast(stack);
+            voice = (uint32_t)sporth_stack_pop_fast(stack);
 
             max_p = (uint32_t)poly->ft->tbl[0] + 2;
-            sporth_stack_push_float(stack, poly->ft->tbl[1 + (max_p * voice) + param]);
+            sporth_stack_push_fast(stack, poly->ft->tbl[1 + (max_p * voice) + param]);
             break;
         case PLUMBER_DESTROY:
             poly = pd->last->ud;
-            free(poly);
+            sp_free(poly);
             break;
         default:
             fprintf(stderr, "polyget: Unknown mode!\n");
@@ -34,13 +34,13 @@ int sporth_port(sporth_stack *stack, void *ud)
         case PLUMBER_COMPUTE:
             data = pd->last->ud;
 
-            htime = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            htime = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
 
             data->htime = htime;
 
             sp_port_compute(pd->sp, data, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             data = pd->last->ud;
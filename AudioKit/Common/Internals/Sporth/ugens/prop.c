@@ -38,16 +38,11 @@ int sporth_prop(sporth_stack *stack, void *ud)
             free(str);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                fprintf(stderr, "Not enough arguments for prop\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            bpm = sporth_stack_pop_float(stack);
+            bpm = sporth_stack_pop_fast(stack);
             data = pd->last->ud;
             data->bpm = bpm;
             sp_prop_compute(pd->sp, data, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             data = pd->last->ud;
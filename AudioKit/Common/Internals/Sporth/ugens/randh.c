@@ -42,15 +42,15 @@ int sporth_randh(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            freq = sporth_stack_pop_float(stack);
-            max = sporth_stack_pop_float(stack);
-            min = sporth_stack_pop_float(stack);
+            freq = sporth_stack_pop_fast(stack);
+            max = sporth_stack_pop_fast(stack);
+            min = sporth_stack_pop_fast(stack);
             randh = pd->last->ud;
             randh->freq = freq;
             randh->min = min;
             randh->max = max;
             sp_randh_compute(pd->sp, randh, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             randh = pd->last->ud;
@@ -41,15 +41,15 @@ int sporth_randi(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            cps = sporth_stack_pop_float(stack);
-            max = sporth_stack_pop_float(stack);
-            min = sporth_stack_pop_float(stack);
+            cps = sporth_stack_pop_fast(stack);
+            max = sporth_stack_pop_fast(stack);
+            min = sporth_stack_pop_fast(stack);
             randi = pd->last->ud;
             randi->min = min;
             randi->max = max;
             randi->cps = cps;
             sp_randi_compute(pd->sp, randi, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             randi = pd->last->ud;
@@ -38,11 +38,11 @@ int sporth_reverse(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            delay = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            delay = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             reverse = pd->last->ud;
             sp_reverse_compute(pd->sp, reverse, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             reverse = pd->last->ud;
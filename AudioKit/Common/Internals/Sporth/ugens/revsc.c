@@ -45,10 +45,10 @@ int sporth_revsc(sporth_stack *stack, void *ud)
         case PLUMBER_COMPUTE:
             data = pd->last->ud;
 
-            lpfreq = sporth_stack_pop_float(stack);
-            feedback = sporth_stack_pop_float(stack);
-            in2 = sporth_stack_pop_float(stack);
-            in1 = sporth_stack_pop_float(stack);
+            lpfreq = sporth_stack_pop_fast(stack);
+            feedback = sporth_stack_pop_fast(stack);
+            in2 = sporth_stack_pop_fast(stack);
+            in1 = sporth_stack_pop_fast(stack);
 
 
             data->feedback = feedback;
@@ -56,8 +56,8 @@ int sporth_revsc(sporth_stack *stack, void *ud)
             out1 = 0; out2 = 0;
             sp_revsc_compute(pd->sp, data, &in1, &in2, &out1, &out2);
 
-            sporth_stack_push_float(stack, out1);
-            sporth_stack_push_float(stack, out2);
+            sporth_stack_push_fast(stack, out1);
+            sporth_stack_push_fast(stack, out2);
 
             break;
 
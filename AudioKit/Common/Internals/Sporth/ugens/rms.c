@@ -35,10 +35,10 @@ int sporth_rms(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            in = sporth_stack_pop_float(stack);
+            in = sporth_stack_pop_fast(stack);
             rms = pd->last->ud;
             sp_rms_compute(pd->sp, rms, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             rms = pd->last->ud;
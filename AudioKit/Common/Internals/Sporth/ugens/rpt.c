@@ -51,18 +51,18 @@ int sporth_rpt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            maxdur = sporth_stack_pop_float(stack);
-            rep = (int)sporth_stack_pop_float(stack);
-            div = (int)sporth_stack_pop_float(stack);
-            bpm = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            maxdur = sporth_stack_pop_fast(stack);
+            rep = (int)sporth_stack_pop_fast(stack);
+            div = (int)sporth_stack_pop_fast(stack);
+            bpm = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             rpt = pd->last->ud;
             rpt->bpm = bpm;
             rpt->div = div;
             rpt->rep = rep;
             sp_rpt_compute(pd->sp, rpt, &trig, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             rpt = pd->last->ud;
@@ -39,11 +39,11 @@ int sporth_samphold(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            trig = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            trig = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             samphold = pd->last->ud;
             sp_samphold_compute(pd->sp, samphold, &trig, &input, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             samphold = pd->last->ud;
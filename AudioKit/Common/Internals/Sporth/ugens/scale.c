@@ -18,6 +18,15 @@ int sporth_scale(sporth_stack *stack, void *ud)
 
             sp_scale_create(&scale);
             plumber_add_ugen(pd, SPORTH_SCALE, scale);
+            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
+                fprintf(stderr,"Not enough arguments for scale\n");
+                stack->error++;
+                return PLUMBER_NOTOK;
+            }
+            sporth_stack_pop_float(stack);
+            sporth_stack_pop_float(stack);
+            sporth_stack_pop_float(stack);
+            sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_INIT:
 
@@ -38,19 +47,14 @@ int sporth_scale(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for scale\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            max = sporth_stack_pop_float(stack);
-            min = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            max = sporth_stack_pop_fast(stack);
+            min = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             scale = pd->last->ud;
             scale->min = min;
             scale->max = max;
             sp_scale_compute(pd->sp, scale, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             scale = pd->last->ud;
@@ -42,14 +42,14 @@ int sporth_streson(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            fdbgain = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            fdbgain = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             streson = pd->last->ud;
             streson->freq = freq;
             streson->fdbgain = fdbgain;
             sp_streson_compute(pd->sp, streson, &input, &output);
-            sporth_stack_push_float(stack, output);
+            sporth_stack_push_fast(stack, output);
             break;
         case PLUMBER_DESTROY:
             streson = pd->last->ud;
@@ -18,6 +18,15 @@ int sporth_switch(sporth_stack *stack, void *ud)
 
             sp_switch_create(&sw);
             plumber_add_ugen(pd, SPORTH_SWITCH, sw);
+            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
+                fprintf(stderr,"Not enough arguments for switch\n");
+                stack->error++;
+                return PLUMBER_NOTOK;
+            }
+            sporth_stack_pop_float(stack);
+            sporth_stack_pop_float(stack);
+            sporth_stack_pop_float(stack);
+            sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_INIT:
 
@@ -38,17 +47,12 @@ int sporth_switch(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "fff") != SPORTH_OK) {
-                fprintf(stderr,"Not enough arguments for switch\n");
-                stack->error++;
-                return PLUMBER_NOTOK;
-            }
-            input_2 = sporth_stack_pop_float(stack);
-            input_1 = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            input_2 = sporth_stack_pop_fast(stack);
+            input_1 = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             sw = pd->last->ud;
             sp_switch_compute(pd->sp, sw, &trig, &input_1, &input_2, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             sw = pd->last->ud;
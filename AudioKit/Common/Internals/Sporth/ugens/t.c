@@ -20,7 +20,7 @@ int sporth_tget(sporth_stack *stack, void *ud)
 
     switch(pd->mode){
         case PLUMBER_CREATE:
-            td = malloc(sizeof(sporth_tbl_d));
+            td = sp_malloc(sizeof(sporth_tbl_d));
             plumber_add_ugen(pd, SPORTH_TGET, td);
             if(sporth_check_args(stack, "fs") != SPORTH_OK) {
                fprintf(stderr,"Init: not enough arguments for tget\n");
@@ -47,13 +47,13 @@ int sporth_tget(sporth_stack *stack, void *ud)
 
         case PLUMBER_COMPUTE:
             td = pd->last->ud;
-            td->index = (unsigned int) floor(sporth_stack_pop_float(stack)) % td->ft->size;
-            sporth_stack_push_float(stack, td->ft->tbl[td->index]);
+            td->index = (unsigned int) floor(sporth_stack_pop_fast(stack)) % td->ft->size;
+            sporth_stack_push_fast(stack, td->ft->tbl[td->index]);
             break;
 
         case PLUMBER_DESTROY:
             td = pd->last->ud;
-            free(td);
+            sp_free(td);
             break;
 
         default:
@@ -72,7 +72,7 @@ int sporth_tset(sporth_stack *stack, void *ud)
 
     switch(pd->mode){
         case PLUMBER_CREATE:
-            td = malloc(sizeof(sporth_tbl_d));
+            td = sp_malloc(sizeof(sporth_tbl_d));
             plumber_add_ugen(pd, SPORTH_TSET, td);
             if(sporth_check_args(stack, "ffs") != SPORTH_OK) {
                fprintf(stderr,"Init: not enough arguments for tset\n");
@@ -99,14 +99,14 @@ int sporth_tset(sporth_stack *stack, void *ud)
 
         case PLUMBER_COMPUTE:
             td = pd->last->ud;
-            td->index = (unsigned int) floor(sporth_stack_pop_float(stack)) % td->ft->size;
-            td->val = sporth_stack_pop_float(stack);
+            td->index = (unsigned int) floor(sporth_stack_pop_fast(stack)) % td->ft->size;
+            td->val = sporth_stack_pop_fast(stack);
             td->ft->tbl[td->index] = td->val;
             break;
 
         case PLUMBER_DESTROY:
             td = pd->last->ud;
-            free(td);
+            sp_free(td);
             break;
 
         default:
@@ -126,7 +126,7 @@ int sporth_tblsize(sporth_stack *stack, void *ud)
 
     switch(pd->mode){
         case PLUMBER_CREATE:
-            tsize = malloc(sizeof(uint32_t));
+            tsize = sp_malloc(sizeof(uint32_t));
             plumber_add_ugen(pd, SPORTH_TBLSIZE, tsize);
             if(sporth_check_args(stack, "s") != SPORTH_OK) {
                fprintf(stderr,"Init: not enough arguments for tblsize\n");
@@ -153,12 +153,12 @@ int sporth_tblsize(sporth_stack *stack, void *ud)
 
         case PLUMBER_COMPUTE:
             tsize = pd->last->ud;
-            sporth_stack_push_float(stack, (SPFLOAT) *tsize);
+            sporth_stack_push_fast(stack, (SPFLOAT) *tsize);
             break;
 
         case PLUMBER_DESTROY:
             tsize = pd->last->ud;
-            free(tsize);
+            sp_free(tsize);
             break;
 
         default:
@@ -178,7 +178,7 @@ int sporth_tbldur(sporth_stack *stack, void *ud)
 
     switch(pd->mode){
         case PLUMBER_CREATE:
-            tlen = malloc(sizeof(SPFLOAT));
+            tlen = sp_malloc(sizeof(SPFLOAT));
             plumber_add_ugen(pd, SPORTH_TBLDUR, tlen);
             if(sporth_check_args(stack, "s") != SPORTH_OK) {
                fprintf(stderr,"Init: not enough arguments for tget\n");
@@ -204,12 +204,12 @@ int sporth_tbldur(sporth_stack *stack, void *ud)
 
         case PLUMBER_COMPUTE:
             tlen = pd->last->ud;
-            sporth_stack_push_float(stack, (SPFLOAT) *tlen);
+            sporth_stack_push_fast(stack, (SPFLOAT) *tlen);
             break;
 
         case PLUMBER_DESTROY:
             tlen = pd->last->ud;
-            free(tlen);
+            sp_free(tlen);
             break;
 
         default:
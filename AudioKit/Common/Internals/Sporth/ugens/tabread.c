@@ -59,17 +59,17 @@ int sporth_tabread(sporth_stack *stack, void *ud)
             free(ftname);
             break;
         case PLUMBER_COMPUTE:
-            wrap = sporth_stack_pop_float(stack);
-            offset = sporth_stack_pop_float(stack);
-            mode = sporth_stack_pop_float(stack);
-            index = sporth_stack_pop_float(stack);
+            wrap = sporth_stack_pop_fast(stack);
+            offset = sporth_stack_pop_fast(stack);
+            mode = sporth_stack_pop_fast(stack);
+            index = sporth_stack_pop_fast(stack);
             tabread = pd->last->ud;
             tabread->index = index;
             tabread->mode = mode;
             tabread->offset = offset;
             tabread->wrap = wrap;
             sp_tabread_compute(pd->sp, tabread, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tabread = pd->last->ud;
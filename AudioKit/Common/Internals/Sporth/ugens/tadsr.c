@@ -48,18 +48,18 @@ int sporth_tadsr(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            rel = sporth_stack_pop_float(stack);
-            sus = sporth_stack_pop_float(stack);
-            dec = sporth_stack_pop_float(stack);
-            atk = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            rel = sporth_stack_pop_fast(stack);
+            sus = sporth_stack_pop_fast(stack);
+            dec = sporth_stack_pop_fast(stack);
+            atk = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             tadsr = pd->last->ud;
             tadsr->atk = atk;
             tadsr->dec = dec;
             tadsr->sus = sus;
             tadsr->rel = rel;
             sp_tadsr_compute(pd->sp, tadsr, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tadsr = pd->last->ud;
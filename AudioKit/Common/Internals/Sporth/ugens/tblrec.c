@@ -21,8 +21,16 @@ int sporth_tblrec(sporth_stack *stack, void *ud)
 
     switch(pd->mode){
         case PLUMBER_CREATE:
-            td = malloc(sizeof(sporth_tbl_d));
+            td = sp_malloc(sizeof(sporth_tbl_d));
             plumber_add_ugen(pd, SPORTH_TBLREC, td);
+            if(sporth_check_args(stack, "ffs") != SPORTH_OK) {
+               fprintf(stderr,"Init: not enough arguments for tblrec\n");
+                return PLUMBER_NOTOK;
+            }
+            ftname = sporth_stack_pop_string(stack);
+            sporth_stack_pop_float(stack);
+            sporth_stack_pop_float(stack);
+            free(ftname);
             break;
 
         case PLUMBER_INIT:
@@ -46,8 +54,8 @@ int sporth_tblrec(sporth_stack *stack, void *ud)
 
         case PLUMBER_COMPUTE:
             td = pd->last->ud;
-            trig = sporth_stack_pop_float(stack);
-            td->val = sporth_stack_pop_float(stack);
+            trig = sporth_stack_pop_fast(stack);
+            td->val = sporth_stack_pop_fast(stack);
 
             if(trig != 0) {
                 if(td->record == 1) {
@@ -67,7 +75,7 @@ int sporth_tblrec(sporth_stack *stack, void *ud)
 
         case PLUMBER_DESTROY:
             td = pd->last->ud;
-            free(td);
+            sp_free(td);
             break;
 
         default:
@@ -36,17 +36,17 @@ int sporth_tenv(sporth_stack *stack, void *ud)
             break;
 
         case PLUMBER_COMPUTE:
-            release = sporth_stack_pop_float(stack);
-            hold = sporth_stack_pop_float(stack);
-            attack = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            release = sporth_stack_pop_fast(stack);
+            hold = sporth_stack_pop_fast(stack);
+            attack = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
 
             data = pd->last->ud;
             data->atk = attack;
             data->rel = release;
             data->hold = hold;
             sp_tenv_compute(pd->sp, data, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
 
         case PLUMBER_DESTROY:
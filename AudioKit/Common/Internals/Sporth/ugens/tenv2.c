@@ -42,14 +42,14 @@ int sporth_tenv2(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            rel = sporth_stack_pop_float(stack);
-            atk = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            rel = sporth_stack_pop_fast(stack);
+            atk = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             tenv2 = pd->last->ud;
             tenv2->atk = atk;
             tenv2->rel = rel;
             sp_tenv2_compute(pd->sp, tenv2, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tenv2 = pd->last->ud;
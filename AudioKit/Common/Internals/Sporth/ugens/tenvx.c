@@ -45,16 +45,16 @@ int sporth_tenvx(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            rel = sporth_stack_pop_float(stack);
-            hold = sporth_stack_pop_float(stack);
-            atk = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            rel = sporth_stack_pop_fast(stack);
+            hold = sporth_stack_pop_fast(stack);
+            atk = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             tenvx = pd->last->ud;
             tenvx->atk = atk;
             tenvx->hold = hold;
             tenvx->rel = rel;
             sp_tenvx_compute(pd->sp, tenvx, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tenvx = pd->last->ud;
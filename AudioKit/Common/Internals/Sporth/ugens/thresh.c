@@ -39,14 +39,14 @@ int sporth_thresh(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            mode = (int)sporth_stack_pop_float(stack);
-            threshold = sporth_stack_pop_float(stack);
-            input = sporth_stack_pop_float(stack);
+            mode = (int)sporth_stack_pop_fast(stack);
+            threshold = sporth_stack_pop_fast(stack);
+            input = sporth_stack_pop_fast(stack);
             thresh = pd->last->ud;
             thresh->thresh = threshold;
             thresh->mode = mode;
             sp_thresh_compute(pd->sp, thresh, &input, &trig);
-            sporth_stack_push_float(stack, trig);
+            sporth_stack_push_fast(stack, trig);
             break;
         case PLUMBER_DESTROY:
             thresh = pd->last->ud;
@@ -12,8 +12,9 @@ int sporth_tick(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "tick: Creating\n");
 #endif
-            tick = malloc(sizeof(int));    
+            tick = sp_malloc(sizeof(int));    
             plumber_add_ugen(pd, SPORTH_TICK, tick);
+            sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_INIT:
 
@@ -32,11 +33,11 @@ int sporth_tick(sporth_stack *stack, void *ud)
             } else {
                 out = 0;
             } 
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tick = pd->last->ud;
-            free(tick);
+            sp_free(tick);
             break;
         default:
             fprintf(stderr, "tick: Uknown mode!\n");
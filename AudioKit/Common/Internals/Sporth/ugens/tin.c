@@ -35,10 +35,10 @@ int sporth_tin(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            trig = sporth_stack_pop_float(stack);
+            trig = sporth_stack_pop_fast(stack);
             tin = pd->last->ud;
             sp_tin_compute(pd->sp, tin, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tin = pd->last->ud;
@@ -9,7 +9,7 @@ int sporth_tog(sporth_stack *stack, void *ud)
     SPFLOAT *val;
     switch(pd->mode){
         case PLUMBER_CREATE:
-            val = malloc(sizeof(SPFLOAT));
+            val = sp_malloc(sizeof(SPFLOAT));
             plumber_add_ugen(pd, SPORTH_TOG, val);
             if(sporth_check_args(stack, "f") != SPORTH_OK) {
                 stack->error++;
@@ -29,15 +29,15 @@ int sporth_tog(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             val = pd->last->ud;
-            trig = sporth_stack_pop_float(stack);
+            trig = sporth_stack_pop_fast(stack);
             if(trig != 0) {
                 *val = (*val == 0) ? 1 : 0;
             } 
-            sporth_stack_push_float(stack, *val);
+            sporth_stack_push_fast(stack, *val);
             break;
         case PLUMBER_DESTROY:
             val = pd->last->ud;
-            free(val);
+            sp_free(val);
             break;
         default:
            printf("Error: Unknown mode!");
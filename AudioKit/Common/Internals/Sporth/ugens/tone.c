@@ -37,12 +37,12 @@ int sporth_tone(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            hp = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            hp = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             tone = pd->last->ud;
             tone->hp = hp;
             sp_tone_compute(pd->sp, tone, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tone = pd->last->ud;
@@ -41,9 +41,9 @@ int sporth_tphasor(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            iphs = sporth_stack_pop_float(stack);
-            freq = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            iphs = sporth_stack_pop_fast(stack);
+            freq = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             tphasor = pd->last->ud;
             tphasor->freq = freq;
 
@@ -52,7 +52,7 @@ int sporth_tphasor(sporth_stack *stack, void *ud)
             }
 
             sp_phasor_compute(pd->sp, tphasor, NULL, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             tphasor = pd->last->ud;
@@ -41,14 +41,14 @@ int sporth_trand(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            max = sporth_stack_pop_float(stack);
-            min = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            max = sporth_stack_pop_fast(stack);
+            min = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
             trand = pd->last->ud;
             trand->min = min;
             trand->max = max;
             sp_trand_compute(pd->sp, trand, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
             trand = pd->last->ud;
@@ -62,12 +62,12 @@ fprintf(stderr, "WE IZ DESTROYING TSEQ!!!!\n");
 
         case PLUMBER_COMPUTE:
             tseq = pd->last->ud;
-            shuf = sporth_stack_pop_float(stack);
-            trig = sporth_stack_pop_float(stack);
+            shuf = sporth_stack_pop_fast(stack);
+            trig = sporth_stack_pop_fast(stack);
 
             tseq->shuf = shuf;
             sp_tseq_compute(pd->sp, tseq, &trig, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             break;
         case PLUMBER_DESTROY:
 #ifdef DEBUG_MODE
@@ -22,7 +22,7 @@ int sporth_vdelay(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             fprintf(stderr, "vdelay: Creating\n");
 #endif
-            vd = malloc(sizeof(sporth_vdelay_d));
+            vd = sp_malloc(sizeof(sporth_vdelay_d));
             sp_vdelay_create(&vd->vdelay);
             plumber_add_ugen(pd, SPORTH_VDELAY, vd);
             if(sporth_check_args(stack, "ffff") != SPORTH_OK) {
@@ -54,20 +54,20 @@ int sporth_vdelay(sporth_stack *stack, void *ud)
             break;
         case PLUMBER_COMPUTE:
             vd = pd->last->ud;
-            maxdel = sporth_stack_pop_float(stack);
-            del = sporth_stack_pop_float(stack);
-            feedback = sporth_stack_pop_float(stack);
-            in = sporth_stack_pop_float(stack);
+            maxdel = sporth_stack_pop_fast(stack);
+            del = sporth_stack_pop_fast(stack);
+            feedback = sporth_stack_pop_fast(stack);
+            in = sporth_stack_pop_fast(stack);
             in += vd->prev * feedback;
             vd->vdelay->del = del;
             sp_vdelay_compute(pd->sp, vd->vdelay, &in, &out);
-            sporth_stack_push_float(stack, out);
+            sporth_stack_push_fast(stack, out);
             vd->prev = out;
             break;
         case PLUMBER_DESTROY:
             vd= pd->last->ud;
             sp_vdelay_destroy(&vd->vdelay);
-            free(vd);
+            sp_free(vd);
             break;
         default:
             fprintf(stderr, "vdelay: Uknown mode!\n");
@@ -35,7 +35,7 @@ int sporth_zeros(sporth_stack *stack, void *ud)
             break;
 
         case PLUMBER_COMPUTE:
-            size = (int)sporth_stack_pop_float(stack);
+            size = (int)sporth_stack_pop_fast(stack);
             break;
 
         case PLUMBER_DESTROY:
@@ -74,19 +74,19 @@ int sporth_zitarev(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            level = sporth_stack_pop_float(stack);
-            mix = sporth_stack_pop_float(stack);
-            eq2_level = sporth_stack_pop_float(stack);
-            eq2_freq = sporth_stack_pop_float(stack);
-            eq1_level = sporth_stack_pop_float(stack);
-            eq1_freq = sporth_stack_pop_float(stack);
-            hf_damping = sporth_stack_pop_float(stack);
-            rt60_mid = sporth_stack_pop_float(stack);
-            rt60_low = sporth_stack_pop_float(stack);
-            lf_x = sporth_stack_pop_float(stack);
-            in_delay = sporth_stack_pop_float(stack);
-            input_2 = sporth_stack_pop_float(stack);
-            input_1 = sporth_stack_pop_float(stack);
+            level = sporth_stack_pop_fast(stack);
+            mix = sporth_stack_pop_fast(stack);
+            eq2_level = sporth_stack_pop_fast(stack);
+            eq2_freq = sporth_stack_pop_fast(stack);
+            eq1_level = sporth_stack_pop_fast(stack);
+            eq1_freq = sporth_stack_pop_fast(stack);
+            hf_damping = sporth_stack_pop_fast(stack);
+            rt60_mid = sporth_stack_pop_fast(stack);
+            rt60_low = sporth_stack_pop_fast(stack);
+            lf_x = sporth_stack_pop_fast(stack);
+            in_delay = sporth_stack_pop_fast(stack);
+            input_2 = sporth_stack_pop_fast(stack);
+            input_1 = sporth_stack_pop_fast(stack);
             zitarev = pd->last->ud;
             *zitarev->in_delay = in_delay;
             *zitarev->lf_x = lf_x;
@@ -100,8 +100,8 @@ int sporth_zitarev(sporth_stack *stack, void *ud)
             *zitarev->mix = mix;
             *zitarev->level = level;
             sp_zitarev_compute(pd->sp, zitarev, &input_1, &input_2, &out_1, &out_2);
-            sporth_stack_push_float(stack, out_1);
-            sporth_stack_push_float(stack, out_2);
+            sporth_stack_push_fast(stack, out_1);
+            sporth_stack_push_fast(stack, out_2);
             break;
         case PLUMBER_DESTROY:
             zitarev = pd->last->ud;
@@ -173,18 +173,18 @@ int sporth_zrev(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
-            hf_damping = sporth_stack_pop_float(stack);
-            rt60_mid = sporth_stack_pop_float(stack);
-            rt60_low = sporth_stack_pop_float(stack);
-            input_2 = sporth_stack_pop_float(stack);
-            input_1 = sporth_stack_pop_float(stack);
+            hf_damping = sporth_stack_pop_fast(stack);
+            rt60_mid = sporth_stack_pop_fast(stack);
+            rt60_low = sporth_stack_pop_fast(stack);
+            input_2 = sporth_stack_pop_fast(stack);
+            input_1 = sporth_stack_pop_fast(stack);
             zitarev = pd->last->ud;
             *zitarev->rt60_low = rt60_low;
             *zitarev->rt60_mid = rt60_mid;
             *zitarev->hf_damping = hf_damping;
             sp_zitarev_compute(pd->sp, zitarev, &input_1, &input_2, &out_1, &out_2);
-            sporth_stack_push_float(stack, out_1);
-            sporth_stack_push_float(stack, out_2);
+            sporth_stack_push_fast(stack, out_1);
+            sporth_stack_push_fast(stack, out_2);
             break;
         case PLUMBER_DESTROY:
             zitarev = pd->last->ud;
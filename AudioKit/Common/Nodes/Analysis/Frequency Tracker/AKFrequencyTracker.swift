@@ -29,7 +29,7 @@ public class AKFrequencyTracker: AKNode, AKToggleable {
     
     /// Detected frequency
     public var frequency: Double {
-        return Double(self.internalAU!.getFrequency()) * 2.0
+        return Double(self.internalAU!.getFrequency())
     }
 
     // MARK: - Initialization
@@ -64,7 +64,7 @@ public class AKFrequencyTracker: AKNode, AKToggleable {
             self.internalAU = avAudioUnitEffect.AUAudioUnit as? AKFrequencyTrackerAudioUnit
             AKManager.sharedInstance.engine.attachNode(self.avAudioNode)
             input.addConnectionPoint(self)
-            self.internalAU?.setFrequencyLimitsWithMinimum(Float(minimumFrequency/2), maximum: Float(maximumFrequency/2))
+            self.internalAU?.setFrequencyLimitsWithMinimum(Float(minimumFrequency), maximum: Float(maximumFrequency))
         }
     }
     
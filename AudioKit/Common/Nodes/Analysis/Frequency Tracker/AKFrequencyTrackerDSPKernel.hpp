@@ -11,6 +11,8 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
+#import <algorithm>
 
 extern "C" {
 #include "soundpipe.h"
@@ -29,8 +31,20 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_pitchamdf_create(&pitchamdf);
-        sp_pitchamdf_init(sp, pitchamdf, minimumFrequency, maximumFrequency);
+        // pitchyin needs 0 < min < max < sr / 2, pitchamdf took any limits
+        float maxFrequency = std::min(maximumFrequency, (float)(sp->sr * 0.5 - 1.0));
+        float minFrequency = std::max(minimumFrequency, (float)1.0);
+        if (minFrequency >= maxFrequency) minFrequency = maxFrequency * 0.5;
+        // one tracker per channel, each sees only its own input
+        trackers.resize(channels);
+        for (int channel = 0; channel < channels; ++channel) {
+            sp_pitchyin_create(&trackers[channel]);
+            if (sp_pitchyin_init(sp, trackers[channel], minFrequency, maxFrequency) != SP_OK) {
+                // nothing to destroy yet, only the struct was allocated
+                sp_free(trackers[channel]);
+                trackers[channel] = nullptr;
+            }
+        }
     }
     
     void start() {
@@ -42,7 +56,9 @@ public:
     }
 
     void destroy() {
-        sp_pitchamdf_destroy(&pitchamdf);
+        for (int channel = 0; channel < channels; ++channel) {
+            if (trackers[channel] != nullptr) sp_pitchyin_destroy(&trackers[channel]);
+        }
         sp_destroy(&sp);
     }
     
@@ -76,24 +92,28 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float temp = *in;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
-                if (started) {
-                    sp_pitchamdf_compute(sp, pitchamdf, in, &trackedFrequency, &trackedAmplitude);
-                } else {
-                    trackedAmplitude = 0;
-                    trackedFrequency = 0;
+        float confidence = -1;
+
+        for (int channel = 0; channel < channels; ++channel) {
+            float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outBufferListPtr->mBuffers[channel].mData + bufferOffset;
+            sp_pitchyin *tracker = trackers[channel];
+            if (started && tracker != nullptr) {
+                sp_pitchyin_compute_block(sp, tracker, in, NULL, NULL, NULL, frameCount);
+                // report the channel with the clearest pitch
+                if (tracker->conf > confidence) {
+                    confidence = tracker->conf;
+                    trackedFrequency = tracker->freq;
+                    trackedAmplitude = tracker->amp;
                 }
-                *out = temp;
             }
+            for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+                out[frameIndex] = in[frameIndex];
+            }
+        }
+        if (!started) {
+            trackedAmplitude = 0;
+            trackedFrequency = 0;
         }
     }
 
@@ -111,7 +131,7 @@ private:
     AudioBufferList* outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_pitchamdf *pitchamdf;
+    std::vector<sp_pitchyin *> trackers;
     
 public:
     float trackedAmplitude = 0.0;
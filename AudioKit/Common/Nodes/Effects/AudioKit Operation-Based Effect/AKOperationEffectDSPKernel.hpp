@@ -94,29 +94,24 @@ public:
             return;
         }
         
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-
-            int frameOffset = int(frameIndex + bufferOffset);
-            
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                if (channel < 2) {
-                    pd.p[channel] = *in;
-                }
-            }
-            
-            for (int i = 0; i < 16; i++) {
-                pd.p[i+2] = parameters[i];
-            }
-            
-            plumber_compute(&pd, PLUMBER_COMPUTE);
-
-            for (int channel = 0; channel < channels; ++channel) {
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
-                *out = sporth_stack_pop_float(&pd.sporth.stack);
-            }
+        const float *in[2];
+        float *out[16];
+        int inCount = channels < 2 ? channels : 2;
+        int outCount = channels < 16 ? channels : 16;
+        for (int channel = 0; channel < inCount; ++channel) {
+            in[channel] = (const float *)inBufferListPtr->mBuffers[channel].mData + bufferOffset;
         }
+        for (int channel = 0; channel < outCount; ++channel) {
+            out[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + bufferOffset;
+        }
+
+        for (int i = 0; i < 16; i++) {
+            pd.p[i+2] = parameters[i];
+        }
+
+        // The input comes in through p[0] and p[1] a sample at a time; the
+        // rest of the patch runs a block at a time where it can.
+        plumber_compute_block(&pd, in, inCount, out, outCount, frameCount);
     }
 
     // MARK: Member Variables
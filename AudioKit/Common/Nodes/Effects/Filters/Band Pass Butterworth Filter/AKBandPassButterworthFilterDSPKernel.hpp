@@ -11,6 +11,7 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
 
 extern "C" {
 #include "soundpipe.h"
@@ -33,10 +34,10 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_butbp_create(&butbp);
-        sp_butbp_init(sp, butbp);
-        butbp->freq = 2000;
-        butbp->bw = 100;
+        sp_bqbank_create(&bqbank);
+        sp_bqbank_init(sp, bqbank, channels);
+        inChannels.resize(channels);
+        outChannels.resize(channels);
     }
 
     void start() {
@@ -48,11 +49,12 @@ public:
     }
 
     void destroy() {
-        sp_butbp_destroy(&butbp);
+        sp_bqbank_destroy(&bqbank);
         sp_destroy(&sp);
     }
 
     void reset() {
+        sp_bqbank_clear(bqbank);
     }
 
     void setParameter(AUParameterAddress address, AUValue value) {
@@ -99,28 +101,43 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            double centerFrequency = double(centerFrequencyRamper.getStep());
-            double bandwidth = double(bandwidthRamper.getStep());
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-            butbp->freq = (float)centerFrequency;
-            butbp->bw = (float)bandwidth;
+        if (!started) {
+            outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
+            outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
+            return;
+        }
 
-            if (!started) {
-                outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
-                outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
-                return;
+        // Frames are filtered in runs that share the same coefficients, so
+        // unramped buffers go through the filter bank in a single block.
+        int runStart = 0;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float centerFrequency = centerFrequencyRamper.getStep();
+            float bandwidth = bandwidthRamper.getStep();
+
+            if (centerFrequency != designedCenterFrequency || bandwidth != designedBandwidth) {
+                processFrames(runStart, frameIndex, bufferOffset);
+                runStart = frameIndex;
+                designedCenterFrequency = centerFrequency;
+                designedBandwidth = bandwidth;
+                sp_bqbank_butbp(sp, centerFrequency, bandwidth, coefficients);
+                for (int channel = 0; channel < channels; ++channel) {
+                    sp_bqbank_set(bqbank, channel, coefficients);
+                }
             }
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        processFrames(runStart, frameCount, bufferOffset);
+    }
 
-                sp_butbp_compute(sp, butbp, in, out);
-            }
+    void processFrames(int startFrame, int endFrame, AUAudioFrameCount bufferOffset) {
+        if (endFrame <= startFrame) {
+            return;
         }
+        int frameOffset = int(startFrame + bufferOffset);
+        for (int channel = 0; channel < channels; ++channel) {
+            inChannels[channel]  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+            outChannels[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        sp_bqbank_compute_block(sp, bqbank, inChannels.data(), outChannels.data(), endFrame - startFrame);
     }
 
     // MARK: Member Variables
@@ -134,7 +151,13 @@ private:
     AudioBufferList *outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_butbp *butbp;
+    sp_bqbank *bqbank;
+    float coefficients[5];
+    float designedCenterFrequency = -1.0;
+    float designedBandwidth = -1.0;
+
+    std::vector<const float *> inChannels;
+    std::vector<float *> outChannels;
 
 public:
     bool started = true;
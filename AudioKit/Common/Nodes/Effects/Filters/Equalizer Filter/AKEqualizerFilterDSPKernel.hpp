@@ -11,6 +11,7 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
 
 extern "C" {
 #include "soundpipe.h"
@@ -34,11 +35,10 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_eqfil_create(&eqfil);
-        sp_eqfil_init(sp, eqfil);
-        eqfil->freq = 1000;
-        eqfil->bw = 100;
-        eqfil->gain = 10;
+        sp_bqbank_create(&bqbank);
+        sp_bqbank_init(sp, bqbank, channels);
+        inChannels.resize(channels);
+        outChannels.resize(channels);
     }
 
     void start() {
@@ -50,11 +50,12 @@ public:
     }
 
     void destroy() {
-        sp_eqfil_destroy(&eqfil);
+        sp_bqbank_destroy(&bqbank);
         sp_destroy(&sp);
     }
 
     void reset() {
+        sp_bqbank_clear(bqbank);
     }
 
     void setParameter(AUParameterAddress address, AUValue value) {
@@ -112,30 +113,45 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            double centerFrequency = double(centerFrequencyRamper.getStep());
-            double bandwidth = double(bandwidthRamper.getStep());
-            double gain = double(gainRamper.getStep());
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-            eqfil->freq = (float)centerFrequency;
-            eqfil->bw = (float)bandwidth;
-            eqfil->gain = (float)gain;
+        if (!started) {
+            outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
+            outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
+            return;
+        }
 
-            if (!started) {
-                outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
-                outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
-                return;
+        // Frames are filtered in runs that share the same coefficients, so
+        // unramped buffers go through the filter bank in a single block.
+        int runStart = 0;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float centerFrequency = centerFrequencyRamper.getStep();
+            float bandwidth = bandwidthRamper.getStep();
+            float gain = gainRamper.getStep();
+
+            if (centerFrequency != designedCenterFrequency || bandwidth != designedBandwidth || gain != designedGain) {
+                processFrames(runStart, frameIndex, bufferOffset);
+                runStart = frameIndex;
+                designedCenterFrequency = centerFrequency;
+                designedBandwidth = bandwidth;
+                designedGain = gain;
+                sp_bqbank_eqfil(sp, centerFrequency, bandwidth, gain, coefficients);
+                for (int channel = 0; channel < channels; ++channel) {
+                    sp_bqbank_set(bqbank, channel, coefficients);
+                }
             }
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        processFrames(runStart, frameCount, bufferOffset);
+    }
 
-                sp_eqfil_compute(sp, eqfil, in, out);
-            }
+    void processFrames(int startFrame, int endFrame, AUAudioFrameCount bufferOffset) {
+        if (endFrame <= startFrame) {
+            return;
+        }
+        int frameOffset = int(startFrame + bufferOffset);
+        for (int channel = 0; channel < channels; ++channel) {
+            inChannels[channel]  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+            outChannels[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
         }
+        sp_bqbank_compute_block(sp, bqbank, inChannels.data(), outChannels.data(), endFrame - startFrame);
     }
 
     // MARK: Member Variables
@@ -149,7 +165,14 @@ private:
     AudioBufferList *outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_eqfil *eqfil;
+    sp_bqbank *bqbank;
+    float coefficients[5];
+    float designedCenterFrequency = -1.0;
+    float designedBandwidth = -1.0;
+    float designedGain = -1.0;
+
+    std::vector<const float *> inChannels;
+    std::vector<float *> outChannels;
 
 public:
     bool started = true;
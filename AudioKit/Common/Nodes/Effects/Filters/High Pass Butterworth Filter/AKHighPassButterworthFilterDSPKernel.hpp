@@ -11,6 +11,7 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
 
 extern "C" {
 #include "soundpipe.h"
@@ -32,9 +33,10 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_buthp_create(&buthp);
-        sp_buthp_init(sp, buthp);
-        buthp->freq = 500;
+        sp_bqbank_create(&bqbank);
+        sp_bqbank_init(sp, bqbank, channels);
+        inChannels.resize(channels);
+        outChannels.resize(channels);
     }
 
     void start() {
@@ -46,11 +48,12 @@ public:
     }
 
     void destroy() {
-        sp_buthp_destroy(&buthp);
+        sp_bqbank_destroy(&bqbank);
         sp_destroy(&sp);
     }
 
     void reset() {
+        sp_bqbank_clear(bqbank);
     }
 
     void setParameter(AUParameterAddress address, AUValue value) {
@@ -86,26 +89,41 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            double cutoffFrequency = double(cutoffFrequencyRamper.getStep());
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-            buthp->freq = (float)cutoffFrequency;
+        if (!started) {
+            outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
+            outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
+            return;
+        }
 
-            if (!started) {
-                outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
-                outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
-                return;
+        // Frames are filtered in runs that share the same coefficients, so
+        // unramped buffers go through the filter bank in a single block.
+        int runStart = 0;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float cutoffFrequency = cutoffFrequencyRamper.getStep();
+
+            if (cutoffFrequency != designedCutoffFrequency) {
+                processFrames(runStart, frameIndex, bufferOffset);
+                runStart = frameIndex;
+                designedCutoffFrequency = cutoffFrequency;
+                sp_bqbank_buthp(sp, cutoffFrequency, coefficients);
+                for (int channel = 0; channel < channels; ++channel) {
+                    sp_bqbank_set(bqbank, channel, coefficients);
+                }
             }
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        processFrames(runStart, frameCount, bufferOffset);
+    }
 
-                sp_buthp_compute(sp, buthp, in, out);
-            }
+    void processFrames(int startFrame, int endFrame, AUAudioFrameCount bufferOffset) {
+        if (endFrame <= startFrame) {
+            return;
         }
+        int frameOffset = int(startFrame + bufferOffset);
+        for (int channel = 0; channel < channels; ++channel) {
+            inChannels[channel]  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+            outChannels[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        sp_bqbank_compute_block(sp, bqbank, inChannels.data(), outChannels.data(), endFrame - startFrame);
     }
 
     // MARK: Member Variables
@@ -119,7 +137,12 @@ private:
     AudioBufferList *outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_buthp *buthp;
+    sp_bqbank *bqbank;
+    float coefficients[5];
+    float designedCutoffFrequency = -1.0;
+
+    std::vector<const float *> inChannels;
+    std::vector<float *> outChannels;
 
 public:
     bool started = true;
@@ -11,6 +11,7 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
 
 extern "C" {
 #include "soundpipe.h"
@@ -33,10 +34,12 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_moogladder_create(&moogladder);
-        sp_moogladder_init(sp, moogladder);
-        moogladder->freq = 1000;
-        moogladder->res = 0.5;
+        sp_moogbank_create(&moogbank);
+        sp_moogbank_init(sp, moogbank, channels);
+        moogbank->freq = 1000;
+        moogbank->res = 0.5;
+        inChannels.resize(channels);
+        outChannels.resize(channels);
     }
 
     void start() {
@@ -48,11 +51,12 @@ public:
     }
 
     void destroy() {
-        sp_moogladder_destroy(&moogladder);
+        sp_moogbank_destroy(&moogbank);
         sp_destroy(&sp);
     }
 
     void reset() {
+        sp_moogbank_clear(moogbank);
     }
 
     void setParameter(AUParameterAddress address, AUValue value) {
@@ -99,28 +103,39 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            double cutoffFrequency = double(cutoffFrequencyRamper.getStep());
-            double resonance = double(resonanceRamper.getStep());
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-            moogladder->freq = (float)cutoffFrequency;
-            moogladder->res = (float)resonance;
+        if (!started) {
+            outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
+            outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
+            return;
+        }
 
-            if (!started) {
-                outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
-                outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
-                return;
+        // Each channel has its own ladder. Frames are filtered in runs that
+        // share the same parameters, so unramped buffers are a single block.
+        int runStart = 0;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float cutoffFrequency = cutoffFrequencyRamper.getStep();
+            float resonance = resonanceRamper.getStep();
+
+            if (cutoffFrequency != moogbank->freq || resonance != moogbank->res) {
+                processFrames(runStart, frameIndex, bufferOffset);
+                runStart = frameIndex;
+                moogbank->freq = cutoffFrequency;
+                moogbank->res = resonance;
             }
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        processFrames(runStart, frameCount, bufferOffset);
+    }
 
-                sp_moogladder_compute(sp, moogladder, in, out);
-            }
+    void processFrames(int startFrame, int endFrame, AUAudioFrameCount bufferOffset) {
+        if (endFrame <= startFrame) {
+            return;
         }
+        int frameOffset = int(startFrame + bufferOffset);
+        for (int channel = 0; channel < channels; ++channel) {
+            inChannels[channel]  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+            outChannels[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+        }
+        sp_moogbank_compute_block(sp, moogbank, inChannels.data(), outChannels.data(), endFrame - startFrame);
     }
 
     // MARK: Member Variables
@@ -134,7 +149,10 @@ private:
     AudioBufferList *outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_moogladder *moogladder;
+    sp_moogbank *moogbank;
+
+    std::vector<const float *> inChannels;
+    std::vector<float *> outChannels;
 
 public:
     bool started = true;
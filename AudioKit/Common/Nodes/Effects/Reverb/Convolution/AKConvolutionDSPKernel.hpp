@@ -11,6 +11,7 @@
 
 #import "AKDSPKernel.hpp"
 #import "AKParameterRamper.hpp"
+#import <vector>
 
 extern "C" {
 #include "soundpipe.h"
@@ -29,7 +30,11 @@ public:
         sampleRate = float(inSampleRate);
 
         sp_create(&sp);
-        sp_conv_create(&conv);
+        // one convolver per channel, each with its own input
+        convs.resize(channels);
+        for (int channel = 0; channel < channels; ++channel) {
+            sp_conv_create(&convs[channel]);
+        }
 
     }
 
@@ -39,7 +44,13 @@ public:
 
     void start() {
         started = true;
-        sp_conv_init(sp, conv, ftbl, (float)partitionLength);
+        // the IR tail runs in larger partitions, latency stays at partitionLength
+        int maxPartitionLength = partitionLength > tailPartitionLength ? partitionLength : tailPartitionLength;
+        for (int channel = 0; channel < channels; ++channel) {
+            sp_conv_init_nonuniform(sp, convs[channel], ftbl, (float)partitionLength, (float)maxPartitionLength);
+            // large partitions go to a worker thread; stays on this thread if none qualify
+            sp_conv_thread_start(convs[channel], (float)threadPartitionLength);
+        }
     }
 
     void stop() {
@@ -53,7 +64,9 @@ public:
     }
 
     void destroy() {
-        sp_conv_destroy(&conv);
+        for (int channel = 0; channel < channels; ++channel) {
+            sp_conv_destroy(&convs[channel]);
+        }
         sp_destroy(&sp);
     }
 
@@ -98,7 +111,7 @@ public:
                 float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
                 float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
 
-                sp_conv_compute(sp, conv, in, out);
+                sp_conv_compute(sp, convs[channel], in, out);
                 *out = *out * 0.05; // Hack
             }
         }
@@ -111,12 +124,14 @@ private:
     int channels = 2;
     float sampleRate = 44100.0;
     int partitionLength = 2048;
+    int tailPartitionLength = 8192;
+    int threadPartitionLength = 2048;
 
     AudioBufferList *inBufferListPtr = nullptr;
     AudioBufferList *outBufferListPtr = nullptr;
 
     sp_data *sp;
-    sp_conv *conv;
+    std::vector<sp_conv *> convs;
     sp_ftbl *ftbl;
     UInt32 ftbl_size = 4096;
 
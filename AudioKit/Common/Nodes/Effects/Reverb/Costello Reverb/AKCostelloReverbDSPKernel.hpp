@@ -99,34 +99,41 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        if (!started) {
+            outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
+            outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
+            return;
+        }
 
-            if (!started) {
-                outBufferListPtr->mBuffers[0] = inBufferListPtr->mBuffers[0];
-                outBufferListPtr->mBuffers[1] = inBufferListPtr->mBuffers[1];
-                return;
-            }
-            double feedback = double(feedbackRamper.getStep());
-            double cutoffFrequency = double(cutoffFrequencyRamper.getStep());
-
-            int frameOffset = int(frameIndex + bufferOffset);
-
-            revsc->feedback = (float)feedback;
-            revsc->lpfreq = (float)cutoffFrequency;
-            float *tmpin[2];
-            float *tmpout[2];
-            for (int channel = 0; channel < channels; ++channel) {
-                float *in  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
-                if (channel < 2) {
-                    tmpin[channel] = in;
-                    tmpout[channel] = out;
-                }
+        // Frames are reverberated in runs that share the same parameters,
+        // so unramped buffers are a single block.
+        int runStart = 0;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float feedback = feedbackRamper.getStep();
+            float cutoffFrequency = cutoffFrequencyRamper.getStep();
+
+            if (feedback != revsc->feedback || cutoffFrequency != revsc->lpfreq) {
+                processFrames(runStart, frameIndex, bufferOffset);
+                runStart = frameIndex;
+                revsc->feedback = feedback;
+                revsc->lpfreq = cutoffFrequency;
             }
-            sp_revsc_compute(sp, revsc, tmpin[0], tmpin[1], tmpout[0], tmpout[1]);
+        }
+        processFrames(runStart, frameCount, bufferOffset);
+    }
 
+    void processFrames(int startFrame, int endFrame, AUAudioFrameCount bufferOffset) {
+        if (endFrame <= startFrame) {
+            return;
+        }
+        int frameOffset = int(startFrame + bufferOffset);
+        float *in[2];
+        float *out[2];
+        for (int channel = 0; channel < 2; ++channel) {
+            in[channel]  = (float *)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+            out[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
         }
+        sp_revsc_compute_block(sp, revsc, in[0], in[1], out[0], out[1], endFrame - startFrame);
     }
 
     // MARK: Member Variables
@@ -95,27 +95,24 @@ public:
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
 
-        // For each sample.
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-
-            int frameOffset = int(frameIndex + bufferOffset);
-            
-            pd.p[0] = internalTrigger;
-            pd.p[1] = internalTrigger;
-            for (int i = 0; i < 10; i++) {
-                pd.p[i+2] = parameters[i];
-            }
-            if (started) {
-                plumber_compute(&pd, PLUMBER_COMPUTE);
-            }
+        float *out[16];
+        int outCount = channels < 16 ? channels : 16;
+        for (int channel = 0; channel < outCount; ++channel) {
+            out[channel] = (float *)outBufferListPtr->mBuffers[channel].mData + bufferOffset;
+        }
 
-            for (int channel = 0; channel < channels; ++channel) {
-                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
-                if (started) {
-                    *out = sporth_stack_pop_float(&pd.sporth.stack);
-                } else {
-                    *out = 0;
-                }
+        // The trigger and parameters hold still for the whole buffer, so the
+        // patch can run a block at a time.
+        pd.p[0] = internalTrigger;
+        pd.p[1] = internalTrigger;
+        for (int i = 0; i < 10; i++) {
+            pd.p[i+2] = parameters[i];
+        }
+        if (started) {
+            plumber_compute_block(&pd, nullptr, 0, out, outCount, frameCount);
+        } else {
+            for (int channel = 0; channel < outCount; ++channel) {
+                std::fill(out[channel], out[channel] + frameCount, 0.0f);
             }
         }
         if (internalTrigger == 1) {
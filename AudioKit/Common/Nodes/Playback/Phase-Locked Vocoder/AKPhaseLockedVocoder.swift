@@ -151,7 +151,7 @@ public class AKPhaseLockedVocoder: AKNode {
             theOutputFormat.mFormatID = kAudioFormatLinearPCM
             theOutputFormat.mFormatFlags = kLinearPCMFormatFlagIsFloat
             theOutputFormat.mBitsPerChannel = UInt32(strideof(Float)) * 8
-            theOutputFormat.mChannelsPerFrame = 1; // Mono
+            theOutputFormat.mChannelsPerFrame = theFileFormat.mChannelsPerFrame // Mono or interleaved stereo
             theOutputFormat.mBytesPerFrame = theOutputFormat.mChannelsPerFrame * UInt32(strideof(Float))
             theOutputFormat.mFramesPerPacket = 1
             theOutputFormat.mBytesPerPacket = theOutputFormat.mFramesPerPacket * theOutputFormat.mBytesPerFrame
@@ -181,7 +181,7 @@ public class AKPhaseLockedVocoder: AKNode {
                 if err == noErr {
                     // success
                     let data=UnsafeMutablePointer<Float>(theDataBuffer.mBuffers.mData)
-                    internalAU?.setupAudioFileTable(data, size: ioNumberFrames)
+                    internalAU?.setupAudioFileTable(data, size: ioNumberFrames, channels: theOutputFormat.mChannelsPerFrame)
                     internalAU!.start()
                 } else {
                     // failure
@@ -16,7 +16,7 @@
 @property (nonatomic) float amplitude;
 @property (nonatomic) float pitchRatio;
 
-- (void)setupAudioFileTable:(float *)data size:(UInt32)size;
+- (void)setupAudioFileTable:(float *)data size:(UInt32)size channels:(UInt32)channels;
 
 - (void)start;
 - (void)stop;
@@ -40,8 +40,8 @@
     _kernel.setPitchratio(pitchRatio);
 }
 
-- (void)setupAudioFileTable:(float *)data size:(UInt32)size {
-    _kernel.setUpTable(data, size);
+- (void)setupAudioFileTable:(float *)data size:(UInt32)size channels:(UInt32)channels {
+    _kernel.setUpTable(data, size, channels);
 }
 
 - (void)start {
@@ -39,7 +39,7 @@ public:
 
     void start() {
         started = true;
-        sp_mincer_init(sp, mincer, ftbl);
+        sp_mincer_initn(sp, mincer, ftbl, tableChannels, 0, 2048, 4);
         mincer->time = 0;
         mincer->amp = 1;
         mincer->pitch = 1;
@@ -49,8 +49,10 @@ public:
         started = false;
     }
     
-    void setUpTable(float *table, UInt32 size) {
-        ftbl_size = size;
+    void setUpTable(float *table, UInt32 size, UInt32 channelCount) {
+        // size is in frames, the table holds channelCount interleaved channels
+        tableChannels = channelCount;
+        ftbl_size = size * channelCount;
         sp_ftbl_create(sp, &ftbl, ftbl_size);
         ftbl->tbl = table;
     }
@@ -145,17 +147,15 @@ public:
             mincer->amp = amplitude;
             mincer->pitch = pitchRatio;
 
-//            for (int channel = 0; channel < channels; ++channel) {
-                float *outL = (float *)outBufferListPtr->mBuffers[0].mData + frameOffset;
-                float *outR = (float *)outBufferListPtr->mBuffers[1].mData + frameOffset;
-                if (started) {
-                    sp_mincer_compute(sp, mincer, NULL, outL);
-                    *outR = *outL;
-                } else {
-                    *outL = 0;
-                    *outR = 0;
-                }
-//            }
+            float tableOut[2] = {0, 0};
+            if (started) {
+                sp_mincer_compute(sp, mincer, NULL, tableOut);
+            }
+            for (int channel = 0; channel < channels; ++channel) {
+                float *out = (float *)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+                // a mono table feeds every output channel
+                *out = tableOut[channel < tableChannels ? channel : 0];
+            }
         }
     }
 
@@ -172,6 +172,7 @@ private:
     sp_mincer *mincer;
     sp_ftbl *ftbl;
     UInt32 ftbl_size = 4096;
+    int tableChannels = 1;
 
     float position = 0;
     float amplitude = 1;
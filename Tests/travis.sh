@@ -5,6 +5,12 @@ if test `find . -name \*.pbxproj -exec grep -H /Users/ {} \;|tee /tmp/found|wc -
 fi
 set -o pipefail
 
+echo "Testing Soundpipe"
+sh AudioKit/Common/Internals/Soundpipe/test/run_tests.sh || exit 3
+
+echo "Testing sporth2c"
+sh AudioKit/Common/Internals/Sporth/test/sporth2c.sh || exit 2
+
 echo "Building AudioKit Frameworks"
 cd Frameworks
 ./build_frameworks.sh || exit 1